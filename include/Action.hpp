@@ -28,12 +28,14 @@
 #include <iostream>
 #include <memory>
 #include <atomic>
+#include <chrono>
 
 #include "util/Utf8String.hpp"
 #include "util/threading/ThreadTask.hpp"
 
 #include "ResponseCode.hpp"
 #include "NetworkConnection.hpp"
+#include "CompletionToken.hpp"
 
 #define DEFAULT_NETWORK_ACTION_THREAD_SLEEP_DURATION_MS 100
 
@@ -64,6 +66,30 @@ namespace awsiotsdk {
         GREENGRASS_DISCOVER = 16
     };
 
+    /**
+     * @brief ActionPriority Enum Class
+     *
+     * Defines the priority classes for outbound Actions. Queued Actions are processed in strict priority order,
+     * Actions of the same priority are processed in the order they were queued.
+     */
+    enum class ActionPriority {
+        CONTROL = 0,  ///< Protocol control packets like PUBACK and SUBSCRIBE
+        HIGH = 1,     ///< Default for QoS1 publishes
+        LOW = 2       ///< Default for QoS0 publishes
+    };
+
+    /**
+     * @brief OverflowPolicy Enum Class
+     *
+     * Defines what happens when an Action is queued while its priority lane is full. Actions that are dropped or
+     * rejected have their Ack listeners notified with ResponseCode::ACTION_QUEUE_FULL.
+     */
+    enum class OverflowPolicy {
+        DROP_NEWEST = 0,  ///< Reject the new Action. Default
+        DROP_OLDEST = 1,  ///< Drop the oldest queued Action of the same priority to make room for the new one
+        BLOCK = 2         ///< Wait for room until the configured timeout expires, then reject the new Action
+    };
+
     /**
      * @brief Action State Class
      *
@@ -116,6 +142,30 @@ namespace awsiotsdk {
         virtual ~ActionData() = default;                        // Default destructor
 
         AsyncAckNotificationHandlerPtr p_async_ack_handler_;    ///< Handler to call when response is received for this action
+        std::shared_ptr<CompletionToken> p_completion_token_;   ///< Token to complete when response is received for this action
+
+        /**
+         * @brief Check whether the caller wants to be notified of the response to this action
+         * @return boolean indicating whether an Ack handler or a completion token is set
+         */
+        bool HasAckListener() { return nullptr != p_async_ack_handler_ || nullptr != p_completion_token_; }
+
+        /**
+         * @brief Check whether the peer responds to this action
+         *
+         * Actions without a response, like QoS0 Publishes, notify their listeners as soon as they have been sent
+         *
+         * @return boolean indicating whether a response is expected
+         */
+        virtual bool IsAckExpected() { return true; }
+
+        /**
+         * @brief Call the Ack handler and complete the completion token, whichever are set
+         *
+         * @param action_id - ID of the Action the response is for
+         * @param rc - Response
+         */
+        void NotifyAckListeners(uint16_t action_id, ResponseCode rc);
 
         /**
          * @brief Get ID of the current run of this Action
@@ -189,6 +239,52 @@ namespace awsiotsdk {
         virtual ResponseCode PerformAction(std::shared_ptr<NetworkConnection> p_network_connection,
                                            std::shared_ptr<ActionData> p_action_data) = 0;
 
+        /**
+         * @brief Check whether the Action can be run one step at a time using PerformActionStep
+         *
+         * Only long running runner Actions need to support this. Steppable runners can share the threads of a
+         * util::Threading::Executor instead of each using a dedicated thread.
+         *
+         * @return boolean indicating whether PerformActionStep is implemented
+         */
+        virtual bool IsSteppable() { return false; }
+
+        /**
+         * @brief Check whether the steps of the Action only have work to do when the network connection has data
+         *
+         * Executors that can wait on descriptors, such as util::Threading::EventLoop, run the steps of such Actions
+         * when the connection's poll descriptor becomes readable instead of polling them.
+         *
+         * @return boolean indicating whether steps wait for incoming network data
+         */
+        virtual bool WaitsForNetworkData() { return false; }
+
+        /**
+         * @brief Check whether the next step has work to do without new network data
+         *
+         * Only meaningful for Actions that wait for network data. Executors do not wait on the poll descriptor
+         * before running the next step of an Action that returns true, eg. one that has kept back work it could not
+         * hand off in its last step.
+         *
+         * @return boolean indicating whether the next step must run even if no data arrives
+         */
+        virtual bool IsStepPending() { return false; }
+
+        /**
+         * @brief Perform one step of a long running Action
+         *
+         * A step does a bounded amount of work and does not sleep, the time until the next step is returned instead.
+         * Steps are never run concurrently. The default implementation finishes immediately.
+         *
+         * @param p_network_connection - Network connection to be used to perform the Action
+         * @param p_action_data - Action data to be used for this run of the action
+         * @param next_step_delay_out[out] - Delay before the next step, negative once the Action is finished
+         * @return ResponseCode indicating result of the step
+         */
+        virtual ResponseCode PerformActionStep(std::shared_ptr<NetworkConnection> p_network_connection,
+                                               std::shared_ptr<ActionData> p_action_data,
+                                               std::chrono::microseconds &next_step_delay_out);
+
         // Rule of 5 stuff
         // Disabling default, move and copy constructors
         // Actions instances can be run as threads if needed and should not be copied or moved
@@ -222,6 +318,19 @@ namespace awsiotsdk {
         ResponseCode ReadFromNetworkBuffer(std::shared_ptr<NetworkConnection> p_network_connection,
                                            util::Vector<unsigned char> &read_buf, size_t bytes_to_read);
 
+        /**
+         * @brief Run PerformActionStep on the calling thread until the Action is finished or the parent thread sync
+         * is cleared, sleeping between steps
+         *
+         * Lets steppable runners implement PerformAction for a dedicated thread on top of PerformActionStep
+         *
+         * @param p_network_connection - Network connection to be used to perform the Action
+         * @param p_action_data - Action data to be used for this run of the action
+         * @return ResponseCode returned by the last step
+         */
+        ResponseCode RunActionSteps(std::shared_ptr<NetworkConnection> p_network_connection,
+                                    std::shared_ptr<ActionData> p_action_data);
+
         /**
          * @brief Generic Network Write function for all actions
          * @param p_network_connection - Network connection to be used to perform Write
@@ -230,5 +339,18 @@ namespace awsiotsdk {
          */
         ResponseCode WriteToNetworkBuffer(std::shared_ptr<NetworkConnection> p_network_connection,
                                           const util::String &write_buf);
+
+        /**
+         * @brief Generic Network Write function for packets serialized as several segments
+         *
+         * Writes the segments in order as one contiguous stream without copying them. Partial writes are continued
+         * from where they stopped while the action's thread is running.
+         *
+         * @param p_network_connection - Network connection to be used to perform Write
+         * @param segments - Segments containing data to be written to the network instance
+         * @return ResponeCode indicating result of the API call
+         */
+        ResponseCode WriteToNetworkBuffer(std::shared_ptr<NetworkConnection> p_network_connection,
+                                          const util::Vector<WriteSegment> &segments);
     };
 }
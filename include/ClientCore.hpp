@@ -27,6 +27,7 @@
 #pragma once
 
 #include "ClientCoreState.hpp"
+#include "util/threading/Executor.hpp"
 #include "util/threading/ThreadTask.hpp"
 
 namespace awsiotsdk {
@@ -43,8 +44,50 @@ namespace awsiotsdk {
     AWS_API_EXPORT class ClientCore {
     protected:
         util::Map<ActionType, std::shared_ptr<util::Threading::ThreadTask>> thread_map_;  ///< Map for storing currently active threads
+        util::Map<ActionType, std::shared_ptr<util::Threading::Executor::Task>> task_map_;  ///< Map for storing tasks scheduled on the executor
 
         std::shared_ptr<ClientCoreState>p_client_core_state_;                             ///< Client Core state instance
+        std::shared_ptr<util::Threading::Executor> p_executor_;                           ///< Shared executor, nullptr if each runner has its own thread
+        std::shared_ptr<std::atomic_bool> task_sync_;                                     ///< Sync point of all runners scheduled on the executor
+
+        /**
+         * @brief Descriptor watch of a runner that waits for network data
+         *
+         * Shared between ClientCore and the step function of the runner's task
+         */
+        class NetworkDataWatch {
+        public:
+            std::mutex watch_lock_;                                    ///< Protects p_task_, which is set after scheduling
+            std::weak_ptr<util::Threading::Executor::Task> p_task_;    ///< Task of the runner
+            int watched_descriptor_;                                   ///< Last poll descriptor of the connection
+            bool is_armed_;                                            ///< Whether the descriptor is being watched
+            std::atomic_bool is_reconnected_;                          ///< Set when a new connection is established
+
+            NetworkDataWatch() : watched_descriptor_(-1), is_armed_(false), is_reconnected_(false) {}
+        };
+
+        /**
+         * @brief Run one step of a runner that waits for network data
+         *
+         * Watches the connection's poll descriptor and parks the task while there is nothing to read. The watch is
+         * armed again right after a step that left nothing to read, eg. one that only received part of a packet.
+         * Parked tasks are woken up by the descriptor, or by the network connect handler once a new connection has
+         * been established. Falls back to running every step if the executor or the connection does not support
+         * descriptor watches.
+         *
+         * @param p_weak_executor - Executor the runner is scheduled on
+         * @param p_watch - Watch state of the runner
+         * @param p_runner - Runner Action
+         * @param p_network_connection - Network connection of the runner
+         * @param p_action_data - Action data of the runner
+         * @return std::chrono::microseconds delay before the next step, negative once the runner is finished or
+         * util::Threading::Executor::ParkedStepDelay() while the descriptor is watched
+         */
+        static std::chrono::microseconds RunWatchedActionStep(std::weak_ptr<util::Threading::Executor> p_weak_executor,
+                                                              std::shared_ptr<NetworkDataWatch> p_watch,
+                                                              std::shared_ptr<Action> p_runner,
+                                                              std::shared_ptr<NetworkConnection> p_network_connection,
+                                                              std::shared_ptr<ActionData> p_action_data);
 
         /**
          * @brief Constructor
@@ -54,6 +97,16 @@ namespace awsiotsdk {
          */
         ClientCore(std::shared_ptr<NetworkConnection> p_network_connection, std::shared_ptr<ClientCoreState> p_state);
 
+        /**
+         * @brief Constructor
+         *
+         * @param p_network_connection - Network Connection instance to be passed as argument to actions
+         * @param p_state - Client Core state instance
+         * @param p_executor - Executor to run the outbound queue and steppable runners on, nullptr for dedicated threads
+         */
+        ClientCore(std::shared_ptr<NetworkConnection> p_network_connection, std::shared_ptr<ClientCoreState> p_state,
+                   std::shared_ptr<util::Threading::Executor> p_executor);
+
     public:
         // Disabling default, copy and move constructors. Defining the virtual destructor
         // Class contains thread instances. Should not be copied or moved
@@ -83,6 +136,23 @@ namespace awsiotsdk {
         static std::unique_ptr<ClientCore> Create(std::shared_ptr<NetworkConnection> p_network_connection,
                                                   std::shared_ptr<ClientCoreState> p_state);
 
+        /**
+         * @brief Factory method for creating a Client Core instance that runs on a shared executor
+         *
+         * The outbound queue and all steppable Action runners are run as tasks on the provided executor instead of
+         * in dedicated threads, so any number of Client Core instances can share a fixed number of threads. Runners
+         * that are not steppable still get a dedicated Thread Task. With a util::Threading::EventLoop, runners that
+         * wait for network data only run when the connection's poll descriptor is readable.
+         *
+         * @param p_network_connection - Network Connection instance to be passed as argument to actions
+         * @param p_state - Client Core state instance
+         * @param p_executor - Executor shared with other Client Core instances
+         * @return std::unique_ptr<ClientCore> instance
+         */
+        static std::unique_ptr<ClientCore> Create(std::shared_ptr<NetworkConnection> p_network_connection,
+                                                  std::shared_ptr<ClientCoreState> p_state,
+                                                  std::shared_ptr<util::Threading::Executor> p_executor);
+
         /**
          * @brief Register Action for execution by Client Core
          *
@@ -99,12 +169,27 @@ namespace awsiotsdk {
 
         ResponseCode RegisterAction(ActionType action_type, Action::CreateHandlerPtr p_action_create_handler);
 
+        /**
+         * @brief Perform Action without waiting for the response
+         *
+         * The request is sent from the calling thread, the response is delivered through the provided completion
+         * token. The token is always completed, either with the response, with the send result if no response is
+         * expected or with a failure. Can be used before the outbound queue is being processed, for CONNECT
+         *
+         * @param action_type - Type of the Action to be executed. Must be registered
+         * @param action_data - Action Data to be passed as argument to the Action instance
+         * @param p_completion_token - Token to complete with the result of the Action
+         * @return ResponseCode indicating whether the request was sent
+         */
+        ResponseCode StartAction(ActionType action_type, std::shared_ptr<ActionData> action_data,
+                                 std::shared_ptr<CompletionToken> p_completion_token);
+
         /**
          * @brief Perform Action in Blocking Mode
          *
          * This API will perform the Action in Blocking mode. The timeout for the action to give a valid response
-         * is provided as an argument. This API stops processing of all outbound actions until Response is received
-         * for the requested Action Type
+         * is provided as an argument. Multiple threads can wait for responses to blocking calls at the same time,
+         * outbound queued actions continue to be processed while waiting
          *
          * @param action_type - Type of the Action to be executed. Must be registered
          * @param action_data - Action Data to be passed as argument to the Action instance
@@ -130,12 +215,29 @@ namespace awsiotsdk {
         ResponseCode PerformActionAsync(ActionType action_type, std::shared_ptr<ActionData> action_data,
                                         uint16_t &action_id_out);
 
+        /**
+         * @brief Perform Action in Asynchronous Mode with the specified priority
+         *
+         * Same as PerformActionAsync, but the Action is queued in the lane for the provided priority class.
+         * Queued Actions with a higher priority are always performed first
+         *
+         * @param action_type - Type of the Action to be executed. Must be registered
+         * @param action_data - Action Data to be passed as argument to the Action instance
+         * @param priority - Priority class of the Action
+         * @param [out] action_id_out - Action ID assigned to this request
+         *
+         * @return ResponseCode indicating result of the enqueue operation
+         */
+        ResponseCode PerformActionAsync(ActionType action_type, std::shared_ptr<ActionData> action_data,
+                                        ActionPriority priority, uint16_t &action_id_out);
+
         /**
          * @brief Create Thread Task to execute request Action Type
          *
          * This API will create a new instance of the Action Type that is request in the API call and call perform
          * action on that instance in a new Thread Task. If the Action is Thread Aware, it will be executed until
-         * it finishes or the Thread Task is terminated (Usually on exit).
+         * it finishes or the Thread Task is terminated (Usually on exit). If this instance has an executor and the
+         * Action is steppable, it is scheduled as an executor task instead. Only one runner is kept per Action Type.
          *
          * @param action_type - Type of the Action to be executed. Must be registered
          * @param action_data - Action Data to be passed as argument to the Action instance
@@ -23,12 +23,17 @@
 
 #include <condition_variable>
 #include <chrono>
+#include <functional>
 
 #include "util/Core_EXPORTS.hpp"
 
 #include "util/Utf8String.hpp"
+#include "util/InFlightTable.hpp"
 #include "util/memory/stl/Map.hpp"
-#include "util/memory/stl/Queue.hpp"
+#include "util/memory/stl/Vector.hpp"
+#include "util/threading/BoundedMpscQueue.hpp"
+#include "util/threading/TimingWheel.hpp"
+#include "util/threading/TokenBucket.hpp"
 
 #include "Action.hpp"
 #include "ResponseCode.hpp"
@@ -44,6 +49,48 @@
  */
 #define DEFAULT_MAX_QUEUE_SIZE 16
 
+/**
+ * Default sustained rate at which outbound actions are processed, can be changed at runtime
+ */
+#ifndef DEFAULT_CORE_ACTION_PROCESSING_RATE_HZ
+#define DEFAULT_CORE_ACTION_PROCESSING_RATE_HZ 5
+#endif
+
+/**
+ * Default number of outbound actions that can be processed back to back after the client has been idle
+ */
+#ifndef DEFAULT_CORE_ACTION_PROCESSING_BURST_SIZE
+#define DEFAULT_CORE_ACTION_PROCESSING_BURST_SIZE 1
+#endif
+
+/**
+ * Physical capacity of each outbound action priority lane. Upper bound for values passed to SetMaxActionQueueSize
+ */
+#ifndef MAX_OUTBOUND_ACTION_QUEUE_CAPACITY
+#define MAX_OUTBOUND_ACTION_QUEUE_CAPACITY 1024
+#endif
+
+/**
+ * Default time a producer waits for room in a full priority lane with OverflowPolicy::BLOCK
+ */
+#ifndef DEFAULT_OUTBOUND_ACTION_BLOCK_TIMEOUT_MS
+#define DEFAULT_OUTBOUND_ACTION_BLOCK_TIMEOUT_MS 1000
+#endif
+
+/**
+ * Default time after which a pending Ack is considered lost, can be changed at runtime
+ */
+#ifndef DEFAULT_ACK_TIMEOUT_MS
+#define DEFAULT_ACK_TIMEOUT_MS 30000
+#endif
+
+/**
+ * Resolution of the pending Ack timer wheel
+ */
+#ifndef ACK_TIMER_WHEEL_TICK_MS
+#define ACK_TIMER_WHEEL_TICK_MS 10
+#endif
+
 namespace awsiotsdk {
 
     /**
@@ -95,46 +142,199 @@ namespace awsiotsdk {
         /**
          * @brief Pending Ack Data Class
          *
-         * Defining an internal class for storing information about Pending Acks.
+         * Defining an internal class for storing the listeners of a Pending Ack. Either or both may be set.
          *
          */
         class PendingAckData {
         public:
-            std::chrono::system_clock::time_point time_of_request_;           ///< Time at which the request was sent
             ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler_;  ///< Handler to which response must be sent
+            std::shared_ptr<CompletionToken> p_completion_token_;             ///< Token to complete with the response
+
+            /**
+             * @brief Call the handler and complete the token, whichever are set
+             *
+             * @param action_id - Action ID the response is for
+             * @param rc - Response
+             */
+            void Notify(uint16_t action_id, ResponseCode rc) const;
         };
 
-        std::atomic<uint16_t> next_action_id_;                                                   ///< Atomic, ID of the next Action that will be enqueued
+        uint16_t last_action_id_;                                                                ///< ID of the last Action that was enqueued, protected by ack_map_lock_
         std::atomic_int cur_core_threads_;                                                       ///< Atomic, Count of currently running core threads
         std::atomic_int max_hardware_threads_;                                                   ///< Atomic, Count of the maximum allowed hardware threads
         std::atomic_size_t max_queue_size_;                                                      ///< Atomic, Current configured max queue size
-        std::chrono::seconds ack_timeout_;                                                       ///< Timeout for pending Acks, older Acks are deleted with a failed response
+        std::chrono::milliseconds ack_timeout_;                                                  ///< Timeout for pending Acks, older Acks are deleted with a failed response
 
         std::mutex register_action_lock_;                                                        ///< Mutex for Register Action Request flow
         std::mutex ack_map_lock_;                                                                ///< Mutex for Ack Map operations
 
-        // Used to perform blocking sync actions
-        std::mutex sync_action_request_lock_;                                                    ///< Mutex for Sync Action Request flow
-        std::mutex sync_action_response_lock_;                                                   ///< Mutex for Sync Action Response flow
-        std::condition_variable sync_action_response_wait_;                                      ///< Condition variable used to wake up calling thread on Sync Action response
-        ResponseCode sync_action_response_;                                                      ///< Variable to store received Sync Action response
+        std::mutex sync_action_request_lock_;                                                    ///< Mutex serializing execution of Actions, held only while a request is being sent
 
         std::atomic_bool process_queued_actions_;                                                ///< Atomic, indicates whether currently queued Actions should be processed or not
         std::shared_ptr<std::atomic_bool> continue_execution_;                                   ///< Atomic, Used to synchronize running threads, false value causes running threads to stop
 
         util::Map<ActionType, std::unique_ptr<Action>> action_map_;                              ///< Map containing currently initialized Action Instances
-        util::Map<uint16_t, std::unique_ptr<PendingAckData>> pending_ack_map_;                   ///< Map containing currently pending Acks
+        util::InFlightTable<PendingAckData> pending_acks_;                                       ///< Listeners of currently pending Acks, indexed by Action ID
+        util::Vector<bool> dispatching_acks_;                                                     ///< Whether the Ack handler for an Action ID has been removed but not finished yet
+        util::Threading::TimingWheel pending_ack_timers_;                                        ///< Expiry timers for pending Acks, indexed by Action ID
+        std::chrono::steady_clock::time_point ack_timer_epoch_;                                  ///< Time corresponding to tick 0 of pending_ack_timers_
         util::Map<ActionType, Action::CreateHandlerPtr> action_create_handler_map_;              ///< Map containing currently registered Action Types and corrosponding Factories
 
-        util::Queue<std::pair<ActionType, std::shared_ptr<ActionData>>> outbound_action_queue_;  ///< Queue of outbound actions
+        typedef std::pair<ActionType, std::shared_ptr<ActionData>> OutboundAction;
+
+        typedef util::Threading::BoundedMpscQueue<OutboundAction> OutboundActionQueue;
+
+        /**
+         * @brief Overflow configuration and statistics of a single priority lane
+         */
+        class OverflowState {
+        public:
+            std::atomic<OverflowPolicy> policy_;                                                 ///< Atomic, policy applied when the lane is full
+            std::atomic<std::chrono::milliseconds::rep> block_timeout_ms_;                      ///< Atomic, max wait for room with OverflowPolicy::BLOCK
+            std::atomic_size_t dropped_action_count_;                                            ///< Atomic, number of Actions dropped or rejected because the lane was full
+        };
+
+        util::Vector<std::unique_ptr<OutboundActionQueue>> outbound_action_queues_;              ///< Lock-free queues of outbound actions, indexed by ActionPriority
+        util::Vector<std::unique_ptr<OverflowState>> outbound_overflow_states_;                  ///< Overflow state of each lane, indexed by ActionPriority
+
+        // Used to park producers waiting for room with OverflowPolicy::BLOCK
+        std::mutex outbound_space_wait_lock_;                                                    ///< Mutex for parking producers waiting for room in a lane
+        std::condition_variable outbound_space_wait_;                                            ///< Condition variable used to wake up parked producers
+        std::atomic_int blocked_producer_count_;                                                 ///< Atomic, number of parked producers
+
+        // Used to park the outbound processing thread while there is nothing to do
+        std::mutex outbound_action_wait_lock_;                                                   ///< Mutex for parking the outbound processing thread
+        std::condition_variable outbound_action_wait_;                                           ///< Condition variable used to wake up the parked outbound processing thread
+        std::atomic_bool is_outbound_consumer_parked_;                                           ///< Atomic, indicates whether the outbound processing thread is parked
+        std::function<void()> p_outbound_wake_handler_;                                          ///< Wakes up the parked outbound processing task when run on an Executor
+        std::function<void()> p_network_connect_handler_;                                        ///< Wakes up the parked network read task when run on an Executor
+
+        util::Threading::TokenBucket outbound_rate_limiter_;                                     ///< Limits the rate at which outbound actions are processed
+        bool has_outbound_rate_limit_token_;                                                     ///< Whether a rate limit token was taken for an action that has not been popped yet
+
+        /**
+         * @brief Check whether all outbound priority lanes are empty
+         * @return boolean indicating whether there are no queued outbound actions
+         */
+        bool IsOutboundActionQueueEmpty();
+
+        /**
+         * @brief Pop the next outbound action in priority order
+         *
+         * @param outbound_action_out[out] - Popped action
+         * @return boolean indicating whether an action was popped
+         */
+        bool PopNextOutboundAction(OutboundAction &outbound_action_out);
+
+        /**
+         * @brief Wake up producers waiting for room in a lane, if there are any
+         */
+        void NotifyOutboundActionProducers();
+
+        /**
+         * @brief Park the calling producer until the lane has room or the deadline passes
+         *
+         * @param outbound_action_queue - Lane to wait for
+         * @param deadline - Point in time after which to stop waiting
+         * @return boolean indicating whether the lane has room
+         */
+        bool WaitForOutboundActionQueueSpace(OutboundActionQueue &outbound_action_queue,
+                                             std::chrono::steady_clock::time_point deadline);
 
         /**
-         * @brief Internal Action Handler for Sync Action responses
+         * @brief Wake up the outbound processing thread if it is parked
          *
-         * @param action_id - ID of the Action that response was received for
-         * @param rc - Received response
+         * Producers only pay for the mutex and notify when the consumer has actually announced that it is parked.
          */
-        void SyncActionHandler(uint16_t action_id, ResponseCode rc);
+        void NotifyOutboundActionConsumer();
+
+        /**
+         * @brief Park the outbound processing thread until an action is enqueued or processing is enabled
+         *
+         * Waits for at most DEFAULT_CORE_THREAD_SLEEP_DURATION_MS so that the thread can still observe a stop request.
+         */
+        void WaitForOutboundAction();
+
+        /**
+         * @brief Park the outbound processing thread until the rate limiter allows the next action
+         *
+         * @param wait_time - Time until the next token is available
+         */
+        void WaitForOutboundRateLimit(std::chrono::microseconds wait_time);
+
+        /**
+         * @brief Perform at most one outbound action without blocking
+         *
+         * @param is_idle_out[out] - Set when there is nothing to do until an action is enqueued
+         * @return std::chrono::microseconds time until the rate limiter allows the next action, 0 if the next
+         * action can be processed right away
+         */
+        std::chrono::microseconds ProcessOutboundActionQueueStep(bool &is_idle_out);
+
+        /**
+         * @brief Perform an outbound Action popped from the queue or sent directly by TryPerformOutboundAction
+         *
+         * Must be called with sync_action_request_lock_ held. Registers the pending Ack if one is expected and
+         * reports failures and completion without an Ack to the Ack listeners of the Action
+         *
+         * @param action_type - Type of the Action
+         * @param p_action_data - Data to be passed to perform Action, with the Action ID already set
+         */
+        void PerformOutboundAction(ActionType action_type, std::shared_ptr<ActionData> p_action_data);
+
+        /**
+         * @brief Remove the listeners of a pending Ack and mark them as being notified
+         *
+         * Must be called with ack_map_lock_ held. DispatchAck must be called for the returned listeners
+         *
+         * @param action_id - Action ID
+         * @param pending_ack_out[out] - Removed listeners
+         * @return boolean indicating whether an Ack was pending for the Action ID
+         */
+        bool TakePendingAck(uint16_t action_id, PendingAckData &pending_ack_out);
+
+        /**
+         * @brief Notify the listeners of a pending Ack that was removed with TakePendingAck
+         *
+         * Must be called without holding ack_map_lock_, listeners may register new Acks.
+         *
+         * @param action_id - Action ID the listeners were registered for
+         * @param pending_ack - Listeners to notify
+         * @param rc - Response to pass to the listeners
+         */
+        void DispatchAck(uint16_t action_id, const PendingAckData &pending_ack, ResponseCode rc);
+
+        /**
+         * @brief Check whether a response is still expected for a sync Action that was sent successfully
+         *
+         * An Ack is expected if it is still pending, is currently being delivered or has already been delivered to
+         * the completion token.
+         *
+         * @param action_id - ID of the sent Action
+         * @param p_completion_token - Completion token of the blocking call
+         * @return boolean indicating whether the caller should wait on the token
+         */
+        bool IsSyncActionResponseExpected(uint16_t action_id, std::shared_ptr<CompletionToken> p_completion_token);
+
+        /**
+         * @brief Allocate the next Action ID that does not have a pending Ack
+         *
+         * IDs are handed out in increasing order starting after last_action_id, wrapping around to 1. 0 is never
+         * handed out since it is reserved for CONNACK. IDs with a pending Ack are skipped so a slow Ack can never
+         * be confused with the response to a newer request using the same ID.
+         *
+         * @param last_action_id[in,out] - Last allocated ID, updated to the returned ID. Protected by ack_map_lock_
+         * @return uint16_t Action ID
+         */
+        uint16_t AllocateActionId(uint16_t &last_action_id);
+
+        /**
+         * @brief Convert a point in time to a tick of the pending Ack timer wheel
+         *
+         * @param time_point - Time to convert
+         * @return TimingWheel::Tick tick
+         */
+        util::Threading::TimingWheel::Tick GetAckTimerTick(std::chrono::steady_clock::time_point time_point);
 
     public:
         /**
@@ -165,7 +365,9 @@ namespace awsiotsdk {
         /**
          * @brief Define Handler for Resubscribe Callbacks
          *
-         * This handler is used to provide notification to the application when a resubscribe occurs.
+         * This handler is used to provide notification to the application when a resubscribe occurs. It is called once
+         * the Subacks of all resubscribed topics have arrived or timed out, usually from the network read thread, or
+         * right away if sending the Subscribe packets failed.
          * NOTE: This handler should be NON-BLOCKING
          */
         typedef std::function<ResponseCode(util::String mqtt_client_id,
@@ -185,13 +387,7 @@ namespace awsiotsdk {
          * @brief Overload for Get next Action ID
          * @return uint16_t Action ID
          */
-        virtual uint16_t GetNextActionId() {
-            if (UINT16_MAX == next_action_id_) {
-                next_action_id_ = 1;
-                return UINT16_MAX;
-            }
-            return next_action_id_++;
-        };
+        virtual uint16_t GetNextActionId() { return AllocateActionId(last_action_id_); }
 
         /**
          * @brief Get current value of maximum action queue size
@@ -201,9 +397,109 @@ namespace awsiotsdk {
 
         /**
          * @brief Set max size for action queue
+         *
+         * The limit applies separately to each priority lane, so a backlog of low priority actions can never cause
+         * control actions to be rejected. Values larger than MAX_OUTBOUND_ACTION_QUEUE_CAPACITY are clamped to it
+         *
          * @param size_t max_queue_size
          */
-        void SetMaxActionQueueSize(size_t max_queue_size) { max_queue_size_ = max_queue_size; }
+        void SetMaxActionQueueSize(size_t max_queue_size) {
+            for (auto &p_queue : outbound_action_queues_) {
+                p_queue->SetMaxSize(max_queue_size);
+            }
+            max_queue_size_ = outbound_action_queues_.front()->GetMaxSize();
+            NotifyOutboundActionProducers();
+        }
+
+        /**
+         * @brief Set the overflow policy of all priority lanes
+         *
+         * @param policy - Policy applied when an Action is queued while its lane is full
+         * @param block_timeout - Max time to wait for room with OverflowPolicy::BLOCK, ignored otherwise
+         */
+        void SetOutboundActionOverflowPolicy(OverflowPolicy policy, std::chrono::milliseconds block_timeout);
+
+        /**
+         * @brief Set the overflow policy of a single priority lane
+         *
+         * @param priority - Lane to configure
+         * @param policy - Policy applied when an Action is queued while the lane is full
+         * @param block_timeout - Max time to wait for room with OverflowPolicy::BLOCK, ignored otherwise
+         */
+        void SetOutboundActionOverflowPolicy(ActionPriority priority, OverflowPolicy policy,
+                                             std::chrono::milliseconds block_timeout);
+
+        /**
+         * @brief Get the overflow policy of a priority lane
+         *
+         * @param priority - Lane to query
+         * @return OverflowPolicy policy
+         */
+        OverflowPolicy GetOutboundActionOverflowPolicy(ActionPriority priority) {
+            return outbound_overflow_states_[(size_t) priority]->policy_;
+        }
+
+        /**
+         * @brief Get the number of Actions dropped or rejected because their lane was full, across all lanes
+         * @return size_t count
+         */
+        size_t GetDroppedActionCount();
+
+        /**
+         * @brief Get the number of Actions dropped or rejected because the lane was full
+         *
+         * @param priority - Lane to query
+         * @return size_t count
+         */
+        size_t GetDroppedActionCount(ActionPriority priority) {
+            return outbound_overflow_states_[(size_t) priority]->dropped_action_count_;
+        }
+
+        /**
+         * @brief Set the rate limit for processing outbound actions
+         *
+         * Takes effect immediately, including for actions that are already queued.
+         *
+         * @param actions_per_second - Sustained rate. Values <= 0 disable rate limiting
+         * @param burst_size - Max number of actions that can be processed back to back after being idle
+         */
+        void SetOutboundActionRateLimit(double actions_per_second, size_t burst_size) {
+            outbound_rate_limiter_.SetRate(actions_per_second, burst_size);
+            NotifyOutboundActionConsumer();
+        }
+
+        /**
+         * @brief Get the sustained rate limit for processing outbound actions
+         * @return double actions per second, <= 0 if rate limiting is disabled
+         */
+        double GetOutboundActionRate() { return outbound_rate_limiter_.GetRate(); }
+
+        /**
+         * @brief Get the burst size for processing outbound actions
+         * @return size_t burst size
+         */
+        size_t GetOutboundActionBurstSize() { return outbound_rate_limiter_.GetBurstSize(); }
+
+        /**
+         * @brief Get the timeout after which pending Acks are deleted with a failed response
+         * @return std::chrono::milliseconds timeout
+         */
+        std::chrono::milliseconds GetAckTimeout();
+
+        /**
+         * @brief Set the timeout after which pending Acks are deleted with a failed response
+         *
+         * Applies to Acks registered after this call
+         *
+         * @param ack_timeout - Timeout
+         */
+        void SetAckTimeout(std::chrono::milliseconds ack_timeout);
+
+        /**
+         * @brief Get the number of requests currently waiting for an Ack
+         * @return size_t number of pending Acks
+         */
+        size_t GetPendingAckCount();
 
         /**
          * @brief Get pointer to sync point used for execution status of the Core instance
@@ -218,7 +514,12 @@ namespace awsiotsdk {
          * @brief Sets whether the Client is allowed to process queue actions
          * @param process_queued_actions value to set it to
          */
-        void SetProcessQueuedActions(bool process_queued_actions) { process_queued_actions_ = process_queued_actions; }
+        void SetProcessQueuedActions(bool process_queued_actions) {
+            process_queued_actions_ = process_queued_actions;
+            if (process_queued_actions) {
+                NotifyOutboundActionConsumer();
+            }
+        }
 
         /**
          * @brief Get whether the Client can process queued actions
@@ -232,19 +533,85 @@ namespace awsiotsdk {
          * This function processes the actions queued up in the Outbound action queue.
          * The function accepts a Sync point that can be used to control execution in a separate thread.
          * If the value is set to false for the sync point, the function will perform one action from the queue.
-         * This puts the running thread to sleep if there are no queued up actions.
+         * This parks the running thread if there are no queued up actions or processing is currently disabled.
+         * The thread is woken up as soon as an action is enqueued.
          * DO NOT call from main thread unless you have a separate thread to queue up actions
          *
          * @param thread_task_out_sync
          */
         void ProcessOutboundActionQueue(std::shared_ptr<std::atomic_bool> thread_task_out_sync);
 
+        /**
+         * @brief Process the outbound action queue as an Executor task step
+         *
+         * Performs at most one queued action. Instead of parking the calling thread, marks the consumer as parked
+         * and returns the time after which it should be run again. The outbound wake handler is called to run it
+         * earlier once an action is enqueued.
+         *
+         * @return std::chrono::microseconds delay before the next step
+         */
+        std::chrono::microseconds RunOutboundActionQueueStep();
+
+        /**
+         * @brief Set the handler used to wake up the outbound processing task
+         *
+         * Only used when the queue is processed by an Executor task instead of a dedicated thread. Must be set before
+         * actions are enqueued.
+         *
+         * @param p_outbound_wake_handler - Handler that runs the next step of the outbound processing task
+         */
+        void SetOutboundActionWakeHandler(std::function<void()> p_outbound_wake_handler) {
+            p_outbound_wake_handler_ = std::move(p_outbound_wake_handler);
+        }
+
+        /**
+         * @brief Set the handler called whenever the network connection has been established
+         *
+         * Only used when runners are run as Executor tasks. A runner that waits for network data is parked while it
+         * watches the poll descriptor of the connection, and must be woken up to watch the descriptor of a new
+         * connection. Must be set before the network connection is established.
+         *
+         * @param p_network_connect_handler - Handler that runs the next step of the network read task
+         */
+        void SetNetworkConnectHandler(std::function<void()> p_network_connect_handler) {
+            p_network_connect_handler_ = std::move(p_network_connect_handler);
+        }
+
+        /**
+         * @brief Notify the runners that the network connection has been established
+         *
+         * Called by the connect action, for the first connection and for every reconnect
+         */
+        void NotifyNetworkConnected() {
+            if (nullptr != p_network_connect_handler_) {
+                p_network_connect_handler_();
+            }
+        }
+
+        /**
+         * @brief Perform Action without waiting for the response
+         *
+         * Sends the request right away like PerformAction, but returns once it has been sent. The provided token is
+         * always completed, with the response once it is received, with the send result if no response is expected
+         * or sending failed and with ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR once the Ack timeout expires.
+         * Unlike PerformActionAsync this does not depend on the outbound queue being processed, so it can be used
+         * for CONNECT
+         *
+         * @param action_type - Type of the Action to be executed. Must be registered
+         * @param action_data - Action Data to be passed as argument to the Action instance
+         * @param p_completion_token - Token to complete with the result of the Action
+         * @return ResponseCode indicating whether the request was sent
+         */
+        ResponseCode StartAction(ActionType action_type, std::shared_ptr<ActionData> action_data,
+                                 std::shared_ptr<CompletionToken> p_completion_token);
+
         /**
          * @brief Perform Action in Blocking Mode
          *
          * This API will perform the Action in Blocking mode. The timeout for the action to give a valid response
-         * is provided as an argument. This API stops processing of all outbound actions until Response is received
-         * for the requested Action Type
+         * is provided as an argument. Sending the request is serialized with other Actions, waiting for the response
+         * is not, so any number of threads can be waiting for responses to blocking calls at the same time and
+         * outbound queued Actions continue to be processed in the meantime
          *
          * @param action_type - Type of the Action to be executed. Must be registered
          * @param action_data - Action Data to be passed as argument to the Action instance
@@ -291,6 +658,49 @@ namespace awsiotsdk {
         ResponseCode EnqueueOutboundAction(ActionType action_type, std::shared_ptr<ActionData> action_data,
                                            uint16_t &action_id_out);
 
+        /**
+         * @brief Perform an outbound Action on the calling thread if it would not have to wait
+         *
+         * Skips the outbound queue for latency sensitive Actions. The Action is only performed if queued Actions are
+         * being processed, the queue is empty, no other Action is being sent and the rate limit allows it.
+         * Otherwise nothing is done and the caller should enqueue the Action instead. The result of a performed
+         * Action is reported to its Ack listeners like for queued Actions
+         *
+         * @param action_type - Type of the Action
+         * @param p_action_data - Data to be passed to perform Action
+         * @param action_id_out[out] - Action ID that was assigned to this action by the Client, if it was performed
+         * @return boolean indicating whether the Action was performed
+         */
+        bool TryPerformOutboundAction(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
+                                      uint16_t &action_id_out);
+
+        /**
+         * @brief Enqueue Action for processing in Outbound Queue with the specified priority
+         *
+         * Actions with a higher priority are processed before any queued action with a lower priority. If the lane
+         * for the priority is full, its OverflowPolicy decides whether the Action is rejected, replaces the oldest
+         * queued Action or waits for room. With OverflowPolicy::BLOCK this call can block the calling thread for up
+         * to the configured timeout, so it should not be used for lanes filled from SDK threads
+         *
+         * @param action_type - Type of the Action
+         * @param action_data - Data to be passed to perform Action
+         * @param priority - Priority class of the Action
+         * @param action_id_out[out] - Action ID that was assigned to this action by the Client
+         * @return ResponseCode indicating result of the API call
+         */
+        ResponseCode EnqueueOutboundAction(ActionType action_type, std::shared_ptr<ActionData> action_data,
+                                           ActionPriority priority, uint16_t &action_id_out);
+
+        /**
+         * @brief Get the priority used for an Action Type when none is specified
+         *
+         * Publishes default to ActionPriority::HIGH, all other Action Types to ActionPriority::CONTROL
+         *
+         * @param action_type - Type of the Action
+         * @return ActionPriority default priority
+         */
+        static ActionPriority GetDefaultActionPriority(ActionType action_type);
+
         /**
          * @brief Register Ack Handler for provided action id
          * @param action_id - Action ID
@@ -300,6 +710,17 @@ namespace awsiotsdk {
         ResponseCode RegisterPendingAck(uint16_t action_id,
                                         ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler);
 
+        /**
+         * @brief Register the Ack listeners of an Action for provided action id
+         *
+         * Registers the Ack handler and the completion token of the Action data, whichever are set
+         *
+         * @param action_id - Action ID
+         * @param p_action_data - Action data containing the listeners
+         * @return ResponseCode indicating result of the API call
+         */
+        ResponseCode RegisterPendingAck(uint16_t action_id, std::shared_ptr<ActionData> p_action_data);
+
         /**
          * @brief Delete Ack Handler for specified Action ID
          * @param action_id - Action ID
@@ -316,7 +737,9 @@ namespace awsiotsdk {
         /**
          * @brief Delete all expired Acks
          *
-         * Deletes all Acks where the timeouts have expired. Responds with Code indicating request timeout
+         * Deletes all Acks where the timeouts have expired. Responds with Code indicating request timeout.
+         * Called periodically by the outbound processing thread. Cost is proportional to the number of expired Acks
+         * and elapsed timer ticks, not to the number of pending Acks
          */
         void DeleteExpiredAcks();
 
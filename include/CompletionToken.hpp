@@ -0,0 +1,150 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file CompletionToken.hpp
+ * @brief Completion token for waiting on the response to an Async Action
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "util/memory/stl/Vector.hpp"
+
+#include "ResponseCode.hpp"
+
+namespace awsiotsdk {
+    /**
+     * @brief Completion Token Class
+     *
+     * Receives the response to a single Async Action, as an alternative to an AsyncAckNotificationHandlerPtr.
+     * The token is completed exactly once, either with the received Ack, with a failure if the request could not be
+     * sent or with ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR if no Ack is received in time. Any thread can wait on it.
+     * Completion only takes the token's own lock, so thousands of tokens can be outstanding without any shared
+     * correlation state.
+     */
+    class CompletionToken {
+    public:
+        /**
+         * @brief Define a type for completion continuations
+         *
+         * Called once on the thread that completes the token. Used to resume work without blocking a thread, for
+         * example by the coroutine layer.
+         * NOTE: This handler should be NON-BLOCKING
+         */
+        typedef std::function<void()> ContinuationPtr;
+
+    protected:
+        std::atomic_bool is_complete_;      ///< Atomic, whether the token has been completed
+        uint16_t action_id_;                ///< ID of the Action the token was completed for
+        ResponseCode response_;             ///< Response the token was completed with
+        std::mutex completion_lock_;        ///< Mutex protecting the completion state
+        std::condition_variable wait_;      ///< Condition variable used to wake up waiting threads
+        ContinuationPtr p_continuation_;    ///< Continuation to call on completion, if any
+
+    public:
+        /**
+         * @brief Constructor
+         */
+        CompletionToken();
+
+        // Rule of 5 stuff
+        // Contains synchronization primitives, should not be moved or copied
+        CompletionToken(const CompletionToken &) = delete;               // Copy constructor
+        CompletionToken(CompletionToken &&) = delete;                    // Move constructor
+        CompletionToken &operator=(const CompletionToken &) & = delete;  // Copy assignment operator
+        CompletionToken &operator=(CompletionToken &&) & = delete;       // Move assignment operator
+        ~CompletionToken() = default;                                    // Default destructor
+
+        /**
+         * @brief Create factory method
+         * @return std::shared_ptr<CompletionToken> new token
+         */
+        static std::shared_ptr<CompletionToken> Create();
+
+        /**
+         * @brief Complete the token and wake up all waiting threads
+         *
+         * Only the first call has an effect
+         *
+         * @param action_id - ID of the Action the response is for
+         * @param rc - Response
+         */
+        void Complete(uint16_t action_id, ResponseCode rc);
+
+        /**
+         * @brief Set a continuation to be called when the token is completed
+         *
+         * Replaces any previously set continuation
+         *
+         * @param p_continuation - Continuation to call
+         * @return false if the token is already complete, the continuation is not stored or called in that case
+         */
+        bool SetContinuation(ContinuationPtr p_continuation);
+
+        /**
+         * @brief Check whether the token has been completed, does not block
+         * @return boolean indicating completion
+         */
+        bool IsComplete() { return is_complete_; }
+
+        /**
+         * @brief Wait for the token to be completed
+         *
+         * @param timeout - Max time to wait
+         * @return boolean indicating whether the token was completed in time
+         */
+        bool WaitFor(std::chrono::milliseconds timeout);
+
+        /**
+         * @brief Wait for the token to be completed
+         *
+         * @param deadline - Point in time after which to stop waiting
+         * @return boolean indicating whether the token was completed in time
+         */
+        bool WaitUntil(std::chrono::steady_clock::time_point deadline);
+
+        /**
+         * @brief Get the response the token was completed with, does not block
+         * @return ResponseCode response, ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR if not completed yet
+         */
+        ResponseCode GetResponse();
+
+        /**
+         * @brief Get the ID of the Action the token was completed for
+         * @return uint16_t Action ID, 0 if not completed yet
+         */
+        uint16_t GetActionId();
+
+        /**
+         * @brief Wait for a group of tokens to be completed
+         *
+         * All tokens share a single deadline, so waiting on a large batch takes at most timeout in total
+         *
+         * @param tokens - Tokens to wait for, null entries are ignored
+         * @param timeout - Max time to wait for all of them
+         * @return size_t number of tokens that are completed
+         */
+        static size_t WaitForAll(const util::Vector<std::shared_ptr<CompletionToken>> &tokens,
+                                 std::chrono::milliseconds timeout);
+    };
+}
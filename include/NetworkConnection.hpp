@@ -31,10 +31,24 @@
 #include "util/Core_EXPORTS.hpp"
 #include "util/memory/stl/String.hpp"
 #include "util/memory/stl/Vector.hpp"
+#include "util/SharedBufferView.hpp"
 
 #include "ResponseCode.hpp"
 
 namespace awsiotsdk {
+    /**
+     * @brief Contiguous range of bytes that is part of a gathered write
+     *
+     * Does not own the bytes, they must stay valid until the write returns.
+     */
+    class WriteSegment {
+    public:
+        const char *p_data_;  ///< First byte of the segment
+        size_t length_;       ///< Number of bytes in the segment
+
+        WriteSegment(const char *p_data, size_t length) : p_data_(p_data), length_(length) {}
+    };
+
     /**
      * @brief Network Connection Class
      *
@@ -51,6 +65,15 @@ namespace awsiotsdk {
         std::mutex read_mutex;   ///< Mutex for synchronizing read operations
         std::mutex write_mutex;  ///< Mutex for synchronizing write operations
 
+        std::shared_ptr<util::Vector<unsigned char>> p_receive_buf_;  ///< Bytes read ahead, shared with packet views
+        size_t receive_buf_start_;                                    ///< Offset of the first unconsumed byte
+        size_t receive_buf_end_;                                      ///< Offset after the last read byte
+
+        util::String segments_buf_;  ///< Reused by the default WriteSegmentsInternal, guarded by write_mutex
+
+        NetworkConnection() : p_receive_buf_(std::make_shared<util::Vector<unsigned char>>()),
+                              receive_buf_start_(0), receive_buf_end_(0) {}
+
         /**
          * @brief Create a Network socket and open the connection
          *
@@ -73,6 +96,23 @@ namespace awsiotsdk {
          */
         virtual ResponseCode WriteInternal(const util::String &buf, size_t &size_written_bytes_out) = 0;
 
+        /**
+         * @brief Write a sequence of segments to the network socket as one contiguous stream
+         *
+         * Internal implementation of the WriteSegments function. size_written_bytes_out must be set to the total
+         * number of bytes written, even if an error is returned.
+         *
+         * The default implementation copies the segments into one buffer, which is kept for the next write, and
+         * calls WriteInternal. Implementations that can write from several buffers should override it so that large
+         * segments are not copied.
+         *
+         * @param util::Vector<WriteSegment> - segments to write, in order
+         * @param size_t - reference to store number of bytes written
+         * @return ResponseCode - successful write or Network error code
+         */
+        virtual ResponseCode WriteSegmentsInternal(const util::Vector<WriteSegment> &segments,
+                                                   size_t &size_written_bytes_out);
+
         /**
          * @brief Read bytes from the network socket
          *
@@ -86,6 +126,49 @@ namespace awsiotsdk {
         virtual ResponseCode ReadInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
                                           size_t size_bytes_to_read, size_t &size_read_bytes_out) = 0;
 
+        /**
+         * @brief Read the bytes that are available from the network socket
+         *
+         * Internal implementation of the FillReceiveBuffer function. Reads at least min_bytes_to_read bytes unless the
+         * read times out, and as many more as are available without waiting, up to max_bytes_to_read. With a
+         * min_bytes_to_read of 0 only the bytes that are available are read, and SUCCESS is returned even if there
+         * are none. size_read_bytes_out must be set to the number of bytes read even if an error is returned, so
+         * that bytes read before a timeout are not lost.
+         *
+         * The default implementation reads exactly min_bytes_to_read bytes using ReadInternal. It cannot tell how
+         * many bytes are available, so with a min_bytes_to_read of 0 it reads a single byte unless IsReadPending
+         * returns false. Implementations that can tell how many bytes are available should override it to reduce the
+         * number of reads and to never wait when asked for 0 bytes.
+         *
+         * @param util::Vector<unsigned char> - reference to buffer where read bytes should be copied
+         * @param size_t - offset in the buffer to copy the read bytes to
+         * @param size_t - minimum number of bytes to read
+         * @param size_t - maximum number of bytes to read, the buffer has room for at least this many bytes
+         * @param size_t - reference to store number of bytes read
+         * @return ResponseCode - successful read or Network error code
+         */
+        virtual ResponseCode ReadAvailableInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+                                                   size_t min_bytes_to_read, size_t max_bytes_to_read,
+                                                   size_t &size_read_bytes_out) {
+            IOT_UNUSED(max_bytes_to_read);
+            size_read_bytes_out = 0;
+            if (0 == min_bytes_to_read) {
+                if (!IsReadPending()) {
+                    return ResponseCode::SUCCESS;
+                }
+                min_bytes_to_read = 1;
+            }
+            return ReadInternal(buf, buf_read_offset, min_bytes_to_read, size_read_bytes_out);
+        }
+
+        /**
+         * @brief Drop any bytes left in the receive buffer, must be called with read_mutex locked
+         */
+        void ResetReceiveBuffer() {
+            receive_buf_start_ = 0;
+            receive_buf_end_ = 0;
+        }
+
         /**
          * @brief Disconnect from network socket
          *
@@ -114,6 +197,26 @@ namespace awsiotsdk {
          */
         virtual bool IsPhysicalLayerConnected() = 0;
 
+        /**
+         * @brief Get the descriptor that becomes readable when data arrives
+         *
+         * Used by event loops to wait for incoming data instead of polling Read. Implementations that have no such
+         * descriptor return -1 and are polled.
+         *
+         * @return int - socket descriptor, -1 if not connected or not available
+         */
+        virtual int GetPollDescriptor() { return -1; }
+
+        /**
+         * @brief Check whether a Read could return data without waiting on the socket
+         *
+         * Includes data buffered inside the network stack, for example decrypted TLS records, that will not make
+         * the poll descriptor readable again. Implementations that cannot tell must return true.
+         *
+         * @return bool - false only if Read is known to have nothing to return right now
+         */
+        virtual bool IsReadPending() { return true; }
+
         /**
          * @brief Create a Network socket and open the connection
          *
@@ -134,10 +237,25 @@ namespace awsiotsdk {
          */
         virtual ResponseCode Write(const util::String &buf, size_t &size_written_bytes_out) final;
 
+        /**
+         * @brief Write a sequence of segments to the network socket as one contiguous stream
+         *
+         * Calls the internal write function after obtaining write lock. Allows packets to be written from the
+         * buffers that already hold their parts, e.g. a serialized header followed by the payload of the application.
+         *
+         * @param segments - segments to write, in order
+         * @param size_written_bytes_out - total number of bytes written, segments are written in order so a partial
+         * write ends inside the first segment that was not fully written
+         * @return ResponseCode - successful write or Network error code
+         */
+        virtual ResponseCode WriteSegments(const util::Vector<WriteSegment> &segments,
+                                           size_t &size_written_bytes_out) final;
+
         /**
          * @brief Read bytes from the network socket
          *
-         * Calls the internal read function after obtaining read lock
+         * Calls the internal read function after obtaining read lock. Bytes held in the receive buffer are returned
+         * first.
          *
          * @param util::String - reference to buffer where read bytes should be copied
          * @param size_t - number of bytes to read
@@ -147,6 +265,42 @@ namespace awsiotsdk {
         virtual ResponseCode Read(util::Vector<unsigned char> &buf, size_t buf_read_offset,
                                   size_t size_bytes_to_read, size_t &size_read_bytes_out) final;
 
+        /**
+         * @brief Read ahead from the network socket until the receive buffer holds at least min_bytes bytes
+         *
+         * Each read takes as many bytes as are available, up to the free space of the receive buffer, so several
+         * small packets can be received with a single read. Bytes read before a failure stay buffered. Read returns
+         * buffered bytes first. The buffer is emptied by Connect and Disconnect.
+         *
+         * Without is_wait_allowed only the bytes that have already arrived are read. Callers that share their thread
+         * with other connections use this to return instead of waiting for the rest of a packet.
+         *
+         * @param min_bytes - number of bytes the receive buffer must hold
+         * @param is_wait_allowed - whether reads may wait for bytes that have not arrived yet
+         * @return ResponseCode - SUCCESS if min_bytes bytes are buffered, NETWORK_SSL_NOTHING_TO_READ if fewer bytes
+         * arrived in time, or were available without waiting, otherwise the Network error code of the read that
+         * failed
+         */
+        virtual ResponseCode FillReceiveBuffer(size_t min_bytes, bool is_wait_allowed) final;
+
+        /**
+         * @brief Get the unconsumed bytes of the receive buffer
+         *
+         * The returned view keeps its bytes valid and unchanged after they are consumed, for as long as it or a copy
+         * of it is held. FillReceiveBuffer continues in a new buffer while any view of the current one exists, so
+         * holding views only costs an extra allocation per read and never a copy of the viewed bytes.
+         *
+         * @return util::SharedBufferView - view of the unconsumed bytes, empty if there are none
+         */
+        virtual util::SharedBufferView GetReceiveBuffer() final;
+
+        /**
+         * @brief Mark bytes at the start of the receive buffer as consumed
+         *
+         * @param size_bytes - number of bytes to consume, at most the number of unconsumed bytes
+         */
+        virtual void ConsumeReceiveBuffer(size_t size_bytes) final;
+
         /**
          * @brief Disconnect from network socket
          *
@@ -48,6 +48,56 @@ namespace awsiotsdk {
         std::unique_ptr<ClientCore> p_client_core_;          ///< Unique pointer to the Client Core instance
         std::shared_ptr<mqtt::ClientState> p_client_state_;  ///< MQTT Client state
 
+        /**
+         * @brief Perform Sync Publish of a prepared packet
+         *
+         * @param p_publish_packet - Packet to publish, nullptr if the request data was invalid
+         * @param action_response_timeout - Timeout in milliseconds within which response should be obtained after request is sent
+         * @return ResponseCode indicating status of request
+         */
+        ResponseCode PerformPublish(std::shared_ptr<mqtt::PublishPacket> p_publish_packet,
+                                    std::chrono::milliseconds action_response_timeout);
+
+        /**
+         * @brief Send or queue a prepared packet for Async Publish
+         *
+         * QoS0 packets are written on the calling thread when QoS0 direct write is enabled and the connection is
+         * not busy, everything else is queued
+         *
+         * @param p_publish_packet - Packet to publish, with the Ack listeners set
+         * @param priority - priority class of the request, used if it is queued
+         * @param packet_id_out - packet ID of the message being sent
+         * @return ResponseCode indicating status of request
+         */
+        ResponseCode SendPublishAsync(std::shared_ptr<mqtt::PublishPacket> p_publish_packet, ActionPriority priority,
+                                      uint16_t &packet_id_out);
+
+        /**
+         * @brief Queue a prepared packet for Async Publish, notifying the handler of the result
+         *
+         * @param p_publish_packet - Packet to publish, nullptr if the request data was invalid
+         * @param p_async_ack_handler - the ack handling function
+         * @param packet_id_out - packet ID of the message being sent
+         * @param priority - priority class of the request
+         * @return ResponseCode indicating status of request
+         */
+        ResponseCode PerformPublishAsync(std::shared_ptr<mqtt::PublishPacket> p_publish_packet,
+                                         ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
+                                         uint16_t &packet_id_out, ActionPriority priority);
+
+        /**
+         * @brief Queue a prepared packet for Async Publish, completing a new token with the result
+         *
+         * @param p_publish_packet - Packet to publish, nullptr if the request data was invalid
+         * @param priority - priority class of the request
+         * @param packet_id_out - packet ID of the message being sent
+         * @param p_completion_token_out - token that is completed with the result of the request
+         * @return ResponseCode indicating status of request
+         */
+        ResponseCode PerformPublishAsync(std::shared_ptr<mqtt::PublishPacket> p_publish_packet,
+                                         ActionPriority priority, uint16_t &packet_id_out,
+                                         std::shared_ptr<CompletionToken> &p_completion_token_out);
+
         /**
          * @brief Constructor
          *
@@ -69,6 +119,29 @@ namespace awsiotsdk {
                    ClientCoreState::ApplicationResubscribeCallbackPtr resubscribe_callback_ptr,
                    std::shared_ptr<ResubscribeCallbackContextData> p_resubscribe_app_handler_data);
 
+        /**
+         * @brief Constructor
+         *
+         * @param p_network_connection - Network connection to use with this MQTT Client instance
+         * @param mqtt_command_timeout - Command timeout in milliseconds for internal blocking operations (Reconnect and Resubscribe)
+         * @param disconnect_callback_ptr - pointer of the disconnect callback handler
+         * @param p_disconnect_app_handler_data - context data for the disconnect handler
+         * @param reconnect_callback_ptr - pointer of the reconnect callback handler
+         * @param p_reconnect_app_handler_data - context data for the reconnect handler
+         * @param resubscribe_callback_ptr - pointer of the resubscribe callback handler
+         * @param p_resubscribe_app_handler_data - context data for the resubscribe handler
+         * @param p_executor - Executor to run the client's processing on, nullptr for dedicated threads
+         */
+        MqttClient(std::shared_ptr<NetworkConnection> p_network_connection,
+                   std::chrono::milliseconds mqtt_command_timeout,
+                   ClientCoreState::ApplicationDisconnectCallbackPtr disconnect_callback_ptr,
+                   std::shared_ptr<DisconnectCallbackContextData> p_disconnect_app_handler_data,
+                   ClientCoreState::ApplicationReconnectCallbackPtr reconnect_callback_ptr,
+                   std::shared_ptr<ReconnectCallbackContextData> p_reconnect_app_handler_data,
+                   ClientCoreState::ApplicationResubscribeCallbackPtr resubscribe_callback_ptr,
+                   std::shared_ptr<ResubscribeCallbackContextData> p_resubscribe_app_handler_data,
+                   std::shared_ptr<util::Threading::Executor> p_executor);
+
         /**
          * @brief Constructor
          *
@@ -150,6 +223,48 @@ namespace awsiotsdk {
                                                   ClientCoreState::ApplicationResubscribeCallbackPtr p_resubscribec_callback,
                                                   std::shared_ptr<ResubscribeCallbackContextData> p_resubscribe_app_handler_data);
 
+        /**
+         * @brief Create factory method for a client that runs on a shared executor
+         *
+         * The outbound queue, network read and keep alive processing of the client are run as tasks on the provided
+         * executor instead of in three dedicated threads, so the thread count does not grow with the number of
+         * clients. Subscription and Ack callbacks are called on executor threads and should be NON-BLOCKING, a
+         * blocked callback holds on to a worker that other clients are waiting for.
+         *
+         * @param p_network_connection  - Network connection to use with this MQTT Client instance
+         * @param mqtt_command_timeout - Command timeout in milliseconds for internal blocking operations (Reconnect and Resubscribe)
+         * @param p_executor - Executor shared with other clients
+         * @return std::unique_ptr<MqttClient> pointing to a unique MQTT client instance, nullptr if an argument is null
+         */
+        static std::unique_ptr<MqttClient> Create(std::shared_ptr<NetworkConnection> p_network_connection,
+                                                  std::chrono::milliseconds mqtt_command_timeout,
+                                                  std::shared_ptr<util::Threading::Executor> p_executor);
+
+        /**
+         * @brief Create factory method for a client that runs on a shared executor, with additional parameters for
+         * disconnect, reconnect and resubscribe callbacks.
+         *
+         * @param p_network_connection  - Network connection to use with this MQTT Client instance
+         * @param mqtt_command_timeout - Command timeout in milliseconds for internal blocking operations (Reconnect and Resubscribe)
+         * @param disconnect_callback_ptr - pointer of the disconnect callback handler
+         * @param p_app_handler_data - context data for the disconnect handler
+         * @param reconnect_callback_ptr - pointer of the reconnect callback handler
+         * @param p_reconnect_app_handler_data - context data for the reconnect handler
+         * @param resubscribe_callback_ptr - pointer of the resubscribe callback handler
+         * @param p_resubscribe_app_handler_data - context data for the resubscribe handler
+         * @param p_executor - Executor shared with other clients
+         * @return std::unique_ptr<MqttClient> pointing to a unique MQTT client instance, nullptr if an argument is null
+         */
+        static std::unique_ptr<MqttClient> Create(std::shared_ptr<NetworkConnection> p_network_connection,
+                                                  std::chrono::milliseconds mqtt_command_timeout,
+                                                  ClientCoreState::ApplicationDisconnectCallbackPtr disconnect_callback_ptr,
+                                                  std::shared_ptr<DisconnectCallbackContextData> p_disconnect_app_handler_data,
+                                                  ClientCoreState::ApplicationReconnectCallbackPtr reconnect_callback_ptr,
+                                                  std::shared_ptr<ReconnectCallbackContextData> p_reconnect_app_handler_data,
+                                                  ClientCoreState::ApplicationResubscribeCallbackPtr resubscribe_callback_ptr,
+                                                  std::shared_ptr<ResubscribeCallbackContextData> p_resubscribe_app_handler_data,
+                                                  std::shared_ptr<util::Threading::Executor> p_executor);
+
         // Sync API
 
         /**
@@ -200,6 +315,34 @@ namespace awsiotsdk {
                                      std::unique_ptr<mqtt::WillOptions> p_will_msg,
                                      bool is_metrics_enabled);
 
+        /**
+         * @brief Perform Connect and get a completion token for the result
+         *
+         * Performs the Network Connect and sends the MQTT Connect request, but does not wait for the CONNACK. The
+         * result is delivered through the returned completion token, which is completed when the CONNACK is received,
+         * with a failure if the request could not be sent or with ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR once the
+         * client's Ack timeout expires. Network and TLS connection setup still happen on the calling thread
+         *
+         * @param is_clean_session
+         * @param mqtt_version
+         * @param keep_alive_timeout
+         * @param p_client_id
+         * @param p_username
+         * @param p_password
+         * @param p_will_msg Last Will and Testament message
+         * @param is_metrics_enabled
+         * @param p_completion_token_out token that is completed with the result of the request
+         *
+         * @return ResponseCode indicating whether the request was sent
+         */
+        virtual ResponseCode ConnectAsync(bool is_clean_session, mqtt::Version mqtt_version,
+                                          std::chrono::seconds keep_alive_timeout,
+                                          std::unique_ptr<Utf8String> p_client_id,
+                                          std::unique_ptr<Utf8String> p_username,
+                                          std::unique_ptr<Utf8String> p_password,
+                                          std::unique_ptr<mqtt::WillOptions> p_will_msg, bool is_metrics_enabled,
+                                          std::shared_ptr<CompletionToken> &p_completion_token_out);
+
         /**
          * @brief Perform Sync Disconnect
          *
@@ -231,6 +374,19 @@ namespace awsiotsdk {
                                      mqtt::QoS qos, const util::String &payload,
                                      std::chrono::milliseconds action_response_timeout);
 
+        /**
+         * @brief Perform Sync Publish of a request
+         *
+         * Same as Publish with individual data. The request can also name the topic by handle and take over or
+         * share the payload instead of copying it, see mqtt::PublishRequest. Its priority is not used.
+         *
+         * @param request Message to publish
+         * @param action_response_timeout Timeout in milliseconds within which response should be obtained after request is sent
+         *
+         * @return ResponseCode indicating status of request
+         */
+        virtual ResponseCode Publish(mqtt::PublishRequest request, std::chrono::milliseconds action_response_timeout);
+
         /**
          * @brief Perform Sync Subscribe
          *
@@ -285,6 +441,55 @@ namespace awsiotsdk {
                                           ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
                                           uint16_t &packet_id_out);
 
+        /**
+         * @brief Perform Async Publish of a request
+         *
+         * Same as PublishAsync with individual data. The request can also name the topic by handle and take over or
+         * share the payload instead of copying it, see mqtt::PublishRequest. It is queued with the priority of the
+         * request. Queued requests with a higher priority are always sent first. Protocol control packets like
+         * PUBACK use ActionPriority::CONTROL
+         *
+         * @param request Message to publish
+         * @param p_async_ack_handler the ack handling function
+         * @param packet_id_out packet ID of the message being sent
+         *
+         * @return ResponseCode indicating status of request
+         */
+        virtual ResponseCode PublishAsync(mqtt::PublishRequest request,
+                                          ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
+                                          uint16_t &packet_id_out);
+
+        /**
+         * @brief Perform Async Publish of a request and get a completion token for the result
+         *
+         * Same as PublishAsync with a request, but instead of calling a handler the result is delivered through the
+         * returned completion token. QoS1 tokens are completed when the PUBACK is received or the request times out,
+         * QoS0 tokens as soon as the Publish has been sent. Many tokens can be collected and waited on with
+         * CompletionToken::WaitForAll. If the request could not be queued, the token is completed with the
+         * returned ResponseCode
+         *
+         * @param request Message to publish
+         * @param packet_id_out packet ID of the message being sent
+         * @param p_completion_token_out token that is completed with the result of the request
+         *
+         * @return ResponseCode indicating status of request
+         */
+        virtual ResponseCode PublishAsync(mqtt::PublishRequest request, uint16_t &packet_id_out,
+                                          std::shared_ptr<CompletionToken> &p_completion_token_out);
+
+        /**
+         * @brief Get the handle of a topic to publish to repeatedly
+         *
+         * The topic name is validated and encoded once, publishes by handle write the encoded bytes as is. Handles
+         * are kept for the lifetime of the client, intended for the set of topics an application publishes to
+         * regularly. Handles are only valid for the client that created them. Pass them to mqtt::PublishRequest.
+         *
+         * @param topic_name topic name to publish to
+         *
+         * @return std::shared_ptr<const mqtt::TopicHandle> handle, nullptr if the topic name is not valid
+         */
+        std::shared_ptr<const mqtt::TopicHandle> InternTopic(const util::String &topic_name);
+
         /**
          * @brief Perform Async Subscribe
          *
@@ -303,6 +508,21 @@ namespace awsiotsdk {
                                             ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
                                             uint16_t &packet_id_out);
 
+        /**
+         * @brief Perform Async Subscribe and get a completion token for the result
+         *
+         * Same as SubscribeAsync, but the result is delivered through the returned completion token
+         *
+         * @param subscription_list - A list of subscriptions to use for the operation
+         * @param packet_id_out - Packet ID assigned to outgoing packet
+         * @param p_completion_token_out - Token that is completed with the result of the request
+         *
+         * @return ResponseCode indicating status of request
+         */
+        virtual ResponseCode SubscribeAsync(util::Vector<std::shared_ptr<mqtt::Subscription>> subscription_list,
+                                            uint16_t &packet_id_out,
+                                            std::shared_ptr<CompletionToken> &p_completion_token_out);
+
         /**
          * @brief Perform Async Unsubscribe
          *
@@ -321,6 +541,21 @@ namespace awsiotsdk {
                                               ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
                                               uint16_t &packet_id_out);
 
+        /**
+         * @brief Perform Async Unsubscribe and get a completion token for the result
+         *
+         * Same as UnsubscribeAsync, but the result is delivered through the returned completion token
+         *
+         * @param topic_list - List of topics to unsubscribe from
+         * @param packet_id_out - Packet ID assigned to outgoing packet
+         * @param p_completion_token_out - Token that is completed with the result of the request
+         *
+         * @return ResponseCode indicating status of request
+         */
+        virtual ResponseCode UnsubscribeAsync(util::Vector<std::unique_ptr<Utf8String>> topic_list,
+                                              uint16_t &packet_id_out,
+                                              std::shared_ptr<CompletionToken> &p_completion_token_out);
+
         /**
          * @brief Check if Client is in Connected state
          *
@@ -346,6 +581,49 @@ namespace awsiotsdk {
             return p_client_state_->IsAutoReconnectEnabled();
         }
 
+        /**
+         * @brief Sets whether QoS0 async publishes are written on the calling thread
+         *
+         * Disabled by default. When enabled, a QoS0 PublishAsync is serialized and written before the call returns
+         * if the client is connected, nothing is queued and no other request is being sent at that moment.
+         * Otherwise it is queued as usual. Skips the latency of waking up the outbound processing thread, at the
+         * cost of the calling thread doing the network write. The outbound rate limit still applies
+         *
+         * @param value for setting the flag
+         */
+        virtual void SetQoS0DirectWriteEnabled(bool value) {
+            p_client_state_->SetQoS0DirectWriteEnabled(value);
+        }
+
+        /**
+         * @brief returns whether QoS0 async publishes are written on the calling thread
+         *
+         * @return boolean indicating state of the flag
+         */
+        virtual bool IsQoS0DirectWriteEnabled() {
+            return p_client_state_->IsQoS0DirectWriteEnabled();
+        }
+
+        /**
+         * @brief Run subscription handlers on an executor instead of the network read thread
+         *
+         * Received messages are submitted to the executor keyed by topic name, so messages on the same topic are
+         * handled in the order they were received while messages on different topics can be handled in parallel.
+         * A slow handler then no longer delays Acks, Ping responses and messages on other topics. The Puback of a
+         * QoS1 message is sent once its handlers have returned. While the queue of a topic's shard is full the read
+         * thread stops reading without blocking and retries after the inbound pause duration, which applies
+         * backpressure to the connection. The keyed executor may therefore run on the same Executor or EventLoop as
+         * the client's runners.
+         *
+         * Handlers must not wait for received packets (eg. call synchronous APIs) while reading could be paused for
+         * space in their shard. Must only be called while disconnected.
+         *
+         * @param p_handler_executor - Executor to run handlers on, nullptr to run them on the read thread (default)
+         */
+        virtual void SetSubscriptionHandlerExecutor(std::shared_ptr<util::Threading::KeyedExecutor> p_handler_executor) {
+            p_client_state_->SetSubscriptionHandlerExecutor(p_handler_executor);
+        }
+
         /**
          * @brief returns the minimum back-off time value
          *
@@ -380,6 +658,137 @@ namespace awsiotsdk {
          */
         virtual void SetMaxReconnectBackoffTimeout(std::chrono::seconds max_reconnect_backoff_timeout);
 
+        /**
+         * @brief Sets the rate limit for outbound packets queued by the async APIs
+         *
+         * Uses a token bucket. The client sends at most burst_size packets back to back and at most
+         * actions_per_second packets per second over longer periods. Can be changed while the client is running.
+         *
+         * @param actions_per_second - Sustained rate. Values <= 0 disable rate limiting
+         * @param burst_size - Max number of packets that can be sent back to back after being idle
+         */
+        virtual void SetOutboundRateLimit(double actions_per_second, size_t burst_size);
+
+        /**
+         * @brief returns the sustained outbound rate limit
+         *
+         * @return double packets per second, <= 0 if rate limiting is disabled
+         */
+        virtual double GetOutboundRateLimit();
+
+        /**
+         * @brief returns the outbound burst size
+         *
+         * @return size_t burst size
+         */
+        virtual size_t GetOutboundBurstSize();
+
+        /**
+         * @brief Sets what happens when a request is queued by the async APIs while the queue is full
+         *
+         * Applies to all priority classes. Dropped and rejected requests have their Ack handler called with
+         * ResponseCode::ACTION_QUEUE_FULL. OverflowPolicy::DROP_OLDEST keeps the freshest data flowing after a
+         * network stall, OverflowPolicy::BLOCK provides backpressure by making the async call wait for room
+         *
+         * @param policy - Overflow policy
+         * @param block_timeout - Max time an async call waits for room with OverflowPolicy::BLOCK
+         */
+        virtual void SetOutboundOverflowPolicy(OverflowPolicy policy, std::chrono::milliseconds block_timeout);
+
+        /**
+         * @brief Sets the overflow policy for requests of a single priority class
+         *
+         * Priority classes are queued separately, for example telemetry sent with ActionPriority::LOW can drop the
+         * oldest messages while commands sent with ActionPriority::HIGH block
+         *
+         * @param priority - Priority class to configure
+         * @param policy - Overflow policy
+         * @param block_timeout - Max time an async call waits for room with OverflowPolicy::BLOCK
+         */
+        virtual void SetOutboundOverflowPolicy(ActionPriority priority, OverflowPolicy policy,
+                                               std::chrono::milliseconds block_timeout);
+
+        /**
+         * @brief returns the overflow policy of a priority class
+         *
+         * @param priority
+         * @return OverflowPolicy
+         */
+        virtual OverflowPolicy GetOutboundOverflowPolicy(ActionPriority priority);
+
+        /**
+         * @brief returns the number of requests dropped or rejected because the queue was full
+         *
+         * @return size_t count across all priority classes
+         */
+        virtual size_t GetDroppedRequestCount();
+
+        /**
+         * @brief returns the number of requests of a priority class dropped or rejected because the queue was full
+         *
+         * @param priority
+         * @return size_t count
+         */
+        virtual size_t GetDroppedRequestCount(ActionPriority priority);
+
+        /**
+         * @brief Sets the budget for received messages that are being handled
+         *
+         * A message counts against the budget from the time it is read until its subscription handlers have
+         * returned. Once either limit is reached the client stops reading from the network connection until handlers
+         * catch up. Packets that were read along with the message are still handled, so the limits can be exceeded
+         * by one read. QoS1 messages are only acknowledged after their handlers return, so the broker stops sending
+         * once its in-flight window is full. Mostly useful with SetSubscriptionHandlerExecutor, handlers on the read
+         * thread only ever hold one message. Handlers should catch up within the keep alive interval, Ping
+         * responses are not read while paused either. Can be changed while the client is running.
+         *
+         * @param max_messages - Max number of messages being handled, 0 for no limit (default)
+         * @param max_bytes - Max total size of messages being handled, 0 for no limit (default)
+         */
+        virtual void SetInboundLimit(size_t max_messages, size_t max_bytes) {
+            p_client_state_->SetInboundLimit(max_messages, max_bytes);
+        }
+
+        /**
+         * @brief returns the number of received messages whose handlers have not returned yet
+         *
+         * @return size_t count
+         */
+        virtual size_t GetInboundMessageCount() { return p_client_state_->GetInboundMessageCount(); }
+
+        /**
+         * @brief returns the total size of received messages whose handlers have not returned yet
+         *
+         * @return size_t bytes
+         */
+        virtual size_t GetInboundBytes() { return p_client_state_->GetInboundBytes(); }
+
+        /**
+         * @brief Sets the time after which a request that has not been acknowledged is considered lost
+         *
+         * The Ack handler of such requests is called with ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR.
+         * Applies to requests sent after this call
+         *
+         * @param ack_timeout
+         */
+        virtual void SetAckTimeout(std::chrono::milliseconds ack_timeout);
+
+        /**
+         * @brief returns the time after which a request that has not been acknowledged is considered lost
+         *
+         * @return milliseconds
+         */
+        virtual std::chrono::milliseconds GetAckTimeout();
+
+        /**
+         * @brief returns the number of requests currently waiting for an Ack
+         *
+         * At most 65535 requests can be in flight at a time, one per MQTT Packet ID
+         *
+         * @return size_t
+         */
+        virtual size_t GetInFlightRequestCount();
+
         /**
          * @brief Set the callback function for disconnects
          *
@@ -22,17 +22,40 @@
 #pragma once
 
 #include <atomic>
+#include <mutex>
 
+#include "util/SharedObjectPool.hpp"
 #include "util/Utf8String.hpp"
 #include "util/memory/stl/Map.hpp"
+#include "util/threading/KeyedExecutor.hpp"
 
 #include "Action.hpp"
 #include "ClientCore.hpp"
 
 #include "mqtt/Common.hpp"
+#include "mqtt/TopicHandle.hpp"
+#include "mqtt/TopicTrie.hpp"
+
+/**
+ * Number of Publish and Puback packets each client keeps for reuse. Packets beyond this are allocated per message
+ */
+#ifndef DEFAULT_PACKET_POOL_SIZE
+#define DEFAULT_PACKET_POOL_SIZE 32
+#endif
+
+/**
+ * Delay between checks of the inbound limit while reading from the network connection is paused
+ */
+#ifndef DEFAULT_INBOUND_PAUSE_DURATION_MS
+#define DEFAULT_INBOUND_PAUSE_DURATION_MS 1
+#endif
 
 namespace awsiotsdk {
     namespace mqtt {
+        class PublishPacket;
+        class PublishRequest;
+        class PubackPacket;
+
         class ClientState : public ClientCoreState {
         protected:
 
@@ -41,6 +64,8 @@ namespace awsiotsdk {
             std::atomic_bool is_auto_reconnect_enabled_;
             std::atomic_bool is_auto_reconnect_required_;
             std::atomic_bool is_pingreq_pending_;
+            std::atomic_bool is_inbound_paused_;          ///< Set while the read runner leaves packets unread
+            std::atomic_bool is_qos0_direct_write_enabled_;
 
             uint16_t last_sent_packet_id_;
 
@@ -52,9 +77,79 @@ namespace awsiotsdk {
             std::shared_ptr<ActionData> p_connect_data_;
 
             std::atomic_bool trigger_disconnect_callback_;
-        public:
+
+            std::mutex subscriptions_lock_;                                ///< Guards the subscription map, trie, packet ID index and writes of the snapshot
+            /**
+             * Subscriptions by topic filter. Must only be modified through AddSubscription and the RemoveSubscription
+             * functions, which also update the trie used to match received topics and the packet ID index
+             */
             util::Map<util::String, std::shared_ptr<Subscription>> subscription_map_;
+            TopicTrie<std::shared_ptr<Subscription>> subscription_trie_;   ///< Subscriptions by topic filter levels, kept in sync with subscription_map_
+            /**
+             * Immutable copy of subscription_trie_ that received topics are matched against without taking the
+             * subscriptions lock. Replaced as a whole after every change, only accessed through std::atomic_load and
+             * std::atomic_store
+             */
+            std::shared_ptr<const TopicTrie<std::shared_ptr<Subscription>>> p_subscription_snapshot_;
+            /**
+             * Subscriptions waiting for a SUBACK or UNSUBACK, by packet ID of the request. Lets Acks be resolved
+             * without scanning every Subscription
+             */
+            util::Map<uint16_t, util::Vector<std::shared_ptr<Subscription>>> subscriptions_by_packet_id_;
+
+            /**
+             * @brief Remove a Subscription from the packet ID index. Call with the subscriptions lock held
+             *
+             * @param p_subscription - Subscription to remove, indexed under its current packet ID
+             */
+            void UnindexSubscription(const std::shared_ptr<Subscription> &p_subscription);
+
+            /**
+             * @brief Take the Subscription expected at an index of an Ack out of the packet ID index. Call with the
+             * subscriptions lock held
+             *
+             * @param packet_id - Packet ID of the Ack
+             * @param index_in_packet - Index in the Ack, starting at 1
+             * @return std::shared_ptr<Subscription> - Subscription, nullptr if none is expected there
+             */
+            std::shared_ptr<Subscription> TakeIndexedSubscription(uint16_t packet_id, uint8_t index_in_packet);
+
+            /**
+             * @brief Add a Subscription to the map and trie without publishing a snapshot. Call with the
+             * subscriptions lock held
+             *
+             * @param p_subscription - Subscription to add, must have a topic
+             */
+            void InsertSubscription(const std::shared_ptr<Subscription> &p_subscription);
+
+            /**
+             * @brief Remove a Subscription from the map and trie without publishing a snapshot, unless it has been
+             * replaced by another Subscription for the same topic filter. Call with the subscriptions lock held
+             *
+             * @param p_subscription - Subscription to remove
+             * @return bool - true if the trie changed
+             */
+            bool EraseSubscription(const std::shared_ptr<Subscription> &p_subscription);
+
+            /**
+             * @brief Replace the snapshot with a copy of the trie. Call with the subscriptions lock held, after
+             * changing the trie
+             */
+            void PublishSubscriptionSnapshot();
+
+            util::SharedObjectPool<PublishPacket> publish_packet_pool_;    ///< Publish packets reused by outbound messages
+            util::SharedObjectPool<PubackPacket> puback_packet_pool_;      ///< Puback packets reused by inbound messages
+
+            std::mutex topic_handles_lock_;                                              ///< Guards topic_handles_
+            util::Map<util::String, std::shared_ptr<const TopicHandle>> topic_handles_;  ///< Interned topics by name
+
+            std::shared_ptr<util::Threading::KeyedExecutor> p_subscription_handler_executor_;  ///< Runs subscription handlers, nullptr to run them on the read thread
 
+            std::atomic_size_t inbound_message_count_;    ///< Received messages whose handlers have not returned yet
+            std::atomic_size_t inbound_bytes_;            ///< Total size of the messages counted in inbound_message_count_
+            std::atomic_size_t max_inbound_messages_;     ///< Reading pauses at this many inbound messages, 0 for no limit
+            std::atomic_size_t max_inbound_bytes_;        ///< Reading pauses at this many inbound bytes, 0 for no limit
+        public:
             // Rule of 5 stuff
             // Disable copying because class contains std::atomic<> types used for thread synchronization
             ClientState() = delete;                                  // Default constructor
@@ -88,6 +183,9 @@ namespace awsiotsdk {
             bool IsPingreqPending() { return is_pingreq_pending_; }
             void SetPingreqPending(bool value) { is_pingreq_pending_ = value; }
 
+            bool IsQoS0DirectWriteEnabled() { return is_qos0_direct_write_enabled_; }
+            void SetQoS0DirectWriteEnabled(bool value) { is_qos0_direct_write_enabled_ = value; }
+
             bool isDisconnectCallbackPending() { return trigger_disconnect_callback_; }
             void setDisconnectCallbackPending(bool value) { trigger_disconnect_callback_ = value; }
 
@@ -121,19 +219,287 @@ namespace awsiotsdk {
             std::shared_ptr<ActionData> GetAutoReconnectData() { return p_connect_data_; }
             void SetAutoReconnectData(std::shared_ptr<ActionData> p_connect_data) { p_connect_data_ = p_connect_data; }
 
+            /**
+             * @brief Get the executor subscription handlers are run on
+             * @return std::shared_ptr<util::Threading::KeyedExecutor> - executor, nullptr if handlers are run on the
+             * read thread
+             */
+            std::shared_ptr<util::Threading::KeyedExecutor> GetSubscriptionHandlerExecutor() {
+                return p_subscription_handler_executor_;
+            }
+
+            /**
+             * @brief Set the executor subscription handlers are run on. Must only be changed while disconnected
+             * @param p_subscription_handler_executor - executor, nullptr to run handlers on the read thread
+             */
+            void SetSubscriptionHandlerExecutor(
+                std::shared_ptr<util::Threading::KeyedExecutor> p_subscription_handler_executor) {
+                p_subscription_handler_executor_ = p_subscription_handler_executor;
+            }
+
+            /**
+             * @brief Set the limits at which reading from the network connection pauses
+             * @param max_messages - Max number of inbound messages, 0 for no limit
+             * @param max_bytes - Max total size of inbound messages, 0 for no limit
+             */
+            void SetInboundLimit(size_t max_messages, size_t max_bytes) {
+                max_inbound_messages_ = max_messages;
+                max_inbound_bytes_ = max_bytes;
+            }
+
+            size_t GetInboundMessageCount() { return inbound_message_count_; }
+            size_t GetInboundBytes() { return inbound_bytes_; }
+
+            /**
+             * @brief Check whether reading from the network connection should pause until handlers catch up
+             * @return boolean indicating whether either inbound limit is reached
+             */
+            bool IsInboundLimitReached() {
+                size_t max_inbound_messages = max_inbound_messages_;
+                size_t max_inbound_bytes = max_inbound_bytes_;
+                return (0 != max_inbound_messages && inbound_message_count_ >= max_inbound_messages)
+                    || (0 != max_inbound_bytes && inbound_bytes_ >= max_inbound_bytes);
+            }
+
+            /**
+             * @brief Count a received message against the inbound limits until its handlers have returned
+             * @param size_bytes - Size of the message
+             */
+            void AddInboundMessage(size_t size_bytes) {
+                inbound_message_count_++;
+                inbound_bytes_ += size_bytes;
+            }
+
+            /**
+             * @brief Stop counting a message once its handlers have returned
+             * @param size_bytes - Size passed to AddInboundMessage
+             */
+            void RemoveInboundMessage(size_t size_bytes) {
+                inbound_bytes_ -= size_bytes;
+                inbound_message_count_--;
+            }
+
+            /**
+             * @brief Check whether the read runner has stopped reading from the network connection
+             *
+             * A PINGRESP may be waiting unread while this is set, the keepalive runner does not treat its absence as
+             * a dead connection then
+             *
+             * @return boolean indicating whether reading is paused until handlers catch up
+             */
+            bool IsInboundPaused() { return is_inbound_paused_; }
+            void SetInboundPaused(bool value) { is_inbound_paused_ = value; }
+
+            /**
+             * @brief Get a Subscription matching the topic name
+             *
+             * Returns the Subscription whose topic filter equals the topic name if there is one, otherwise any
+             * matching wildcard Subscription. Use GetSubscriptions to get every match. Does not take the subscriptions
+             * lock.
+             *
+             * @param p_topic_name - Topic name of a received message
+             * @return std::shared_ptr<Subscription> - matching Subscription, nullptr if none
+             */
             std::shared_ptr<Subscription> GetSubscription(util::String p_topic_name);
 
+            /**
+             * @brief Get all Subscriptions matching the topic name, including wildcard Subscriptions
+             *
+             * Matches against the latest published snapshot without taking the subscriptions lock, so the read thread
+             * is not held up by Subscriptions being added or removed at the same time. A change made concurrently
+             * may or may not be seen.
+             *
+             * @param p_topic_name - Topic name of a received message
+             * @param subscriptions_out - Vector the matching Subscriptions are appended to
+             */
+            void GetSubscriptions(const util::String &p_topic_name,
+                                  util::Vector<std::shared_ptr<Subscription>> &subscriptions_out);
+
+            /**
+             * @brief Get the Subscription with exactly this topic filter, wildcards are not matched
+             *
+             * @param topic_filter - Topic filter of the Subscription
+             * @return std::shared_ptr<Subscription> - Subscription, nullptr if none
+             */
+            std::shared_ptr<Subscription> FindSubscription(const util::String &topic_filter);
+
+            /**
+             * @brief Get every Subscription, ordered by topic filter
+             *
+             * @param subscriptions_out - Vector the Subscriptions are appended to
+             */
+            void GetAllSubscriptions(util::Vector<std::shared_ptr<Subscription>> &subscriptions_out);
+
+            /**
+             * @brief Check whether there are any Subscriptions
+             * @return boolean indicating whether at least one Subscription exists
+             */
+            bool HasSubscriptions();
+
+            /**
+             * @brief Mark every Subscription inactive, eg. after a disconnect
+             */
+            void DeactivateAllSubscriptions();
+
+            /**
+             * @brief Add a Subscription, replacing any Subscription with the same topic filter
+             *
+             * @param p_subscription - Subscription to add
+             * @return ResponseCode - SUCCESS, NULL_VALUE_ERROR if p_subscription or its topic is null
+             */
+            ResponseCode AddSubscription(std::shared_ptr<Subscription> p_subscription);
+
+            /**
+             * @brief Add all Subscriptions of a request, replacing any Subscription with the same topic filter
+             *
+             * The matching snapshot is published once for the whole list, not once per Subscription
+             *
+             * @param subscription_list - Subscriptions to add
+             * @return ResponseCode - SUCCESS, NULL_VALUE_ERROR if any Subscription or topic is null, nothing is added
+             */
+            ResponseCode AddSubscriptions(const util::Vector<std::shared_ptr<Subscription>> &subscription_list);
+
+            /**
+             * @brief Remove Subscriptions added by a request that could not be sent. Subscriptions that have since
+             * been replaced for the same topic filter are kept
+             *
+             * @param subscription_list - Subscriptions to remove
+             */
+            void RemoveSubscriptions(const util::Vector<std::shared_ptr<Subscription>> &subscription_list);
+
+            /**
+             * @brief Index the Subscriptions of a Subscribe packet by its packet ID
+             *
+             * Sets the Ack index of every Subscription to its position in the packet. Must be called before the packet
+             * is sent, so that the SUBACK can be resolved with SetSubscriptionActive and RemoveSubscription
+             *
+             * @param packet_id - Packet ID of the Subscribe packet
+             * @param subscription_list - Subscriptions in the packet
+             */
+            void IndexSubscribePacket(uint16_t packet_id,
+                                      const util::Vector<std::shared_ptr<Subscription>> &subscription_list);
+
+            /**
+             * @brief Set the packet ID and Ack index of the Subscription with this topic filter and index it
+             *
+             * @param p_topic_name - Topic filter of the Subscription
+             * @param packet_id - Packet ID of the request
+             * @param index_in_packet - Index of the Subscription in the Ack
+             * @return std::shared_ptr<Subscription> - updated Subscription, nullptr if none has this topic filter
+             */
             std::shared_ptr<Subscription> SetSubscriptionPacketInfo(util::String p_topic_name,
                                                                     uint16_t packet_id,
                                                                     uint8_t index_in_packet);
 
+            /**
+             * @brief Activate the Subscription acknowledged at an index of a SUBACK
+             *
+             * @param packet_id - Packet ID of the SUBACK
+             * @param index_in_sub_packet - Index in the SUBACK, starting at 1
+             * @param max_qos - QoS granted by the server
+             * @return ResponseCode - SUCCESS, FAILURE if no Subscription is waiting for this Ack
+             */
             ResponseCode SetSubscriptionActive(uint16_t packet_id, uint8_t index_in_sub_packet, mqtt::QoS max_qos);
 
+            /**
+             * @brief Remove the Subscription rejected at an index of a SUBACK
+             *
+             * @param packet_id - Packet ID of the SUBACK
+             * @param index_in_sub_packet - Index in the SUBACK, starting at 1
+             * @return ResponseCode - SUCCESS, FAILURE if no Subscription is waiting for this Ack
+             */
             ResponseCode RemoveSubscription(uint16_t packet_id, uint8_t index_in_sub_packet);
 
+            /**
+             * @brief Remove the Subscriptions rejected at several indexes of one SUBACK, publishing the matching
+             * snapshot once
+             *
+             * @param packet_id - Packet ID of the SUBACK
+             * @param indexes_in_sub_packet - Indexes in the SUBACK, starting at 1
+             * @return ResponseCode - SUCCESS, FAILURE if no Subscription is waiting for one of the indexes
+             */
+            ResponseCode RemoveSubscriptions(uint16_t packet_id, const util::Vector<uint8_t> &indexes_in_sub_packet);
+
+            /**
+             * @brief Remove every Subscription waiting for an Ack with this packet ID, eg. on UNSUBACK
+             *
+             * @param packet_id - Packet ID of the Ack
+             * @return ResponseCode - SUCCESS, FAILURE if no Subscription is waiting for this Ack
+             */
             ResponseCode RemoveAllSubscriptionsForPacketId(uint16_t packet_id);
 
             ResponseCode RemoveSubscription(util::String p_topic_name);
+
+            /**
+             * @brief Get a Publish packet for an outbound message, reusing a pooled packet if one is free
+             *
+             * A pooled packet is free again once every other reference to it has been released, after it has been
+             * sent or acknowledged. Falls back to allocating a packet when all pooled packets are in use.
+             *
+             * @param p_topic_name Topic name or handle on which message is to be published
+             * @param is_retained Is retained flag
+             * @param is_duplicate Is duplicate message flag
+             * @param qos QoS to use for this message, QoS2 is not supported currently
+             * @param payload Payload to copy, take over or share, see the PublishPacket constructors
+             * @return std::shared_ptr<PublishPacket> - the packet, nullptr if the topic is nullptr
+             */
+            std::shared_ptr<PublishPacket> AcquirePublishPacket(std::unique_ptr<Utf8String> p_topic_name,
+                                                                bool is_retained,
+                                                                bool is_duplicate,
+                                                                QoS qos,
+                                                                const util::String &payload);
+            std::shared_ptr<PublishPacket> AcquirePublishPacket(std::unique_ptr<Utf8String> p_topic_name,
+                                                                bool is_retained,
+                                                                bool is_duplicate,
+                                                                QoS qos,
+                                                                util::String &&payload);
+            std::shared_ptr<PublishPacket> AcquirePublishPacket(std::unique_ptr<Utf8String> p_topic_name,
+                                                                bool is_retained,
+                                                                bool is_duplicate,
+                                                                QoS qos,
+                                                                const util::SharedBufferView &payload);
+            std::shared_ptr<PublishPacket> AcquirePublishPacket(std::shared_ptr<const TopicHandle> p_topic_handle,
+                                                                bool is_retained,
+                                                                bool is_duplicate,
+                                                                QoS qos,
+                                                                const util::String &payload);
+            std::shared_ptr<PublishPacket> AcquirePublishPacket(std::shared_ptr<const TopicHandle> p_topic_handle,
+                                                                bool is_retained,
+                                                                bool is_duplicate,
+                                                                QoS qos,
+                                                                util::String &&payload);
+            std::shared_ptr<PublishPacket> AcquirePublishPacket(std::shared_ptr<const TopicHandle> p_topic_handle,
+                                                                bool is_retained,
+                                                                bool is_duplicate,
+                                                                QoS qos,
+                                                                const util::SharedBufferView &payload);
+
+            /**
+             * @brief Get a Publish packet for a request, see the overloads with individual data
+             *
+             * @param request Request to take the topic and payload from, they are moved out of it
+             * @return std::shared_ptr<PublishPacket> - the packet, nullptr if the request has no topic
+             */
+            std::shared_ptr<PublishPacket> AcquirePublishPacket(PublishRequest &request);
+
+            /**
+             * @brief Get the handle of a topic, validating and encoding the topic name on first use
+             *
+             * Handles are kept for the lifetime of the client state, this is meant for the set of topics an
+             * application publishes to repeatedly, not for topics used once.
+             *
+             * @param topic_name Topic name to publish to
+             * @return std::shared_ptr<const TopicHandle> - the handle, nullptr if the topic name is not valid
+             */
+            std::shared_ptr<const TopicHandle> InternTopic(const util::String &topic_name);
+
+            /**
+             * @brief Get a Puback packet, reusing a pooled packet if one is free
+             *
+             * @param publish_packet_id Packet ID of the Publish to acknowledge
+             * @return std::shared_ptr<PubackPacket> - the packet
+             */
+            std::shared_ptr<PubackPacket> AcquirePubackPacket(uint16_t publish_packet_id);
         };
     }
 }
@@ -21,6 +21,9 @@
 
 #pragma once
 
+#include <atomic>
+
+#include "util/SharedBufferView.hpp"
 #include "util/Utf8String.hpp"
 #include "ResponseCode.hpp"
 
@@ -173,7 +176,8 @@ namespace awsiotsdk {
          * Defining a type for the MQTT Subscriptions
          * Contains all information required to process a subscription including callback handler
          *
-         * @note Also defines a type for the Application callback handler - Subscription::ApplicationCallbackHandlerPtr
+         * @note Also defines types for the Application callback handlers - Subscription::ApplicationCallbackHandlerPtr
+         * and Subscription::ApplicationViewCallbackHandlerPtr
          *
          */
         class Subscription {
@@ -187,17 +191,29 @@ namespace awsiotsdk {
             typedef std::function<ResponseCode(util::String topic_name, util::String payload,
                                                std::shared_ptr<SubscriptionHandlerContextData> p_app_handler_data)> ApplicationCallbackHandlerPtr;
 
+            /**
+             * @brief Define handler for Application Callbacks that receive views of the message.
+             *
+             * Topic name and payload refer to the bytes of the received packet, nothing is copied after the network
+             * read. The views may be copied and retained after the handler returns, the bytes stay valid as long as
+             * any view of them is held. Retained views keep the receive buffer they point into alive.
+             */
+            typedef std::function<ResponseCode(const util::SharedBufferView &topic_name,
+                                               const util::SharedBufferView &payload,
+                                               std::shared_ptr<SubscriptionHandlerContextData> p_app_handler_data)> ApplicationViewCallbackHandlerPtr;
+
             ApplicationCallbackHandlerPtr p_app_handler_;                         ///< Pointer to the Application Handler
+            ApplicationViewCallbackHandlerPtr p_app_view_handler_;                ///< Pointer to the Application View Handler, used instead of p_app_handler_ if set
             std::shared_ptr<SubscriptionHandlerContextData> p_app_handler_data_;  ///< Data to be passed to the Application Handler
             util::String p_topic_regex_;                                          ///< Topic regex string which is used if the topic is a wildcard topic
 
             // Disabling default constructor. Defining a virtual destructor
-            // Ensure Subscription Instances can be copied/moved
-            Subscription() = delete;                                    // Delete Default constructor
-            Subscription(const Subscription &) = default;               // Delete Copy constructor
-            Subscription(Subscription &&) = default;                    // Default Move constructor
-            Subscription &operator=(const Subscription &) & = default;  // Delete Copy assignment operator
-            Subscription &operator=(Subscription &&) & = default;       // Default Move assignment operator
+            // Ensure Subscription Instances can be copied/moved, is_active_ is copied by value
+            Subscription() = delete;                                     // Delete Default constructor
+            Subscription(const Subscription &other);                     // Copy constructor
+            Subscription(Subscription &&other);                          // Move constructor
+            Subscription &operator=(const Subscription &other) &;        // Copy assignment operator
+            Subscription &operator=(Subscription &&other) &;             // Move assignment operator
             virtual ~Subscription() {
                 // Do NOT delete App handler data
             }
@@ -230,6 +246,21 @@ namespace awsiotsdk {
                                                         ApplicationCallbackHandlerPtr p_app_handler,
                                                         std::shared_ptr<SubscriptionHandlerContextData> p_app_handler_data);
 
+            /**
+             * @brief Factory method to create a Subscription instance whose handler receives views of the message
+             *
+             * @param p_topic_name - Topic name for this subscription
+             * @param max_qos - Max QoS
+             * @param p_app_view_handler - Application View Handler instance
+             * @param p_app_handler_data - Data to be passed to application handler. Can be nullptr
+             *
+             * @return shared_ptr Subscription instance
+             */
+            static std::shared_ptr<Subscription> CreateWithViewHandler(std::unique_ptr<Utf8String> p_topic_name,
+                                                                       QoS max_qos,
+                                                                       ApplicationViewCallbackHandlerPtr p_app_view_handler,
+                                                                       std::shared_ptr<SubscriptionHandlerContextData> p_app_handler_data);
+
             /**
            * @brief Is the Topic Name Valid?
             *
@@ -252,14 +283,16 @@ namespace awsiotsdk {
             void SetActive(bool value) { is_active_ = value; }
 
             /**
-             * @brief Get Packet ID for this subscription's Subscribe request
+             * @brief Get Packet ID for this subscription's Subscribe request. Only accessed with the ClientState
+             * subscriptions lock held
              *
              * @return uint16_t ID of the packet
              */
             uint16_t GetPacketId() { return packet_id_; }
 
             /**
-             * @brief Set expected index of Ack for this Subscription in the SUBACK packet
+             * @brief Set expected index of Ack for this Subscription in the SUBACK packet. Only called by ClientState
+             * with its subscriptions lock held, the read thread resolves Acks with it
              *
              * @param packet_id - Expected packet id
              * @param index_in_packet - Expected Index in packet
@@ -303,7 +336,7 @@ namespace awsiotsdk {
                 return (packet_id == packet_id_ && index_in_packet == index_in_packet_);
             }
         protected:
-            bool is_active_;                            ///< Boolean indicating weather the subscription is active or not
+            std::atomic_bool is_active_;                ///< Boolean indicating weather the subscription is active or not
             uint16_t packet_id_;                        ///< Packet Id of the Subscribe/Unsubscribe Packet
             uint8_t index_in_packet_;                   ///< Index of the subscription in the Subscribe/Unsubscribe Packet
             QoS max_qos_;                               ///< Max QoS for messages on this subscription
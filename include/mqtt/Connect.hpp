@@ -24,6 +24,30 @@
 #include "mqtt/ClientState.hpp"
 #include "mqtt/Packet.hpp"
 
+/**
+ * Most topics in one Subscribe packet sent when resubscribing after a reconnect. AWS IoT accepts at most
+ * MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET, other brokers may accept more. Must not exceed 255, the Suback has one byte per
+ * topic and topics are tracked by their 8 bit index in the packet
+ */
+#ifndef DEFAULT_RESUBSCRIBE_MAX_TOPICS_PER_PACKET
+#define DEFAULT_RESUBSCRIBE_MAX_TOPICS_PER_PACKET MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET
+#endif
+
+/**
+ * Largest remaining length of a Subscribe packet sent when resubscribing, should not exceed the largest packet the
+ * broker accepts. Topics that do not fit start the next packet
+ */
+#ifndef DEFAULT_RESUBSCRIBE_MAX_PACKET_SIZE
+#define DEFAULT_RESUBSCRIBE_MAX_PACKET_SIZE 131072
+#endif
+
+/**
+ * Subscribe packets sent when resubscribing are written back to back, combined into writes of about this many bytes
+ */
+#ifndef DEFAULT_RESUBSCRIBE_WRITE_SIZE
+#define DEFAULT_RESUBSCRIBE_WRITE_SIZE 16384
+#endif
+
 namespace awsiotsdk {
     namespace mqtt {
         /**
@@ -373,6 +397,96 @@ namespace awsiotsdk {
         class KeepaliveActionRunner : public Action {
         protected:
             std::shared_ptr<ClientState> p_client_state_;    ///< Shared Client State instance
+
+            bool is_step_started_;                                          ///< Has the first connect been seen?
+            std::shared_ptr<PingreqPacket> p_pingreq_packet_;               ///< Ping request sent on every interval
+            std::chrono::seconds reconnect_backoff_timer_;                  ///< Current reconnect backoff
+            std::chrono::seconds max_backoff_value_;                        ///< Max reconnect backoff
+            std::chrono::seconds keep_alive_interval_;                      ///< Interval between ping requests
+            std::chrono::system_clock::time_point next_pingreq_time_;       ///< Time the next ping request is due at
+            std::shared_ptr<ConnectPacket> p_reconnect_packet_;             ///< Connect packet of the pending reconnect
+            std::shared_ptr<CompletionToken> p_reconnect_token_;            ///< Token of the pending reconnect, if any
+            std::chrono::steady_clock::time_point reconnect_deadline_;      ///< Time the pending reconnect times out
+
+            /**
+             * @brief Progress of one resubscribe, shared by the Ack handlers of the Subscribe packets it sent
+             *
+             * Reports the result to the application's resubscribe handler exactly once, after the last Suback arrived
+             * or timed out, or right away if sending the packets failed
+             */
+            class ResubscribeProgress {
+            protected:
+                std::mutex progress_lock_;                   ///< Guards the counts and the result
+                std::weak_ptr<ClientState> p_client_state_;  ///< Client State holding the resubscribe handler
+                util::String client_id_;                     ///< Client ID passed to the resubscribe handler
+                size_t pending_count_;                       ///< Packets not acknowledged yet, plus one while sending
+                bool has_success_;                           ///< Whether any packet was at least partly accepted
+                ResponseCode failure_rc_;                    ///< Last failure, SUCCESS if none
+                bool is_reported_;                           ///< Whether the result has been reported
+
+                /**
+                 * @brief Release one pending count, reports the result once none is left
+                 */
+                void ReleasePending();
+
+            public:
+                ResubscribeProgress(std::weak_ptr<ClientState> p_client_state, util::String client_id)
+                    : p_client_state_(std::move(p_client_state)), client_id_(std::move(client_id)),
+                      pending_count_(1), has_success_(false), failure_rc_(ResponseCode::SUCCESS),
+                      is_reported_(false) {}
+
+                /**
+                 * @brief Count a packet that is about to be sent
+                 */
+                void AddPendingPacket();
+
+                /**
+                 * @brief Record the Suback of a packet, reports the result once nothing is pending anymore
+                 *
+                 * @param rc - Result of the packet as forwarded with its Ack
+                 */
+                void OnSuback(ResponseCode rc);
+
+                /**
+                 * @brief Mark all packets as sent, reports the result if every Suback has already arrived
+                 */
+                void OnAllPacketsSent();
+
+                /**
+                 * @brief Report a result now, unless one has already been reported
+                 *
+                 * @param rc - Result to report
+                 */
+                void Report(ResponseCode rc);
+            };
+
+            /**
+             * @brief Resubscribe to every existing Subscription after a reconnect, without waiting for the Subacks
+             *
+             * Packs topics into as few Subscribe packets as DEFAULT_RESUBSCRIBE_MAX_TOPICS_PER_PACKET and
+             * DEFAULT_RESUBSCRIBE_MAX_PACKET_SIZE allow and writes them back to back. Each Subscription becomes active
+             * as soon as the Suback for its packet arrives. The resubscribe handler is called with the combined result
+             * once every packet has been acknowledged, or with the error if writing failed.
+             *
+             * @param p_network_connection - Network connection instance to write the packets to
+             * @param client_id - Client ID passed to the resubscribe handler
+             * @return - ResponseCode indicating status of writing the packets
+             */
+            ResponseCode Resubscribe(std::shared_ptr<NetworkConnection> p_network_connection,
+                                     const util::String &client_id);
+
+            /**
+             * @brief Run one step of the reconnect procedure
+             *
+             * Sends the Connect request without waiting for the Connack so the step does not block, later steps check
+             * for the response. Once it arrives, resubscribes to existing topics or backs off before the next attempt.
+             *
+             * @param p_network_connection - Network connection instance to use for resubscribing
+             * @param next_step_delay_out[out] - Delay before the next step
+             * @return - ResponseCode indicating status of the reconnect
+             */
+            ResponseCode PerformReconnectStep(std::shared_ptr<NetworkConnection> p_network_connection,
+                                              std::chrono::microseconds &next_step_delay_out);
         public:
             // Disabling default, move and copy constructors to match Action parent
             // Default virtual destructor
@@ -421,6 +535,23 @@ namespace awsiotsdk {
              */
             ResponseCode PerformAction(std::shared_ptr<NetworkConnection> p_network_connection,
                                        std::shared_ptr<ActionData> p_action_data);
+
+            bool IsSteppable() { return true; }
+
+            /**
+             * @brief Perform one iteration of the MQTT Keep Alive Action
+             *
+             * Does nothing until the first connect. A missing ping response only leads to a reconnect while inbound
+             * reads are not paused, the deadline is pushed back as long as they are. Never finishes on its own.
+             *
+             * @param p_network_connection - Network connection instance to use for performing this action
+             * @param p_action_data - Action data specific to this execution of the Action
+             * @param next_step_delay_out[out] - Delay before the next step
+             * @return - ResponseCode indicating status of the step
+             */
+            ResponseCode PerformActionStep(std::shared_ptr<NetworkConnection> p_network_connection,
+                                           std::shared_ptr<ActionData> p_action_data,
+                                           std::chrono::microseconds &next_step_delay_out);
         };
     }
 }
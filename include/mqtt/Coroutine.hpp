@@ -0,0 +1,342 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file Coroutine.hpp
+ * @brief Optional C++20 coroutine interface for the MQTT Client
+ *
+ * Only available when compiling with C++20 coroutine support, the header is empty otherwise. The awaitables are built
+ * on the same completion tokens as the token based Async APIs, so no additional threads are used. A suspended
+ * coroutine is resumed on the SDK thread that completes its request, which is the read thread for Acks and inbound
+ * messages and the outbound queue thread for requests without an Ack. Work done after a co_await runs on that
+ * thread and should be NON-BLOCKING, move longer work to an application owned executor.
+ */
+
+#pragma once
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include <coroutine>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+#include "mqtt/Client.hpp"
+
+namespace awsiotsdk {
+    namespace mqtt {
+        namespace coro {
+            /**
+             * @brief Fire and forget coroutine return type
+             *
+             * Starts running immediately and frees its frame once it finishes. The SDK is built without exceptions,
+             * an exception escaping the coroutine terminates the program.
+             */
+            class DetachedTask {
+            public:
+                class promise_type {
+                public:
+                    DetachedTask get_return_object() noexcept { return DetachedTask(); }
+                    std::suspend_never initial_suspend() noexcept { return {}; }
+                    std::suspend_never final_suspend() noexcept { return {}; }
+                    void return_void() noexcept {}
+                    void unhandled_exception() noexcept { std::abort(); }
+                };
+            };
+
+            /**
+             * @brief Awaitable for the result of a request
+             *
+             * co_await returns the ResponseCode the completion token was completed with. Awaiting a token that is
+             * already complete does not suspend.
+             */
+            class CompletionAwaiter {
+            protected:
+                std::shared_ptr<CompletionToken> p_completion_token_;   ///< Token completed with the request result
+
+            public:
+                /**
+                 * @brief Constructor
+                 *
+                 * @param p_completion_token - Token to await, must not be null
+                 */
+                explicit CompletionAwaiter(std::shared_ptr<CompletionToken> p_completion_token)
+                    : p_completion_token_(std::move(p_completion_token)) {
+                }
+
+                bool await_ready() const noexcept { return p_completion_token_->IsComplete(); }
+
+                bool await_suspend(std::coroutine_handle<> handle) {
+                    // Token may have been completed since await_ready, resume right away in that case
+                    return p_completion_token_->SetContinuation([handle]() { handle.resume(); });
+                }
+
+                ResponseCode await_resume() { return p_completion_token_->GetResponse(); }
+
+                /**
+                 * @brief Get the awaited completion token, gives access to the Action ID of the request
+                 * @return std::shared_ptr<CompletionToken>
+                 */
+                std::shared_ptr<CompletionToken> GetCompletionToken() const { return p_completion_token_; }
+            };
+
+            /**
+             * @brief Awaitable MQTT Connect, see MqttClient::ConnectAsync
+             *
+             * Network and TLS connection setup happen before the first suspension, on the calling thread.
+             */
+            inline CompletionAwaiter Connect(MqttClient &client, bool is_clean_session, mqtt::Version mqtt_version,
+                                             std::chrono::seconds keep_alive_timeout,
+                                             std::unique_ptr<Utf8String> p_client_id,
+                                             std::unique_ptr<Utf8String> p_username,
+                                             std::unique_ptr<Utf8String> p_password,
+                                             std::unique_ptr<mqtt::WillOptions> p_will_msg,
+                                             bool is_metrics_enabled) {
+                std::shared_ptr<CompletionToken> p_completion_token;
+                client.ConnectAsync(is_clean_session, mqtt_version, keep_alive_timeout, std::move(p_client_id),
+                                    std::move(p_username), std::move(p_password), std::move(p_will_msg),
+                                    is_metrics_enabled, p_completion_token);
+                return CompletionAwaiter(p_completion_token);
+            }
+
+            /**
+             * @brief Awaitable MQTT Publish, see MqttClient::PublishAsync
+             *
+             * Completes on PUBACK for QoS1 and once sent for QoS0.
+             */
+            inline CompletionAwaiter Publish(MqttClient &client, std::unique_ptr<Utf8String> p_topic_name,
+                                             bool is_retained, mqtt::QoS qos, const util::String &payload) {
+                uint16_t packet_id = 0;
+                std::shared_ptr<CompletionToken> p_completion_token;
+                mqtt::PublishRequest request(std::move(p_topic_name), qos);
+                request.is_retained_ = is_retained;
+                request.SetPayload(payload);
+                client.PublishAsync(std::move(request), packet_id, p_completion_token);
+                return CompletionAwaiter(p_completion_token);
+            }
+
+            /**
+             * @brief Awaitable MQTT Subscribe, see MqttClient::SubscribeAsync
+             */
+            inline CompletionAwaiter Subscribe(MqttClient &client,
+                                               util::Vector<std::shared_ptr<mqtt::Subscription>> subscription_list) {
+                uint16_t packet_id = 0;
+                std::shared_ptr<CompletionToken> p_completion_token;
+                client.SubscribeAsync(std::move(subscription_list), packet_id, p_completion_token);
+                return CompletionAwaiter(p_completion_token);
+            }
+
+            /**
+             * @brief Awaitable MQTT Unsubscribe, see MqttClient::UnsubscribeAsync
+             */
+            inline CompletionAwaiter Unsubscribe(MqttClient &client,
+                                                 util::Vector<std::unique_ptr<Utf8String>> topic_list) {
+                uint16_t packet_id = 0;
+                std::shared_ptr<CompletionToken> p_completion_token;
+                client.UnsubscribeAsync(std::move(topic_list), packet_id, p_completion_token);
+                return CompletionAwaiter(p_completion_token);
+            }
+
+            /**
+             * @brief Message Stream Class
+             *
+             * Async generator for the messages received on one or more subscriptions. Messages are buffered until
+             * they are awaited with Next. Only one coroutine may await Next at a time.
+             *
+             * Subscriptions created by the stream only keep a weak reference to it, messages received after the
+             * stream is destroyed are discarded.
+             */
+            class MessageStream : public std::enable_shared_from_this<MessageStream> {
+            public:
+                /**
+                 * @brief Received message
+                 */
+                struct Message {
+                    util::String topic_name_;   ///< Topic the message was received on
+                    util::String payload_;      ///< Message payload
+                };
+
+                /**
+                 * @brief Awaitable for the next message
+                 *
+                 * co_await returns the next message, or an empty optional once the stream is closed and drained.
+                 */
+                class NextAwaiter {
+                protected:
+                    std::shared_ptr<MessageStream> p_stream_;   ///< Stream to take the message from
+
+                public:
+                    explicit NextAwaiter(std::shared_ptr<MessageStream> p_stream) : p_stream_(std::move(p_stream)) {
+                    }
+
+                    bool await_ready() {
+                        std::lock_guard<std::mutex> stream_lock(p_stream_->stream_lock_);
+                        return p_stream_->is_closed_ || !p_stream_->messages_.empty();
+                    }
+
+                    bool await_suspend(std::coroutine_handle<> handle) {
+                        std::lock_guard<std::mutex> stream_lock(p_stream_->stream_lock_);
+                        if (p_stream_->is_closed_ || !p_stream_->messages_.empty()) {
+                            return false;
+                        }
+                        p_stream_->waiting_handle_ = handle;
+                        return true;
+                    }
+
+                    std::optional<Message> await_resume() {
+                        std::lock_guard<std::mutex> stream_lock(p_stream_->stream_lock_);
+                        if (p_stream_->messages_.empty()) {
+                            return std::nullopt;
+                        }
+                        std::optional<Message> message(std::move(p_stream_->messages_.front()));
+                        p_stream_->messages_.pop_front();
+                        return message;
+                    }
+                };
+
+            protected:
+                std::mutex stream_lock_;                    ///< Mutex protecting the stream state
+                std::deque<Message> messages_;              ///< Messages that have not been awaited yet
+                std::coroutine_handle<> waiting_handle_;    ///< Coroutine waiting for the next message, if any
+                size_t max_buffered_messages_;              ///< Max buffered messages, 0 for no limit
+                size_t dropped_message_count_;              ///< Number of messages dropped because the buffer was full
+                bool is_closed_;                            ///< Whether the stream has been closed
+
+                /**
+                 * @brief Take the waiting coroutine, if any. Call with the stream lock held
+                 */
+                std::coroutine_handle<> TakeWaitingHandle() {
+                    std::coroutine_handle<> handle = waiting_handle_;
+                    waiting_handle_ = nullptr;
+                    return handle;
+                }
+
+            public:
+                /**
+                 * @brief Constructor
+                 *
+                 * @param max_buffered_messages - Max number of buffered messages, the oldest message is dropped when
+                 * a new one arrives while the buffer is full. 0 for no limit
+                 */
+                explicit MessageStream(size_t max_buffered_messages)
+                    : max_buffered_messages_(max_buffered_messages), dropped_message_count_(0), is_closed_(false) {
+                }
+
+                // Rule of 5 stuff
+                // Contains synchronization primitives, should not be moved or copied
+                MessageStream(const MessageStream &) = delete;                // Copy constructor
+                MessageStream(MessageStream &&) = delete;                     // Move constructor
+                MessageStream &operator=(const MessageStream &) & = delete;   // Copy assignment operator
+                MessageStream &operator=(MessageStream &&) & = delete;        // Move assignment operator
+                ~MessageStream() = default;                                   // Default destructor
+
+                /**
+                 * @brief Create factory method
+                 *
+                 * @param max_buffered_messages - Max number of buffered messages, 0 for no limit
+                 * @return std::shared_ptr<MessageStream> new stream
+                 */
+                static std::shared_ptr<MessageStream> Create(size_t max_buffered_messages) {
+                    return std::make_shared<MessageStream>(max_buffered_messages);
+                }
+
+                /**
+                 * @brief Create a Subscription that feeds this stream
+                 *
+                 * The Subscription still has to be subscribed, for example with coro::Subscribe
+                 *
+                 * @param p_topic_name - Topic name for this subscription
+                 * @param max_qos - Max QoS
+                 * @return std::shared_ptr<Subscription> new subscription
+                 */
+                std::shared_ptr<Subscription> CreateSubscription(std::unique_ptr<Utf8String> p_topic_name,
+                                                                 mqtt::QoS max_qos) {
+                    std::weak_ptr<MessageStream> p_weak_stream = shared_from_this();
+                    return Subscription::Create(std::move(p_topic_name), max_qos,
+                                                [p_weak_stream](util::String topic_name, util::String payload,
+                                                                std::shared_ptr<SubscriptionHandlerContextData>) {
+                                                    std::shared_ptr<MessageStream> p_stream = p_weak_stream.lock();
+                                                    if (nullptr != p_stream) {
+                                                        p_stream->Push(std::move(topic_name), std::move(payload));
+                                                    }
+                                                    return ResponseCode::SUCCESS;
+                                                }, nullptr);
+                }
+
+                /**
+                 * @brief Add a message to the stream, resumes the waiting coroutine on the calling thread
+                 *
+                 * Messages pushed after Close are discarded
+                 *
+                 * @param topic_name - Topic the message was received on
+                 * @param payload - Message payload
+                 */
+                void Push(util::String topic_name, util::String payload) {
+                    std::coroutine_handle<> handle;
+                    {
+                        std::lock_guard<std::mutex> stream_lock(stream_lock_);
+                        if (is_closed_) {
+                            return;
+                        }
+                        if (0 != max_buffered_messages_ && messages_.size() >= max_buffered_messages_) {
+                            messages_.pop_front();
+                            dropped_message_count_++;
+                        }
+                        messages_.push_back(Message{std::move(topic_name), std::move(payload)});
+                        handle = TakeWaitingHandle();
+                    }
+                    if (handle) {
+                        handle.resume();
+                    }
+                }
+
+                /**
+                 * @brief Close the stream
+                 *
+                 * Buffered messages can still be awaited, after that Next returns an empty optional
+                 */
+                void Close() {
+                    std::coroutine_handle<> handle;
+                    {
+                        std::lock_guard<std::mutex> stream_lock(stream_lock_);
+                        is_closed_ = true;
+                        handle = TakeWaitingHandle();
+                    }
+                    if (handle) {
+                        handle.resume();
+                    }
+                }
+
+                /**
+                 * @brief Await the next message
+                 * @return NextAwaiter awaitable
+                 */
+                NextAwaiter Next() { return NextAwaiter(shared_from_this()); }
+
+                /**
+                 * @brief Get number of messages dropped because the buffer was full
+                 * @return size_t count
+                 */
+                size_t GetDroppedMessageCount() {
+                    std::lock_guard<std::mutex> stream_lock(stream_lock_);
+                    return dropped_message_count_;
+                }
+            };
+        }
+    }
+}
+
+#endif
@@ -21,7 +21,10 @@
 
 #pragma once
 
+#include <deque>
+
 #include "util/memory/stl/Map.hpp"
+#include "util/SharedBufferView.hpp"
 
 #include "ResponseCode.hpp"
 #include "Action.hpp"
@@ -46,25 +49,75 @@ namespace awsiotsdk {
             std::shared_ptr<NetworkConnection> p_network_connection_;  ///< Shared Network Connection instance
 
             std::atomic_bool is_waiting_for_connack_;                  ///< Is this waiting for connack?
+            bool is_step_started_;                                     ///< Has the first step been run?
+            bool is_read_wait_allowed_;                                ///< May reads wait? Only on a dedicated thread
+            util::Vector<unsigned char> read_buf_;                     ///< Copy of packets other than PUBLISH
+
+            /**
+             * @brief Handlers of a Publish kept back because their shard of the subscription handler executor was full
+             */
+            class DeferredPublish {
+            public:
+                util::String topic_name_;                                    ///< Topic name, key of the handlers
+                util::Threading::KeyedExecutor::WorkItemPtr p_work_item_;    ///< Handlers of the Publish
+            };
+
+            util::Map<size_t, std::deque<DeferredPublish>> deferred_publishes_;  ///< Kept back Publishes by shard index, in order of arrival
+            bool is_deferred_publish_limit_reached_;                   ///< Whether a shard has as many kept back Publishes as it can queue
 
             /**
              * @brief Decode Remaining length from MQTT packet
              *
+             * @param p_data Buffer starting with the fixed header byte of the packet
+             * @param data_len Number of bytes in the buffer
              * @param rem_len reference in which to store decoded length
+             * @param header_len reference in which to store the length of the fixed header including the remaining
+             * length bytes. If more bytes are needed, the number of bytes needed to continue decoding
              *
-             * @return ResponseCode indicating status of request
+             * @return ResponseCode - SUCCESS, NETWORK_SSL_NOTHING_TO_READ if the buffer ends inside the remaining
+             * length or MQTT_DECODE_REMAINING_LENGTH_ERROR if the encoding is invalid
              */
-            ResponseCode DecodeRemainingLength(size_t &rem_len);
+            ResponseCode DecodeRemainingLength(const unsigned char *p_data, size_t data_len, size_t &rem_len,
+                                               size_t &header_len);
+
+            /**
+             * @brief Take the next MQTT Packet out of the receive buffer of the network connection, without reading
+             *
+             * @param fixed_header_byte Reference in which the Fixed header byte should be stored
+             * @param packet_out Set to a view of the rest of the packet in the receive buffer, nothing is copied
+             * @param required_bytes_out Number of bytes the receive buffer must hold to make progress
+             *
+             * @return ResponseCode - SUCCESS, NETWORK_SSL_NOTHING_TO_READ if the packet is not complete yet or a
+             * decoding error
+             */
+            ResponseCode TakeBufferedPacket(unsigned char &fixed_header_byte, util::SharedBufferView &packet_out,
+                                            size_t &required_bytes_out);
 
             /**
              * @brief Read MQTT Packet from buffer
              *
+             * Takes the packet out of the receive buffer of the network connection, reading only if the buffer does
+             * not hold a complete packet. Unless reads may wait and no Publish is kept back, only the bytes that have
+             * already arrived are read. Bytes of an incomplete packet stay buffered if the read times out or nothing
+             * more has arrived. Does not read while the inbound limit of the client is reached,
+             * NETWORK_SSL_NOTHING_TO_READ is returned instead.
+             *
              * @param fixed_header_byte Reference to string in which Fixed header byte should be stored
-             * @param read_buf Reference to string in which the rest of the packet should be stored
+             * @param packet_out Set to a view of the rest of the packet in the receive buffer
              *
              * @return ResponseCode indicating status of request
              */
-            ResponseCode ReadPacketFromNetwork(unsigned char &fixed_header_byte, util::Vector<unsigned char> &read_buf);
+            ResponseCode ReadPacketFromNetwork(unsigned char &fixed_header_byte, util::SharedBufferView &packet_out);
+
+            /**
+             * @brief Handle a received MQTT packet
+             *
+             * @param fixed_header_byte Fixed header byte of the packet
+             * @param packet View of the rest of the packet
+             *
+             * @return ResponseCode indicating status of request
+             */
+            ResponseCode HandlePacket(unsigned char fixed_header_byte, const util::SharedBufferView &packet);
 
             /**
              * @brief Handle MQTT Connack packet
@@ -78,18 +131,57 @@ namespace awsiotsdk {
             /**
              * @brief Handle MQTT Publish packet
              *
-             * @param read_buf Reference to string buffer containing the MQTT Publish payload
+             * View handlers receive views of the topic name and payload in the packet. The payload is copied once
+             * for all String handlers, only if there is at least one. If a subscription handler executor is set,
+             * the handlers are run on it, keyed by topic name, and the Puback is queued once they have returned.
+             * Submitting never blocks, the executor may share its threads with this runner. If the shard of the
+             * topic is full, or already has kept back Publishes, the handlers are kept in deferred_publishes_ and
+             * submitted by a later step. Only once a shard has as many kept back Publishes as it can queue does
+             * reading pause, Publishes of other shards and other packets are handled in the meantime.
+             *
+             * @param packet View of the MQTT Publish packet after the fixed header
              * @param is_duplicate MQTT Is Duplicate message flag
              * @param is_retained MQTT Is retained flag
              * @param qos QoS of received Publish message
              *
              * @return ResponseCode indicating status of request
              */
-            ResponseCode HandlePublish(const util::Vector<unsigned char> &read_buf,
+            ResponseCode HandlePublish(const util::SharedBufferView &packet,
                                        bool is_duplicate,
                                        bool is_retained,
                                        QoS qos);
 
+            /**
+             * @brief Submit the handlers of Publishes kept back because their shard of the subscription handler
+             * executor was full, in order, as far as the shards have room
+             *
+             * Runs them on the read thread if the executor has been removed since
+             */
+            void SubmitDeferredPublishes();
+
+            /**
+             * @brief Call the handlers of the Subscriptions matching a received Publish, then queue its Puback
+             *
+             * Runs on the read thread, or on the subscription handler executor if one is set
+             *
+             * @param p_client_state Client state to queue the Puback on
+             * @param topic_name Topic name of the message
+             * @param topic_view View of the topic name in the packet
+             * @param payload_view View of the payload in the packet
+             * @param matching_subscriptions Subscriptions matching the topic name
+             * @param qos QoS of received Publish message
+             * @param packet_id Packet ID of received Publish message, unused for QoS0
+             *
+             * @return ResponseCode indicating status of request
+             */
+            static ResponseCode DeliverPublish(const std::shared_ptr<ClientState> &p_client_state,
+                                               const util::String &topic_name,
+                                               const util::SharedBufferView &topic_view,
+                                               const util::SharedBufferView &payload_view,
+                                               const util::Vector<std::shared_ptr<Subscription>> &matching_subscriptions,
+                                               QoS qos,
+                                               uint16_t packet_id);
+
             /**
              * @brief Handle MQTT Puback packet
              *
@@ -148,6 +240,41 @@ namespace awsiotsdk {
              */
             ResponseCode PerformAction(std::shared_ptr<NetworkConnection> p_network_connection,
                                        std::shared_ptr<ActionData> p_action_data);
+
+            bool IsSteppable() { return true; }
+
+            bool WaitsForNetworkData() { return true; }
+
+            /**
+             * @brief Check whether the next step must run even if no data arrives
+             *
+             * True while Publishes are kept back, they have to be submitted once their shard has room, or while
+             * the inbound limit of the client is reached, the poll descriptor may then stay readable without the step
+             * making progress.
+             *
+             * @return boolean indicating whether the next step must run even if no data arrives
+             */
+            bool IsStepPending();
+
+            /**
+             * @brief Read and handle incoming MQTT packets
+             *
+             * Handles one packet, plus any further complete packets received by the same read when running as a
+             * thread or task. Steps run through PerformAction wait for the rest of a packet, steps run by an Executor
+             * only read what has already arrived and keep an incomplete packet buffered, so that one slow peer does
+             * not hold up the other connections of the Executor. Asks for the next step after the core thread sleep
+             * duration if there was nothing to read, after the inbound pause duration if reading is paused or
+             * handlers could not be handed off, right away otherwise. Marks inbound reads as paused on the client
+             * state while it leaves packets unread. Never finishes on its own.
+             *
+             * @param p_network_connection - Network connection instance to use for performing this action
+             * @param p_action_data - Action data specific to this execution of the Action
+             * @param next_step_delay_out[out] - Delay before the next step
+             * @return - ResponseCode indicating status of the step
+             */
+            ResponseCode PerformActionStep(std::shared_ptr<NetworkConnection> p_network_connection,
+                                           std::shared_ptr<ActionData> p_action_data,
+                                           std::chrono::microseconds &next_step_delay_out);
         };
     }
 }
@@ -23,11 +23,85 @@
 
 #pragma once
 
+#include "util/SharedBufferView.hpp"
+
 #include "mqtt/ClientState.hpp"
 #include "mqtt/Packet.hpp"
+#include "mqtt/TopicHandle.hpp"
 
 namespace awsiotsdk {
     namespace mqtt {
+        /**
+         * @brief Publish Request
+         *
+         * Describes an outbound message for MqttClient::Publish and MqttClient::PublishAsync. The topic is given to
+         * the constructor, either as a name or as a handle from MqttClient::InternTopic. The SetPayload overload
+         * that is used decides whether the payload is copied, taken over or shared with the packet.
+         */
+        class PublishRequest {
+        protected:
+            friend class ClientState;
+
+            std::unique_ptr<Utf8String> p_topic_name_;           ///< Topic name, nullptr if a topic handle is used
+            std::shared_ptr<const TopicHandle> p_topic_handle_;  ///< Topic handle, nullptr if a topic name is used
+            util::String payload_;                               ///< Payload copied or taken over by the request
+            util::SharedBufferView shared_payload_;              ///< Payload shared with the packet, used if not empty
+
+        public:
+            bool is_retained_;          ///< Is retained flag, false by default. Not supported by the AWS IoT Service
+            bool is_duplicate_;         ///< Is duplicate message flag, false by default
+            QoS qos_;                   ///< Message Quality of Service
+            ActionPriority priority_;   ///< Priority class if queued, by default HIGH for QoS1 and LOW for QoS0
+
+            // Rule of 5 stuff
+            // Move only, the request owns its topic name
+            PublishRequest() = delete;                                    // Delete Default constructor
+            PublishRequest(const PublishRequest &) = delete;              // Delete Copy constructor
+            PublishRequest(PublishRequest &&) = default;                  // Default Move constructor
+            PublishRequest &operator=(const PublishRequest &) & = delete; // Delete Copy assignment operator
+            PublishRequest &operator=(PublishRequest &&) & = default;     // Default Move assignment operator
+            ~PublishRequest() = default;                                  // Default destructor
+
+            /**
+             * @brief Constructor, request to publish to a topic name with an empty payload
+             *
+             * @param p_topic_name Topic name on which message is to be published
+             * @param qos QoS to use for this message, QoS2 is not supported currently
+             */
+            PublishRequest(std::unique_ptr<Utf8String> p_topic_name, QoS qos);
+
+            /**
+             * @brief Constructor, request to publish to a topic handle with an empty payload
+             *
+             * @param p_topic_handle Topic handle on which message is to be published
+             * @param qos QoS to use for this message, QoS2 is not supported currently
+             */
+            PublishRequest(std::shared_ptr<const TopicHandle> p_topic_handle, QoS qos);
+
+            /**
+             * @brief Copy the payload into the request
+             *
+             * Use the rvalue overload to avoid the copy, or MqttClient::Publish with a const payload to copy it
+             * directly into a reused packet.
+             */
+            void SetPayload(const util::String &payload);
+
+            /**
+             * @brief Take over the payload instead of copying it
+             *
+             * Useful for large payloads that were built for this message only.
+             */
+            void SetPayload(util::String &&payload);
+
+            /**
+             * @brief Share the payload with the packet without copying it
+             *
+             * The same view can be published to several topics or published again, and payloads received by view
+             * handlers can be forwarded as is. The bytes must not be modified while requests refer to them.
+             */
+            void SetPayload(const util::SharedBufferView &payload);
+        };
+
         /**
          * @brief Publish Message Packet Type
          *
@@ -35,11 +109,40 @@ namespace awsiotsdk {
          */
         class PublishPacket : public Packet {
         protected:
-            bool is_retained_;                          ///< Retained messages are \b NOT supported by the AWS IoT Service at the time of this SDK release
-            bool is_duplicate_;                         ///< Is this message a duplicate QoS > 0 message?  Handled automatically by the MQTT client
-            QoS qos_;                                   ///< Message Quality of Service
-            std::unique_ptr<Utf8String> p_topic_name_;  ///< Topic Name this packet was published to
-            util::String payload_;                      ///< MQTT message payload
+            bool is_retained_;                                   ///< Retained messages are \b NOT supported by the AWS IoT Service at the time of this SDK release
+            bool is_duplicate_;                                  ///< Is this message a duplicate QoS > 0 message?  Handled automatically by the MQTT client
+            QoS qos_;                                            ///< Message Quality of Service
+            std::unique_ptr<Utf8String> p_topic_name_;           ///< Topic Name this packet was published to
+            std::shared_ptr<const TopicHandle> p_topic_handle_;  ///< Encoded Topic Name, used instead of p_topic_name_ if set
+            util::String payload_;                               ///< MQTT message payload
+            util::SharedBufferView shared_payload_;              ///< Payload shared with the caller, used instead of payload_ if not empty
+
+            void SetTopic(std::unique_ptr<Utf8String> p_topic_name);
+            void SetTopic(std::shared_ptr<const TopicHandle> p_topic_handle);
+
+            void SetPayload(const util::String &payload);
+            void SetPayload(util::String &&payload);
+            void SetPayload(const util::SharedBufferView &payload);
+
+            /**
+             * @brief Set everything but the topic and payload, which must already be stored
+             */
+            void InitializeHeader(bool is_retained, bool is_duplicate, QoS qos);
+
+            /**
+             * @brief Append the length prefixed topic name to a buffer
+             */
+            void AppendTopicToBuffer(util::String &buf);
+
+            size_t GetEncodedTopicLength() {
+                return (nullptr != p_topic_handle_) ? p_topic_handle_->GetEncodedTopicName().length()
+                                                    : p_topic_name_->Length() + 2;  // length of topic name requires 2 bytes
+            }
+
+            const char *GetPayloadData() {
+                return shared_payload_.IsEmpty() ? payload_.data()
+                                                 : reinterpret_cast<const char *>(shared_payload_.Data());
+            }
         public:
             // Ensure Default and Copy Constructors and Copy assignment operator are deleted
             // Use default move constructors and assignment operators
@@ -75,6 +178,66 @@ namespace awsiotsdk {
                           QoS qos,
                           const util::String &payload);
 
+            /**
+             * @brief Constructor, Individual data, takes over the payload without copying it
+             *
+             * @param p_topic_name Topic name on which message is to be published
+             * @param is_retained Is retained flag
+             * @param is_duplicate Is duplicate message flag
+             * @param qos QoS to use for this message, QoS2 is not supported currently
+             * @param payload String containing payload to send with message. Can be zero length.
+             */
+            PublishPacket(std::unique_ptr<Utf8String> p_topic_name,
+                          bool is_retained,
+                          bool is_duplicate,
+                          QoS qos,
+                          util::String &&payload);
+
+            /**
+             * @brief Constructor, Individual data, refers to a shared payload without copying it
+             *
+             * The same payload can be used by any number of packets, for example to publish it to several topics.
+             * Bytes of the buffer must not be modified while packets refer to them.
+             *
+             * @param p_topic_name Topic name on which message is to be published
+             * @param is_retained Is retained flag
+             * @param is_duplicate Is duplicate message flag
+             * @param qos QoS to use for this message, QoS2 is not supported currently
+             * @param payload View of the payload to send with message. Can be empty.
+             */
+            PublishPacket(std::unique_ptr<Utf8String> p_topic_name,
+                          bool is_retained,
+                          bool is_duplicate,
+                          QoS qos,
+                          const util::SharedBufferView &payload);
+
+            /**
+             * @brief Constructor, Individual data with a topic handle
+             *
+             * Same as the constructors taking a topic name, the topic is written from the handle as is.
+             *
+             * @param p_topic_handle Handle of the topic on which message is to be published, must not be nullptr
+             * @param is_retained Is retained flag
+             * @param is_duplicate Is duplicate message flag
+             * @param qos QoS to use for this message, QoS2 is not supported currently
+             * @param payload Payload to copy, take over or share. Can be zero length.
+             */
+            PublishPacket(std::shared_ptr<const TopicHandle> p_topic_handle,
+                          bool is_retained,
+                          bool is_duplicate,
+                          QoS qos,
+                          const util::String &payload);
+            PublishPacket(std::shared_ptr<const TopicHandle> p_topic_handle,
+                          bool is_retained,
+                          bool is_duplicate,
+                          QoS qos,
+                          util::String &&payload);
+            PublishPacket(std::shared_ptr<const TopicHandle> p_topic_handle,
+                          bool is_retained,
+                          bool is_duplicate,
+                          QoS qos,
+                          const util::SharedBufferView &payload);
+
             /**
              * @brief Constructor, Deserializes data from buffer
              *
@@ -118,6 +281,50 @@ namespace awsiotsdk {
                                                          bool is_duplicate,
                                                          QoS qos);
 
+            /**
+             * @brief Reinitialize a packet for another message, used to reuse pooled packets
+             *
+             * Sets the same state as the matching individual data constructor. A copied payload reuses the capacity
+             * of the payload buffer, the packet id, Ack handler and completion token of the previous message are
+             * cleared.
+             *
+             * @param p_topic_name Topic name or handle on which message is to be published, must not be nullptr
+             * @param is_retained Is retained flag
+             * @param is_duplicate Is duplicate message flag
+             * @param qos QoS to use for this message, QoS2 is not supported currently
+             * @param payload Payload to copy, take over or share, see the constructors. Can be zero length
+             */
+            void Reset(std::unique_ptr<Utf8String> p_topic_name,
+                       bool is_retained,
+                       bool is_duplicate,
+                       QoS qos,
+                       const util::String &payload);
+            void Reset(std::unique_ptr<Utf8String> p_topic_name,
+                       bool is_retained,
+                       bool is_duplicate,
+                       QoS qos,
+                       util::String &&payload);
+            void Reset(std::unique_ptr<Utf8String> p_topic_name,
+                       bool is_retained,
+                       bool is_duplicate,
+                       QoS qos,
+                       const util::SharedBufferView &payload);
+            void Reset(std::shared_ptr<const TopicHandle> p_topic_handle,
+                       bool is_retained,
+                       bool is_duplicate,
+                       QoS qos,
+                       const util::String &payload);
+            void Reset(std::shared_ptr<const TopicHandle> p_topic_handle,
+                       bool is_retained,
+                       bool is_duplicate,
+                       QoS qos,
+                       util::String &&payload);
+            void Reset(std::shared_ptr<const TopicHandle> p_topic_handle,
+                       bool is_retained,
+                       bool is_duplicate,
+                       QoS qos,
+                       const util::SharedBufferView &payload);
+
             /**
              * @brief Get the value of the Is Retained flag
              * @return boolean indicating the value of the Is Retained flag
@@ -134,19 +341,21 @@ namespace awsiotsdk {
              * @brief Get String containing topic name for this message
              * @return util::String with topic name
              */
-            util::String GetTopicName() { return p_topic_name_->ToStdString(); }
+            util::String GetTopicName() {
+                return (nullptr != p_topic_handle_) ? p_topic_handle_->GetTopicName() : p_topic_name_->ToStdString();
+            }
 
             /**
              * @brief Get string containing Payload
              * @return util::String with payload
              */
-            util::String GetPayload() { return payload_; }
+            util::String GetPayload() { return shared_payload_.IsEmpty() ? payload_ : shared_payload_.ToString(); }
 
             /**
              * @brief Get length of the payload
              * @return util::String with payload length
              */
-            size_t GetPayloadLen() { return payload_.length(); }
+            size_t GetPayloadLen() { return shared_payload_.IsEmpty() ? payload_.length() : shared_payload_.Length(); }
 
             /**
              * @brief Serialize this packet into a String
@@ -154,7 +363,24 @@ namespace awsiotsdk {
              */
             util::String ToString();
 
+            /**
+             * @brief Serialize this packet as segments for a gathered write, without copying the payload
+             *
+             * The fixed header, topic name and packet id are serialized into header_buf, the payload is referenced
+             * where the packet stores it. The segments are valid while header_buf and the packet are unchanged.
+             *
+             * @param header_buf - Buffer for the bytes preceding the payload
+             * @param segments_out - Set to the segments of the serialized packet
+             */
+            void ToSegments(util::String &header_buf, util::Vector<WriteSegment> &segments_out);
+
             QoS GetQoS() { return qos_; }
+
+            /**
+             * @brief Check whether the server responds to this Publish
+             * @return boolean, false for QoS0 Publishes which are not acknowledged
+             */
+            bool IsAckExpected() { return QoS::QOS0 != qos_; }
         };
 
         /**
@@ -188,6 +414,13 @@ namespace awsiotsdk {
              */
             PubackPacket(uint16_t publish_packet_id);
 
+            /**
+             * @brief Reinitialize a packet to acknowledge another Publish, used to reuse pooled packets
+             *
+             * @param publish_packet_id Packet ID of the Publish to acknowledge
+             */
+            void Reset(uint16_t publish_packet_id);
+
             /**
              * @brief Factory Create method
              * @param packet_id Packet ID for this Puback
@@ -213,6 +446,8 @@ namespace awsiotsdk {
         class PublishActionAsync : public Action {
         protected:
             std::shared_ptr<ClientState> p_client_state_;  ///< Shared Client State instance
+            util::String header_buf_;                      ///< Serialized header of the Publish being written, reused
+            util::Vector<WriteSegment> segments_;          ///< Segments of the Publish being written, reused
         public:
             // Disabling default, move and copy constructors to match Action parent
             // Default virtual destructor
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TopicHandle.hpp
+ * @brief Topic name that has been validated and encoded for MQTT once, for repeated publishes
+ *
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "util/memory/stl/String.hpp"
+
+/**
+ * Maximum length of an encoded MQTT string, limited by its two byte length prefix
+ */
+#define MAX_MQTT_TOPIC_NAME_LENGTH 65535
+
+namespace awsiotsdk {
+    namespace mqtt {
+        /**
+         * @brief Topic Handle
+         *
+         * Holds a topic name that is known to be valid UTF-8, along with its length prefixed MQTT encoding. Publishes
+         * by handle append the encoded bytes to the packet as is, so neither validation nor encoding is repeated
+         * per message. Handles are immutable and can be shared between threads and packets.
+         */
+        class TopicHandle {
+        protected:
+            util::String topic_name_;          ///< Topic name
+            util::String encoded_topic_name_;  ///< Two byte big endian length followed by the topic name
+
+            TopicHandle(const util::String &topic_name);
+
+        public:
+            // Rule of 5 stuff
+            // Immutable once created, only shared through the pointer returned by Create
+            TopicHandle() = delete;                                   // Delete Default constructor
+            TopicHandle(const TopicHandle &) = delete;                // Delete Copy constructor
+            TopicHandle(TopicHandle &&) = delete;                     // Delete Move constructor
+            TopicHandle &operator=(const TopicHandle &) & = delete;   // Delete Copy assignment operator
+            TopicHandle &operator=(TopicHandle &&) & = delete;        // Delete Move assignment operator
+            ~TopicHandle() = default;                                 // Default destructor
+
+            /**
+             * @brief Validate and encode a topic name
+             *
+             * @param topic_name - Topic name to publish to
+             * @return std::shared_ptr<const TopicHandle> - nullptr if the topic name is empty, longer than
+             * MAX_MQTT_TOPIC_NAME_LENGTH or not valid UTF-8
+             */
+            static std::shared_ptr<const TopicHandle> Create(const util::String &topic_name);
+
+            const util::String &GetTopicName() const { return topic_name_; }
+
+            const util::String &GetEncodedTopicName() const { return encoded_topic_name_; }
+        };
+    }
+}
@@ -0,0 +1,332 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TopicTrie.hpp
+ * @brief Topic level trie for matching MQTT topic names against subscription topic filters
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "util/PersistentHashMap.hpp"
+#include "util/memory/stl/String.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+namespace awsiotsdk {
+    namespace mqtt {
+        /**
+         * @brief Topic Trie
+         *
+         * Stores one value per MQTT topic filter in a trie with one node per topic level. Matching a topic name
+         * walks the trie level by level, following the exact level, the '+' branch and the '#' branch of each node,
+         * so the cost depends on the number of levels in the topic and not on the number of stored filters.
+         *
+         * Matching follows the MQTT 3.1.1 rules:
+         *  - '+' matches exactly one level, which may be empty
+         *  - '#' matches the parent level and any number of child levels, "sport/#" matches "sport"
+         *  - Topic names starting with '$' are not matched by filters starting with a wildcard
+         *
+         * Filters are expected to be valid, see Subscription::IsValidTopicName. Insert rejects filters with '#'
+         * anywhere other than the last level.
+         *
+         * Nodes are never changed once created. A write creates new copies of the nodes on the path of its filter
+         * and shares every other node, and the children of a node are kept in a util::PersistentHashMap, so copying
+         * a node does not copy its children either. Copying a trie is O(1) and a write costs O(log n) per level of
+         * the filter, however many filters share a prefix. A copy is an immutable snapshot: any number of threads
+         * may Match against it while another thread keeps writing the trie it was copied from. Other than that,
+         * this class is not thread safe, callers must provide synchronization.
+         *
+         * @tparam T - Type of the stored value. Must be default and copy constructible
+         */
+        template<typename T>
+        class TopicTrie {
+        protected:
+            static const char TOPIC_LEVEL_SEPARATOR = '/';
+            static const char SINGLE_LEVEL_WILDCARD_CHAR = '+';
+            static const char MULTI_LEVEL_WILDCARD_CHAR = '#';
+            static const char RESERVED_TOPIC_PREFIX = '$';
+
+            /**
+             * @brief One topic level
+             */
+            class Node {
+            public:
+                /**
+                 * Children by exact level name
+                 */
+                util::PersistentHashMap<util::String, std::shared_ptr<const Node>> children_;
+                std::shared_ptr<const Node> p_single_level_child_;  ///< Child for a '+' level
+                std::shared_ptr<const Node> p_multi_level_child_;   ///< Child for a '#' level, always a leaf
+                bool has_value_;                                    ///< Whether a filter ends at this node
+                T value_;                                           ///< Value of the filter ending here
+
+                Node() : has_value_(false), value_() {}
+
+                bool IsEmpty() const {
+                    return !has_value_ && children_.IsEmpty() && nullptr == p_single_level_child_
+                        && nullptr == p_multi_level_child_;
+                }
+            };
+
+            std::shared_ptr<const Node> p_root_;  ///< Node above the first topic level, nullptr if the trie is empty
+            size_t size_;                         ///< Number of stored filters
+
+            /**
+             * @brief Get the end of the level starting at level_start
+             */
+            static size_t GetLevelEnd(const util::String &topic, size_t level_start) {
+                size_t level_end = topic.find(TOPIC_LEVEL_SEPARATOR, level_start);
+                return (util::String::npos == level_end) ? topic.length() : level_end;
+            }
+
+            static bool IsLevel(const util::String &topic, size_t level_start, size_t level_end, char level_char) {
+                return (level_end == level_start + 1) && (level_char == topic[level_start]);
+            }
+
+            /**
+             * @brief Add matches of the levels of topic_name from level_start onwards below p_node
+             *
+             * A level_start past the end of topic_name means all levels have been consumed
+             */
+            static void MatchFrom(const Node *p_node, const util::String &topic_name, size_t level_start,
+                                  util::Vector<T> &matches_out) {
+                if (level_start > topic_name.length()) {
+                    if (p_node->has_value_) {
+                        matches_out.push_back(p_node->value_);
+                    }
+                    // "a/#" also matches "a"
+                    if (nullptr != p_node->p_multi_level_child_) {
+                        matches_out.push_back(p_node->p_multi_level_child_->value_);
+                    }
+                    return;
+                }
+
+                bool allow_wildcards = (0 != level_start) || topic_name.empty()
+                    || RESERVED_TOPIC_PREFIX != topic_name[0];
+                size_t level_end = GetLevelEnd(topic_name, level_start);
+
+                if (allow_wildcards) {
+                    if (nullptr != p_node->p_multi_level_child_) {
+                        matches_out.push_back(p_node->p_multi_level_child_->value_);
+                    }
+                    if (nullptr != p_node->p_single_level_child_) {
+                        MatchFrom(p_node->p_single_level_child_.get(), topic_name, level_end + 1, matches_out);
+                    }
+                }
+
+                if (!p_node->children_.IsEmpty()) {
+                    const std::shared_ptr<const Node> *p_child =
+                        p_node->children_.Find(topic_name.substr(level_start, level_end - level_start));
+                    if (nullptr != p_child) {
+                        MatchFrom(p_child->get(), topic_name, level_end + 1, matches_out);
+                    }
+                }
+            }
+
+            /**
+             * @brief Find the node of the levels of topic_filter from level_start onwards below p_node
+             *
+             * @return const Node * - the node, nullptr if it does not exist
+             */
+            static const Node *FindNode(const Node *p_node, const util::String &topic_filter, size_t level_start) {
+                while (nullptr != p_node && level_start <= topic_filter.length()) {
+                    size_t level_end = GetLevelEnd(topic_filter, level_start);
+                    if (IsLevel(topic_filter, level_start, level_end, SINGLE_LEVEL_WILDCARD_CHAR)) {
+                        p_node = p_node->p_single_level_child_.get();
+                    } else if (IsLevel(topic_filter, level_start, level_end, MULTI_LEVEL_WILDCARD_CHAR)) {
+                        p_node = p_node->p_multi_level_child_.get();
+                    } else {
+                        const std::shared_ptr<const Node> *p_child =
+                            p_node->children_.Find(topic_filter.substr(level_start, level_end - level_start));
+                        p_node = (nullptr == p_child) ? nullptr : p_child->get();
+                    }
+                    level_start = level_end + 1;
+                }
+                return p_node;
+            }
+
+            /**
+             * @brief Get a copy of p_node with the value stored for the levels of topic_filter from level_start
+             *
+             * @param p_node - Node to start at, nullptr if there is none yet
+             * @param is_added_out[out] - Set to true if the filter was not stored yet
+             * @return std::shared_ptr<const Node> - the new node
+             */
+            static std::shared_ptr<const Node> InsertInto(const Node *p_node, const util::String &topic_filter,
+                                                          size_t level_start, T &value, bool &is_added_out) {
+                std::shared_ptr<Node> p_copy = (nullptr == p_node) ? std::make_shared<Node>()
+                                                                   : std::make_shared<Node>(*p_node);
+                if (level_start > topic_filter.length()) {
+                    is_added_out = !p_copy->has_value_;
+                    p_copy->has_value_ = true;
+                    p_copy->value_ = std::move(value);
+                    return p_copy;
+                }
+
+                size_t level_end = GetLevelEnd(topic_filter, level_start);
+                if (IsLevel(topic_filter, level_start, level_end, SINGLE_LEVEL_WILDCARD_CHAR)) {
+                    p_copy->p_single_level_child_ = InsertInto(p_copy->p_single_level_child_.get(), topic_filter,
+                                                               level_end + 1, value, is_added_out);
+                } else if (IsLevel(topic_filter, level_start, level_end, MULTI_LEVEL_WILDCARD_CHAR)) {
+                    p_copy->p_multi_level_child_ = InsertInto(p_copy->p_multi_level_child_.get(), topic_filter,
+                                                              level_end + 1, value, is_added_out);
+                } else {
+                    util::String level = topic_filter.substr(level_start, level_end - level_start);
+                    const std::shared_ptr<const Node> *p_child = p_copy->children_.Find(level);
+                    std::shared_ptr<const Node> p_new_child =
+                        InsertInto((nullptr == p_child) ? nullptr : p_child->get(), topic_filter, level_end + 1, value,
+                                   is_added_out);
+                    p_copy->children_.Insert(level, std::move(p_new_child));
+                }
+                return p_copy;
+            }
+
+            /**
+             * @brief Get a copy of p_node without the filter, pruning nodes that became empty
+             *
+             * @param p_node - Node to start at, the filter must be stored below it
+             * @return std::shared_ptr<const Node> - the new node, nullptr if it is empty
+             */
+            static std::shared_ptr<const Node> RemoveFrom(const Node *p_node, const util::String &topic_filter,
+                                                          size_t level_start) {
+                std::shared_ptr<Node> p_copy = std::make_shared<Node>(*p_node);
+                if (level_start > topic_filter.length()) {
+                    p_copy->has_value_ = false;
+                    p_copy->value_ = T();
+                } else {
+                    size_t level_end = GetLevelEnd(topic_filter, level_start);
+                    if (IsLevel(topic_filter, level_start, level_end, SINGLE_LEVEL_WILDCARD_CHAR)) {
+                        p_copy->p_single_level_child_ = RemoveFrom(p_copy->p_single_level_child_.get(), topic_filter,
+                                                                   level_end + 1);
+                    } else if (IsLevel(topic_filter, level_start, level_end, MULTI_LEVEL_WILDCARD_CHAR)) {
+                        p_copy->p_multi_level_child_ = RemoveFrom(p_copy->p_multi_level_child_.get(), topic_filter,
+                                                                  level_end + 1);
+                    } else {
+                        util::String level = topic_filter.substr(level_start, level_end - level_start);
+                        std::shared_ptr<const Node> p_child = RemoveFrom(p_copy->children_.Find(level)->get(),
+                                                                         topic_filter, level_end + 1);
+                        if (nullptr == p_child) {
+                            p_copy->children_.Erase(level);
+                        } else {
+                            p_copy->children_.Insert(level, std::move(p_child));
+                        }
+                    }
+                }
+                return p_copy->IsEmpty() ? nullptr : p_copy;
+            }
+
+        public:
+            // Rule of 5 stuff
+            // Copies share all nodes. Not movable, a moved from trie would keep its size
+            TopicTrie() : size_(0) {}                                     // Default constructor
+            TopicTrie(const TopicTrie &) = default;                       // Copy constructor
+            TopicTrie(TopicTrie &&) = delete;                             // Delete Move constructor
+            TopicTrie &operator=(const TopicTrie &) & = default;          // Copy assignment operator
+            TopicTrie &operator=(TopicTrie &&) & = delete;                // Delete Move assignment operator
+            ~TopicTrie() = default;                                       // Default destructor
+
+            /**
+             * @brief Store a value for a topic filter, replacing the value already stored for the same filter
+             *
+             * @param topic_filter - Topic filter, may contain '+' and '#' levels
+             * @param value - Value to store
+             * @return bool - false if the filter has a '#' level that is not the last level
+             */
+            bool Insert(const util::String &topic_filter, T value) {
+                // Check the filter before creating any nodes
+                size_t level_start = 0;
+                while (level_start < topic_filter.length()) {
+                    size_t level_end = GetLevelEnd(topic_filter, level_start);
+                    if (level_end != topic_filter.length()
+                        && IsLevel(topic_filter, level_start, level_end, MULTI_LEVEL_WILDCARD_CHAR)) {
+                        return false;
+                    }
+                    level_start = level_end + 1;
+                }
+
+                bool is_added = false;
+                p_root_ = InsertInto(p_root_.get(), topic_filter, 0, value, is_added);
+                if (is_added) {
+                    size_++;
+                }
+                return true;
+            }
+
+            /**
+             * @brief Remove the value stored for a topic filter
+             *
+             * @param topic_filter - Topic filter exactly as it was inserted
+             * @return bool - true if a value was removed
+             */
+            bool Remove(const util::String &topic_filter) {
+                const Node *p_node = FindNode(p_root_.get(), topic_filter, 0);
+                if (nullptr == p_node || !p_node->has_value_) {
+                    return false;
+                }
+                p_root_ = RemoveFrom(p_root_.get(), topic_filter, 0);
+                size_--;
+                return true;
+            }
+
+            /**
+             * @brief Get the value stored for a topic filter, the filter is compared literally
+             *
+             * @param topic_filter - Topic filter exactly as it was inserted
+             * @param value_out - Set to the stored value if found
+             * @return bool - true if a value is stored for the filter
+             */
+            bool Find(const util::String &topic_filter, T &value_out) const {
+                const Node *p_node = FindNode(p_root_.get(), topic_filter, 0);
+                if (nullptr == p_node || !p_node->has_value_) {
+                    return false;
+                }
+                value_out = p_node->value_;
+                return true;
+            }
+
+            /**
+             * @brief Append the values of all filters matching a topic name
+             *
+             * Every matching filter contributes its value once. The order of the matches is unspecified.
+             *
+             * @param topic_name - Topic name of a received message, must not contain wildcards
+             * @param matches_out - Vector the matching values are appended to
+             */
+            void Match(const util::String &topic_name, util::Vector<T> &matches_out) const {
+                if (0 == size_) {
+                    return;
+                }
+                MatchFrom(p_root_.get(), topic_name, 0, matches_out);
+            }
+
+            /**
+             * @brief Remove all stored filters, copies of the trie keep theirs
+             */
+            void Clear() {
+                p_root_.reset();
+                size_ = 0;
+            }
+
+            size_t Size() const { return size_; }
+
+            bool IsEmpty() const { return 0 == size_; }
+        };
+    }
+}
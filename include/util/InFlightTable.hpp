@@ -0,0 +1,209 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file InFlightTable.hpp
+ * @brief Flat id indexed table of in-flight requests with a bitmap id allocator
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "util/memory/stl/Vector.hpp"
+
+namespace awsiotsdk {
+    namespace util {
+        /**
+         * @brief In-Flight Table
+         *
+         * Stores one value per id for a fixed range of ids [0, capacity). Occupied ids are tracked in a bitmap,
+         * so insert, lookup and removal are O(1) array accesses and finding a free id scans 64 ids per step.
+         * All storage is allocated in the constructor, the table does not allocate afterwards.
+         *
+         * This class is not thread safe, callers must provide synchronization.
+         *
+         * @tparam T - Type of the stored value. Must be default constructible and move assignable
+         */
+        template<typename T>
+        class InFlightTable {
+        protected:
+            static const size_t BITS_PER_WORD = 64;
+
+            util::Vector<T> slots_;              ///< Value per id, default constructed while the id is free
+            util::Vector<uint64_t> in_flight_;   ///< Bitmap of occupied ids
+            size_t capacity_;                    ///< Number of supported ids
+            size_t size_;                        ///< Number of occupied ids
+
+            static size_t CountTrailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+                return (size_t) __builtin_ctzll(word);
+#else
+                size_t count = 0;
+                while (0 == (word & 1)) {
+                    word >>= 1;
+                    count++;
+                }
+                return count;
+#endif
+            }
+
+            /**
+             * @brief Find the first free id in [from, to)
+             */
+            bool FindFreeInRange(size_t from, size_t to, size_t &id_out) const {
+                while (from < to) {
+                    size_t word_index = from / BITS_PER_WORD;
+                    // Treat ids below from as occupied so they are skipped
+                    uint64_t free_bits = ~in_flight_[word_index] & (~((uint64_t) 0) << (from % BITS_PER_WORD));
+                    if (0 != free_bits) {
+                        size_t id = word_index * BITS_PER_WORD + CountTrailingZeros(free_bits);
+                        if (id >= to) {
+                            return false;
+                        }
+                        id_out = id;
+                        return true;
+                    }
+                    from = (word_index + 1) * BITS_PER_WORD;
+                }
+                return false;
+            }
+
+            void SetInFlight(size_t id, bool in_flight) {
+                uint64_t mask = ((uint64_t) 1) << (id % BITS_PER_WORD);
+                if (in_flight) {
+                    in_flight_[id / BITS_PER_WORD] |= mask;
+                } else {
+                    in_flight_[id / BITS_PER_WORD] &= ~mask;
+                }
+            }
+
+        public:
+            /**
+             * @brief Constructor
+             *
+             * @param capacity - Number of ids supported, valid ids are [0, capacity)
+             */
+            explicit InFlightTable(size_t capacity)
+                : slots_(capacity), in_flight_((capacity + BITS_PER_WORD - 1) / BITS_PER_WORD, 0),
+                  capacity_(capacity), size_(0) {
+            }
+
+            // Rule of 5 stuff
+            // Disabling default constructor while keeping defaults for the rest
+            InFlightTable() = delete;                                     // Delete Default constructor
+            InFlightTable(const InFlightTable &) = default;                // Copy constructor
+            InFlightTable(InFlightTable &&) = default;                    // Move constructor
+            InFlightTable &operator=(const InFlightTable &) & = default;  // Copy assignment operator
+            InFlightTable &operator=(InFlightTable &&) & = default;       // Move assignment operator
+            ~InFlightTable() = default;                                   // Default destructor
+
+            /**
+             * @brief Check whether an id is currently in flight
+             *
+             * @param id - Id to check
+             * @return boolean indicating whether the id is occupied
+             */
+            bool IsInFlight(size_t id) const {
+                return id < capacity_
+                    && 0 != (in_flight_[id / BITS_PER_WORD] & (((uint64_t) 1) << (id % BITS_PER_WORD)));
+            }
+
+            /**
+             * @brief Store a value for a free id
+             *
+             * @param id - Id to occupy
+             * @param value - Value to store
+             * @return false if the id is out of range or already in flight, the table is not modified in that case
+             */
+            bool Insert(size_t id, T value) {
+                if (id >= capacity_ || IsInFlight(id)) {
+                    return false;
+                }
+                slots_[id] = std::move(value);
+                SetInFlight(id, true);
+                size_++;
+                return true;
+            }
+
+            /**
+             * @brief Remove an id from the table and return its value
+             *
+             * @param id - Id to release
+             * @param value_out[out] - Value that was stored for the id
+             * @return false if the id was not in flight
+             */
+            bool Take(size_t id, T &value_out) {
+                if (!IsInFlight(id)) {
+                    return false;
+                }
+                value_out = std::move(slots_[id]);
+                // Don't keep anything the value referenced alive until the id is reused
+                slots_[id] = T();
+                SetInFlight(id, false);
+                size_--;
+                return true;
+            }
+
+            /**
+             * @brief Remove an id from the table, discarding its value
+             *
+             * @param id - Id to release
+             * @return false if the id was not in flight
+             */
+            bool Erase(size_t id) {
+                T value;
+                return Take(id, value);
+            }
+
+            /**
+             * @brief Find the first free id at or after start_id
+             *
+             * The search wraps around to min_id after the last id. Starting after the previously allocated id
+             * hands out ids round robin, so a released id is not reused right away. The id is not occupied by this
+             * call.
+             *
+             * @param start_id - Id to start searching at
+             * @param min_id - Lowest id that may be returned, ids below it are never handed out
+             * @param id_out[out] - Free id
+             * @return false if there is no free id in [min_id, capacity)
+             */
+            bool FindNextFree(size_t start_id, size_t min_id, size_t &id_out) const {
+                if (start_id < min_id || start_id >= capacity_) {
+                    start_id = min_id;
+                }
+                return FindFreeInRange(start_id, capacity_, id_out) || FindFreeInRange(min_id, start_id, id_out);
+            }
+
+            /**
+             * @brief Get number of ids currently in flight
+             * @return size_t count
+             */
+            size_t Size() const { return size_; }
+
+            /**
+             * @brief Get number of supported ids
+             * @return size_t capacity
+             */
+            size_t Capacity() const { return capacity_; }
+        };
+
+        template<typename T>
+        const size_t InFlightTable<T>::BITS_PER_WORD;
+    }
+}
@@ -0,0 +1,298 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PersistentHashMap.hpp
+ * @brief Hash map whose copies share their contents and are not affected by writes to each other
+ *
+ */
+
+#pragma once
+
+#include <bitset>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "util/memory/stl/Vector.hpp"
+
+namespace awsiotsdk {
+    namespace util {
+        /**
+         * @brief Persistent Hash Map
+         *
+         * Hash array mapped trie: every node holds up to 32 entries, selected by the next 5 bits of the key's hash.
+         * Nodes are never changed once created. A write creates new copies of the nodes on the path to its key and
+         * shares every other node, so copying a map is O(1) and a write copies O(log32 n) nodes of at most 32
+         * entries each. A copy is therefore an immutable snapshot of the map at the time it was made, any number of
+         * threads may read it while another thread writes the map it was copied from. Other than that, this class
+         * is not thread safe, callers must provide synchronization.
+         *
+         * Keys whose hashes are equal in every bit are kept in a list at the bottom of the trie.
+         *
+         * @tparam K - Type of the keys. Must be default and copy constructible and equality comparable
+         * @tparam V - Type of the values. Must be default and copy constructible
+         * @tparam Hash - Hash function of the keys
+         */
+        template<typename K, typename V, typename Hash = std::hash<K>>
+        class PersistentHashMap {
+        protected:
+            static const size_t BITS_PER_LEVEL = 5;
+            static const size_t LEVEL_MASK = (1 << BITS_PER_LEVEL) - 1;
+            // Depth at which all hash bits are used up and nodes become collision lists
+            static const size_t MAX_DEPTH = (sizeof(size_t) * CHAR_BIT + BITS_PER_LEVEL - 1) / BITS_PER_LEVEL;
+
+            class Node;
+
+            /**
+             * @brief Key and value, or a child node holding the keys whose hashes share the bits so far
+             */
+            class Entry {
+            public:
+                size_t hash_;                          ///< Hash of the key, unused for child nodes
+                std::shared_ptr<const Node> p_child_;  ///< Child node, nullptr for a key and value
+                K key_;                                ///< Key, unused for child nodes
+                V value_;                              ///< Value, unused for child nodes
+
+                Entry() : hash_(0), key_(), value_() {}
+            };
+
+            /**
+             * @brief Up to 32 entries ordered by the bits of their hash at this depth
+             */
+            class Node {
+            public:
+                uint32_t bitmap_;              ///< Bit i is set if there is an entry for bits i, 0 in collision lists
+                util::Vector<Entry> entries_;  ///< Entries of the set bits in order, or the collision list
+
+                Node() : bitmap_(0) {}
+            };
+
+            std::shared_ptr<const Node> p_root_;  ///< Root node, nullptr if the map is empty
+            size_t size_;                         ///< Number of keys
+
+            static uint32_t GetBit(size_t hash, size_t depth) {
+                return static_cast<uint32_t>(1) << ((hash >> (depth * BITS_PER_LEVEL)) & LEVEL_MASK);
+            }
+
+            /**
+             * @brief Get the index of the entry for a bit, the number of set bits below it
+             */
+            static size_t GetIndex(uint32_t bitmap, uint32_t bit) {
+                return std::bitset<32>(bitmap & (bit - 1)).count();
+            }
+
+            static std::shared_ptr<const Node> CreateLeafNode(size_t depth, Entry entry) {
+                std::shared_ptr<Node> p_node = std::make_shared<Node>();
+                p_node->bitmap_ = (MAX_DEPTH <= depth) ? 0 : GetBit(entry.hash_, depth);
+                p_node->entries_.push_back(std::move(entry));
+                return p_node;
+            }
+
+            /**
+             * @brief Get a copy of p_node with the key set to the value
+             *
+             * @param p_node - Node to start at, nullptr if there is none
+             * @param depth - Depth of p_node
+             * @param entry - Key, hash and value to set
+             * @param is_added_out[out] - Set to true if the key was not in the map yet
+             * @return std::shared_ptr<const Node> - the new node
+             */
+            static std::shared_ptr<const Node> InsertInto(const Node *p_node, size_t depth, Entry entry,
+                                                          bool &is_added_out) {
+                if (nullptr == p_node) {
+                    is_added_out = true;
+                    return CreateLeafNode(depth, std::move(entry));
+                }
+
+                std::shared_ptr<Node> p_copy = std::make_shared<Node>(*p_node);
+                if (MAX_DEPTH <= depth) {
+                    for (Entry &existing : p_copy->entries_) {
+                        if (existing.key_ == entry.key_) {
+                            existing.value_ = std::move(entry.value_);
+                            return p_copy;
+                        }
+                    }
+                    is_added_out = true;
+                    p_copy->entries_.push_back(std::move(entry));
+                    return p_copy;
+                }
+
+                uint32_t bit = GetBit(entry.hash_, depth);
+                size_t index = GetIndex(p_copy->bitmap_, bit);
+                if (0 == (p_copy->bitmap_ & bit)) {
+                    is_added_out = true;
+                    p_copy->bitmap_ |= bit;
+                    p_copy->entries_.insert(p_copy->entries_.begin() + index, std::move(entry));
+                    return p_copy;
+                }
+
+                Entry &existing = p_copy->entries_[index];
+                if (nullptr != existing.p_child_) {
+                    existing.p_child_ = InsertInto(existing.p_child_.get(), depth + 1, std::move(entry), is_added_out);
+                } else if (existing.key_ == entry.key_) {
+                    existing.value_ = std::move(entry.value_);
+                } else {
+                    // Both keys move one level down, into a node of their own
+                    Entry child_entry;
+                    child_entry.p_child_ = InsertInto(CreateLeafNode(depth + 1, std::move(existing)).get(),
+                                                      depth + 1, std::move(entry), is_added_out);
+                    existing = std::move(child_entry);
+                }
+                return p_copy;
+            }
+
+            /**
+             * @brief Get a copy of p_node without the key
+             *
+             * @param p_node - Node to start at
+             * @param depth - Depth of p_node
+             * @param hash - Hash of the key
+             * @param key - Key to remove, must be in the map
+             * @return std::shared_ptr<const Node> - the new node, nullptr if it has no entries left
+             */
+            static std::shared_ptr<const Node> RemoveFrom(const Node *p_node, size_t depth, size_t hash,
+                                                          const K &key) {
+                std::shared_ptr<Node> p_copy = std::make_shared<Node>(*p_node);
+                size_t index = 0;
+                if (MAX_DEPTH <= depth) {
+                    while (!(p_copy->entries_[index].key_ == key)) {
+                        index++;
+                    }
+                } else {
+                    uint32_t bit = GetBit(hash, depth);
+                    index = GetIndex(p_copy->bitmap_, bit);
+                    Entry &existing = p_copy->entries_[index];
+                    if (nullptr != existing.p_child_) {
+                        std::shared_ptr<const Node> p_child = RemoveFrom(existing.p_child_.get(), depth + 1, hash,
+                                                                         key);
+                        if (nullptr != p_child) {
+                            if (1 == p_child->entries_.size() && nullptr == p_child->entries_[0].p_child_) {
+                                // A single key moves back up, lookups do not walk through nodes of one key
+                                existing = p_child->entries_[0];
+                            } else {
+                                existing.p_child_ = std::move(p_child);
+                            }
+                            return p_copy;
+                        }
+                    }
+                    p_copy->bitmap_ &= ~bit;
+                }
+
+                p_copy->entries_.erase(p_copy->entries_.begin() + index);
+                return p_copy->entries_.empty() ? nullptr : p_copy;
+            }
+
+            const Entry *FindEntry(const K &key) const {
+                size_t hash = Hash()(key);
+                const Node *p_node = p_root_.get();
+                for (size_t depth = 0; nullptr != p_node; depth++) {
+                    if (MAX_DEPTH <= depth) {
+                        for (const Entry &entry : p_node->entries_) {
+                            if (entry.key_ == key) {
+                                return &entry;
+                            }
+                        }
+                        return nullptr;
+                    }
+
+                    uint32_t bit = GetBit(hash, depth);
+                    if (0 == (p_node->bitmap_ & bit)) {
+                        return nullptr;
+                    }
+                    const Entry &entry = p_node->entries_[GetIndex(p_node->bitmap_, bit)];
+                    if (nullptr == entry.p_child_) {
+                        return (entry.key_ == key) ? &entry : nullptr;
+                    }
+                    p_node = entry.p_child_.get();
+                }
+                return nullptr;
+            }
+
+        public:
+            // Rule of 5 stuff
+            // Copies share all nodes, moves leave an empty map behind
+            PersistentHashMap() : size_(0) {}                                                // Default constructor
+            PersistentHashMap(const PersistentHashMap &) = default;                          // Copy constructor
+            PersistentHashMap(PersistentHashMap &&other)                                     // Move constructor
+                : p_root_(std::move(other.p_root_)), size_(other.size_) { other.size_ = 0; }
+            PersistentHashMap &operator=(const PersistentHashMap &) & = default;             // Copy assignment operator
+            PersistentHashMap &operator=(PersistentHashMap &&other) & {                      // Move assignment operator
+                p_root_ = std::move(other.p_root_);
+                size_ = other.size_;
+                other.size_ = 0;
+                return *this;
+            }
+            ~PersistentHashMap() = default;                                                  // Default destructor
+
+            /**
+             * @brief Set the value of a key, replacing the value already set for it
+             *
+             * @param key - Key
+             * @param value - Value
+             */
+            void Insert(const K &key, V value) {
+                Entry entry;
+                entry.hash_ = Hash()(key);
+                entry.key_ = key;
+                entry.value_ = std::move(value);
+                bool is_added = false;
+                p_root_ = InsertInto(p_root_.get(), 0, std::move(entry), is_added);
+                if (is_added) {
+                    size_++;
+                }
+            }
+
+            /**
+             * @brief Remove a key
+             *
+             * @param key - Key
+             * @return bool - true if the key was found and removed
+             */
+            bool Erase(const K &key) {
+                if (nullptr == FindEntry(key)) {
+                    return false;
+                }
+                p_root_ = RemoveFrom(p_root_.get(), 0, Hash()(key), key);
+                size_--;
+                return true;
+            }
+
+            /**
+             * @brief Get the value of a key
+             *
+             * @param key - Key
+             * @return const V * - the value, nullptr if the key is not in the map. Valid until the map is written
+             * or destroyed
+             */
+            const V *Find(const K &key) const {
+                const Entry *p_entry = FindEntry(key);
+                return (nullptr == p_entry) ? nullptr : &p_entry->value_;
+            }
+
+            size_t Size() const { return size_; }
+
+            bool IsEmpty() const { return 0 == size_; }
+
+            void Clear() {
+                p_root_.reset();
+                size_ = 0;
+            }
+        };
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file SharedBufferView.hpp
+ * @brief Non-owning view of a range of bytes in a reference counted buffer
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "util/memory/stl/String.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+namespace awsiotsdk {
+    namespace util {
+        /**
+         * @brief Shared Buffer View
+         *
+         * Refers to a range of bytes inside a buffer without copying them. Every view holds a reference to the
+         * buffer, so the bytes stay valid and unchanged for as long as any view of them exists, including copies
+         * retained after a callback returns. Copying a view only copies the reference.
+         */
+        class SharedBufferView {
+        protected:
+            std::shared_ptr<const util::Vector<unsigned char>> p_buffer_;  ///< Buffer the view refers to
+            size_t offset_;                                                ///< Offset of the first byte in the buffer
+            size_t length_;                                                ///< Number of bytes in the view
+
+        public:
+            // Rule of 5 stuff
+            // Default constructor creates an empty view, keeping defaults for the rest
+            SharedBufferView() : offset_(0), length_(0) {}                           // Default constructor
+            SharedBufferView(const SharedBufferView &) = default;                    // Copy constructor
+            SharedBufferView(SharedBufferView &&) = default;                         // Move constructor
+            SharedBufferView &operator=(const SharedBufferView &) & = default;       // Copy assignment operator
+            SharedBufferView &operator=(SharedBufferView &&) & = default;            // Move assignment operator
+            ~SharedBufferView() = default;                                           // Default destructor
+
+            /**
+             * @brief Constructor
+             *
+             * @param p_buffer - Buffer to refer to. The owner must not modify the bytes in the range while any view
+             * of them exists
+             * @param offset - Offset of the first byte of the range
+             * @param length - Number of bytes in the range, offset + length must not exceed the buffer size
+             */
+            SharedBufferView(std::shared_ptr<const util::Vector<unsigned char>> p_buffer, size_t offset, size_t length)
+                : p_buffer_(std::move(p_buffer)), offset_(offset), length_(length) {}
+
+            /**
+             * @brief Constructor, takes over a buffer and refers to all of it
+             *
+             * @param buffer - Buffer to take over, it is not modified afterwards
+             */
+            explicit SharedBufferView(util::Vector<unsigned char> &&buffer)
+                : p_buffer_(std::make_shared<const util::Vector<unsigned char>>(std::move(buffer))), offset_(0),
+                  length_(p_buffer_->size()) {}
+
+            /**
+             * @brief Get a view of a part of this view, sharing the same buffer
+             *
+             * @param offset - Offset relative to the start of this view
+             * @param length - Number of bytes, offset + length must not exceed Length()
+             * @return SharedBufferView - view of the part
+             */
+            SharedBufferView SubView(size_t offset, size_t length) const {
+                return SharedBufferView(p_buffer_, offset_ + offset, length);
+            }
+
+            /**
+             * @brief Get the first byte of the view
+             *
+             * @return const unsigned char * - nullptr if the view is empty
+             */
+            const unsigned char *Data() const {
+                return (0 == length_) ? nullptr : p_buffer_->data() + offset_;
+            }
+
+            size_t Length() const { return length_; }
+
+            bool IsEmpty() const { return 0 == length_; }
+
+            /**
+             * @brief Copy the bytes of the view into a String
+             *
+             * @return util::String - copy of the bytes
+             */
+            util::String ToString() const {
+                return (0 == length_) ? util::String() : util::String(reinterpret_cast<const char *>(Data()), length_);
+            }
+        };
+    }
+}
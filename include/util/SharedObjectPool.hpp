@@ -0,0 +1,116 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file SharedObjectPool.hpp
+ * @brief Pool of reference counted objects that are reused once all other references are released
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+#include "util/memory/stl/Vector.hpp"
+
+namespace awsiotsdk {
+    namespace util {
+        /**
+         * @brief Shared Object Pool
+         *
+         * Keeps one reference to every object it has created. An object is free once the pool holds the only
+         * reference left, so callers hand out and release pooled objects like any other shared_ptr and nothing has
+         * to be returned to the pool explicitly. Reusing an object reuses its allocation, its control block and the
+         * capacity of any buffers it owns.
+         *
+         * Callers must reset the state of an acquired object before using it, it still holds the values of its
+         * previous use. Weak references to pooled objects are not supported, they do not count as uses.
+         *
+         * @tparam T - Type of the pooled objects
+         */
+        template<typename T>
+        class SharedObjectPool {
+        protected:
+            std::mutex pool_lock_;                      ///< Guards the objects and the next index
+            util::Vector<std::shared_ptr<T>> objects_;  ///< Every object created by the pool
+            size_t max_size_;                           ///< Maximum number of objects
+            size_t next_index_;                         ///< Index to start the search for a free object at
+
+        public:
+            // Rule of 5 stuff
+            // Owns its objects, should not be copied or moved
+            SharedObjectPool() = delete;                                              // Delete Default constructor
+            SharedObjectPool(const SharedObjectPool &) = delete;                      // Delete Copy constructor
+            SharedObjectPool(SharedObjectPool &&) = delete;                           // Delete Move constructor
+            SharedObjectPool &operator=(const SharedObjectPool &) & = delete;         // Delete Copy assignment operator
+            SharedObjectPool &operator=(SharedObjectPool &&) & = delete;              // Delete Move assignment operator
+            ~SharedObjectPool() = default;                                            // Default destructor
+
+            /**
+             * @brief Constructor
+             *
+             * @param max_size - Maximum number of objects the pool creates
+             */
+            explicit SharedObjectPool(size_t max_size) : max_size_(max_size), next_index_(0) {
+                objects_.reserve(max_size);
+            }
+
+            /**
+             * @brief Get a free object, creating one if none is free and the pool is not full
+             *
+             * @param create - Called without arguments to create a new object, returns std::shared_ptr<T>
+             * @return std::shared_ptr<T> - the object, nullptr if all objects are in use and the pool is full or
+             * create returned nullptr
+             */
+            template<typename CreateFunction>
+            std::shared_ptr<T> Acquire(CreateFunction create) {
+                std::lock_guard<std::mutex> pool_guard(pool_lock_);
+                size_t object_count = objects_.size();
+                for (size_t itr = 0; itr < object_count; itr++) {
+                    size_t index = (next_index_ + itr) % object_count;
+                    if (1 == objects_[index].use_count()) {
+                        // Writes made by the thread that released the last other reference must be visible
+                        std::atomic_thread_fence(std::memory_order_acquire);
+                        next_index_ = (index + 1) % object_count;
+                        return objects_[index];
+                    }
+                }
+
+                if (object_count >= max_size_) {
+                    return nullptr;
+                }
+                std::shared_ptr<T> p_object = create();
+                if (nullptr != p_object) {
+                    objects_.push_back(p_object);
+                }
+                return p_object;
+            }
+
+            /**
+             * @brief Get the number of objects created by the pool, in use or not
+             * @return size_t - number of objects
+             */
+            size_t Size() {
+                std::lock_guard<std::mutex> pool_guard(pool_lock_);
+                return objects_.size();
+            }
+
+            size_t GetMaxSize() const { return max_size_; }
+        };
+    }
+}
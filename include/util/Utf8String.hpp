@@ -34,10 +34,6 @@ namespace awsiotsdk {
 
         Utf8String(const char *str, std::size_t length);
 
-        static bool IsValidInput(util::String str);
-
-        static bool IsValidInput(const char *str, std::size_t length);
-
     public:
         // Rule of 5 stuff
         // Disabling default constructor while keeping defaults for the rest
@@ -48,12 +44,28 @@ namespace awsiotsdk {
         Utf8String &operator=(Utf8String &&) & = default;       // Move assignment operator
         ~Utf8String() = default;                                // Default destructor
 
+        static bool IsValidInput(const util::String &str);
+
+        /**
+         * @brief Check that a range of bytes is valid UTF-8 without copying it
+         *
+         * @param str - first byte of the range
+         * @param length - number of bytes in the range
+         * @return bool - true if the bytes are valid UTF-8
+         */
+        static bool IsValidInput(const char *str, std::size_t length);
+
         static std::unique_ptr<Utf8String> Create(util::String str);
 
         static std::unique_ptr<Utf8String> Create(const char *str, std::size_t length);
 
         std::size_t Length();
 
-        util::String ToStdString();
+        /**
+         * @brief Get the string
+         *
+         * @return const util::String & - reference to the string, valid as long as this instance
+         */
+        const util::String &ToStdString() const;
     };
 }
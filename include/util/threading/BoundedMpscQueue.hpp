@@ -0,0 +1,227 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file BoundedMpscQueue.hpp
+ * @brief Lock-free bounded queue used for passing work from application threads to a Client Core thread
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "util/Core_EXPORTS.hpp"
+
+namespace awsiotsdk {
+    namespace util {
+        namespace Threading {
+            /**
+             * @brief Bounded lock-free Multi Producer Single Consumer queue
+             *
+             * Ring buffer where every cell carries a sequence number that tells producers and consumers whether the
+             * cell is free or holds data for the current lap. Producers claim a position with a single CAS, the
+             * consumer never takes a lock. The physical capacity is fixed at construction and rounded up to a power
+             * of two. A logical limit, which can be changed at runtime, is enforced on top of it.
+             *
+             * The dequeue side also claims positions with a CAS, so a second thread may drain the queue (eg. when
+             * clearing it on shutdown) while the regular consumer is still running.
+             *
+             * @tparam T Element type, must be default constructible and move assignable
+             */
+            template<typename T>
+            class BoundedMpscQueue {
+            protected:
+                /**
+                 * @brief Single slot of the ring
+                 */
+                struct Cell {
+                    std::atomic_size_t sequence_;  ///< Position this cell is ready for
+                    T data_;                       ///< Stored element
+                };
+
+                // Padding is used to keep producer and consumer counters on separate cache lines
+                static const size_t CACHE_LINE_SIZE = 64;
+
+                std::unique_ptr<Cell[]> p_buffer_;                                ///< Ring storage
+                size_t buffer_mask_;                                             ///< Capacity - 1, capacity is a power of two
+                char pad_0_[CACHE_LINE_SIZE];
+                std::atomic_size_t enqueue_pos_;                                 ///< Next position producers will claim
+                char pad_1_[CACHE_LINE_SIZE - sizeof(std::atomic_size_t)];
+                std::atomic_size_t dequeue_pos_;                                 ///< Next position to be consumed
+                char pad_2_[CACHE_LINE_SIZE - sizeof(std::atomic_size_t)];
+                std::atomic_size_t size_;                                        ///< Number of admitted elements
+                std::atomic_size_t max_size_;                                    ///< Logical limit, never exceeds capacity
+
+                static size_t RoundUpToPowerOfTwo(size_t value) {
+                    size_t result = 1;
+                    while (result < value) {
+                        result <<= 1;
+                    }
+                    return result;
+                }
+
+            public:
+                /**
+                 * @brief Constructor
+                 *
+                 * @param capacity - Physical capacity of the ring, rounded up to the next power of two
+                 */
+                explicit BoundedMpscQueue(size_t capacity) {
+                    size_t buffer_size = RoundUpToPowerOfTwo(capacity < 2 ? 2 : capacity);
+                    p_buffer_ = std::unique_ptr<Cell[]>(new Cell[buffer_size]);
+                    buffer_mask_ = buffer_size - 1;
+                    for (size_t itr = 0; itr < buffer_size; itr++) {
+                        p_buffer_[itr].sequence_.store(itr, std::memory_order_relaxed);
+                    }
+                    enqueue_pos_.store(0, std::memory_order_relaxed);
+                    dequeue_pos_.store(0, std::memory_order_relaxed);
+                    size_.store(0, std::memory_order_relaxed);
+                    max_size_.store(buffer_size, std::memory_order_relaxed);
+                }
+
+                // Rule of 5 stuff
+                // Contains atomics shared between threads, should not be moved or copied
+                BoundedMpscQueue() = delete;                                        // Delete Default constructor
+                BoundedMpscQueue(const BoundedMpscQueue &) = delete;                // Delete Copy constructor
+                BoundedMpscQueue(BoundedMpscQueue &&) = delete;                     // Delete Move constructor
+                BoundedMpscQueue &operator=(const BoundedMpscQueue &) & = delete;   // Delete Copy assignment operator
+                BoundedMpscQueue &operator=(BoundedMpscQueue &&) & = delete;        // Delete Move assignment operator
+                ~BoundedMpscQueue() = default;                                      // Default destructor
+
+                /**
+                 * @brief Get the physical capacity of the ring
+                 * @return size_t capacity
+                 */
+                size_t Capacity() const { return buffer_mask_ + 1; }
+
+                /**
+                 * @brief Get the logical limit of the queue
+                 * @return size_t max size
+                 */
+                size_t GetMaxSize() const { return max_size_.load(std::memory_order_relaxed); }
+
+                /**
+                 * @brief Set the logical limit of the queue. Values larger than the capacity are clamped.
+                 *
+                 * Lowering the limit below the current size does not drop elements, it only blocks new pushes
+                 * until enough elements have been consumed.
+                 *
+                 * @param max_size - New limit
+                 */
+                void SetMaxSize(size_t max_size) {
+                    max_size_.store(max_size > Capacity() ? Capacity() : max_size, std::memory_order_relaxed);
+                }
+
+                /**
+                 * @brief Get number of elements currently in the queue. Approximate while producers are active.
+                 * @return size_t size
+                 */
+                size_t Size() const { return size_.load(std::memory_order_seq_cst); }
+
+                /**
+                 * @brief Check whether the queue is empty. Approximate while producers are active.
+                 * @return bool
+                 */
+                bool IsEmpty() const { return 0 == Size(); }
+
+                /**
+                 * @brief Attempt to push an element. Safe to call from any number of threads.
+                 *
+                 * @param value - Element to push, moved from only when the push succeeds
+                 * @return true if the element was pushed, false if the queue is full
+                 */
+                bool TryPush(T &&value) {
+                    // Admission against the logical limit. Admitted elements never exceed the physical capacity
+                    size_t cur_size = size_.load(std::memory_order_relaxed);
+                    do {
+                        if (cur_size >= max_size_.load(std::memory_order_relaxed)) {
+                            return false;
+                        }
+                    } while (!size_.compare_exchange_weak(cur_size, cur_size + 1, std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed));
+
+                    Cell *p_cell;
+                    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+                    for (;;) {
+                        p_cell = &p_buffer_[pos & buffer_mask_];
+                        size_t seq = p_cell->sequence_.load(std::memory_order_acquire);
+                        intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+                        if (0 == diff) {
+                            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                                break;
+                            }
+                        } else if (0 > diff) {
+                            // Cell still holds data from the previous lap
+                            size_.fetch_sub(1, std::memory_order_seq_cst);
+                            return false;
+                        } else {
+                            pos = enqueue_pos_.load(std::memory_order_relaxed);
+                        }
+                    }
+
+                    p_cell->data_ = std::move(value);
+                    p_cell->sequence_.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+
+                /**
+                 * @brief Attempt to pop the oldest element
+                 *
+                 * @param value_out[out] - Popped element
+                 * @return true if an element was popped, false if the queue is empty
+                 */
+                bool TryPop(T &value_out) {
+                    Cell *p_cell;
+                    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+                    for (;;) {
+                        p_cell = &p_buffer_[pos & buffer_mask_];
+                        size_t seq = p_cell->sequence_.load(std::memory_order_acquire);
+                        intptr_t diff = (intptr_t) seq - (intptr_t) (pos + 1);
+                        if (0 == diff) {
+                            if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                                break;
+                            }
+                        } else if (0 > diff) {
+                            // Empty, or the producer that claimed this cell has not finished writing yet
+                            return false;
+                        } else {
+                            pos = dequeue_pos_.load(std::memory_order_relaxed);
+                        }
+                    }
+
+                    value_out = std::move(p_cell->data_);
+                    p_cell->data_ = T();
+                    p_cell->sequence_.store(pos + buffer_mask_ + 1, std::memory_order_release);
+                    size_.fetch_sub(1, std::memory_order_seq_cst);
+                    return true;
+                }
+
+                /**
+                 * @brief Pop and discard all elements currently in the queue
+                 */
+                void Clear() {
+                    T discard;
+                    while (TryPop(discard)) {
+                        discard = T();
+                    }
+                }
+            };
+        }
+    }
+}
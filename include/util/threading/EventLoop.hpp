@@ -0,0 +1,104 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file EventLoop.hpp
+ * @brief Single threaded epoll based Executor
+ *
+ */
+
+#pragma once
+
+#include "util/memory/stl/Map.hpp"
+#include "util/threading/Executor.hpp"
+
+namespace awsiotsdk {
+    namespace util {
+        namespace Threading {
+            /**
+             * @brief Event Loop Class
+             *
+             * Executor with exactly one thread that waits for due steps and for read readiness of watched descriptors
+             * in a single epoll set. Used to drive a large number of connections from one thread, each connection's
+             * read runner only runs when its socket has data. Steps are run in due order, a step that blocks delays
+             * every other task on the loop.
+             *
+             * Only available on Linux, Create returns nullptr on other platforms.
+             */
+            class AWS_API_EXPORT EventLoop : public Executor {
+            protected:
+                int epoll_fd_;                                          ///< epoll instance, -1 if unavailable
+                int wake_fd_;                                           ///< eventfd used to interrupt epoll_wait
+                bool is_polling_;                                       ///< Whether the loop thread is in epoll_wait
+                bool is_wake_pending_;                                  ///< Whether wake_fd_ has been written and not read yet
+                util::Map<int, std::shared_ptr<Task>> watched_tasks_;   ///< Task to wake up for each watched descriptor
+
+                /**
+                 * @brief Constructor, creates the epoll set
+                 *
+                 * @param config - Executor configuration, the worker count is ignored
+                 */
+                explicit EventLoop(const ExecutorConfig &config);
+
+                void WaitForWork(std::unique_lock<std::mutex> &executor_lock, bool has_due,
+                                 std::chrono::steady_clock::time_point due);
+
+                void NotifyWork(bool notify_all);
+
+                void OnTaskFinished(const std::shared_ptr<Task> &p_task);
+
+                /**
+                 * @brief Remove the watch of a task. Call with the executor lock held
+                 *
+                 * @param p_task - Task to stop watching for
+                 */
+                void UnwatchLocked(const std::shared_ptr<Task> &p_task);
+
+            public:
+                // Rule of 5 stuff
+                // Contains threads and descriptors, should not be moved or copied
+                EventLoop() = delete;                                 // Delete Default constructor
+                EventLoop(const EventLoop &) = delete;                // Delete Copy constructor
+                EventLoop(EventLoop &&) = delete;                     // Delete Move constructor
+                EventLoop &operator=(const EventLoop &) & = delete;   // Delete Copy assignment operator
+                EventLoop &operator=(EventLoop &&) & = delete;        // Delete Move assignment operator
+
+                /**
+                 * @brief Destructor, stops the loop thread and closes the epoll set
+                 */
+                virtual ~EventLoop();
+
+                /**
+                 * @brief Create factory method
+                 *
+                 * @param config - Executor configuration, stack size, affinity and thread name apply to the loop thread
+                 * @return std::shared_ptr<EventLoop> new event loop, nullptr if epoll is unavailable or the thread
+                 * could not be started
+                 */
+                static std::shared_ptr<EventLoop> Create(const ExecutorConfig &config);
+
+                bool Watch(const std::shared_ptr<Task> &p_task, int descriptor);
+
+                void Unwatch(const std::shared_ptr<Task> &p_task);
+
+                /**
+                 * @brief Get number of watched descriptors
+                 * @return size_t count
+                 */
+                size_t GetWatchCount();
+            };
+        }
+    }
+}
@@ -0,0 +1,315 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file Executor.hpp
+ * @brief Fixed size worker pool that can be shared by multiple Client Core instances
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+
+#include "util/Core_EXPORTS.hpp"
+#include "util/memory/stl/String.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+namespace awsiotsdk {
+    namespace util {
+        namespace Threading {
+            /**
+             * @brief Executor Configuration Class
+             *
+             * Stack size, CPU affinity and thread names are applied on Linux and ignored on other platforms
+             */
+            class AWS_API_EXPORT ExecutorConfig {
+            public:
+                size_t worker_count_;               ///< Number of worker threads, 0 for one per hardware thread
+                size_t stack_size_bytes_;           ///< Stack size of each worker thread, 0 for the platform default
+                util::Vector<int> cpu_affinity_;    ///< Worker N is pinned to cpu_affinity_[N % size], empty for no pinning
+                util::String thread_name_prefix_;   ///< Worker threads are named prefix + index
+
+                /**
+                 * @brief Constructor, sets defaults
+                 */
+                ExecutorConfig();
+            };
+
+            /**
+             * @brief Executor Class
+             *
+             * Runs any number of long running tasks on a fixed number of worker threads. A task is a step function
+             * that does a bounded amount of work and returns the delay before it should be run again, so the thread
+             * count scales with the configured worker count instead of with the number of tasks. A step of a task
+             * never runs concurrently with another step of the same task.
+             *
+             * Steps should not block for long, a blocked step holds on to its worker thread.
+             */
+            class AWS_API_EXPORT Executor {
+            public:
+                /**
+                 * @brief Define a type for task step functions
+                 *
+                 * Returns the delay before the next step, a negative delay finishes the task and ParkedStepDelay()
+                 * parks it until it is woken up
+                 */
+                typedef std::function<std::chrono::microseconds()> TaskStepPtr;
+
+                /**
+                 * @brief Step delay that parks a task
+                 *
+                 * The next step of a parked task only runs once it is woken up by Wake or by its watched descriptor
+                 *
+                 * @return std::chrono::microseconds delay to return from the step function
+                 */
+                static std::chrono::microseconds ParkedStepDelay() { return std::chrono::microseconds::max(); }
+
+                /**
+                 * @brief Handle to a scheduled task
+                 *
+                 * State is only accessed by the Executor, with the executor lock held
+                 */
+                class Task {
+                protected:
+                    friend class Executor;
+                    friend class EventLoop;
+
+                    TaskStepPtr p_step_;                            ///< Step function
+                    std::chrono::steady_clock::time_point due_;     ///< Time the next step is due at
+                    uint64_t generation_;                           ///< Incremented whenever due_ changes, invalidates old ready queue entries
+                    bool is_queued_;                                ///< Whether the task is waiting in the ready queue
+                    bool is_running_;                               ///< Whether a step is currently running
+                    bool is_wake_requested_;                        ///< Whether Wake was called while a step was running
+                    bool is_finished_;                              ///< Whether the task was cancelled or returned a negative delay
+                    std::thread::id running_thread_id_;             ///< Worker running the current step
+                    int watched_descriptor_;                        ///< Descriptor watched for this task, -1 for none
+                    std::atomic_bool is_descriptor_ready_;          ///< Set when the watched descriptor became readable
+
+                public:
+                    Task() : generation_(0), is_queued_(false), is_running_(false), is_wake_requested_(false),
+                             is_finished_(false), watched_descriptor_(-1), is_descriptor_ready_(false) {
+                    }
+
+                    /**
+                     * @brief Check and clear whether the watched descriptor became readable since the last call
+                     *
+                     * Lets a step tell a wake up caused by its descriptor apart from one caused by its delay
+                     *
+                     * @return boolean indicating whether the descriptor became readable
+                     */
+                    bool TakeDescriptorReady() { return is_descriptor_ready_.exchange(false); }
+                };
+
+            protected:
+                /**
+                 * @brief Ready queue entry, stale if the generation no longer matches the task's
+                 */
+                class QueueEntry {
+                public:
+                    std::chrono::steady_clock::time_point due_;
+                    uint64_t generation_;
+                    std::shared_ptr<Task> p_task_;
+
+                    bool operator>(const QueueEntry &other) const { return due_ > other.due_; }
+                };
+
+                ExecutorConfig config_;                           ///< Executor configuration
+                std::mutex executor_lock_;                        ///< Mutex protecting the ready queue and task state
+                std::condition_variable work_wait_;               ///< Condition variable used to wake up idle workers
+                std::condition_variable step_done_wait_;          ///< Condition variable used to wait for running steps in Cancel
+                util::Vector<QueueEntry> ready_queue_;            ///< Min heap of due tasks, ordered by due time
+                size_t task_count_;                               ///< Number of scheduled tasks that are not finished
+                bool is_stopping_;                                ///< Whether workers should exit
+#if defined(__linux__)
+                util::Vector<pthread_t> worker_threads_;          ///< Worker threads
+#else
+                util::Vector<std::thread> worker_threads_;        ///< Worker threads
+#endif
+
+                /**
+                 * @brief Constructor, worker threads are started separately by StartWorkers
+                 *
+                 * @param config - Executor configuration
+                 */
+                explicit Executor(const ExecutorConfig &config);
+
+                /**
+                 * @brief Start the configured number of worker threads
+                 *
+                 * Not done by the constructor, workers call virtual functions that derived classes may override
+                 */
+                void StartWorkers();
+
+                /**
+                 * @brief Stop and join the worker threads. Safe to call more than once
+                 *
+                 * Derived classes that override the wait functions must call this from their destructor
+                 */
+                void StopWorkers();
+
+                /**
+                 * @brief Add a task to the ready queue. Call with the executor lock held
+                 *
+                 * @param p_task - Task to queue
+                 * @param due - Time the next step is due at
+                 */
+                void Enqueue(const std::shared_ptr<Task> &p_task, std::chrono::steady_clock::time_point due);
+
+                /**
+                 * @brief Run the next step of a task as soon as possible. Call with the executor lock held
+                 *
+                 * @param p_task - Task to wake up
+                 */
+                void WakeLocked(const std::shared_ptr<Task> &p_task);
+
+                /**
+                 * @brief Block an idle worker until it is notified or the next step is due
+                 *
+                 * Called with the executor lock held, which may be released while waiting
+                 *
+                 * @param executor_lock - Held executor lock
+                 * @param has_due - Whether there is a queued step
+                 * @param due - Time the next queued step is due at, only valid if has_due is set
+                 */
+                virtual void WaitForWork(std::unique_lock<std::mutex> &executor_lock, bool has_due,
+                                         std::chrono::steady_clock::time_point due);
+
+                /**
+                 * @brief Wake up idle workers. Called with the executor lock held
+                 *
+                 * @param notify_all - Wake up all workers instead of one
+                 */
+                virtual void NotifyWork(bool notify_all);
+
+                /**
+                 * @brief Called with the executor lock held once a task is finished, before its step is released
+                 *
+                 * @param p_task - Finished task
+                 */
+                virtual void OnTaskFinished(const std::shared_ptr<Task> &p_task);
+
+                /**
+                 * @brief Worker thread loop
+                 */
+                void RunWorker();
+
+#if defined(__linux__)
+                /**
+                 * @brief pthread entry point, runs RunWorker
+                 *
+                 * @param p_executor - Executor instance
+                 */
+                static void *RunWorkerThread(void *p_executor);
+#endif
+
+            public:
+                // Rule of 5 stuff
+                // Contains threads and synchronization primitives, should not be moved or copied
+                Executor() = delete;                                // Delete Default constructor
+                Executor(const Executor &) = delete;                // Delete Copy constructor
+                Executor(Executor &&) = delete;                     // Delete Move constructor
+                Executor &operator=(const Executor &) & = delete;   // Delete Copy assignment operator
+                Executor &operator=(Executor &&) & = delete;        // Delete Move assignment operator
+
+                /**
+                 * @brief Destructor, stops and joins the worker threads. Pending steps are not run
+                 */
+                virtual ~Executor();
+
+                /**
+                 * @brief Create factory method
+                 *
+                 * @param config - Executor configuration
+                 * @return std::shared_ptr<Executor> new executor, nullptr if no worker thread could be started
+                 */
+                static std::shared_ptr<Executor> Create(const ExecutorConfig &config);
+
+                /**
+                 * @brief Schedule a new task
+                 *
+                 * @param p_step - Step function of the task
+                 * @param initial_delay - Delay before the first step, ParkedStepDelay() to wait until it is woken up
+                 * @return std::shared_ptr<Task> handle to the task, nullptr if p_step is null
+                 */
+                std::shared_ptr<Task> Schedule(TaskStepPtr p_step, std::chrono::microseconds initial_delay);
+
+                /**
+                 * @brief Run the next step of a task as soon as possible
+                 *
+                 * If a step is currently running, the next step runs right after it without waiting for the returned
+                 * delay. Has no effect on finished tasks.
+                 *
+                 * @param p_task - Task to wake up
+                 */
+                void Wake(const std::shared_ptr<Task> &p_task);
+
+                /**
+                 * @brief Cancel a task
+                 *
+                 * Waits for a currently running step to return unless called from that step. No further steps are
+                 * run and the step function is released once this returns.
+                 *
+                 * @param p_task - Task to cancel
+                 */
+                void Cancel(const std::shared_ptr<Task> &p_task);
+
+                /**
+                 * @brief Run the next step of a task whenever a descriptor becomes readable
+                 *
+                 * The watch is one shot, once the descriptor has woken the task it has to be watched again. Calling
+                 * this again re-arms the watch or moves it to a different descriptor, a task watches at most one
+                 * descriptor. The watch is removed when the task finishes. The base Executor cannot wait for
+                 * descriptors, tasks have to keep polling in that case.
+                 *
+                 * @param p_task - Task to wake up
+                 * @param descriptor - Descriptor to watch for read readiness
+                 * @return boolean indicating whether the descriptor is now being watched
+                 */
+                virtual bool Watch(const std::shared_ptr<Task> &p_task, int descriptor);
+
+                /**
+                 * @brief Stop watching the descriptor of a task, if any
+                 *
+                 * @param p_task - Task to stop watching for
+                 */
+                virtual void Unwatch(const std::shared_ptr<Task> &p_task);
+
+                /**
+                 * @brief Get number of worker threads
+                 * @return size_t count
+                 */
+                size_t GetWorkerCount();
+
+                /**
+                 * @brief Get number of tasks that are scheduled and not finished
+                 * @return size_t count
+                 */
+                size_t GetTaskCount();
+            };
+        }
+    }
+}
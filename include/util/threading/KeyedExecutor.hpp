@@ -0,0 +1,185 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/**
+ * @file KeyedExecutor.hpp
+ * @brief Runs work items on an Executor, in order for items with the same key
+ *
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "util/Core_EXPORTS.hpp"
+#include "util/memory/stl/String.hpp"
+#include "util/memory/stl/Vector.hpp"
+#include "util/threading/Executor.hpp"
+
+/**
+ * Maximum number of work items a shard runs in a single Executor step before giving other tasks a turn
+ */
+#ifndef DEFAULT_KEYED_EXECUTOR_MAX_ITEMS_PER_STEP
+#define DEFAULT_KEYED_EXECUTOR_MAX_ITEMS_PER_STEP 64
+#endif
+
+namespace awsiotsdk {
+    namespace util {
+        namespace Threading {
+            /**
+             * @brief Keyed Executor Class
+             *
+             * Work items are assigned to a fixed number of shards by hashing their key. Each shard is a task on an
+             * Executor that runs its items one after the other, so items with the same key run in the order they
+             * were submitted while items of different shards run in parallel on the Executor's workers.
+             *
+             * Every shard queues at most a configured number of items. Submit blocks while the shard of the key is
+             * full, which applies backpressure to the submitting thread instead of dropping items. TrySubmit returns
+             * instead, for tasks of the same Executor, eg. Client Core runners sharing it: a worker blocked in Submit
+             * could be the one the full shard needs to make room.
+             */
+            class AWS_API_EXPORT KeyedExecutor {
+            public:
+                /**
+                 * @brief Define a type for work items
+                 */
+                typedef std::function<void()> WorkItemPtr;
+
+            protected:
+                /**
+                 * @brief Queue of a single shard, run by its own Executor task
+                 */
+                class Shard {
+                public:
+                    std::mutex shard_lock_;                         ///< Guards the queue
+                    std::condition_variable not_full_wait_;         ///< Wakes up submitters waiting for space
+                    std::deque<WorkItemPtr> queue_;                 ///< Items waiting to be run
+                    std::shared_ptr<Executor::Task> p_task_;        ///< Task running the items
+                    bool is_stopping_;                              ///< Set once the destructor starts, rejects new items
+
+                    Shard() : is_stopping_(false) {}
+                };
+
+                std::shared_ptr<Executor> p_executor_;              ///< Executor the shards run on
+                util::Vector<std::unique_ptr<Shard>> shards_;       ///< Shards, indexed by key hash
+                size_t max_queue_depth_;                            ///< Maximum number of queued items per shard
+
+                /**
+                 * @brief Constructor, shard tasks are scheduled separately
+                 *
+                 * @param p_executor - Executor the shards run on
+                 * @param shard_count - Number of shards
+                 * @param max_queue_depth - Maximum number of queued items per shard
+                 */
+                KeyedExecutor(std::shared_ptr<Executor> p_executor, size_t shard_count, size_t max_queue_depth);
+
+                /**
+                 * @brief Run queued items of a shard as an Executor task step
+                 *
+                 * @param p_shard - Shard to run items for
+                 * @return std::chrono::microseconds - 0 if more items are queued, otherwise a long delay, Submit
+                 * wakes the task up early
+                 */
+                static std::chrono::microseconds RunShardStep(Shard *p_shard);
+
+                /**
+                 * @brief Get the shard of a key
+                 *
+                 * @param key - Key of an item
+                 * @return Shard * - shard
+                 */
+                Shard *GetShard(const util::String &key);
+
+            public:
+                // Rule of 5 stuff
+                // Contains synchronization primitives shared with the Executor tasks, should not be moved or copied
+                KeyedExecutor() = delete;                                        // Delete Default constructor
+                KeyedExecutor(const KeyedExecutor &) = delete;                   // Delete Copy constructor
+                KeyedExecutor(KeyedExecutor &&) = delete;                        // Delete Move constructor
+                KeyedExecutor &operator=(const KeyedExecutor &) & = delete;      // Delete Copy assignment operator
+                KeyedExecutor &operator=(KeyedExecutor &&) & = delete;           // Delete Move assignment operator
+
+                /**
+                 * @brief Destructor, cancels the shard tasks. Queued items are not run
+                 */
+                ~KeyedExecutor();
+
+                /**
+                 * @brief Create factory method
+                 *
+                 * @param p_executor - Executor to run the shards on, may be shared with Client Core instances
+                 * @param shard_count - Number of shards, items of up to this many keys run in parallel
+                 * @param max_queue_depth - Maximum number of queued items per shard
+                 * @return std::shared_ptr<KeyedExecutor> - new keyed executor, nullptr if p_executor is null or either
+                 * count is 0
+                 */
+                static std::shared_ptr<KeyedExecutor> Create(std::shared_ptr<Executor> p_executor, size_t shard_count,
+                                                             size_t max_queue_depth);
+
+                /**
+                 * @brief Queue a work item, blocking while the shard of the key is full
+                 *
+                 * Must not be called from a work item or from another task of the Executor the shards run on, a full
+                 * shard could then never make room. Use TrySubmit there
+                 *
+                 * @param key - Key of the item, items with the same key run in submission order
+                 * @param p_work_item - Item to run
+                 * @return boolean indicating whether the item was queued, false if it is null or the keyed executor
+                 * is being destroyed
+                 */
+                bool Submit(const util::String &key, WorkItemPtr p_work_item);
+
+                /**
+                 * @brief Queue a work item if the shard of the key has room, without blocking
+                 *
+                 * @param key - Key of the item, items with the same key run in submission order
+                 * @param p_work_item - Item to run, only moved from if it was queued
+                 * @return boolean indicating whether the item was queued, false if the shard is full, the item is null
+                 * or the keyed executor is being destroyed
+                 */
+                bool TrySubmit(const util::String &key, WorkItemPtr &p_work_item);
+
+                /**
+                 * @brief Get number of shards
+                 * @return size_t count
+                 */
+                size_t GetShardCount() const { return shards_.size(); }
+
+                /**
+                 * @brief Get the index of the shard items with a key are run on
+                 *
+                 * @param key - Key of an item
+                 * @return size_t index, less than GetShardCount()
+                 */
+                size_t GetShardIndex(const util::String &key) const {
+                    return std::hash<util::String>()(key) % shards_.size();
+                }
+
+                size_t GetMaxQueueDepth() const { return max_queue_depth_; }
+
+                /**
+                 * @brief Get number of items queued across all shards, not counting running items
+                 * @return size_t count
+                 */
+                size_t GetQueuedCount();
+            };
+        }
+    }
+}
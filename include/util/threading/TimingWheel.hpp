@@ -0,0 +1,173 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TimingWheel.hpp
+ * @brief Hierarchical timing wheel for tracking large numbers of timeouts
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "util/Core_EXPORTS.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+#define TIMING_WHEEL_LEVEL_BITS 6
+#define TIMING_WHEEL_LEVEL_COUNT 4
+
+namespace awsiotsdk {
+    namespace util {
+        namespace Threading {
+            /**
+             * @brief Hierarchical Timing Wheel
+             *
+             * Tracks timeouts for a fixed range of entry ids [0, capacity). Time is measured in ticks, the caller
+             * decides what a tick is. Each level has 64 slots, level 0 slots are one tick wide, level 1 slots are
+             * 64 ticks wide and so on. Entries are moved to a lower level when the wheel reaches their slot, so
+             * schedule and cancel are O(1) and advancing costs O(1) per tick plus O(1) per expired or cascaded
+             * entry. Buckets are intrusive doubly linked lists over a preallocated node array, so scheduling does
+             * not allocate.
+             *
+             * Timeouts further out than the range of the wheel (2^24 ticks) are clamped to it.
+             * This class is not thread safe, callers must provide synchronization.
+             */
+            class TimingWheel {
+            public:
+                typedef uint64_t Tick;
+
+                /**
+                 * @brief Handler called for each expired entry
+                 */
+                typedef std::function<void(size_t entry_id)> ExpiryHandlerPtr;
+
+            protected:
+                static const size_t SLOTS_PER_LEVEL = 1 << TIMING_WHEEL_LEVEL_BITS;
+                static const size_t SLOT_MASK = SLOTS_PER_LEVEL - 1;
+                static const size_t BUCKET_COUNT = SLOTS_PER_LEVEL * TIMING_WHEEL_LEVEL_COUNT;
+                static const size_t OVERDUE_BUCKET = BUCKET_COUNT;  ///< Extra bucket for entries scheduled in the past
+                static const uint32_t INVALID_INDEX = UINT32_MAX;
+
+                /**
+                 * @brief Intrusive list node, one per entry id
+                 */
+                struct Node {
+                    uint32_t next_;    ///< Next node in bucket, INVALID_INDEX if last
+                    uint32_t prev_;    ///< Previous node in bucket, INVALID_INDEX if first
+                    uint32_t bucket_;  ///< Bucket the node is linked in, INVALID_INDEX if not scheduled
+                    Tick expiry_;      ///< Tick at which the entry expires
+                };
+
+                util::Vector<Node> nodes_;              ///< Node per entry id
+                util::Vector<uint32_t> bucket_heads_;   ///< First node of each bucket, level major, plus overdue bucket
+                Tick current_tick_;                     ///< Next tick to be processed
+                size_t scheduled_count_;                ///< Number of currently scheduled entries
+                util::Vector<uint32_t> expired_;        ///< Scratch list of expired entries, reused between calls
+
+                void Link(uint32_t entry_id, uint32_t bucket);
+
+                void Unlink(uint32_t entry_id);
+
+                /**
+                 * @brief Place a node in the bucket matching its expiry relative to the current tick
+                 */
+                void Place(uint32_t entry_id);
+
+                /**
+                 * @brief Move all nodes of a higher level slot down to lower levels
+                 * @return true if the slot index was 0, meaning the next level has to be cascaded as well
+                 */
+                bool Cascade(size_t level);
+
+            public:
+                /**
+                 * @brief Constructor
+                 *
+                 * @param capacity - Number of entry ids supported, valid ids are [0, capacity)
+                 * @param start_tick - Tick the wheel starts at
+                 */
+                TimingWheel(size_t capacity, Tick start_tick);
+
+                // Rule of 5 stuff
+                // Disabling default constructor while keeping defaults for the rest
+                TimingWheel() = delete;                                   // Delete Default constructor
+                TimingWheel(const TimingWheel &) = default;               // Copy constructor
+                TimingWheel(TimingWheel &&) = default;                    // Move constructor
+                TimingWheel &operator=(const TimingWheel &) & = default;  // Copy assignment operator
+                TimingWheel &operator=(TimingWheel &&) & = default;       // Move assignment operator
+                ~TimingWheel() = default;                                 // Default destructor
+
+                /**
+                 * @brief Schedule an entry. An already scheduled entry is rescheduled
+                 *
+                 * @param entry_id - Id of the entry, must be less than capacity
+                 * @param expiry - Tick at which the entry should expire. Ticks in the past expire on next Advance
+                 * @return false if entry_id is out of range
+                 */
+                bool Schedule(size_t entry_id, Tick expiry);
+
+                /**
+                 * @brief Cancel a scheduled entry. Does nothing if the entry is not scheduled
+                 *
+                 * @param entry_id - Id of the entry
+                 */
+                void Cancel(size_t entry_id);
+
+                /**
+                 * @brief Check whether an entry is currently scheduled
+                 *
+                 * @param entry_id - Id of the entry
+                 * @return boolean indicating whether the entry is scheduled
+                 */
+                bool IsScheduled(size_t entry_id) const;
+
+                /**
+                 * @brief Advance the wheel, expiring all entries with an expiry tick <= now
+                 *
+                 * Expired entries are unscheduled before the handler is called, the handler may schedule
+                 * entries again.
+                 *
+                 * @param now - Current tick
+                 * @param expiry_handler - Called once for each expired entry
+                 * @return size_t number of expired entries
+                 */
+                size_t Advance(Tick now, const ExpiryHandlerPtr &expiry_handler);
+
+            protected:
+                /**
+                 * @brief Unschedule all nodes of a bucket and append them to the expired list
+                 */
+                void ExpireBucket(size_t bucket);
+
+            public:
+
+                /**
+                 * @brief Get number of currently scheduled entries
+                 * @return size_t count
+                 */
+                size_t Size() const { return scheduled_count_; }
+
+                /**
+                 * @brief Get number of entry ids supported
+                 * @return size_t capacity
+                 */
+                size_t Capacity() const { return nodes_.size(); }
+            };
+        }
+    }
+}
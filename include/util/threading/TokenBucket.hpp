@@ -0,0 +1,117 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TokenBucket.hpp
+ * @brief Token bucket rate limiter used to pace Client Core threads
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+
+#include "util/Core_EXPORTS.hpp"
+
+namespace awsiotsdk {
+    namespace util {
+        namespace Threading {
+            /**
+             * @brief Token Bucket Rate Limiter
+             *
+             * Tokens are added at a sustained rate up to a maximum burst size. Each operation consumes one token.
+             * An idle limiter accumulates up to burst_size tokens, which allows backlogs to be flushed quickly
+             * without exceeding the sustained rate over longer periods. Rate and burst size can be changed at any time
+             * from any thread.
+             */
+            class TokenBucket {
+            public:
+                typedef std::chrono::steady_clock Clock;
+
+            protected:
+                std::mutex bucket_lock_;               ///< Mutex for bucket state
+                double rate_per_second_;               ///< Sustained rate in tokens per second, <= 0 disables limiting
+                size_t burst_size_;                    ///< Maximum number of tokens that can be accumulated
+                double available_tokens_;              ///< Currently available tokens
+                Clock::time_point last_refill_time_;   ///< Last time tokens were added
+
+                /**
+                 * @brief Add tokens accumulated since the last refill. Must be called with bucket_lock_ held
+                 *
+                 * @param now - Current time
+                 */
+                void Refill(Clock::time_point now);
+
+            public:
+                /**
+                 * @brief Constructor
+                 *
+                 * @param rate_per_second - Sustained rate in tokens per second. Values <= 0 disable limiting
+                 * @param burst_size - Maximum number of tokens that can be accumulated. Minimum of 1 is enforced
+                 */
+                TokenBucket(double rate_per_second, size_t burst_size);
+
+                // Rule of 5 stuff
+                // Contains a mutex, should not be moved or copied
+                TokenBucket() = delete;                                   // Delete Default constructor
+                TokenBucket(const TokenBucket &) = delete;                // Delete Copy constructor
+                TokenBucket(TokenBucket &&) = delete;                     // Delete Move constructor
+                TokenBucket &operator=(const TokenBucket &) & = delete;   // Delete Copy assignment operator
+                TokenBucket &operator=(TokenBucket &&) & = delete;        // Delete Move assignment operator
+                ~TokenBucket() = default;                                 // Default destructor
+
+                /**
+                 * @brief Update rate and burst size. Currently available tokens are capped to the new burst size
+                 *
+                 * @param rate_per_second - Sustained rate in tokens per second. Values <= 0 disable limiting
+                 * @param burst_size - Maximum number of tokens that can be accumulated. Minimum of 1 is enforced
+                 */
+                void SetRate(double rate_per_second, size_t burst_size);
+
+                /**
+                 * @brief Get configured sustained rate
+                 * @return double tokens per second
+                 */
+                double GetRate();
+
+                /**
+                 * @brief Get configured burst size
+                 * @return size_t burst size
+                 */
+                size_t GetBurstSize();
+
+                /**
+                 * @brief Attempt to consume one token
+                 *
+                 * @param now - Current time
+                 * @param wait_time_out[out] - If no token is available, time until the next one will be
+                 * @return true if a token was consumed
+                 */
+                bool TryConsume(Clock::time_point now, std::chrono::microseconds &wait_time_out);
+
+                /**
+                 * @brief Attempt to consume one token using the current time
+                 *
+                 * @param wait_time_out[out] - If no token is available, time until the next one will be
+                 * @return true if a token was consumed
+                 */
+                bool TryConsume(std::chrono::microseconds &wait_time_out) {
+                    return TryConsume(Clock::now(), wait_time_out);
+                }
+            };
+        }
+    }
+}
@@ -38,6 +38,9 @@
 
 #define OPENSSL_WRAPPER_LOG_TAG "[OpenSSL Wrapper]"
 
+// Write segments shorter than this are joined with their neighbours instead of being sent in their own TLS record
+#define WRITE_SEGMENT_COALESCE_LIMIT 4096
+
 namespace awsiotsdk {
     namespace network {
         OpenSSLInitializer::~OpenSSLInitializer() {
@@ -110,6 +113,7 @@ namespace awsiotsdk {
         }
 
         int OpenSSLConnection::WaitForSelect(int error_code) {
+#ifdef WIN32
             fd_set socketFds;
             struct timeval timeout = {tls_write_timeout_.tv_sec, tls_write_timeout_.tv_usec};
             FD_ZERO(&socketFds);
@@ -121,6 +125,20 @@ namespace awsiotsdk {
             } else {
                 return 0;
             }
+#else
+            struct pollfd socket_poll_fd;
+            socket_poll_fd.fd = server_tcp_socket_fd_;
+            socket_poll_fd.revents = 0;
+            if (SSL_ERROR_WANT_READ == error_code) {
+                socket_poll_fd.events = POLLIN;
+            } else if (SSL_ERROR_WANT_WRITE == error_code) {
+                socket_poll_fd.events = POLLOUT;
+            } else {
+                return 0;
+            }
+            int timeout_ms = (int) (tls_write_timeout_.tv_sec * 1000 + tls_write_timeout_.tv_usec / 1000);
+            return poll(&socket_poll_fd, 1, timeout_ms);
+#endif
         }
 
         ResponseCode OpenSSLConnection::Initialize() {
@@ -185,6 +203,33 @@ namespace awsiotsdk {
             return is_connected_;
         }
 
+        int OpenSSLConnection::GetPollDescriptor() {
+            return is_connected_ ? server_tcp_socket_fd_ : -1;
+        }
+
+        bool OpenSSLConnection::IsReadPending() {
+            if (!is_connected_) {
+                return true;
+            }
+            if (0 < SSL_pending(p_ssl_handle_)) {
+                return true;
+            }
+#ifdef WIN32
+            fd_set socketFds;
+            struct timeval timeout = {0, 0};
+            FD_ZERO(&socketFds);
+            FD_SET(server_tcp_socket_fd_, &socketFds);
+            return 0 != select(server_tcp_socket_fd_ + 1, &socketFds, NULL, NULL, &timeout);
+#else
+            struct pollfd socket_poll_fd;
+            socket_poll_fd.fd = server_tcp_socket_fd_;
+            socket_poll_fd.events = POLLIN;
+            socket_poll_fd.revents = 0;
+            // Errors and hang ups are reported as pending, the read surfaces them
+            return 0 != poll(&socket_poll_fd, 1, 0);
+#endif
+        }
+
         ResponseCode OpenSSLConnection::ConnectTCPSocket() {
             const char *endpoint_char = endpoint_.c_str();
             if (nullptr == endpoint_char) {
@@ -407,16 +452,68 @@ namespace awsiotsdk {
         }
 
         ResponseCode OpenSSLConnection::WriteInternal(const util::String &buf, size_t &size_written_bytes_out) {
+            size_t total_written_length = 0;
+            ResponseCode rc = WriteBytes(buf.data(), buf.length(), total_written_length);
+            if (ResponseCode::SUCCESS == rc) {
+                size_written_bytes_out = total_written_length;
+            }
+            return rc;
+        }
+
+        ResponseCode OpenSSLConnection::WriteSegmentsInternal(const util::Vector<WriteSegment> &segments,
+                                                              size_t &size_written_bytes_out) {
+            ResponseCode rc = ResponseCode::SUCCESS;
+            size_written_bytes_out = 0;
+            size_t itr = 0;
+            while (ResponseCode::SUCCESS == rc && itr < segments.size()) {
+                // Find the run of segments that fits in one coalesced write
+                size_t run_end = itr;
+                size_t run_length = 0;
+                while (run_end < segments.size()
+                    && run_length + segments[run_end].length_ < WRITE_SEGMENT_COALESCE_LIMIT) {
+                    run_length += segments[run_end].length_;
+                    run_end++;
+                }
+
+                size_t expected_length = 0;
+                size_t written_length = 0;
+                if (run_end - itr <= 1) {
+                    // A single segment, small or large, is written from where it is stored
+                    expected_length = segments[itr].length_;
+                    rc = WriteBytes(segments[itr].p_data_, expected_length, written_length);
+                    itr++;
+                } else {
+                    coalesce_buf_.clear();
+                    for (; itr < run_end; itr++) {
+                        coalesce_buf_.append(segments[itr].p_data_, segments[itr].length_);
+                    }
+                    expected_length = coalesce_buf_.length();
+                    rc = WriteBytes(coalesce_buf_.data(), expected_length, written_length);
+                }
+                size_written_bytes_out += written_length;
+                if (ResponseCode::SUCCESS == rc && written_length != expected_length) {
+                    // Report the partial write, later segments must not be written ahead of the missing bytes
+                    break;
+                }
+            }
+            return rc;
+        }
+
+        ResponseCode OpenSSLConnection::WriteBytes(const char *p_data, size_t length, size_t &size_written_bytes_out) {
             int error_code = 0;
             int select_retCode = -1;
             int cur_written_length = 0;
             size_t total_written_length = 0;
             ResponseCode rc = ResponseCode::SUCCESS;
-            size_t bytes_to_write = buf.length();
+            size_written_bytes_out = 0;
+            if (0 == length) {
+                return rc;
+            }
 
             do {
                 ERR_clear_error();
-                cur_written_length = SSL_write(p_ssl_handle_, buf.c_str(), bytes_to_write);
+                cur_written_length = SSL_write(p_ssl_handle_, p_data + total_written_length,
+                                               (int) (length - total_written_length));
                 error_code = SSL_get_error(p_ssl_handle_, cur_written_length);
                 if (0 < cur_written_length) {
                     total_written_length += (size_t) cur_written_length;
@@ -433,12 +530,9 @@ namespace awsiotsdk {
 
             } while (is_connected_ && ResponseCode::NETWORK_SSL_WRITE_ERROR != rc &&
                 ResponseCode::NETWORK_SSL_WRITE_TIMEOUT_ERROR != rc &&
-                total_written_length < bytes_to_write);
-
-            if (ResponseCode::SUCCESS == rc) {
-                size_written_bytes_out = total_written_length;
-            }
+                total_written_length < length);
 
+            size_written_bytes_out = total_written_length;
             return rc;
         }
 
@@ -483,15 +577,55 @@ namespace awsiotsdk {
                     ResponseCode::NETWORK_SSL_CONNECTION_CLOSED_ERROR == errorStatus) {
                     break;
                 }
-            } while (is_connected_ && total_read_length < size_bytes_to_read);
+            } while (is_connected_ && total_read_length < buf_read_offset + size_bytes_to_read);
 
             if (ResponseCode::SUCCESS == errorStatus) {
-                size_read_bytes_out = total_read_length;
+                size_read_bytes_out = total_read_length - buf_read_offset;
             }
 
             return errorStatus;
         }
 
+        ResponseCode OpenSSLConnection::ReadAvailableInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+                                                              size_t min_bytes_to_read, size_t max_bytes_to_read,
+                                                              size_t &size_read_bytes_out) {
+            size_t total_read_length = 0;
+            ResponseCode errorStatus = ResponseCode::SUCCESS;
+
+            size_read_bytes_out = 0;
+            while (is_connected_ && total_read_length < max_bytes_to_read) {
+                ERR_clear_error();
+                int cur_read_len = SSL_read(p_ssl_handle_, &buf[buf_read_offset + total_read_length],
+                                            (int) (max_bytes_to_read - total_read_length));
+                if (0 < cur_read_len) {
+                    total_read_length += (size_t) cur_read_len;
+                    continue;
+                }
+
+                int ssl_retcode = SSL_get_error(p_ssl_handle_, cur_read_len);
+                if (SSL_ERROR_WANT_READ == ssl_retcode) {
+                    // Everything available has been read, only wait if the request is not met yet
+                    if (total_read_length >= min_bytes_to_read) {
+                        break;
+                    }
+                    int select_retCode = WaitForSelect(SSL_ERROR_WANT_READ);
+                    if (0 < select_retCode) {
+                        continue;
+                    }
+                    errorStatus = (0 == select_retCode) ? ResponseCode::NETWORK_SSL_NOTHING_TO_READ
+                                                        : ResponseCode::NETWORK_SSL_READ_ERROR;
+                } else if (SSL_ERROR_ZERO_RETURN == ssl_retcode) {
+                    errorStatus = ResponseCode::NETWORK_SSL_CONNECTION_CLOSED_ERROR;
+                } else {
+                    errorStatus = ResponseCode::NETWORK_SSL_READ_ERROR;
+                }
+                break;
+            }
+
+            size_read_bytes_out = total_read_length;
+            return errorStatus;
+        }
+
         ResponseCode OpenSSLConnection::DisconnectInternal() {
             if (!is_connected_) {
                 return ResponseCode::SUCCESS;
@@ -504,16 +638,21 @@ namespace awsiotsdk {
             std::unique_lock<std::mutex> shutdown_lock(clean_shutdown_action_lock_);
 
             // TODO: add config for disconnect timeout
-            // wait for tls_read_timeout and then exit the shutdown loop if it is not successful
-            this->shutdown_timeout_condition_.wait_for(shutdown_lock, std::chrono::milliseconds(timeout), [this] {
+            // Retry until the peer's close_notify arrives, an error occurs or tls_read_timeout expires. Waits on the
+            // socket between attempts, the shutdown returns as soon as the peer answers
+            std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+            while (true) {
                 int rc = SSL_shutdown(p_ssl_handle_);
                 if (1 == rc) {
-                    return true;
+                    break;
+                }
+                // 0 means our close_notify was sent and the peer's has not been received yet
+                int errorCode = (0 == rc) ? SSL_ERROR_WANT_READ : SSL_get_error(p_ssl_handle_, rc);
+                if ((SSL_ERROR_WANT_READ != errorCode && SSL_ERROR_WANT_WRITE != errorCode)
+                    || std::chrono::steady_clock::now() >= deadline || 0 >= WaitForSelect(errorCode)) {
+                    break;
                 }
-                int errorCode = SSL_get_error(p_ssl_handle_, rc);
-                WaitForSelect(errorCode);
-                return false;
-            });
+            }
 
             SSL_free(p_ssl_handle_);
 #if OPENSSL_VERSION_NUMBER >= 0x10002000L && OPENSSL_VERSION_NUMBER < 0x10100000L
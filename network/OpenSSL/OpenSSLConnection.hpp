@@ -28,6 +28,7 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <sys/select.h>
+#include <poll.h>
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <netdb.h>
@@ -36,7 +37,7 @@
 #endif
 
 #include <atomic>
-#include <condition_variable>
+#include <mutex>
 #include <openssl/ssl.h>
 #include <openssl/err.h>
 #include <openssl/pem.h>
@@ -104,14 +105,18 @@ namespace awsiotsdk {
 
             bool certificates_read_flag_;
 
+            util::String coalesce_buf_;                 ///< Joins small write segments, used with the write lock held
+
             std::mutex clean_shutdown_action_lock_;
-            std::condition_variable shutdown_timeout_condition_;
 
             /**
              * @brief Wait for socket FDs to become ready for read or write operations
              *
              * It is assumed that this function will be called only on SSL_ERROR_WANT_READ or SSL_ERROR_WANT_WRITE
              *
+             * Uses poll on POSIX platforms, select cannot handle descriptors at or above FD_SETSIZE which are common
+             * when a process holds many connections
+             *
              * @param error_code - error generated by preceding socket operation
              * @return int - return code of the select operation
              */
@@ -169,6 +174,29 @@ namespace awsiotsdk {
              */
             ResponseCode WriteInternal(const util::String &buf, size_t &size_written_bytes_out);
 
+            /**
+             * @brief Write segments to the network socket
+             *
+             * Runs of small segments are joined so they are sent in one TLS record, larger segments are encrypted
+             * directly from where they are stored.
+             *
+             * @param util::Vector<WriteSegment> - segments to write, in order
+             * @param size_t - reference to store number of bytes written
+             * @return ResponseCode - successful write or Network error code
+             */
+            ResponseCode WriteSegmentsInternal(const util::Vector<WriteSegment> &segments,
+                                               size_t &size_written_bytes_out);
+
+            /**
+             * @brief Write a contiguous range of bytes to the network socket
+             *
+             * @param p_data - first byte to write
+             * @param length - number of bytes to write
+             * @param size_written_bytes_out - number of bytes written, set even if an error is returned
+             * @return ResponseCode - successful write or Network error code
+             */
+            ResponseCode WriteBytes(const char *p_data, size_t length, size_t &size_written_bytes_out);
+
             /**
              * @brief Read bytes from the network socket
              *
@@ -180,6 +208,23 @@ namespace awsiotsdk {
             ResponseCode ReadInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
                                       size_t size_bytes_to_read, size_t &size_read_bytes_out);
 
+            /**
+             * @brief Read the bytes that are available from the network socket
+             *
+             * Calls SSL_read until it would block, waiting on the socket only while fewer than min_bytes_to_read bytes
+             * have been read
+             *
+             * @param util::Vector<unsigned char> - reference to buffer where read bytes should be copied
+             * @param size_t - offset in the buffer to copy the read bytes to
+             * @param size_t - minimum number of bytes to read
+             * @param size_t - maximum number of bytes to read
+             * @param size_t - reference to store number of bytes read, also set on error
+             * @return ResponseCode - successful read or TLS error code
+             */
+            ResponseCode ReadAvailableInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+                                               size_t min_bytes_to_read, size_t max_bytes_to_read,
+                                               size_t &size_read_bytes_out);
+
             /**
              * @brief Disconnect from network socket
              *
@@ -271,6 +316,20 @@ namespace awsiotsdk {
              */
             bool IsPhysicalLayerConnected();
 
+            /**
+             * @brief Get the TCP socket descriptor
+             *
+             * @return int - socket descriptor, -1 if the TLS layer is not connected
+             */
+            int GetPollDescriptor();
+
+            /**
+             * @brief Check whether the socket or the TLS layer has data to read
+             *
+             * @return bool - true if decrypted data is buffered or the socket is readable
+             */
+            bool IsReadPending();
+
             virtual ~OpenSSLConnection();
         };
     }
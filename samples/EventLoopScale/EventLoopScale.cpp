@@ -0,0 +1,589 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file EventLoopScale.cpp
+ * @brief Benchmark driving many MQTT connections from one event loop thread against a local TLS stand-in broker
+ *
+ * Usage : event-loop-scale-sample [client_count] [messages_per_client] [loop|threads]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509v3.h>
+
+#include "OpenSSLConnection.hpp"
+
+#include "util/logging/Logging.hpp"
+#include "util/logging/LogMacros.hpp"
+#include "util/logging/ConsoleLogSystem.hpp"
+
+#include "EventLoopScale.hpp"
+
+#define LOG_TAG_EVENT_LOOP_SCALE "[Sample - EventLoopScale]"
+
+#define DEFAULT_CLIENT_COUNT 500
+#define DEFAULT_MESSAGES_PER_CLIENT 20
+
+#define BROKER_LISTEN_BACKLOG 1024
+#define BROKER_MAX_EPOLL_EVENTS 256
+#define BROKER_READ_CHUNK_SIZE 4096
+#define BROKER_WRITE_TIMEOUT_MS 1000
+
+#define CLIENT_TLS_TIMEOUT_MS 5000
+#define CLIENT_MQTT_COMMAND_TIMEOUT_MS 20000
+#define CLIENT_KEEP_ALIVE_SECS 60
+#define CLIENT_OUTBOUND_RATE_LIMIT_HZ 100000
+#define CLIENT_OUTBOUND_BURST_SIZE 100
+
+#define BENCHMARK_TOPIC_PREFIX "bench/"
+#define BENCHMARK_PAYLOAD "{\"value\":12345}"
+
+namespace awsiotsdk {
+    namespace samples {
+        TlsStandInBroker::TlsStandInBroker() {
+            p_ssl_context_ = nullptr;
+            listen_fd_ = -1;
+            epoll_fd_ = -1;
+            stop_fd_ = -1;
+            port_ = 0;
+            received_publish_count_ = 0;
+        }
+
+        TlsStandInBroker::~TlsStandInBroker() {
+            Stop();
+        }
+
+        ResponseCode TlsStandInBroker::Start(const util::String &cert_path, const util::String &key_path) {
+            p_ssl_context_ = SSL_CTX_new(SSLv23_server_method());
+            if (nullptr == p_ssl_context_
+                || 1 != SSL_CTX_use_certificate_chain_file(p_ssl_context_, cert_path.c_str())
+                || 1 != SSL_CTX_use_PrivateKey_file(p_ssl_context_, key_path.c_str(), SSL_FILETYPE_PEM)) {
+                AWS_LOG_ERROR(LOG_TAG_EVENT_LOOP_SCALE, "Unable to set up broker TLS context");
+                return ResponseCode::NETWORK_SSL_INIT_ERROR;
+            }
+
+            listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (0 > listen_fd_) {
+                return ResponseCode::NETWORK_TCP_SETUP_ERROR;
+            }
+            int reuse_addr = 1;
+            setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse_addr, sizeof(reuse_addr));
+
+            struct sockaddr_in listen_addr;
+            memset(&listen_addr, 0, sizeof(listen_addr));
+            listen_addr.sin_family = AF_INET;
+            listen_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            listen_addr.sin_port = 0;
+            socklen_t addr_len = sizeof(listen_addr);
+            if (0 != bind(listen_fd_, (struct sockaddr *) &listen_addr, sizeof(listen_addr))
+                || 0 != listen(listen_fd_, BROKER_LISTEN_BACKLOG)
+                || 0 != getsockname(listen_fd_, (struct sockaddr *) &listen_addr, &addr_len)) {
+                AWS_LOG_ERROR(LOG_TAG_EVENT_LOOP_SCALE, "Unable to listen on loopback. Error : %d", errno);
+                return ResponseCode::NETWORK_TCP_SETUP_ERROR;
+            }
+            port_ = ntohs(listen_addr.sin_port);
+
+            epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+            stop_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (0 > epoll_fd_ || 0 > stop_fd_) {
+                return ResponseCode::NETWORK_TCP_SETUP_ERROR;
+            }
+            struct epoll_event watch_event;
+            watch_event.events = EPOLLIN;
+            watch_event.data.fd = listen_fd_;
+            epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &watch_event);
+            watch_event.data.fd = stop_fd_;
+            epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, stop_fd_, &watch_event);
+
+            broker_thread_ = std::thread(&TlsStandInBroker::Run, this);
+            return ResponseCode::SUCCESS;
+        }
+
+        void TlsStandInBroker::Stop() {
+            if (broker_thread_.joinable()) {
+                uint64_t stop_count = 1;
+                ssize_t write_count = write(stop_fd_, &stop_count, sizeof(stop_count));
+                IOT_UNUSED(write_count);
+                broker_thread_.join();
+            }
+
+            while (!sessions_.empty()) {
+                CloseSession(sessions_.begin()->first);
+            }
+            if (0 <= stop_fd_) {
+                close(stop_fd_);
+                stop_fd_ = -1;
+            }
+            if (0 <= epoll_fd_) {
+                close(epoll_fd_);
+                epoll_fd_ = -1;
+            }
+            if (0 <= listen_fd_) {
+                close(listen_fd_);
+                listen_fd_ = -1;
+            }
+            if (nullptr != p_ssl_context_) {
+                SSL_CTX_free(p_ssl_context_);
+                p_ssl_context_ = nullptr;
+            }
+        }
+
+        void TlsStandInBroker::Run() {
+            struct epoll_event events[BROKER_MAX_EPOLL_EVENTS];
+            while (true) {
+                int event_count = epoll_wait(epoll_fd_, events, BROKER_MAX_EPOLL_EVENTS, -1);
+                for (int itr = 0; itr < event_count; itr++) {
+                    int descriptor = events[itr].data.fd;
+                    if (descriptor == stop_fd_) {
+                        return;
+                    } else if (descriptor == listen_fd_) {
+                        Accept();
+                    } else {
+                        HandleSession(descriptor);
+                    }
+                }
+            }
+        }
+
+        void TlsStandInBroker::Accept() {
+            while (true) {
+                int session_fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if (0 > session_fd) {
+                    return;
+                }
+
+                // Acks are written one at a time, do not let Nagle hold them back
+                int no_delay = 1;
+                setsockopt(session_fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+
+                std::unique_ptr<Session> p_session = std::unique_ptr<Session>(new Session());
+                p_session->p_ssl_ = SSL_new(p_ssl_context_);
+                p_session->is_handshake_done_ = false;
+                SSL_set_fd(p_session->p_ssl_, session_fd);
+                SSL_set_accept_state(p_session->p_ssl_);
+                sessions_[session_fd] = std::move(p_session);
+
+                struct epoll_event watch_event;
+                watch_event.events = EPOLLIN;
+                watch_event.data.fd = session_fd;
+                epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, session_fd, &watch_event);
+            }
+        }
+
+        void TlsStandInBroker::CloseSession(int session_fd) {
+            util::Map<int, std::unique_ptr<Session>>::iterator session_itr = sessions_.find(session_fd);
+            if (sessions_.end() == session_itr) {
+                return;
+            }
+            epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, session_fd, nullptr);
+            if (session_itr->second->is_handshake_done_) {
+                // Best effort close_notify, the client would otherwise wait for it until its TLS timeout
+                SSL_shutdown(session_itr->second->p_ssl_);
+            }
+            SSL_free(session_itr->second->p_ssl_);
+            close(session_fd);
+            sessions_.erase(session_itr);
+        }
+
+        bool TlsStandInBroker::WriteToSession(Session &session, const unsigned char *p_data, size_t data_len) {
+            size_t written_len = 0;
+            while (written_len < data_len) {
+                int write_rc = SSL_write(session.p_ssl_, p_data + written_len, (int) (data_len - written_len));
+                if (0 < write_rc) {
+                    written_len += (size_t) write_rc;
+                    continue;
+                }
+
+                // Acks are tiny, the socket buffer is rarely full. Waiting here keeps the broker simple
+                int error_code = SSL_get_error(session.p_ssl_, write_rc);
+                if (SSL_ERROR_WANT_WRITE != error_code && SSL_ERROR_WANT_READ != error_code) {
+                    return false;
+                }
+                struct pollfd session_poll_fd;
+                session_poll_fd.fd = SSL_get_fd(session.p_ssl_);
+                session_poll_fd.events = (SSL_ERROR_WANT_WRITE == error_code) ? POLLOUT : POLLIN;
+                session_poll_fd.revents = 0;
+                if (0 >= poll(&session_poll_fd, 1, BROKER_WRITE_TIMEOUT_MS)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool TlsStandInBroker::HandlePacket(Session &session, unsigned char fixed_header_byte,
+                                            const unsigned char *p_body, size_t body_len) {
+            unsigned char packet_type = (unsigned char) ((fixed_header_byte >> 4) & 0x0F);
+            switch (packet_type) {
+                case 1: {
+                    // CONNECT, always accepted without a session
+                    const unsigned char connack[] = {0x20, 0x02, 0x00, 0x00};
+                    return WriteToSession(session, connack, sizeof(connack));
+                }
+                case 3: {
+                    // PUBLISH, QoS1 and QoS2 are both answered with a PUBACK
+                    received_publish_count_++;
+                    unsigned char qos = (unsigned char) ((fixed_header_byte >> 1) & 0x03);
+                    if (0 == qos) {
+                        return true;
+                    }
+                    if (2 > body_len) {
+                        return false;
+                    }
+                    size_t topic_len = ((size_t) p_body[0] << 8) | p_body[1];
+                    if (body_len < topic_len + 4) {
+                        return false;
+                    }
+                    const unsigned char puback[] = {0x40, 0x02, p_body[topic_len + 2], p_body[topic_len + 3]};
+                    return WriteToSession(session, puback, sizeof(puback));
+                }
+                case 8: {
+                    // SUBSCRIBE, every filter is granted QoS0
+                    if (2 > body_len) {
+                        return false;
+                    }
+                    util::Vector<unsigned char> suback = {0x90, 0x02, p_body[0], p_body[1]};
+                    size_t offset = 2;
+                    while (offset + 2 < body_len) {
+                        size_t filter_len = ((size_t) p_body[offset] << 8) | p_body[offset + 1];
+                        offset += filter_len + 3;
+                        suback.push_back(0x00);
+                    }
+                    suback[1] = (unsigned char) (suback.size() - 2);
+                    return WriteToSession(session, suback.data(), suback.size());
+                }
+                case 12: {
+                    // PINGREQ
+                    const unsigned char pingresp[] = {0xD0, 0x00};
+                    return WriteToSession(session, pingresp, sizeof(pingresp));
+                }
+                case 14:
+                    // DISCONNECT
+                    return false;
+                default:
+                    return true;
+            }
+        }
+
+        void TlsStandInBroker::HandleSession(int session_fd) {
+            util::Map<int, std::unique_ptr<Session>>::iterator session_itr = sessions_.find(session_fd);
+            if (sessions_.end() == session_itr) {
+                return;
+            }
+            Session &session = *(session_itr->second);
+
+            if (!session.is_handshake_done_) {
+                int handshake_rc = SSL_do_handshake(session.p_ssl_);
+                if (1 != handshake_rc) {
+                    int error_code = SSL_get_error(session.p_ssl_, handshake_rc);
+                    if (SSL_ERROR_WANT_READ != error_code && SSL_ERROR_WANT_WRITE != error_code) {
+                        CloseSession(session_fd);
+                    }
+                    return;
+                }
+                session.is_handshake_done_ = true;
+            }
+
+            unsigned char read_chunk[BROKER_READ_CHUNK_SIZE];
+            while (true) {
+                int read_rc = SSL_read(session.p_ssl_, read_chunk, sizeof(read_chunk));
+                if (0 < read_rc) {
+                    session.read_buf_.insert(session.read_buf_.end(), read_chunk, read_chunk + read_rc);
+                    continue;
+                }
+                if (SSL_ERROR_WANT_READ != SSL_get_error(session.p_ssl_, read_rc)) {
+                    CloseSession(session_fd);
+                    return;
+                }
+                break;
+            }
+
+            // Handle all complete packets, keep a trailing partial one
+            size_t offset = 0;
+            while (offset + 2 <= session.read_buf_.size()) {
+                size_t remaining_len = 0;
+                size_t multiplier = 1;
+                size_t header_len = 1;
+                bool is_len_complete = false;
+                while (offset + header_len < session.read_buf_.size() && 5 > header_len) {
+                    unsigned char len_byte = session.read_buf_[offset + header_len];
+                    header_len++;
+                    remaining_len += (len_byte & 0x7F) * multiplier;
+                    multiplier *= 128;
+                    if (0 == (len_byte & 0x80)) {
+                        is_len_complete = true;
+                        break;
+                    }
+                }
+                if (!is_len_complete || offset + header_len + remaining_len > session.read_buf_.size()) {
+                    break;
+                }
+
+                if (!HandlePacket(session, session.read_buf_[offset], session.read_buf_.data() + offset + header_len,
+                                  remaining_len)) {
+                    CloseSession(session_fd);
+                    return;
+                }
+                offset += header_len + remaining_len;
+            }
+            session.read_buf_.erase(session.read_buf_.begin(), session.read_buf_.begin() + offset);
+        }
+
+        EventLoopScale::EventLoopScale(size_t client_count, size_t messages_per_client, bool use_event_loop) {
+            client_count_ = client_count;
+            messages_per_client_ = messages_per_client;
+            use_event_loop_ = use_event_loop;
+        }
+
+        ResponseCode EventLoopScale::GenerateCertificate(const util::String &cert_path, const util::String &key_path) {
+            ResponseCode rc = ResponseCode::FAILURE;
+            EVP_PKEY *p_key = nullptr;
+            X509 *p_cert = nullptr;
+            X509_EXTENSION *p_extension = nullptr;
+            FILE *p_file = nullptr;
+
+            EVP_PKEY_CTX *p_key_context = EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, nullptr);
+            if (nullptr == p_key_context || 0 >= EVP_PKEY_keygen_init(p_key_context)
+                || 0 >= EVP_PKEY_CTX_set_rsa_keygen_bits(p_key_context, 2048)
+                || 0 >= EVP_PKEY_keygen(p_key_context, &p_key)) {
+                AWS_LOG_ERROR(LOG_TAG_EVENT_LOOP_SCALE, "Unable to generate broker key");
+                EVP_PKEY_CTX_free(p_key_context);
+                return rc;
+            }
+            EVP_PKEY_CTX_free(p_key_context);
+
+            // Self signed certificate for localhost, also used by the clients as their root CA
+            p_cert = X509_new();
+            X509_set_version(p_cert, 2);
+            ASN1_INTEGER_set(X509_get_serialNumber(p_cert), 1);
+            X509_gmtime_adj(X509_get_notBefore(p_cert), -60);
+            X509_gmtime_adj(X509_get_notAfter(p_cert), 24 * 60 * 60);
+            X509_set_pubkey(p_cert, p_key);
+            X509_NAME *p_name = X509_get_subject_name(p_cert);
+            X509_NAME_add_entry_by_txt(p_name, "CN", MBSTRING_ASC, (const unsigned char *) "localhost", -1, -1, 0);
+            X509_set_issuer_name(p_cert, p_name);
+
+            p_extension = X509V3_EXT_conf_nid(nullptr, nullptr, NID_basic_constraints, (char *) "critical,CA:TRUE");
+            X509_add_ext(p_cert, p_extension, -1);
+            X509_EXTENSION_free(p_extension);
+            p_extension = X509V3_EXT_conf_nid(nullptr, nullptr, NID_subject_alt_name, (char *) "DNS:localhost");
+            X509_add_ext(p_cert, p_extension, -1);
+            X509_EXTENSION_free(p_extension);
+
+            if (0 >= X509_sign(p_cert, p_key, EVP_sha256())) {
+                AWS_LOG_ERROR(LOG_TAG_EVENT_LOOP_SCALE, "Unable to sign broker certificate");
+            } else if (nullptr != (p_file = fopen(cert_path.c_str(), "w"))) {
+                bool is_written = (1 == PEM_write_X509(p_file, p_cert));
+                fclose(p_file);
+                if (is_written && nullptr != (p_file = fopen(key_path.c_str(), "w"))) {
+                    is_written = (1 == PEM_write_PrivateKey(p_file, p_key, nullptr, nullptr, 0, nullptr, nullptr));
+                    fclose(p_file);
+                    if (is_written) {
+                        rc = ResponseCode::SUCCESS;
+                    }
+                }
+            }
+
+            X509_free(p_cert);
+            EVP_PKEY_free(p_key);
+            return rc;
+        }
+
+        size_t EventLoopScale::GetProcessThreadCount() {
+            std::ifstream status_file("/proc/self/status");
+            util::String line;
+            while (std::getline(status_file, line)) {
+                if (0 == line.compare(0, 8, "Threads:")) {
+                    return (size_t) strtoul(line.c_str() + 8, nullptr, 10);
+                }
+            }
+            return 0;
+        }
+
+        ResponseCode EventLoopScale::RunSample() {
+            // Each connection uses two descriptors in this process, one for the client and one for the broker
+            struct rlimit file_limit;
+            if (0 == getrlimit(RLIMIT_NOFILE, &file_limit) && file_limit.rlim_cur < file_limit.rlim_max) {
+                file_limit.rlim_cur = file_limit.rlim_max;
+                setrlimit(RLIMIT_NOFILE, &file_limit);
+            }
+
+            char cert_dir_template[] = "/tmp/aws-iot-event-loop-XXXXXX";
+            if (nullptr == mkdtemp(cert_dir_template)) {
+                return ResponseCode::FILE_OPEN_ERROR;
+            }
+            cert_dir_ = cert_dir_template;
+            util::String cert_path = cert_dir_ + "/broker.crt";
+            util::String key_path = cert_dir_ + "/broker.key";
+
+            ResponseCode rc = GenerateCertificate(cert_path, key_path);
+            TlsStandInBroker broker;
+            if (ResponseCode::SUCCESS == rc) {
+                rc = broker.Start(cert_path, key_path);
+            }
+            if (ResponseCode::SUCCESS != rc) {
+                remove(cert_path.c_str());
+                remove(key_path.c_str());
+                rmdir(cert_dir_.c_str());
+                return rc;
+            }
+
+            std::shared_ptr<util::Threading::EventLoop> p_event_loop = nullptr;
+            if (use_event_loop_) {
+                util::Threading::ExecutorConfig config;
+                config.thread_name_prefix_ = "iot-loop-";
+                p_event_loop = util::Threading::EventLoop::Create(config);
+                if (nullptr == p_event_loop) {
+                    broker.Stop();
+                    return ResponseCode::FAILURE;
+                }
+            }
+
+            std::cout << "Clients : " << client_count_ << ", Messages per client : " << messages_per_client_
+                      << ", Mode : " << (use_event_loop_ ? "event loop" : "thread per client") << std::endl;
+
+            // Connect, TLS handshakes run on this thread, CONNACKs are awaited concurrently
+            util::Vector<std::shared_ptr<MqttClient>> clients;
+            util::Vector<std::shared_ptr<CompletionToken>> tokens;
+            std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+            for (size_t itr = 0; itr < client_count_ && ResponseCode::SUCCESS == rc; itr++) {
+                std::shared_ptr<network::OpenSSLConnection> p_connection
+                    = std::make_shared<network::OpenSSLConnection>("localhost", broker.GetPort(), cert_path,
+                                                                   std::chrono::milliseconds(CLIENT_TLS_TIMEOUT_MS),
+                                                                   std::chrono::milliseconds(CLIENT_TLS_TIMEOUT_MS),
+                                                                   std::chrono::milliseconds(CLIENT_TLS_TIMEOUT_MS),
+                                                                   true);
+                rc = p_connection->Initialize();
+                if (ResponseCode::SUCCESS != rc) {
+                    break;
+                }
+
+                std::chrono::milliseconds command_timeout(CLIENT_MQTT_COMMAND_TIMEOUT_MS);
+                std::shared_ptr<MqttClient> p_client = use_event_loop_
+                                                       ? MqttClient::Create(p_connection, command_timeout,
+                                                                            p_event_loop)
+                                                       : MqttClient::Create(p_connection, command_timeout);
+                if (nullptr == p_client) {
+                    rc = ResponseCode::NULL_VALUE_ERROR;
+                    break;
+                }
+                // Default limit matches the service, the stand-in broker has none
+                p_client->SetOutboundRateLimit(CLIENT_OUTBOUND_RATE_LIMIT_HZ, CLIENT_OUTBOUND_BURST_SIZE);
+
+                std::shared_ptr<CompletionToken> p_token = nullptr;
+                util::String client_id = "event-loop-scale-" + std::to_string(itr);
+                rc = p_client->ConnectAsync(true, mqtt::Version::MQTT_3_1_1,
+                                            std::chrono::seconds(CLIENT_KEEP_ALIVE_SECS),
+                                            Utf8String::Create(client_id), nullptr, nullptr, nullptr, false, p_token);
+                clients.push_back(p_client);
+                tokens.push_back(p_token);
+            }
+            size_t connected_count = CompletionToken::WaitForAll(tokens,
+                                                                 std::chrono::milliseconds(CLIENT_MQTT_COMMAND_TIMEOUT_MS));
+            std::chrono::duration<double> connect_time = std::chrono::steady_clock::now() - start_time;
+            for (std::shared_ptr<CompletionToken> &p_token : tokens) {
+                if (ResponseCode::MQTT_CONNACK_CONNECTION_ACCEPTED != p_token->GetResponse()) {
+                    connected_count--;
+                }
+            }
+            std::cout << "Connected " << connected_count << " clients in " << connect_time.count() << " s"
+                      << std::endl;
+            if (ResponseCode::SUCCESS != rc || clients.size() != connected_count) {
+                AWS_LOG_ERROR(LOG_TAG_EVENT_LOOP_SCALE, "Connect failed. %s", ResponseHelper::ToString(rc).c_str());
+                if (ResponseCode::SUCCESS == rc) {
+                    rc = ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR;
+                }
+            }
+
+            // Publish, one QoS1 message per client per round
+            size_t acked_count = 0;
+            start_time = std::chrono::steady_clock::now();
+            for (size_t round = 0; round < messages_per_client_ && ResponseCode::SUCCESS == rc; round++) {
+                tokens.clear();
+                for (size_t itr = 0; itr < clients.size(); itr++) {
+                    std::shared_ptr<CompletionToken> p_token = nullptr;
+                    uint16_t packet_id = 0;
+                    util::String topic = BENCHMARK_TOPIC_PREFIX + std::to_string(itr);
+                    mqtt::PublishRequest request(Utf8String::Create(topic), mqtt::QoS::QOS1);
+                    request.SetPayload(BENCHMARK_PAYLOAD);
+                    clients[itr]->PublishAsync(std::move(request), packet_id, p_token);
+                    tokens.push_back(p_token);
+                }
+                CompletionToken::WaitForAll(tokens, std::chrono::milliseconds(CLIENT_MQTT_COMMAND_TIMEOUT_MS));
+                for (std::shared_ptr<CompletionToken> &p_token : tokens) {
+                    if (ResponseCode::SUCCESS == p_token->GetResponse()) {
+                        acked_count++;
+                    }
+                }
+            }
+            std::chrono::duration<double> publish_time = std::chrono::steady_clock::now() - start_time;
+            size_t thread_count = GetProcessThreadCount();
+
+            std::cout << "Published " << acked_count << " QoS1 messages in " << publish_time.count() << " s, "
+                      << (0 < publish_time.count() ? (double) acked_count / publish_time.count() : 0.0)
+                      << " msgs/s" << std::endl;
+            std::cout << "Broker received " << broker.GetReceivedPublishCount() << " publishes" << std::endl;
+            std::cout << "Process threads : " << thread_count << " (including this thread and the broker thread)"
+                      << std::endl;
+
+            for (std::shared_ptr<MqttClient> &p_client : clients) {
+                p_client->Disconnect(std::chrono::milliseconds(CLIENT_MQTT_COMMAND_TIMEOUT_MS));
+            }
+            clients.clear();
+            p_event_loop = nullptr;
+            broker.Stop();
+
+            remove(cert_path.c_str());
+            remove(key_path.c_str());
+            rmdir(cert_dir_.c_str());
+            return rc;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    std::shared_ptr<awsiotsdk::util::Logging::ConsoleLogSystem> p_log_system =
+        std::make_shared<awsiotsdk::util::Logging::ConsoleLogSystem>(awsiotsdk::util::Logging::LogLevel::Warn);
+    awsiotsdk::util::Logging::InitializeAWSLogging(p_log_system);
+
+    size_t client_count = (1 < argc) ? (size_t) strtoul(argv[1], nullptr, 10) : DEFAULT_CLIENT_COUNT;
+    size_t messages_per_client = (2 < argc) ? (size_t) strtoul(argv[2], nullptr, 10) : DEFAULT_MESSAGES_PER_CLIENT;
+    bool use_event_loop = (3 < argc) ? (0 != strcmp(argv[3], "threads")) : true;
+
+    awsiotsdk::samples::EventLoopScale benchmark(client_count, messages_per_client, use_event_loop);
+    awsiotsdk::ResponseCode rc = benchmark.RunSample();
+    std::cout << "Exiting Sample! " << awsiotsdk::ResponseHelper::ToString(rc) << std::endl;
+
+    awsiotsdk::util::Logging::ShutdownAWSLogging();
+    return static_cast<int>(rc);
+}
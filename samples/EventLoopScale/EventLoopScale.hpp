@@ -0,0 +1,126 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file EventLoopScale.hpp
+ * @brief Benchmark driving many MQTT connections from one event loop thread against a local TLS stand-in broker
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include <openssl/ssl.h>
+
+#include "mqtt/Client.hpp"
+#include "util/memory/stl/Map.hpp"
+#include "util/memory/stl/String.hpp"
+#include "util/memory/stl/Vector.hpp"
+#include "util/threading/EventLoop.hpp"
+
+namespace awsiotsdk {
+    namespace samples {
+        /**
+         * @brief Minimal single threaded TLS MQTT broker stand-in
+         *
+         * Accepts any number of connections on 127.0.0.1 and answers CONNECT, SUBSCRIBE, PUBLISH and PINGREQ with
+         * the matching acks. Does not route messages. Only intended as a local peer for benchmarks.
+         */
+        class TlsStandInBroker {
+        protected:
+            /**
+             * @brief State of one accepted connection
+             */
+            class Session {
+            public:
+                SSL *p_ssl_;                                ///< TLS session
+                bool is_handshake_done_;                    ///< Whether the TLS handshake has completed
+                util::Vector<unsigned char> read_buf_;      ///< Received bytes that do not form a complete packet yet
+            };
+
+            SSL_CTX *p_ssl_context_;                                ///< Server TLS context
+            int listen_fd_;                                         ///< Listening socket
+            int epoll_fd_;                                          ///< epoll set of the listening socket and sessions
+            int stop_fd_;                                           ///< eventfd used to stop the broker thread
+            uint16_t port_;                                         ///< Port the broker is listening on
+            std::thread broker_thread_;                             ///< Broker thread
+            util::Map<int, std::unique_ptr<Session>> sessions_;     ///< Sessions by socket descriptor
+            std::atomic<uint64_t> received_publish_count_;          ///< Number of PUBLISH packets received
+
+            void Run();
+            void Accept();
+            void HandleSession(int session_fd);
+            void CloseSession(int session_fd);
+            bool HandlePacket(Session &session, unsigned char fixed_header_byte, const unsigned char *p_body,
+                              size_t body_len);
+            bool WriteToSession(Session &session, const unsigned char *p_data, size_t data_len);
+
+        public:
+            // Rule of 5 stuff
+            // Owns a thread and descriptors, should not be copied or moved
+            TlsStandInBroker();
+            TlsStandInBroker(const TlsStandInBroker &) = delete;
+            TlsStandInBroker(TlsStandInBroker &&) = delete;
+            TlsStandInBroker &operator=(const TlsStandInBroker &) & = delete;
+            TlsStandInBroker &operator=(TlsStandInBroker &&) & = delete;
+            ~TlsStandInBroker();
+
+            /**
+             * @brief Start listening on an ephemeral port
+             *
+             * @param cert_path - PEM server certificate
+             * @param key_path - PEM server private key
+             * @return ResponseCode - SUCCESS or the failure reason
+             */
+            ResponseCode Start(const util::String &cert_path, const util::String &key_path);
+
+            /**
+             * @brief Stop the broker thread and close all sessions
+             */
+            void Stop();
+
+            uint16_t GetPort() { return port_; }
+
+            uint64_t GetReceivedPublishCount() { return received_publish_count_; }
+        };
+
+        /**
+         * @brief Event Loop scale benchmark
+         *
+         * Connects client_count MqttClients to a TlsStandInBroker and publishes messages_per_client QoS1 messages
+         * from each of them, reporting connect time, publish throughput and the number of threads in the process.
+         * In event loop mode all clients share one util::Threading::EventLoop, otherwise each client uses its own
+         * threads.
+         */
+        class EventLoopScale {
+        protected:
+            size_t client_count_;
+            size_t messages_per_client_;
+            bool use_event_loop_;
+            util::String cert_dir_;
+
+            ResponseCode GenerateCertificate(const util::String &cert_path, const util::String &key_path);
+            static size_t GetProcessThreadCount();
+
+        public:
+            EventLoopScale(size_t client_count, size_t messages_per_client, bool use_event_loop);
+
+            ResponseCode RunSample();
+        };
+    }
+}
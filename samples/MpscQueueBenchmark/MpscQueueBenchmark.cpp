@@ -0,0 +1,135 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file MpscQueueBenchmark.cpp
+ * @brief Microbenchmark of BoundedMpscQueue throughput with contending producer threads
+ *
+ * Usage : mpsc-queue-benchmark-sample [items_per_producer] [queue_capacity]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#include "util/logging/Logging.hpp"
+#include "util/logging/LogMacros.hpp"
+#include "util/logging/ConsoleLogSystem.hpp"
+#include "util/memory/stl/Vector.hpp"
+#include "util/threading/BoundedMpscQueue.hpp"
+
+#include "MpscQueueBenchmark.hpp"
+
+#define LOG_TAG_MPSC_QUEUE_BENCHMARK "[Sample - MpscQueueBenchmark]"
+
+#define DEFAULT_ITEMS_PER_PRODUCER 200000
+#define DEFAULT_QUEUE_CAPACITY 1024
+
+namespace awsiotsdk {
+    namespace samples {
+        MpscQueueBenchmark::MpscQueueBenchmark(size_t items_per_producer, size_t queue_capacity) {
+            items_per_producer_ = items_per_producer;
+            queue_capacity_ = (0 == queue_capacity) ? 1 : queue_capacity;
+        }
+
+        ResponseCode MpscQueueBenchmark::RunContention(size_t producer_count) {
+            // Producer index in the upper bits, sequence number in the lower ones
+            util::Threading::BoundedMpscQueue<uint64_t> queue(queue_capacity_);
+            std::atomic_bool start(false);
+            util::Vector<std::thread> producers;
+            util::Vector<uint64_t> next_expected(producer_count, 0);
+            uint64_t items_per_producer = items_per_producer_;
+
+            for (size_t itr = 0; itr < producer_count; itr++) {
+                producers.push_back(std::thread([&queue, &start, itr, items_per_producer]() {
+                    while (!start) {
+                        std::this_thread::yield();
+                    }
+                    for (uint64_t seq = 0; seq < items_per_producer; seq++) {
+                        while (!queue.TryPush((((uint64_t) itr) << 32) | seq)) {
+                            std::this_thread::yield();
+                        }
+                    }
+                }));
+            }
+
+            uint64_t total = producer_count * items_per_producer;
+            uint64_t received = 0;
+            size_t mismatch_count = 0;
+            std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+            start = true;
+            while (received < total) {
+                uint64_t item;
+                if (!queue.TryPop(item)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                size_t producer = (size_t) (item >> 32);
+                uint64_t seq = item & 0xFFFFFFFF;
+                if (producer >= producer_count || next_expected[producer] != seq) {
+                    mismatch_count++;
+                } else {
+                    next_expected[producer]++;
+                }
+                received++;
+            }
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+
+            for (std::thread &producer : producers) {
+                producer.join();
+            }
+
+            double seconds = (0 < elapsed.count()) ? elapsed.count() : 1e-6;
+            std::cout << "Producers : " << producer_count << ", " << (uint64_t) (total / seconds) << " items/s"
+                      << std::endl;
+            if (0 != mismatch_count) {
+                AWS_LOG_ERROR(LOG_TAG_MPSC_QUEUE_BENCHMARK, "%zu items were lost or reordered", mismatch_count);
+                return ResponseCode::FAILURE;
+            }
+            return ResponseCode::SUCCESS;
+        }
+
+        ResponseCode MpscQueueBenchmark::RunSample() {
+            std::cout << "Items per producer : " << items_per_producer_ << ", Queue capacity : " << queue_capacity_
+                      << std::endl;
+            const size_t producer_counts[] = {1, 2, 4, 8};
+            for (size_t producer_count : producer_counts) {
+                ResponseCode rc = RunContention(producer_count);
+                if (ResponseCode::SUCCESS != rc) {
+                    return rc;
+                }
+            }
+            return ResponseCode::SUCCESS;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    std::shared_ptr<awsiotsdk::util::Logging::ConsoleLogSystem> p_log_system =
+        std::make_shared<awsiotsdk::util::Logging::ConsoleLogSystem>(awsiotsdk::util::Logging::LogLevel::Warn);
+    awsiotsdk::util::Logging::InitializeAWSLogging(p_log_system);
+
+    size_t items_per_producer = (1 < argc) ? (size_t) strtoul(argv[1], nullptr, 10) : DEFAULT_ITEMS_PER_PRODUCER;
+    size_t queue_capacity = (2 < argc) ? (size_t) strtoul(argv[2], nullptr, 10) : DEFAULT_QUEUE_CAPACITY;
+
+    awsiotsdk::samples::MpscQueueBenchmark benchmark(items_per_producer, queue_capacity);
+    awsiotsdk::ResponseCode rc = benchmark.RunSample();
+    std::cout << "Exiting Sample! " << awsiotsdk::ResponseHelper::ToString(rc) << std::endl;
+
+    awsiotsdk::util::Logging::ShutdownAWSLogging();
+    return static_cast<int>(rc);
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file MpscQueueBenchmark.hpp
+ * @brief Microbenchmark of BoundedMpscQueue throughput with contending producer threads
+ *
+ */
+
+#pragma once
+
+#include "ResponseCode.hpp"
+
+namespace awsiotsdk {
+    namespace samples {
+        /**
+         * @brief MPSC Queue Benchmark
+         *
+         * Pushes items_per_producer items from each of 1, 2, 4 and 8 producer threads into a
+         * util::Threading::BoundedMpscQueue while the main thread pops them, as the client's action queue is used.
+         * Reports the items popped per second for each producer count and checks that no item is lost or reordered
+         * per producer.
+         */
+        class MpscQueueBenchmark {
+        protected:
+            size_t items_per_producer_;
+            size_t queue_capacity_;
+
+            ResponseCode RunContention(size_t producer_count);
+
+        public:
+            MpscQueueBenchmark(size_t items_per_producer, size_t queue_capacity);
+
+            ResponseCode RunSample();
+        };
+    }
+}
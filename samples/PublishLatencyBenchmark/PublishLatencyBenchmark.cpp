@@ -0,0 +1,278 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/**
+ * @file PublishLatencyBenchmark.cpp
+ * @brief Benchmark comparing QoS0 async publish latency of the outbound queue with direct writes
+ *
+ * Usage : publish-latency-benchmark-sample [message_count] [queued|direct] [interval_us]
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "util/logging/Logging.hpp"
+#include "util/logging/LogMacros.hpp"
+#include "util/logging/ConsoleLogSystem.hpp"
+
+#include "mqtt/Client.hpp"
+
+#include "PublishLatencyBenchmark.hpp"
+
+#define LOG_TAG_PUBLISH_LATENCY_BENCHMARK "[Sample - PublishLatencyBenchmark]"
+
+#define DEFAULT_MESSAGE_COUNT 5000
+#define DEFAULT_PUBLISH_INTERVAL_US 200
+
+#define BENCHMARK_TOPIC "bench/latency"
+#define BENCHMARK_CLIENT_ID "publish-latency-benchmark"
+#define BENCHMARK_PAYLOAD_SIZE 64
+
+#define SOCKET_READ_TIMEOUT_MS 1000
+#define MQTT_COMMAND_TIMEOUT_MS 2000
+#define RECEIVE_TIMEOUT_MS 10000
+
+namespace awsiotsdk {
+    namespace samples {
+        ResponseCode SocketNetworkConnection::WriteInternal(const util::String &buf, size_t &size_written_bytes_out) {
+            ssize_t written_bytes = send(socket_fd_, buf.c_str(), buf.length(), MSG_NOSIGNAL);
+            if (0 > written_bytes) {
+                return ResponseCode::NETWORK_SSL_WRITE_ERROR;
+            }
+            size_written_bytes_out = (size_t) written_bytes;
+            return ResponseCode::SUCCESS;
+        }
+
+        ResponseCode SocketNetworkConnection::WaitForData() {
+            struct pollfd socket_poll_fd = {socket_fd_, POLLIN, 0};
+            int poll_rc = poll(&socket_poll_fd, 1, SOCKET_READ_TIMEOUT_MS);
+            if (0 < poll_rc) {
+                return ResponseCode::SUCCESS;
+            }
+            return (0 == poll_rc) ? ResponseCode::NETWORK_SSL_NOTHING_TO_READ : ResponseCode::NETWORK_SSL_READ_ERROR;
+        }
+
+        ResponseCode SocketNetworkConnection::ReadInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+                                                           size_t size_bytes_to_read, size_t &size_read_bytes_out) {
+            size_t total_read_bytes = 0;
+            while (total_read_bytes < size_bytes_to_read) {
+                ssize_t read_bytes = recv(socket_fd_, &buf[buf_read_offset + total_read_bytes],
+                                          size_bytes_to_read - total_read_bytes, MSG_DONTWAIT);
+                if (0 < read_bytes) {
+                    total_read_bytes += (size_t) read_bytes;
+                } else if (0 == read_bytes) {
+                    return ResponseCode::NETWORK_SSL_CONNECTION_CLOSED_ERROR;
+                } else if (EAGAIN == errno || EWOULDBLOCK == errno) {
+                    ResponseCode rc = WaitForData();
+                    if (ResponseCode::SUCCESS != rc) {
+                        return rc;
+                    }
+                } else if (EINTR != errno) {
+                    return ResponseCode::NETWORK_SSL_READ_ERROR;
+                }
+            }
+            size_read_bytes_out = total_read_bytes;
+            return ResponseCode::SUCCESS;
+        }
+
+        PublishLatencyBenchmark::PublishLatencyBenchmark(size_t message_count, bool use_direct_write,
+                                                         std::chrono::microseconds publish_interval)
+            : message_count_(message_count), use_direct_write_(use_direct_write), publish_interval_(publish_interval),
+              publish_times_(message_count), receive_times_(message_count), received_count_(0) {
+        }
+
+        bool PublishLatencyBenchmark::HandleBrokerPacket(int broker_fd, unsigned char fixed_header_byte,
+                                                         const unsigned char *p_body, size_t body_len) {
+            static const unsigned char connack_packet[] = {0x20, 0x02, 0x00, 0x00};
+            static const unsigned char pingresp_packet[] = {0xD0, 0x00};
+            switch (fixed_header_byte >> 4) {
+                case 1:
+                    return sizeof(connack_packet) == send(broker_fd, connack_packet, sizeof(connack_packet),
+                                                          MSG_NOSIGNAL);
+                case 3: {
+                    std::chrono::steady_clock::time_point receive_time = std::chrono::steady_clock::now();
+                    // QoS0, the payload follows the topic name and starts with the message index
+                    size_t topic_len = (size_t) ((p_body[0] << 8) | p_body[1]);
+                    uint64_t message_index = 0;
+                    if (2 + topic_len + sizeof(message_index) > body_len) {
+                        return false;
+                    }
+                    memcpy(&message_index, p_body + 2 + topic_len, sizeof(message_index));
+                    if (message_index < receive_times_.size()) {
+                        receive_times_[message_index] = receive_time;
+                        received_count_++;
+                    }
+                    return true;
+                }
+                case 12:
+                    return sizeof(pingresp_packet) == send(broker_fd, pingresp_packet, sizeof(pingresp_packet),
+                                                           MSG_NOSIGNAL);
+                case 14:
+                    return false;
+                default:
+                    return true;
+            }
+        }
+
+        void PublishLatencyBenchmark::RunBroker(int broker_fd) {
+            util::Vector<unsigned char> read_buf;
+            unsigned char recv_buf[4096];
+            for (;;) {
+                ssize_t read_bytes = recv(broker_fd, recv_buf, sizeof(recv_buf), 0);
+                if (0 > read_bytes && EINTR == errno) {
+                    continue;
+                } else if (0 >= read_bytes) {
+                    return;
+                }
+                read_buf.insert(read_buf.end(), recv_buf, recv_buf + read_bytes);
+
+                // Handle every complete packet in the buffer
+                size_t offset = 0;
+                for (;;) {
+                    size_t rem_len = 0;
+                    size_t multiplier = 1;
+                    size_t header_len = 1;
+                    bool is_header_complete = false;
+                    while (offset + header_len < read_buf.size() && header_len <= 4) {
+                        unsigned char encoded_byte = read_buf[offset + header_len];
+                        rem_len += (size_t) (encoded_byte & 127) * multiplier;
+                        multiplier *= 128;
+                        header_len++;
+                        if (0 == (encoded_byte & 128)) {
+                            is_header_complete = true;
+                            break;
+                        }
+                    }
+                    if (!is_header_complete || offset + header_len + rem_len > read_buf.size()) {
+                        break;
+                    }
+                    if (!HandleBrokerPacket(broker_fd, read_buf[offset], read_buf.data() + offset + header_len,
+                                            rem_len)) {
+                        return;
+                    }
+                    offset += header_len + rem_len;
+                }
+                read_buf.erase(read_buf.begin(), read_buf.begin() + offset);
+            }
+        }
+
+        ResponseCode PublishLatencyBenchmark::RunSample() {
+            int socket_fds[2];
+            if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, socket_fds)) {
+                AWS_LOG_ERROR(LOG_TAG_PUBLISH_LATENCY_BENCHMARK, "Unable to create socket pair, errno %d", errno);
+                return ResponseCode::FAILURE;
+            }
+            int broker_fd = socket_fds[1];
+            std::thread broker_thread([this, broker_fd]() { RunBroker(broker_fd); });
+
+            std::shared_ptr<SocketNetworkConnection>
+                p_network_connection = std::make_shared<SocketNetworkConnection>(socket_fds[0]);
+            std::shared_ptr<MqttClient> p_client =
+                MqttClient::Create(p_network_connection, std::chrono::milliseconds(MQTT_COMMAND_TIMEOUT_MS));
+            p_client->SetOutboundRateLimit(0, 1);
+            p_client->SetQoS0DirectWriteEnabled(use_direct_write_);
+
+            std::cout << "Messages : " << message_count_ << ", Interval : " << publish_interval_.count()
+                      << " us, Mode : " << (use_direct_write_ ? "direct" : "queued") << std::endl;
+
+            ResponseCode rc = p_client->Connect(std::chrono::milliseconds(MQTT_COMMAND_TIMEOUT_MS), true,
+                                                mqtt::Version::MQTT_3_1_1, std::chrono::seconds(30),
+                                                Utf8String::Create(BENCHMARK_CLIENT_ID), nullptr, nullptr, nullptr);
+            std::shared_ptr<const mqtt::TopicHandle> p_topic_handle = p_client->InternTopic(BENCHMARK_TOPIC);
+            if (ResponseCode::MQTT_CONNACK_CONNECTION_ACCEPTED == rc) {
+                rc = ResponseCode::SUCCESS;
+                util::String payload(BENCHMARK_PAYLOAD_SIZE, 'x');
+                std::chrono::steady_clock::time_point next_publish_time = std::chrono::steady_clock::now();
+                for (uint64_t itr = 0; itr < message_count_ && ResponseCode::SUCCESS == rc; itr++) {
+                    memcpy(&payload[0], &itr, sizeof(itr));
+                    uint16_t packet_id = 0;
+                    publish_times_[itr] = std::chrono::steady_clock::now();
+                    mqtt::PublishRequest request(p_topic_handle, mqtt::QoS::QOS0);
+                    request.SetPayload(payload);
+                    rc = p_client->PublishAsync(std::move(request), nullptr, packet_id);
+                    next_publish_time += publish_interval_;
+                    std::this_thread::sleep_until(next_publish_time);
+                }
+
+                std::chrono::steady_clock::time_point receive_deadline =
+                    std::chrono::steady_clock::now() + std::chrono::milliseconds(RECEIVE_TIMEOUT_MS);
+                while (received_count_ < message_count_ && std::chrono::steady_clock::now() < receive_deadline) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+                p_client->Disconnect(std::chrono::milliseconds(MQTT_COMMAND_TIMEOUT_MS));
+            } else {
+                AWS_LOG_ERROR(LOG_TAG_PUBLISH_LATENCY_BENCHMARK, "Connect failed. %s",
+                              ResponseHelper::ToString(rc).c_str());
+            }
+
+            shutdown(socket_fds[0], SHUT_RDWR);
+            broker_thread.join();
+            p_client.reset();
+            close(socket_fds[0]);
+            close(socket_fds[1]);
+
+            if (ResponseCode::SUCCESS != rc) {
+                return rc;
+            }
+            if (received_count_ != message_count_) {
+                AWS_LOG_ERROR(LOG_TAG_PUBLISH_LATENCY_BENCHMARK, "Broker received %llu of %zu messages",
+                              (unsigned long long) received_count_.load(), message_count_);
+                return ResponseCode::FAILURE;
+            }
+
+            util::Vector<double> latencies_us;
+            latencies_us.reserve(message_count_);
+            for (size_t itr = 0; itr < message_count_; itr++) {
+                std::chrono::duration<double, std::micro> latency = receive_times_[itr] - publish_times_[itr];
+                latencies_us.push_back(latency.count());
+            }
+            std::sort(latencies_us.begin(), latencies_us.end());
+            std::cout << "Publish latency p50 : " << latencies_us[latencies_us.size() / 2] << " us, p99 : "
+                      << latencies_us[(latencies_us.size() * 99) / 100] << " us, max : " << latencies_us.back()
+                      << " us" << std::endl;
+            return ResponseCode::SUCCESS;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    std::shared_ptr<awsiotsdk::util::Logging::ConsoleLogSystem> p_log_system =
+        std::make_shared<awsiotsdk::util::Logging::ConsoleLogSystem>(awsiotsdk::util::Logging::LogLevel::Warn);
+    awsiotsdk::util::Logging::InitializeAWSLogging(p_log_system);
+
+    size_t message_count = (1 < argc) ? (size_t) strtoul(argv[1], nullptr, 10) : DEFAULT_MESSAGE_COUNT;
+    bool use_direct_write = (2 < argc) ? (0 == strcmp(argv[2], "direct")) : false;
+    size_t publish_interval_us = (3 < argc) ? (size_t) strtoul(argv[3], nullptr, 10) : DEFAULT_PUBLISH_INTERVAL_US;
+    if (0 == message_count) {
+        message_count = 1;
+    }
+
+    awsiotsdk::samples::PublishLatencyBenchmark benchmark(message_count, use_direct_write,
+                                                          std::chrono::microseconds(publish_interval_us));
+    awsiotsdk::ResponseCode rc = benchmark.RunSample();
+    std::cout << "Exiting Sample! " << awsiotsdk::ResponseHelper::ToString(rc) << std::endl;
+
+    awsiotsdk::util::Logging::ShutdownAWSLogging();
+    return static_cast<int>(rc);
+}
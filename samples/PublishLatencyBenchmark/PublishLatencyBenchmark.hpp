@@ -0,0 +1,102 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/**
+ * @file PublishLatencyBenchmark.hpp
+ * @brief Benchmark comparing QoS0 async publish latency of the outbound queue with direct writes
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#include "NetworkConnection.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+namespace awsiotsdk {
+    namespace samples {
+        /**
+         * @brief Network connection over a connected local stream socket, without TLS
+         */
+        class SocketNetworkConnection : public NetworkConnection {
+        protected:
+            int socket_fd_;                                 ///< Connected socket, owned by the caller
+
+            ResponseCode ConnectInternal() { return ResponseCode::SUCCESS; }
+            ResponseCode DisconnectInternal() { return ResponseCode::SUCCESS; }
+            ResponseCode WriteInternal(const util::String &buf, size_t &size_written_bytes_out);
+            ResponseCode ReadInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+                                      size_t size_bytes_to_read, size_t &size_read_bytes_out);
+
+            /**
+             * @brief Wait until the socket is readable
+             *
+             * @return ResponseCode - SUCCESS, NETWORK_SSL_NOTHING_TO_READ on timeout or NETWORK_SSL_READ_ERROR
+             */
+            ResponseCode WaitForData();
+
+        public:
+            SocketNetworkConnection(int socket_fd) : socket_fd_(socket_fd) {}
+
+            bool IsConnected() { return true; }
+            bool IsPhysicalLayerConnected() { return true; }
+        };
+
+        /**
+         * @brief Publish Latency Benchmark
+         *
+         * Connects an MqttClient over a local socket pair to a stand-in broker thread that acknowledges CONNECT and
+         * PINGREQ and timestamps every PUBLISH it receives. Sends message_count QoS0 messages with PublishAsync,
+         * one every interval_us microseconds, either through the outbound action queue or with QoS0 direct write
+         * enabled. Reports the p50, p99 and maximum time from the PublishAsync call until the broker received the
+         * message. The outbound rate limit is disabled in both modes, so only the queueing itself is measured.
+         */
+        class PublishLatencyBenchmark {
+        protected:
+            size_t message_count_;
+            bool use_direct_write_;
+            std::chrono::microseconds publish_interval_;
+
+            util::Vector<std::chrono::steady_clock::time_point> publish_times_;
+            util::Vector<std::chrono::steady_clock::time_point> receive_times_;
+            std::atomic<uint64_t> received_count_;
+
+            /**
+             * @brief Answer the client on the broker side of the socket pair until it is closed
+             *
+             * @param broker_fd - Broker side of the socket pair
+             */
+            void RunBroker(int broker_fd);
+
+            /**
+             * @brief Handle one packet received by the broker
+             *
+             * @return boolean indicating whether the broker should keep running
+             */
+            bool HandleBrokerPacket(int broker_fd, unsigned char fixed_header_byte, const unsigned char *p_body,
+                                    size_t body_len);
+
+        public:
+            PublishLatencyBenchmark(size_t message_count, bool use_direct_write,
+                                    std::chrono::microseconds publish_interval);
+
+            ResponseCode RunSample();
+        };
+    }
+}
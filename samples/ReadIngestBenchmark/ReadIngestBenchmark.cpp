@@ -0,0 +1,300 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file ReadIngestBenchmark.cpp
+ * @brief Benchmark of the inbound packet reader ingesting many small PUBLISH packets from a local socket
+ *
+ * Usage : read-ingest-benchmark-sample [message_count] [buffered|bytewise]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "util/logging/Logging.hpp"
+#include "util/logging/LogMacros.hpp"
+#include "util/logging/ConsoleLogSystem.hpp"
+
+#include "ReadIngestBenchmark.hpp"
+
+#define LOG_TAG_READ_INGEST_BENCHMARK "[Sample - ReadIngestBenchmark]"
+
+#define DEFAULT_MESSAGE_COUNT 200000
+
+#define BENCHMARK_TOPIC "bench/ingest"
+#define DEFAULT_PAYLOAD_SIZE 32
+
+#define SOCKET_READ_TIMEOUT_MS 1000
+#define WRITER_BATCH_SIZE 64
+
+namespace awsiotsdk {
+    namespace samples {
+        ResponseCode SocketNetworkConnection::WriteInternal(const util::String &buf, size_t &size_written_bytes_out) {
+            ssize_t written_bytes = send(socket_fd_, buf.c_str(), buf.length(), MSG_NOSIGNAL);
+            if (0 > written_bytes) {
+                return ResponseCode::NETWORK_SSL_WRITE_ERROR;
+            }
+            size_written_bytes_out = (size_t) written_bytes;
+            return ResponseCode::SUCCESS;
+        }
+
+        ResponseCode SocketNetworkConnection::WaitForData() {
+            struct pollfd socket_poll_fd = {socket_fd_, POLLIN, 0};
+            int poll_rc = poll(&socket_poll_fd, 1, SOCKET_READ_TIMEOUT_MS);
+            if (0 < poll_rc) {
+                return ResponseCode::SUCCESS;
+            }
+            return (0 == poll_rc) ? ResponseCode::NETWORK_SSL_NOTHING_TO_READ : ResponseCode::NETWORK_SSL_READ_ERROR;
+        }
+
+        ResponseCode SocketNetworkConnection::ReadInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+                                                           size_t size_bytes_to_read, size_t &size_read_bytes_out) {
+            size_t total_read_bytes = 0;
+            while (total_read_bytes < size_bytes_to_read) {
+                ssize_t read_bytes = recv(socket_fd_, &buf[buf_read_offset + total_read_bytes],
+                                          size_bytes_to_read - total_read_bytes, MSG_DONTWAIT);
+                if (0 < read_bytes) {
+                    socket_read_count_++;
+                    total_read_bytes += (size_t) read_bytes;
+                } else if (0 == read_bytes) {
+                    return ResponseCode::NETWORK_SSL_CONNECTION_CLOSED_ERROR;
+                } else if (EAGAIN == errno || EWOULDBLOCK == errno) {
+                    ResponseCode rc = WaitForData();
+                    if (ResponseCode::SUCCESS != rc) {
+                        return rc;
+                    }
+                } else if (EINTR != errno) {
+                    return ResponseCode::NETWORK_SSL_READ_ERROR;
+                }
+            }
+            size_read_bytes_out = total_read_bytes;
+            return ResponseCode::SUCCESS;
+        }
+
+        ResponseCode SocketNetworkConnection::ReadAvailableInternal(util::Vector<unsigned char> &buf,
+                                                                    size_t buf_read_offset,
+                                                                    size_t min_bytes_to_read,
+                                                                    size_t max_bytes_to_read,
+                                                                    size_t &size_read_bytes_out) {
+            ResponseCode rc = ResponseCode::SUCCESS;
+            size_read_bytes_out = 0;
+            while (size_read_bytes_out < max_bytes_to_read) {
+                ssize_t read_bytes = recv(socket_fd_, &buf[buf_read_offset + size_read_bytes_out],
+                                          max_bytes_to_read - size_read_bytes_out, MSG_DONTWAIT);
+                if (0 < read_bytes) {
+                    socket_read_count_++;
+                    size_read_bytes_out += (size_t) read_bytes;
+                } else if (0 == read_bytes) {
+                    rc = ResponseCode::NETWORK_SSL_CONNECTION_CLOSED_ERROR;
+                    break;
+                } else if (EAGAIN == errno || EWOULDBLOCK == errno) {
+                    if (size_read_bytes_out >= min_bytes_to_read) {
+                        break;
+                    }
+                    rc = WaitForData();
+                    if (ResponseCode::SUCCESS != rc) {
+                        break;
+                    }
+                } else if (EINTR != errno) {
+                    rc = ResponseCode::NETWORK_SSL_READ_ERROR;
+                    break;
+                }
+            }
+            return rc;
+        }
+
+        ResponseCode ReadIngestBenchmark::BytewiseReadRunner::RunBytewiseStep(
+            std::shared_ptr<NetworkConnection> p_network_connection) {
+            util::Vector<unsigned char> header_buf;
+            ResponseCode rc = ReadFromNetworkBuffer(p_network_connection, header_buf, 1);
+            if (ResponseCode::SUCCESS != rc) {
+                return rc;
+            }
+
+            unsigned char fixed_header_byte = header_buf[0];
+            size_t rem_len = 0;
+            size_t multiplier = 1;
+            size_t len = 0;
+            do {
+                if (++len > MAX_NO_OF_REMAINING_LENGTH_BYTES) {
+                    return ResponseCode::MQTT_DECODE_REMAINING_LENGTH_ERROR;
+                }
+                rc = ReadFromNetworkBuffer(p_network_connection, header_buf, 1);
+                if (ResponseCode::SUCCESS != rc) {
+                    return rc;
+                }
+                rem_len += (size_t) ((header_buf[0] & 127) * multiplier);
+                multiplier *= 128;
+            } while (0 != (header_buf[0] & 128));
+
+            std::shared_ptr<util::Vector<unsigned char>> p_packet_buf = std::make_shared<util::Vector<unsigned char>>();
+            if (0 < rem_len) {
+                rc = ReadFromNetworkBuffer(p_network_connection, *p_packet_buf, rem_len);
+                if (ResponseCode::SUCCESS != rc) {
+                    return rc;
+                }
+            }
+            return HandlePacket(fixed_header_byte, util::SharedBufferView(p_packet_buf, 0, rem_len));
+        }
+
+        ReadIngestBenchmark::ReadIngestBenchmark(size_t message_count, bool use_read_ahead, size_t payload_size,
+                                                 bool use_view_handler)
+            : message_count_(message_count), use_read_ahead_(use_read_ahead), payload_size_(payload_size),
+              use_view_handler_(use_view_handler), received_count_(0), received_bytes_(0) {
+        }
+
+        ResponseCode ReadIngestBenchmark::RunSample() {
+            int socket_fds[2];
+            if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, socket_fds)) {
+                AWS_LOG_ERROR(LOG_TAG_READ_INGEST_BENCHMARK, "Unable to create socket pair, errno %d", errno);
+                return ResponseCode::FAILURE;
+            }
+
+            std::shared_ptr<mqtt::ClientState> p_client_state =
+                mqtt::ClientState::Create(std::chrono::milliseconds(SOCKET_READ_TIMEOUT_MS));
+            std::atomic<uint64_t> &received_count = received_count_;
+            std::atomic<uint64_t> &received_bytes = received_bytes_;
+            std::shared_ptr<mqtt::Subscription> p_subscription;
+            if (use_view_handler_) {
+                mqtt::Subscription::ApplicationViewCallbackHandlerPtr p_app_view_handler =
+                    [&received_count, &received_bytes](const util::SharedBufferView &topic_name,
+                                                       const util::SharedBufferView &payload,
+                                                       std::shared_ptr<mqtt::SubscriptionHandlerContextData> p_app_handler_data) {
+                        received_bytes += payload.Length();
+                        received_count++;
+                        return ResponseCode::SUCCESS;
+                    };
+                p_subscription = mqtt::Subscription::CreateWithViewHandler(Utf8String::Create(BENCHMARK_TOPIC),
+                                                                           mqtt::QoS::QOS0, p_app_view_handler,
+                                                                           nullptr);
+            } else {
+                mqtt::Subscription::ApplicationCallbackHandlerPtr p_app_handler =
+                    [&received_count, &received_bytes](util::String topic_name, util::String payload,
+                                                       std::shared_ptr<mqtt::SubscriptionHandlerContextData> p_app_handler_data) {
+                        received_bytes += payload.length();
+                        received_count++;
+                        return ResponseCode::SUCCESS;
+                    };
+                p_subscription = mqtt::Subscription::Create(Utf8String::Create(BENCHMARK_TOPIC), mqtt::QoS::QOS0,
+                                                            p_app_handler, nullptr);
+            }
+            p_client_state->AddSubscription(p_subscription);
+            p_subscription->SetActive(true);
+
+            std::shared_ptr<SocketNetworkConnection>
+                p_network_connection = std::make_shared<SocketNetworkConnection>(socket_fds[0]);
+            std::shared_ptr<BytewiseReadRunner> p_read_runner = std::make_shared<BytewiseReadRunner>(p_client_state);
+            std::shared_ptr<std::atomic_bool> p_thread_continue = std::make_shared<std::atomic_bool>(true);
+            p_read_runner->SetParentThreadSync(p_thread_continue);
+
+            // Batches of packets are written with one send, as a broker flushing its queue would
+            util::String payload(payload_size_, 'x');
+            util::String packet_batch;
+            for (size_t itr = 0; itr < WRITER_BATCH_SIZE; itr++) {
+                packet_batch += mqtt::PublishPacket::Create(Utf8String::Create(BENCHMARK_TOPIC), false, false,
+                                                            mqtt::QoS::QOS0, payload)->ToString();
+            }
+            size_t packet_size = packet_batch.length() / WRITER_BATCH_SIZE;
+            std::cout << "Messages : " << message_count_ << ", Packet size : " << packet_size << " bytes, Mode : "
+                      << (use_read_ahead_ ? "buffered" : "bytewise") << ", Handler : "
+                      << (use_view_handler_ ? "view" : "string") << std::endl;
+
+            int writer_fd = socket_fds[1];
+            size_t message_count = message_count_;
+            std::thread writer_thread([writer_fd, message_count, &packet_batch, packet_size]() {
+                size_t remaining_count = message_count;
+                while (0 < remaining_count) {
+                    size_t batch_count = (remaining_count < WRITER_BATCH_SIZE) ? remaining_count : WRITER_BATCH_SIZE;
+                    const char *p_data = packet_batch.c_str();
+                    size_t remaining_bytes = batch_count * packet_size;
+                    while (0 < remaining_bytes) {
+                        ssize_t written_bytes = send(writer_fd, p_data, remaining_bytes, MSG_NOSIGNAL);
+                        if (0 >= written_bytes) {
+                            if (0 > written_bytes && EINTR == errno) {
+                                continue;
+                            }
+                            return;
+                        }
+                        p_data += written_bytes;
+                        remaining_bytes -= (size_t) written_bytes;
+                    }
+                    remaining_count -= batch_count;
+                }
+            });
+
+            ResponseCode rc = ResponseCode::SUCCESS;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            while (received_count_ < message_count_) {
+                std::chrono::microseconds next_step_delay(0);
+                if (use_read_ahead_) {
+                    rc = p_read_runner->PerformActionStep(p_network_connection, nullptr, next_step_delay);
+                } else {
+                    rc = p_read_runner->RunBytewiseStep(p_network_connection);
+                }
+                if (ResponseCode::SUCCESS != rc) {
+                    AWS_LOG_ERROR(LOG_TAG_READ_INGEST_BENCHMARK, "Read failed after %llu messages. %s",
+                                  (unsigned long long) received_count_.load(), ResponseHelper::ToString(rc).c_str());
+                    break;
+                }
+            }
+            std::chrono::duration<double> ingest_time = std::chrono::steady_clock::now() - start;
+
+            shutdown(socket_fds[0], SHUT_RDWR);
+            writer_thread.join();
+            close(socket_fds[0]);
+            close(socket_fds[1]);
+
+            uint64_t socket_read_count = p_network_connection->GetSocketReadCount();
+            std::cout << "Received " << received_count_ << " messages in " << ingest_time.count() << " s, "
+                      << (double) received_count_ / ingest_time.count() << " msgs/s" << std::endl;
+            std::cout << "Socket reads : " << socket_read_count << ", "
+                      << ((0 == received_count_) ? 0.0 : (double) socket_read_count / (double) received_count_)
+                      << " per message" << std::endl;
+            if (received_bytes_ != received_count_ * payload_size_) {
+                AWS_LOG_ERROR(LOG_TAG_READ_INGEST_BENCHMARK, "Received %llu payload bytes, expected %llu",
+                              (unsigned long long) received_bytes_.load(),
+                              (unsigned long long) (received_count_ * payload_size_));
+                rc = ResponseCode::FAILURE;
+            }
+            return rc;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    std::shared_ptr<awsiotsdk::util::Logging::ConsoleLogSystem> p_log_system =
+        std::make_shared<awsiotsdk::util::Logging::ConsoleLogSystem>(awsiotsdk::util::Logging::LogLevel::Warn);
+    awsiotsdk::util::Logging::InitializeAWSLogging(p_log_system);
+
+    size_t message_count = (1 < argc) ? (size_t) strtoul(argv[1], nullptr, 10) : DEFAULT_MESSAGE_COUNT;
+    bool use_read_ahead = (2 < argc) ? (0 != strcmp(argv[2], "bytewise")) : true;
+    size_t payload_size = (3 < argc) ? (size_t) strtoul(argv[3], nullptr, 10) : DEFAULT_PAYLOAD_SIZE;
+    bool use_view_handler = (4 < argc) ? (0 == strcmp(argv[4], "view")) : false;
+
+    awsiotsdk::samples::ReadIngestBenchmark benchmark(message_count, use_read_ahead, payload_size, use_view_handler);
+    awsiotsdk::ResponseCode rc = benchmark.RunSample();
+    std::cout << "Exiting Sample! " << awsiotsdk::ResponseHelper::ToString(rc) << std::endl;
+
+    awsiotsdk::util::Logging::ShutdownAWSLogging();
+    return static_cast<int>(rc);
+}
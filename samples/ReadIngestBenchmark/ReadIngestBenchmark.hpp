@@ -0,0 +1,107 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file ReadIngestBenchmark.hpp
+ * @brief Benchmark of the inbound packet reader ingesting many small PUBLISH packets from a local socket
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "NetworkConnection.hpp"
+#include "mqtt/ClientState.hpp"
+#include "mqtt/NetworkRead.hpp"
+
+namespace awsiotsdk {
+    namespace samples {
+        /**
+         * @brief Network connection over a connected local stream socket, without TLS
+         *
+         * Counts the reads made on the socket so the benchmark can report reads per packet.
+         */
+        class SocketNetworkConnection : public NetworkConnection {
+        protected:
+            int socket_fd_;                                 ///< Connected socket, owned by the caller
+            std::atomic<uint64_t> socket_read_count_;       ///< Number of recv calls that returned data
+
+            ResponseCode ConnectInternal() { return ResponseCode::SUCCESS; }
+            ResponseCode DisconnectInternal() { return ResponseCode::SUCCESS; }
+            ResponseCode WriteInternal(const util::String &buf, size_t &size_written_bytes_out);
+            ResponseCode ReadInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+                                      size_t size_bytes_to_read, size_t &size_read_bytes_out);
+            ResponseCode ReadAvailableInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+                                               size_t min_bytes_to_read, size_t max_bytes_to_read,
+                                               size_t &size_read_bytes_out);
+
+            /**
+             * @brief Wait until the socket is readable
+             *
+             * @return ResponseCode - SUCCESS, NETWORK_SSL_NOTHING_TO_READ on timeout or NETWORK_SSL_READ_ERROR
+             */
+            ResponseCode WaitForData();
+
+        public:
+            SocketNetworkConnection(int socket_fd) : socket_fd_(socket_fd), socket_read_count_(0) {}
+
+            bool IsConnected() { return true; }
+            bool IsPhysicalLayerConnected() { return true; }
+
+            uint64_t GetSocketReadCount() { return socket_read_count_; }
+        };
+
+        /**
+         * @brief Read Ingest Benchmark
+         *
+         * A writer thread sends message_count QoS0 PUBLISH packets with a payload of payload_size bytes over a local
+         * socket pair as fast as it can. The reader side handles them either with NetworkReadActionRunner, which
+         * reads ahead into the receive buffer of the connection, or with the previous approach of one network read
+         * for the fixed header byte, one per remaining length byte and one for the rest of the packet. Messages are
+         * delivered to a String handler or to a view handler. Reports messages per second and socket reads per
+         * message.
+         */
+        class ReadIngestBenchmark {
+        protected:
+            size_t message_count_;
+            bool use_read_ahead_;
+            size_t payload_size_;
+            bool use_view_handler_;
+            std::atomic<uint64_t> received_count_;
+            std::atomic<uint64_t> received_bytes_;
+
+            /**
+             * @brief Read runner that can also frame packets the way NetworkReadActionRunner used to
+             */
+            class BytewiseReadRunner : public mqtt::NetworkReadActionRunner {
+            public:
+                BytewiseReadRunner(std::shared_ptr<mqtt::ClientState> p_client_state)
+                    : mqtt::NetworkReadActionRunner(p_client_state) {}
+
+                /**
+                 * @brief Read and handle one packet with separate reads for every header byte
+                 */
+                ResponseCode RunBytewiseStep(std::shared_ptr<NetworkConnection> p_network_connection);
+            };
+
+        public:
+            ReadIngestBenchmark(size_t message_count, bool use_read_ahead, size_t payload_size, bool use_view_handler);
+
+            ResponseCode RunSample();
+        };
+    }
+}
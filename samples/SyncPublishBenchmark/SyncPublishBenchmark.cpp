@@ -0,0 +1,190 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file SyncPublishBenchmark.cpp
+ * @brief Benchmark of synchronous QoS1 publish throughput from concurrent threads
+ *
+ * Usage : sync-publish-benchmark-sample [publishes_per_thread] [ack_latency_ms]
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#include "util/logging/Logging.hpp"
+#include "util/logging/LogMacros.hpp"
+#include "util/logging/ConsoleLogSystem.hpp"
+#include "util/memory/stl/Vector.hpp"
+#include "mqtt/Publish.hpp"
+
+#include "SyncPublishBenchmark.hpp"
+
+#define LOG_TAG_SYNC_PUBLISH_BENCHMARK "[Sample - SyncPublishBenchmark]"
+
+#define DEFAULT_PUBLISHES_PER_THREAD 100
+#define DEFAULT_ACK_LATENCY_MS 2
+
+#define BENCHMARK_TOPIC "bench/sync"
+#define BENCHMARK_PAYLOAD "Hello From C++ SDK Benchmark"
+
+#define MQTT_COMMAND_TIMEOUT_MS 2000
+
+namespace awsiotsdk {
+    namespace samples {
+        ResponseCode AckingNetworkConnection::WriteInternal(const util::String &buf, size_t &size_written_bytes_out) {
+            // Fixed header, remaining length, topic name, then the packet ID of a QoS1 Publish
+            size_t index = 1;
+            while (index < buf.length() && 0 != (buf[index] & 0x80)) {
+                index++;
+            }
+            index++;
+            if (index + 2 > buf.length()) {
+                return ResponseCode::NETWORK_SSL_WRITE_ERROR;
+            }
+            size_t topic_len = ((unsigned char) buf[index] << 8) | (unsigned char) buf[index + 1];
+            index += 2 + topic_len;
+            if (index + 2 > buf.length()) {
+                return ResponseCode::NETWORK_SSL_WRITE_ERROR;
+            }
+            uint16_t packet_id = (uint16_t) (((unsigned char) buf[index] << 8) | (unsigned char) buf[index + 1]);
+            {
+                std::lock_guard<std::mutex> broker_guard(broker_lock_);
+                pending_pubacks_.push_back(std::make_pair(std::chrono::steady_clock::now() + ack_latency_, packet_id));
+            }
+            broker_wait_.notify_one();
+            size_written_bytes_out = buf.length();
+            return ResponseCode::SUCCESS;
+        }
+
+        ResponseCode AckingNetworkConnection::ReadInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+                                                           size_t size_bytes_to_read, size_t &size_read_bytes_out) {
+            size_read_bytes_out = 0;
+            return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+        }
+
+        void AckingNetworkConnection::RunBroker(std::shared_ptr<mqtt::ClientState> p_client_state) {
+            // Fixed latency, so Pubacks are due in the order the Publishes were written
+            std::unique_lock<std::mutex> broker_guard(broker_lock_);
+            while (is_broker_running_) {
+                if (pending_pubacks_.empty()) {
+                    broker_wait_.wait(broker_guard);
+                    continue;
+                }
+                PendingPuback puback = pending_pubacks_.front();
+                if (std::chrono::steady_clock::now() < puback.first) {
+                    broker_wait_.wait_until(broker_guard, puback.first);
+                    continue;
+                }
+                pending_pubacks_.pop_front();
+                broker_guard.unlock();
+                p_client_state->ForwardReceivedAck(puback.second, ResponseCode::SUCCESS);
+                broker_guard.lock();
+            }
+        }
+
+        void AckingNetworkConnection::StopBroker() {
+            {
+                std::lock_guard<std::mutex> broker_guard(broker_lock_);
+                is_broker_running_ = false;
+            }
+            broker_wait_.notify_one();
+        }
+
+        SyncPublishBenchmark::SyncPublishBenchmark(size_t publishes_per_thread, std::chrono::milliseconds ack_latency)
+            : publishes_per_thread_(publishes_per_thread), ack_latency_(ack_latency) {
+        }
+
+        ResponseCode SyncPublishBenchmark::RunThreads(size_t thread_count) {
+            std::shared_ptr<mqtt::ClientState> p_client_state =
+                mqtt::ClientState::Create(std::chrono::milliseconds(MQTT_COMMAND_TIMEOUT_MS));
+            std::shared_ptr<AckingNetworkConnection> p_network_connection =
+                std::make_shared<AckingNetworkConnection>(ack_latency_);
+            p_client_state->p_network_connection_ = p_network_connection;
+            ResponseCode rc = p_client_state->RegisterAction(ActionType::PUBLISH, mqtt::PublishActionAsync::Create,
+                                                             p_client_state);
+            if (ResponseCode::SUCCESS != rc) {
+                return rc;
+            }
+
+            std::thread broker(&AckingNetworkConnection::RunBroker, p_network_connection.get(), p_client_state);
+            std::atomic_size_t failed_count(0);
+            util::Vector<std::thread> publishers;
+            size_t publishes_per_thread = publishes_per_thread_;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (size_t itr = 0; itr < thread_count; itr++) {
+                publishers.push_back(std::thread([p_client_state, publishes_per_thread, &failed_count]() {
+                    for (size_t publish_itr = 0; publish_itr < publishes_per_thread; publish_itr++) {
+                        std::shared_ptr<mqtt::PublishPacket> p_publish_packet = mqtt::PublishPacket::Create(
+                            Utf8String::Create(BENCHMARK_TOPIC), false, false, mqtt::QoS::QOS1, BENCHMARK_PAYLOAD);
+                        if (ResponseCode::SUCCESS != p_client_state->PerformAction(
+                            ActionType::PUBLISH, p_publish_packet, std::chrono::milliseconds(MQTT_COMMAND_TIMEOUT_MS))) {
+                            failed_count++;
+                        }
+                    }
+                }));
+            }
+            for (std::thread &publisher : publishers) {
+                publisher.join();
+            }
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            p_network_connection->StopBroker();
+            broker.join();
+            // Registered actions refer to the client state
+            p_client_state->ClearRegisteredActions();
+
+            double publish_count = static_cast<double>(thread_count * publishes_per_thread);
+            std::cout << "Threads : " << thread_count << ", " << (uint64_t) (publish_count / elapsed.count())
+                      << " publishes/s" << std::endl;
+            if (0 != failed_count) {
+                AWS_LOG_ERROR(LOG_TAG_SYNC_PUBLISH_BENCHMARK, "%zu publishes failed", failed_count.load());
+                return ResponseCode::FAILURE;
+            }
+            return ResponseCode::SUCCESS;
+        }
+
+        ResponseCode SyncPublishBenchmark::RunSample() {
+            std::cout << "Publishes per thread : " << publishes_per_thread_ << ", Puback latency : "
+                      << ack_latency_.count() << " ms" << std::endl;
+            const size_t thread_counts[] = {1, 4, 16};
+            for (size_t thread_count : thread_counts) {
+                ResponseCode rc = RunThreads(thread_count);
+                if (ResponseCode::SUCCESS != rc) {
+                    return rc;
+                }
+            }
+            return ResponseCode::SUCCESS;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    std::shared_ptr<awsiotsdk::util::Logging::ConsoleLogSystem> p_log_system =
+        std::make_shared<awsiotsdk::util::Logging::ConsoleLogSystem>(awsiotsdk::util::Logging::LogLevel::Warn);
+    awsiotsdk::util::Logging::InitializeAWSLogging(p_log_system);
+
+    size_t publishes_per_thread = (1 < argc) ? (size_t) strtoul(argv[1], nullptr, 10) : DEFAULT_PUBLISHES_PER_THREAD;
+    long ack_latency_ms = (2 < argc) ? strtol(argv[2], nullptr, 10) : DEFAULT_ACK_LATENCY_MS;
+
+    awsiotsdk::samples::SyncPublishBenchmark benchmark(publishes_per_thread,
+                                                       std::chrono::milliseconds(ack_latency_ms));
+    awsiotsdk::ResponseCode rc = benchmark.RunSample();
+    std::cout << "Exiting Sample! " << awsiotsdk::ResponseHelper::ToString(rc) << std::endl;
+
+    awsiotsdk::util::Logging::ShutdownAWSLogging();
+    return static_cast<int>(rc);
+}
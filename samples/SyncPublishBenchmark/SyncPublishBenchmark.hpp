@@ -0,0 +1,95 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file SyncPublishBenchmark.hpp
+ * @brief Benchmark of synchronous QoS1 publish throughput from concurrent threads
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include "NetworkConnection.hpp"
+#include "mqtt/ClientState.hpp"
+
+namespace awsiotsdk {
+    namespace samples {
+        /**
+         * @brief Network connection that stands in for a broker acknowledging every QoS1 Publish after a fixed latency
+         *
+         * Writes are parsed for their packet ID, RunBroker forwards the Pubacks to the client state once they are due
+         */
+        class AckingNetworkConnection : public NetworkConnection {
+        protected:
+            typedef std::pair<std::chrono::steady_clock::time_point, uint16_t> PendingPuback;
+
+            std::chrono::milliseconds ack_latency_;         ///< Time between a write and its Puback
+            std::mutex broker_lock_;                        ///< Guards pending_pubacks_ and is_broker_running_
+            std::condition_variable broker_wait_;           ///< Wakes up the broker thread
+            std::deque<PendingPuback> pending_pubacks_;     ///< Pubacks in the order they are due
+            bool is_broker_running_;                        ///< Cleared by StopBroker
+
+            ResponseCode ConnectInternal() { return ResponseCode::SUCCESS; }
+            ResponseCode DisconnectInternal() { return ResponseCode::SUCCESS; }
+            ResponseCode WriteInternal(const util::String &buf, size_t &size_written_bytes_out);
+            ResponseCode ReadInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+                                      size_t size_bytes_to_read, size_t &size_read_bytes_out);
+
+        public:
+            AckingNetworkConnection(std::chrono::milliseconds ack_latency)
+                : ack_latency_(ack_latency), is_broker_running_(true) {}
+
+            bool IsConnected() { return true; }
+            bool IsPhysicalLayerConnected() { return true; }
+
+            /**
+             * @brief Forward Pubacks to the client state as they become due, until StopBroker is called
+             *
+             * @param p_client_state - Client state waiting for the Pubacks
+             */
+            void RunBroker(std::shared_ptr<mqtt::ClientState> p_client_state);
+
+            void StopBroker();
+        };
+
+        /**
+         * @brief Sync Publish Benchmark
+         *
+         * Runs publishes_per_thread synchronous QoS1 publishes from each of 1, 4 and 16 threads through the Publish
+         * action of a mqtt::ClientState, against a stand-in broker that acknowledges every Publish after
+         * ack_latency_ms. Reports the aggregate publishes per second for each thread count. Blocking calls wait for
+         * their Pubacks concurrently, so the throughput grows with the number of threads instead of being limited to
+         * one round trip at a time.
+         */
+        class SyncPublishBenchmark {
+        protected:
+            size_t publishes_per_thread_;
+            std::chrono::milliseconds ack_latency_;
+
+            ResponseCode RunThreads(size_t thread_count);
+
+        public:
+            SyncPublishBenchmark(size_t publishes_per_thread, std::chrono::milliseconds ack_latency);
+
+            ResponseCode RunSample();
+        };
+    }
+}
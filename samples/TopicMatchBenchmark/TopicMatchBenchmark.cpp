@@ -0,0 +1,255 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TopicMatchBenchmark.cpp
+ * @brief Microbenchmark comparing topic trie matching with per message regex matching of subscriptions
+ *
+ * Usage : topic-match-benchmark-sample [subscription_count] [message_count]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <regex>
+
+#include "util/logging/Logging.hpp"
+#include "util/logging/LogMacros.hpp"
+#include "util/logging/ConsoleLogSystem.hpp"
+
+#include "TopicMatchBenchmark.hpp"
+
+#define LOG_TAG_TOPIC_MATCH_BENCHMARK "[Sample - TopicMatchBenchmark]"
+
+#define DEFAULT_SUBSCRIPTION_COUNT 200
+#define DEFAULT_MESSAGE_COUNT 2000
+
+// Every UNMATCHED_TOPIC_INTERVAL th message is published on a topic no subscription matches
+#define UNMATCHED_TOPIC_INTERVAL 16
+
+// Subscription counts of the subscribe scaling runs
+#define SUBSCRIBE_SCALING_COUNTS {1000, 5000, 20000}
+
+namespace awsiotsdk {
+    namespace samples {
+        TopicMatchBenchmark::TopicMatchBenchmark(size_t subscription_count, size_t message_count) {
+            subscription_count_ = (0 == subscription_count) ? 1 : subscription_count;
+            message_count_ = message_count;
+        }
+
+        ResponseCode TopicMatchBenchmark::CreateSubscriptions() {
+            mqtt::Subscription::ApplicationCallbackHandlerPtr p_app_handler =
+                [](util::String topic_name, util::String payload,
+                   std::shared_ptr<mqtt::SubscriptionHandlerContextData> p_app_handler_data) {
+                    return ResponseCode::SUCCESS;
+                };
+
+            // Half of the filters are exact, a quarter use '+' and a quarter use '#'
+            for (size_t itr = 0; itr < subscription_count_; itr++) {
+                util::String index = std::to_string(itr);
+                util::String topic_filter;
+                switch (itr % 4) {
+                    case 0:
+                        topic_filter = "devices/" + index + "/telemetry";
+                        break;
+                    case 1:
+                        topic_filter = "devices/" + index + "/+/status";
+                        break;
+                    case 2:
+                        topic_filter = "fleet/" + index + "/#";
+                        break;
+                    default:
+                        topic_filter = "devices/" + index + "/config";
+                        break;
+                }
+
+                std::shared_ptr<mqtt::Subscription> p_subscription =
+                    mqtt::Subscription::Create(Utf8String::Create(topic_filter), mqtt::QoS::QOS0, p_app_handler,
+                                               nullptr);
+                if (nullptr == p_subscription) {
+                    AWS_LOG_ERROR(LOG_TAG_TOPIC_MATCH_BENCHMARK, "Invalid topic filter %s", topic_filter.c_str());
+                    return ResponseCode::FAILURE;
+                }
+                subscription_map_.insert(std::make_pair(topic_filter, p_subscription));
+                subscription_trie_.Insert(topic_filter, p_subscription);
+            }
+            return ResponseCode::SUCCESS;
+        }
+
+        void TopicMatchBenchmark::CreateTopicNames() {
+            for (size_t itr = 0; itr < message_count_; itr++) {
+                util::String index = std::to_string(itr % subscription_count_);
+                util::String variant = std::to_string(itr % 8);
+                if (UNMATCHED_TOPIC_INTERVAL - 1 == itr % UNMATCHED_TOPIC_INTERVAL) {
+                    topic_names_.push_back("unknown/" + index + "/telemetry");
+                    continue;
+                }
+                switch ((itr % subscription_count_) % 4) {
+                    case 0:
+                        topic_names_.push_back("devices/" + index + "/telemetry");
+                        break;
+                    case 1:
+                        topic_names_.push_back("devices/" + index + "/sensor" + variant + "/status");
+                        break;
+                    case 2:
+                        topic_names_.push_back("fleet/" + index + "/region/" + variant);
+                        break;
+                    default:
+                        topic_names_.push_back("devices/" + index + "/config");
+                        break;
+                }
+            }
+        }
+
+        std::shared_ptr<mqtt::Subscription> TopicMatchBenchmark::MatchWithRegex(const util::String &topic_name) {
+            // Same search ClientState::GetSubscription performed before it used mqtt::TopicTrie
+            util::Map<util::String, std::shared_ptr<mqtt::Subscription>>::const_iterator find_itr =
+                std::find_if(subscription_map_.begin(),
+                             subscription_map_.end(),
+                             [&topic_name](const std::pair<util::String, std::shared_ptr<mqtt::Subscription>> &s) {
+                                 if (s.first == topic_name) {
+                                     return true;
+                                 }
+                                 if (0 < s.second->p_topic_regex_.length()) {
+                                     std::regex wildcard_regex(s.second->p_topic_regex_, std::regex::ECMAScript);
+                                     return std::regex_match(topic_name.c_str(), wildcard_regex);
+                                 }
+                                 return false;
+                             });
+            return (subscription_map_.end() == find_itr) ? nullptr : find_itr->second;
+        }
+
+        ResponseCode TopicMatchBenchmark::RunSubscribeScaling(size_t subscription_count, size_t topics_per_packet) {
+            mqtt::Subscription::ApplicationCallbackHandlerPtr p_app_handler =
+                [](util::String topic_name, util::String payload,
+                   std::shared_ptr<mqtt::SubscriptionHandlerContextData> p_app_handler_data) {
+                    return ResponseCode::SUCCESS;
+                };
+
+            util::Vector<util::Vector<std::shared_ptr<mqtt::Subscription>>> packets;
+            for (size_t itr = 0; itr < subscription_count; itr++) {
+                if (0 == itr % topics_per_packet) {
+                    packets.push_back(util::Vector<std::shared_ptr<mqtt::Subscription>>());
+                }
+                util::String topic_filter = "devices/dev" + std::to_string(itr) + "/cmd";
+                packets.back().push_back(mqtt::Subscription::Create(Utf8String::Create(topic_filter),
+                                                                    mqtt::QoS::QOS0, p_app_handler, nullptr));
+            }
+
+            std::shared_ptr<mqtt::ClientState> p_client_state =
+                mqtt::ClientState::Create(std::chrono::milliseconds(200));
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (const util::Vector<std::shared_ptr<mqtt::Subscription>> &packet : packets) {
+                ResponseCode rc = p_client_state->AddSubscriptions(packet);
+                if (ResponseCode::SUCCESS != rc) {
+                    return rc;
+                }
+            }
+            std::chrono::duration<double, std::milli> add_time = std::chrono::steady_clock::now() - start;
+
+            util::String last_topic_filter = "devices/dev" + std::to_string(subscription_count - 1) + "/cmd";
+            if (nullptr == p_client_state->GetSubscription(last_topic_filter)) {
+                AWS_LOG_ERROR(LOG_TAG_TOPIC_MATCH_BENCHMARK, "%s is not matched", last_topic_filter.c_str());
+                return ResponseCode::FAILURE;
+            }
+
+            std::cout << "Subscribe " << subscription_count << " topics, " << topics_per_packet
+                      << " per packet : " << add_time.count() << " ms, "
+                      << add_time.count() * 1000 / static_cast<double>(subscription_count) << " us per subscription"
+                      << std::endl;
+            return ResponseCode::SUCCESS;
+        }
+
+        ResponseCode TopicMatchBenchmark::RunSample() {
+            ResponseCode rc = CreateSubscriptions();
+            if (ResponseCode::SUCCESS != rc) {
+                return rc;
+            }
+            CreateTopicNames();
+
+            std::cout << "Subscriptions : " << subscription_count_ << ", Messages : " << message_count_ << std::endl;
+
+            util::Vector<std::shared_ptr<mqtt::Subscription>> regex_results;
+            regex_results.reserve(message_count_);
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (const util::String &topic_name : topic_names_) {
+                regex_results.push_back(MatchWithRegex(topic_name));
+            }
+            std::chrono::duration<double, std::micro> regex_time = std::chrono::steady_clock::now() - start;
+
+            util::Vector<util::Vector<std::shared_ptr<mqtt::Subscription>>> trie_results(message_count_);
+            start = std::chrono::steady_clock::now();
+            for (size_t itr = 0; itr < message_count_; itr++) {
+                subscription_trie_.Match(topic_names_[itr], trie_results[itr]);
+            }
+            std::chrono::duration<double, std::micro> trie_time = std::chrono::steady_clock::now() - start;
+
+            // The regex search stops at the first match, the trie returns every match
+            size_t matched_count = 0;
+            size_t mismatch_count = 0;
+            for (size_t itr = 0; itr < message_count_; itr++) {
+                const util::Vector<std::shared_ptr<mqtt::Subscription>> &matches = trie_results[itr];
+                if (nullptr == regex_results[itr]) {
+                    mismatch_count += matches.empty() ? 0 : 1;
+                    continue;
+                }
+                matched_count++;
+                if (matches.end() == std::find(matches.begin(), matches.end(), regex_results[itr])) {
+                    mismatch_count++;
+                }
+            }
+
+            double message_count = (0 == message_count_) ? 1.0 : static_cast<double>(message_count_);
+            std::cout << "Matched " << matched_count << " of " << message_count_ << " topics" << std::endl;
+            std::cout << "Regex : " << regex_time.count() / message_count << " us per message" << std::endl;
+            std::cout << "Trie  : " << trie_time.count() / message_count << " us per message" << std::endl;
+            if (0 < trie_time.count()) {
+                std::cout << "Speedup : " << regex_time.count() / trie_time.count() << "x" << std::endl;
+            }
+
+            if (0 != mismatch_count) {
+                AWS_LOG_ERROR(LOG_TAG_TOPIC_MATCH_BENCHMARK, "%zu topics were matched differently", mismatch_count);
+                return ResponseCode::FAILURE;
+            }
+
+            for (size_t scaling_count : SUBSCRIBE_SCALING_COUNTS) {
+                for (size_t topics_per_packet : {(size_t) 1, (size_t) MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET}) {
+                    rc = RunSubscribeScaling(scaling_count, topics_per_packet);
+                    if (ResponseCode::SUCCESS != rc) {
+                        return rc;
+                    }
+                }
+            }
+            return ResponseCode::SUCCESS;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    std::shared_ptr<awsiotsdk::util::Logging::ConsoleLogSystem> p_log_system =
+        std::make_shared<awsiotsdk::util::Logging::ConsoleLogSystem>(awsiotsdk::util::Logging::LogLevel::Warn);
+    awsiotsdk::util::Logging::InitializeAWSLogging(p_log_system);
+
+    size_t subscription_count = (1 < argc) ? (size_t) strtoul(argv[1], nullptr, 10) : DEFAULT_SUBSCRIPTION_COUNT;
+    size_t message_count = (2 < argc) ? (size_t) strtoul(argv[2], nullptr, 10) : DEFAULT_MESSAGE_COUNT;
+
+    awsiotsdk::samples::TopicMatchBenchmark benchmark(subscription_count, message_count);
+    awsiotsdk::ResponseCode rc = benchmark.RunSample();
+    std::cout << "Exiting Sample! " << awsiotsdk::ResponseHelper::ToString(rc) << std::endl;
+
+    awsiotsdk::util::Logging::ShutdownAWSLogging();
+    return static_cast<int>(rc);
+}
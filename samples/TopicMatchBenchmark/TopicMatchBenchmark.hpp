@@ -0,0 +1,68 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TopicMatchBenchmark.hpp
+ * @brief Microbenchmark comparing topic trie matching with per message regex matching of subscriptions
+ *
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mqtt/ClientState.hpp"
+#include "mqtt/Common.hpp"
+#include "mqtt/TopicTrie.hpp"
+#include "util/memory/stl/Map.hpp"
+#include "util/memory/stl/String.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+namespace awsiotsdk {
+    namespace samples {
+        /**
+         * @brief Topic Match Benchmark
+         *
+         * Creates subscription_count Subscriptions, half of them with wildcard filters, and matches message_count
+         * topic names against them twice: once the way ClientState used to, with a linear search of the
+         * subscription map that builds a std::regex for every wildcard Subscription, and once with a
+         * mqtt::TopicTrie. Reports the time per message of both and checks that every topic is matched by both.
+         *
+         * Then adds 1000, 5000 and 20000 Subscriptions to a mqtt::ClientState, once with one SUBSCRIBE packet per
+         * topic and once with packets of MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET topics, and reports the time per
+         * Subscription. ClientState publishes a new matching snapshot per packet, so the time per Subscription
+         * stays close to flat as the count grows.
+         */
+        class TopicMatchBenchmark {
+        protected:
+            size_t subscription_count_;
+            size_t message_count_;
+
+            util::Map<util::String, std::shared_ptr<mqtt::Subscription>> subscription_map_;
+            mqtt::TopicTrie<std::shared_ptr<mqtt::Subscription>> subscription_trie_;
+            util::Vector<util::String> topic_names_;
+
+            ResponseCode CreateSubscriptions();
+            void CreateTopicNames();
+            std::shared_ptr<mqtt::Subscription> MatchWithRegex(const util::String &topic_name);
+            ResponseCode RunSubscribeScaling(size_t subscription_count, size_t topics_per_packet);
+
+        public:
+            TopicMatchBenchmark(size_t subscription_count, size_t message_count);
+
+            ResponseCode RunSample();
+        };
+    }
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/**
+ * @file Utf8ValidationBenchmark.cpp
+ * @brief Microbenchmark comparing Utf8String validation with per code point validation of topics and payloads
+ *
+ * Usage : utf8-validation-benchmark-sample [message_count] [payload_size]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "util/logging/Logging.hpp"
+#include "util/logging/LogMacros.hpp"
+#include "util/logging/ConsoleLogSystem.hpp"
+#include "util/Utf8String.hpp"
+
+#include "Utf8ValidationBenchmark.hpp"
+
+#define LOG_TAG_UTF8_VALIDATION_BENCHMARK "[Sample - Utf8ValidationBenchmark]"
+
+#define DEFAULT_MESSAGE_COUNT 10000
+#define DEFAULT_PAYLOAD_SIZE 512
+
+// Every INVALID_STRING_INTERVAL th string of a corpus has an invalid byte
+#define INVALID_STRING_INTERVAL 8
+
+// Every corpus is validated this many times by both validators
+#define VALIDATION_PASS_COUNT 20
+
+namespace awsiotsdk {
+    namespace samples {
+        Utf8ValidationBenchmark::Utf8ValidationBenchmark(size_t message_count, size_t payload_size) {
+            message_count_ = (0 == message_count) ? 1 : message_count;
+            payload_size_ = payload_size;
+        }
+
+        bool Utf8ValidationBenchmark::IsValidPerCodePoint(const util::String &str) {
+            // Same checks as the decoder Utf8String used for every code point before ASCII blocks were skipped
+            size_t index = 0;
+            size_t length = str.length();
+            while (index < length) {
+                uint32_t lead = static_cast<unsigned char>(str[index]);
+                size_t sequence_length;
+                uint32_t code_point;
+                if (lead < 0x80) {
+                    sequence_length = 1;
+                    code_point = lead;
+                } else if (0x6 == (lead >> 5)) {
+                    sequence_length = 2;
+                    code_point = lead & 0x1F;
+                } else if (0xE == (lead >> 4)) {
+                    sequence_length = 3;
+                    code_point = lead & 0x0F;
+                } else if (0x1E == (lead >> 3)) {
+                    sequence_length = 4;
+                    code_point = lead & 0x07;
+                } else {
+                    return false;
+                }
+                if (sequence_length > length - index) {
+                    return false;
+                }
+                for (size_t itr = 1; itr < sequence_length; itr++) {
+                    uint32_t trail = static_cast<unsigned char>(str[index + itr]);
+                    if (0x2 != (trail >> 6)) {
+                        return false;
+                    }
+                    code_point = (code_point << 6) | (trail & 0x3F);
+                }
+                bool is_overlong = (2 == sequence_length && code_point < 0x80)
+                    || (3 == sequence_length && code_point < 0x800)
+                    || (4 == sequence_length && code_point < 0x10000);
+                bool is_surrogate = (0xD800 <= code_point && code_point <= 0xDFFF);
+                if (is_overlong || is_surrogate || 0x10FFFF < code_point) {
+                    return false;
+                }
+                index += sequence_length;
+            }
+            return true;
+        }
+
+        void Utf8ValidationBenchmark::AddToCorpus(Corpus &corpus, util::String str, size_t index) {
+            bool is_valid = (INVALID_STRING_INTERVAL - 1 != index % INVALID_STRING_INTERVAL);
+            if (!is_valid) {
+                // Invalid lead byte near the end, so most of the string is validated before it is found
+                str[str.length() - str.length() / 8 - 1] = '\xFF';
+            }
+            corpus.total_bytes_ += str.length();
+            corpus.strings_.push_back(std::move(str));
+            corpus.expected_results_.push_back(is_valid);
+        }
+
+        void Utf8ValidationBenchmark::CreateCorpora() {
+            corpora_.resize(4);
+            corpora_[0].name_ = "Topics, ASCII";
+            corpora_[1].name_ = "Topics, non-ASCII";
+            corpora_[2].name_ = "Payloads, ASCII JSON";
+            corpora_[3].name_ = "Payloads, non-ASCII JSON";
+            for (Corpus &corpus : corpora_) {
+                corpus.total_bytes_ = 0;
+            }
+
+            for (size_t itr = 0; itr < message_count_; itr++) {
+                util::String index = std::to_string(itr);
+                switch (itr % 3) {
+                    case 0:
+                        AddToCorpus(corpora_[0], "$aws/things/thing-" + index + "/shadow/update", itr);
+                        AddToCorpus(corpora_[1], "capteurs/b\xC3\xA2timent-" + index + "/temp\xC3\xA9rature", itr);
+                        break;
+                    case 1:
+                        AddToCorpus(corpora_[0], "devices/" + index + "/telemetry", itr);
+                        AddToCorpus(corpora_[1], "\xE5\xB7\xA5\xE5\xA0\xB4/" + index
+                            + "/\xE3\x82\xBB\xE3\x83\xB3\xE3\x82\xB5\xE3\x83\xBC/\xE6\xB8\xA9\xE5\xBA\xA6", itr);
+                        break;
+                    default:
+                        AddToCorpus(corpora_[0], "fleet/region-" + index + "/sensors/humidity/status", itr);
+                        AddToCorpus(corpora_[1], "devices/" + index + "/status/\xF0\x9F\x94\x8B", itr);
+                        break;
+                }
+
+                // Payloads repeat readings until they reach the payload size
+                util::String ascii_payload = "{\"device\":\"thing-" + index + "\",\"readings\":[";
+                util::String unicode_payload = "{\"appareil\":\"capteur-" + index + "\",\"relev\xC3\xA9s\":[";
+                do {
+                    ascii_payload += "{\"temperature\":21.5,\"humidity\":40,\"status\":\"nominal\"},";
+                    unicode_payload += "{\"temp\xC3\xA9rature\":\"21.5\xC2\xB0" "C\",\"\xE7\x8A\xB6\xE6\x85\x8B\":"
+                        "\"\xE6\xAD\xA3\xE5\xB8\xB8\"},";
+                } while (ascii_payload.length() < payload_size_);
+                ascii_payload += "{}]}";
+                unicode_payload += "{}]}";
+                AddToCorpus(corpora_[2], std::move(ascii_payload), itr);
+                AddToCorpus(corpora_[3], std::move(unicode_payload), itr);
+            }
+        }
+
+        ResponseCode Utf8ValidationBenchmark::RunCorpus(const Corpus &corpus) {
+            size_t string_count = corpus.strings_.size();
+            size_t mismatch_count = 0;
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (size_t pass = 0; pass < VALIDATION_PASS_COUNT; pass++) {
+                for (size_t itr = 0; itr < string_count; itr++) {
+                    if (corpus.expected_results_[itr] != IsValidPerCodePoint(corpus.strings_[itr])) {
+                        mismatch_count++;
+                    }
+                }
+            }
+            std::chrono::duration<double, std::nano> per_code_point_time = std::chrono::steady_clock::now() - start;
+
+            start = std::chrono::steady_clock::now();
+            for (size_t pass = 0; pass < VALIDATION_PASS_COUNT; pass++) {
+                for (size_t itr = 0; itr < string_count; itr++) {
+                    if (corpus.expected_results_[itr] != Utf8String::IsValidInput(corpus.strings_[itr])) {
+                        mismatch_count++;
+                    }
+                }
+            }
+            std::chrono::duration<double, std::nano> utf8_string_time = std::chrono::steady_clock::now() - start;
+
+            double validation_count = static_cast<double>(string_count * VALIDATION_PASS_COUNT);
+            double validated_bytes = static_cast<double>(corpus.total_bytes_ * VALIDATION_PASS_COUNT);
+            std::cout << corpus.name_ << ", average length " << corpus.total_bytes_ / string_count << " bytes"
+                      << std::endl;
+            // Bytes per nanosecond are GB per second
+            std::cout << "  Per code point : " << per_code_point_time.count() / validation_count << " ns per string, "
+                      << validated_bytes / per_code_point_time.count() << " GB/s" << std::endl;
+            std::cout << "  Utf8String     : " << utf8_string_time.count() / validation_count << " ns per string, "
+                      << validated_bytes / utf8_string_time.count() << " GB/s" << std::endl;
+            if (0 < utf8_string_time.count()) {
+                std::cout << "  Speedup : " << per_code_point_time.count() / utf8_string_time.count() << "x"
+                          << std::endl;
+            }
+
+            if (0 != mismatch_count) {
+                AWS_LOG_ERROR(LOG_TAG_UTF8_VALIDATION_BENCHMARK, "%zu validations of %s had unexpected results",
+                              mismatch_count, corpus.name_.c_str());
+                return ResponseCode::FAILURE;
+            }
+            return ResponseCode::SUCCESS;
+        }
+
+        ResponseCode Utf8ValidationBenchmark::RunSample() {
+            CreateCorpora();
+            std::cout << "Strings per corpus : " << message_count_ << ", Payload size : " << payload_size_
+                      << " bytes" << std::endl;
+
+            ResponseCode rc = ResponseCode::SUCCESS;
+            for (const Corpus &corpus : corpora_) {
+                ResponseCode corpus_rc = RunCorpus(corpus);
+                if (ResponseCode::SUCCESS != corpus_rc) {
+                    rc = corpus_rc;
+                }
+            }
+            return rc;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    std::shared_ptr<awsiotsdk::util::Logging::ConsoleLogSystem> p_log_system =
+        std::make_shared<awsiotsdk::util::Logging::ConsoleLogSystem>(awsiotsdk::util::Logging::LogLevel::Warn);
+    awsiotsdk::util::Logging::InitializeAWSLogging(p_log_system);
+
+    size_t message_count = (1 < argc) ? (size_t) strtoul(argv[1], nullptr, 10) : DEFAULT_MESSAGE_COUNT;
+    size_t payload_size = (2 < argc) ? (size_t) strtoul(argv[2], nullptr, 10) : DEFAULT_PAYLOAD_SIZE;
+
+    awsiotsdk::samples::Utf8ValidationBenchmark benchmark(message_count, payload_size);
+    awsiotsdk::ResponseCode rc = benchmark.RunSample();
+    std::cout << "Exiting Sample! " << awsiotsdk::ResponseHelper::ToString(rc) << std::endl;
+
+    awsiotsdk::util::Logging::ShutdownAWSLogging();
+    return static_cast<int>(rc);
+}
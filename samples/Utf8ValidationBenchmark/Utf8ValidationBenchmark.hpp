@@ -0,0 +1,68 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/**
+ * @file Utf8ValidationBenchmark.hpp
+ * @brief Microbenchmark comparing Utf8String validation with per code point validation of topics and payloads
+ *
+ */
+
+#pragma once
+
+#include "ResponseCode.hpp"
+#include "util/memory/stl/String.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+namespace awsiotsdk {
+    namespace samples {
+        /**
+         * @brief UTF-8 Validation Benchmark
+         *
+         * Builds four corpora of message_count strings: ASCII topic names, topic names with non-ASCII levels, ASCII
+         * JSON payloads of about payload_size bytes and JSON payloads with non-ASCII text. Every eighth string of
+         * each corpus has an invalid byte. Validates every corpus with Utf8String::IsValidInput and with a per code
+         * point validator like the one Utf8String used before, reports the time per string and the throughput of
+         * both and checks that both agree on every string.
+         */
+        class Utf8ValidationBenchmark {
+        protected:
+            /**
+             * @brief Strings of one kind and the expected validation results
+             */
+            struct Corpus {
+                util::String name_;
+                util::Vector<util::String> strings_;
+                util::Vector<bool> expected_results_;
+                size_t total_bytes_;
+            };
+
+            size_t message_count_;
+            size_t payload_size_;
+            util::Vector<Corpus> corpora_;
+
+            static bool IsValidPerCodePoint(const util::String &str);
+
+            void AddToCorpus(Corpus &corpus, util::String str, size_t index);
+            void CreateCorpora();
+            ResponseCode RunCorpus(const Corpus &corpus);
+
+        public:
+            Utf8ValidationBenchmark(size_t message_count, size_t payload_size);
+
+            ResponseCode RunSample();
+        };
+    }
+}
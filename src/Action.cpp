@@ -26,12 +26,46 @@
 #include "Action.hpp"
 
 namespace awsiotsdk {
+    void ActionData::NotifyAckListeners(uint16_t action_id, ResponseCode rc) {
+        if (nullptr != p_async_ack_handler_) {
+            p_async_ack_handler_(action_id, rc);
+        }
+        if (nullptr != p_completion_token_) {
+            p_completion_token_->Complete(action_id, rc);
+        }
+    }
+
     Action::Action(ActionType action_type, util::String action_info_string) {
         p_thread_continue_ = std::make_shared<std::atomic_bool>(false); // Only one execution by default
         action_type_ = action_type;
         action_info_string_ = action_info_string;
     }
 
+    ResponseCode Action::PerformActionStep(std::shared_ptr<NetworkConnection> p_network_connection,
+                                           std::shared_ptr<ActionData> p_action_data,
+                                           std::chrono::microseconds &next_step_delay_out) {
+        IOT_UNUSED(p_network_connection);
+        IOT_UNUSED(p_action_data);
+        next_step_delay_out = std::chrono::microseconds(-1);
+        return ResponseCode::FAILURE;
+    }
+
+    ResponseCode Action::RunActionSteps(std::shared_ptr<NetworkConnection> p_network_connection,
+                                        std::shared_ptr<ActionData> p_action_data) {
+        ResponseCode rc = ResponseCode::SUCCESS;
+        std::atomic_bool &_p_thread_continue_ = *p_thread_continue_;
+        std::chrono::microseconds next_step_delay(0);
+        do {
+            rc = PerformActionStep(p_network_connection, p_action_data, next_step_delay);
+            if (0 > next_step_delay.count()) {
+                break;
+            } else if (0 < next_step_delay.count()) {
+                std::this_thread::sleep_for(next_step_delay);
+            }
+        } while (_p_thread_continue_);
+        return rc;
+    }
+
     ResponseCode Action::ReadFromNetworkBuffer(std::shared_ptr<NetworkConnection> p_network_connection,
                                                util::Vector<unsigned char> &read_buf,
                                                size_t bytes_to_read) {
@@ -72,32 +106,75 @@ namespace awsiotsdk {
 
     ResponseCode Action::WriteToNetworkBuffer(std::shared_ptr<NetworkConnection> p_network_connection,
                                               const util::String &write_buf) {
-        // TODO : Check if there are corner cases for this function not terminating until it has written the required number of bytes
-        // TODO : Is there a more efficient way to do this?
+        if (nullptr == p_network_connection) {
+            return ResponseCode::NULL_VALUE_ERROR;
+        } else if (write_buf.empty()) {
+            return ResponseCode::NETWORK_NOTHING_TO_WRITE_ERROR;
+        }
+
+        // Most writes complete at once, segments are only allocated to continue a partial write
+        size_t written_bytes = 0;
+        ResponseCode rc = p_network_connection->Write(write_buf, written_bytes);
+        if (ResponseCode::SUCCESS != rc || write_buf.length() == written_bytes) {
+            return rc;
+        } else if (0 == written_bytes || !*p_thread_continue_) {
+            return (*p_thread_continue_) ? ResponseCode::FAILURE : ResponseCode::THREAD_EXITING;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(DEFAULT_NETWORK_ACTION_THREAD_SLEEP_DURATION_MS));
+        util::Vector<WriteSegment> segments;
+        segments.push_back(WriteSegment(write_buf.data() + written_bytes, write_buf.length() - written_bytes));
+        return WriteToNetworkBuffer(p_network_connection, segments);
+    }
 
+    ResponseCode Action::WriteToNetworkBuffer(std::shared_ptr<NetworkConnection> p_network_connection,
+                                              const util::Vector<WriteSegment> &segments) {
         if (nullptr == p_network_connection) {
             return ResponseCode::NULL_VALUE_ERROR;
         }
 
-        if (0 == write_buf.length()) {
+        size_t bytes_to_write = 0;
+        for (const WriteSegment &segment : segments) {
+            bytes_to_write += segment.length_;
+        }
+        if (0 == bytes_to_write) {
             return ResponseCode::NETWORK_NOTHING_TO_WRITE_ERROR;
         }
 
         size_t total_written_bytes = 0;
-        size_t cur_written_bytes = 0;
-        size_t bytes_to_write = write_buf.length();
         ResponseCode rc = ResponseCode::FAILURE;
 
         std::atomic_bool &_p_thread_continue_ = *p_thread_continue_;
-        util::String temp_buf = write_buf;
+        // Segments are only copied after a partial write, the bytes they refer to never are
+        const util::Vector<WriteSegment> *p_remaining_segments = &segments;
+        util::Vector<WriteSegment> remaining_segments;
         do {
-            rc = p_network_connection->Write(temp_buf, cur_written_bytes);
+            size_t cur_written_bytes = 0;
+            rc = p_network_connection->WriteSegments(*p_remaining_segments, cur_written_bytes);
             total_written_bytes += cur_written_bytes;
-            if (total_written_bytes != bytes_to_write) {
-                temp_buf = write_buf.substr(total_written_bytes);
-                std::this_thread::sleep_for(std::chrono::milliseconds(DEFAULT_NETWORK_ACTION_THREAD_SLEEP_DURATION_MS));
+            if (ResponseCode::SUCCESS != rc || total_written_bytes == bytes_to_write || 0 == cur_written_bytes) {
+                break;
+            }
+
+            // Drop the bytes that were written from the front of the remaining segments
+            if (p_remaining_segments != &remaining_segments) {
+                remaining_segments = segments;
+                p_remaining_segments = &remaining_segments;
+            }
+            util::Vector<WriteSegment>::iterator itr = remaining_segments.begin();
+            while (0 < cur_written_bytes && remaining_segments.end() != itr) {
+                if (itr->length_ <= cur_written_bytes) {
+                    cur_written_bytes -= itr->length_;
+                    itr++;
+                } else {
+                    itr->p_data_ += cur_written_bytes;
+                    itr->length_ -= cur_written_bytes;
+                    cur_written_bytes = 0;
+                }
             }
-        } while (_p_thread_continue_ && total_written_bytes != cur_written_bytes && ResponseCode::SUCCESS == rc);
+            remaining_segments.erase(remaining_segments.begin(), itr);
+            std::this_thread::sleep_for(std::chrono::milliseconds(DEFAULT_NETWORK_ACTION_THREAD_SLEEP_DURATION_MS));
+        } while (_p_thread_continue_);
 
         if (ResponseCode::SUCCESS == rc && total_written_bytes != bytes_to_write) {
             if (!_p_thread_continue_) {
@@ -109,4 +186,4 @@ namespace awsiotsdk {
 
         return rc;
     }
-}
\ No newline at end of file
+}
@@ -35,11 +35,48 @@ namespace awsiotsdk {
         return std::unique_ptr<ClientCore>(new ClientCore(p_network_connection, p_state));
     }
 
+    std::unique_ptr<ClientCore> ClientCore::Create(std::shared_ptr<NetworkConnection> p_network_connection,
+                                                   std::shared_ptr<ClientCoreState> p_state,
+                                                   std::shared_ptr<util::Threading::Executor> p_executor) {
+        if (nullptr == p_network_connection || nullptr == p_state || nullptr == p_executor) {
+            return nullptr;
+        }
+
+        return std::unique_ptr<ClientCore>(new ClientCore(p_network_connection, p_state, p_executor));
+    }
+
     ClientCore::ClientCore(std::shared_ptr<NetworkConnection> p_network_connection,
-                           std::shared_ptr<ClientCoreState> p_state) {
+                           std::shared_ptr<ClientCoreState> p_state)
+        : ClientCore(p_network_connection, p_state, nullptr) {
+    }
+
+    ClientCore::ClientCore(std::shared_ptr<NetworkConnection> p_network_connection,
+                           std::shared_ptr<ClientCoreState> p_state,
+                           std::shared_ptr<util::Threading::Executor> p_executor) {
         p_client_core_state_ = p_state;
         p_client_core_state_->p_network_connection_ = p_network_connection;
         p_client_core_state_->SetProcessQueuedActions(false);
+        p_executor_ = p_executor;
+        task_sync_ = std::make_shared<std::atomic_bool>(true);
+
+        if (nullptr != p_executor_) {
+            std::shared_ptr<ClientCoreState> p_client_core_state = p_client_core_state_;
+            std::shared_ptr<util::Threading::Executor::Task> p_task = p_executor_->Schedule(
+                [p_client_core_state]() { return p_client_core_state->RunOutboundActionQueueStep(); },
+                std::chrono::microseconds(0));
+            task_map_.insert(std::make_pair(ActionType::CORE_PROCESS_OUTBOUND, p_task));
+
+            // Weak references only, the state must not keep the executor or the task alive
+            std::weak_ptr<util::Threading::Executor> p_weak_executor = p_executor_;
+            std::weak_ptr<util::Threading::Executor::Task> p_weak_task = p_task;
+            p_client_core_state_->SetOutboundActionWakeHandler([p_weak_executor, p_weak_task]() {
+                std::shared_ptr<util::Threading::Executor> p_executor = p_weak_executor.lock();
+                if (nullptr != p_executor) {
+                    p_executor->Wake(p_weak_task.lock());
+                }
+            });
+            return;
+        }
 
         std::shared_ptr<std::atomic_bool> thread_task_out_sync = std::make_shared<std::atomic_bool>(true);
         std::shared_ptr<util::Threading::ThreadTask> thread_task_out = std::shared_ptr<util::Threading::ThreadTask>(
@@ -54,6 +91,11 @@ namespace awsiotsdk {
         return p_client_core_state_->RegisterAction(action_type, p_action_create_handler, p_client_core_state_);
     }
 
+    ResponseCode ClientCore::StartAction(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
+                                         std::shared_ptr<CompletionToken> p_completion_token) {
+        return p_client_core_state_->StartAction(action_type, p_action_data, p_completion_token);
+    }
+
     ResponseCode ClientCore::PerformAction(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
                                            std::chrono::milliseconds action_reponse_timeout) {
         return p_client_core_state_->PerformAction(action_type, p_action_data, action_reponse_timeout);
@@ -64,6 +106,11 @@ namespace awsiotsdk {
         return p_client_core_state_->EnqueueOutboundAction(action_type, p_action_data, action_id_out);
     }
 
+    ResponseCode ClientCore::PerformActionAsync(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
+                                                ActionPriority priority, uint16_t &action_id_out) {
+        return p_client_core_state_->EnqueueOutboundAction(action_type, p_action_data, priority, action_id_out);
+    }
+
     ResponseCode ClientCore::CreateActionRunner(ActionType action_type, std::shared_ptr<ActionData> p_action_data) {
         Action::CreateHandlerPtr p_action_create_handler = nullptr;
         std::unique_ptr<Action> p_action = nullptr;
@@ -76,6 +123,55 @@ namespace awsiotsdk {
         p_action = p_action_create_handler(p_client_core_state_);
         if (nullptr == p_action) {
             rc = ResponseCode::NULL_VALUE_ERROR;
+        } else if (nullptr != p_executor_ && p_action->IsSteppable()) {
+            if (task_map_.end() != task_map_.find(action_type)) {
+                return rc;
+            }
+
+            std::shared_ptr<Action> p_runner = std::move(p_action);
+            std::shared_ptr<std::atomic_bool> task_sync = task_sync_;
+            std::shared_ptr<NetworkConnection> p_network_connection = p_client_core_state_->p_network_connection_;
+            p_runner->SetParentThreadSync(task_sync);
+            std::shared_ptr<util::Threading::Executor::Task> p_task = nullptr;
+            if (p_runner->WaitsForNetworkData()) {
+                std::weak_ptr<util::Threading::Executor> p_weak_executor = p_executor_;
+                std::shared_ptr<NetworkDataWatch> p_watch = std::make_shared<NetworkDataWatch>();
+                // Held until the task handle is stored, the first step waits for it instead of polling
+                std::lock_guard<std::mutex> watch_lock(p_watch->watch_lock_);
+                p_task = p_executor_->Schedule(
+                    [p_weak_executor, p_watch, p_runner, task_sync, p_network_connection, p_action_data]() {
+                        if (!(*task_sync)) {
+                            return std::chrono::microseconds(-1);
+                        }
+                        return RunWatchedActionStep(p_weak_executor, p_watch, p_runner, p_network_connection,
+                                                    p_action_data);
+                    }, std::chrono::microseconds(0));
+                p_watch->p_task_ = p_task;
+
+                // Parked on the descriptor of the previous connection until woken up
+                p_client_core_state_->SetNetworkConnectHandler([p_weak_executor, p_watch]() {
+                    p_watch->is_reconnected_ = true;
+                    std::shared_ptr<util::Threading::Executor> p_executor = p_weak_executor.lock();
+                    if (nullptr != p_executor) {
+                        std::shared_ptr<util::Threading::Executor::Task> p_task = nullptr;
+                        {
+                            std::lock_guard<std::mutex> watch_lock(p_watch->watch_lock_);
+                            p_task = p_watch->p_task_.lock();
+                        }
+                        p_executor->Wake(p_task);
+                    }
+                });
+            } else {
+                p_task = p_executor_->Schedule(
+                    [p_runner, task_sync, p_network_connection, p_action_data]() {
+                        std::chrono::microseconds next_step_delay(-1);
+                        if (*task_sync) {
+                            p_runner->PerformActionStep(p_network_connection, p_action_data, next_step_delay);
+                        }
+                        return next_step_delay;
+                    }, std::chrono::microseconds(0));
+            }
+            task_map_.insert(std::make_pair(action_type, p_task));
         } else {
             std::shared_ptr<std::atomic_bool> thread_task_sync = std::make_shared<std::atomic_bool>(true);
             p_action->SetParentThreadSync(thread_task_sync);
@@ -91,7 +187,68 @@ namespace awsiotsdk {
         return rc;
     }
 
+    std::chrono::microseconds ClientCore::RunWatchedActionStep(std::weak_ptr<util::Threading::Executor> p_weak_executor,
+                                                               std::shared_ptr<NetworkDataWatch> p_watch,
+                                                               std::shared_ptr<Action> p_runner,
+                                                               std::shared_ptr<NetworkConnection> p_network_connection,
+                                                               std::shared_ptr<ActionData> p_action_data) {
+        std::chrono::microseconds next_step_delay(-1);
+        std::shared_ptr<util::Threading::Executor> p_executor = p_weak_executor.lock();
+        std::shared_ptr<util::Threading::Executor::Task> p_task = nullptr;
+        {
+            std::lock_guard<std::mutex> watch_lock(p_watch->watch_lock_);
+            p_task = p_watch->p_task_.lock();
+        }
+
+        int descriptor = p_network_connection->GetPollDescriptor();
+        bool is_watch_supported = (nullptr != p_executor && nullptr != p_task && 0 <= descriptor);
+        if (is_watch_supported) {
+            bool is_ready = p_task->TakeDescriptorReady();
+            if (p_watch->is_reconnected_.exchange(false) || descriptor != p_watch->watched_descriptor_) {
+                // Reconnected, a watch on the previous socket is meaningless even if the new one reuses its number
+                p_watch->watched_descriptor_ = descriptor;
+                p_watch->is_armed_ = false;
+            }
+
+            // Woken up by something else while the descriptor is watched
+            if (p_watch->is_armed_ && !is_ready) {
+                return util::Threading::Executor::ParkedStepDelay();
+            }
+
+            p_watch->is_armed_ = false;
+            if (!p_runner->IsStepPending() && !p_network_connection->IsReadPending()) {
+                p_watch->is_armed_ = p_executor->Watch(p_task, descriptor);
+                if (p_watch->is_armed_) {
+                    return util::Threading::Executor::ParkedStepDelay();
+                }
+            }
+        } else {
+            p_watch->is_armed_ = false;
+            p_watch->watched_descriptor_ = descriptor;
+        }
+
+        p_runner->PerformActionStep(p_network_connection, p_action_data, next_step_delay);
+
+        // Steps only read what has arrived, wait for the rest of an incomplete packet instead of polling for it
+        if (is_watch_supported && 0 <= next_step_delay.count()
+            && descriptor == p_network_connection->GetPollDescriptor()
+            && !p_runner->IsStepPending() && !p_network_connection->IsReadPending()) {
+            p_watch->is_armed_ = p_executor->Watch(p_task, descriptor);
+            if (p_watch->is_armed_) {
+                return util::Threading::Executor::ParkedStepDelay();
+            }
+        }
+        return next_step_delay;
+    }
+
     ClientCore::~ClientCore() {
         thread_map_.clear();
+
+        // Cancel waits for running steps, runners see the cleared sync point if they are in a long running call
+        *task_sync_ = false;
+        for (auto &task : task_map_) {
+            p_executor_->Cancel(task.second);
+        }
+        task_map_.clear();
     }
 }
@@ -23,19 +23,43 @@
 
 #include "ClientCoreState.hpp"
 
-#ifndef MAX_CORE_ACTION_PROCESSING_RATE_HZ
-#define MAX_CORE_ACTION_PROCESSING_RATE_HZ 5
-#endif
-
 #define LOG_TAG_CLIENT_CORE_STATE "[Client Core State]"
 
 namespace awsiotsdk {
-    ClientCoreState::ClientCoreState() {
+    void ClientCoreState::PendingAckData::Notify(uint16_t action_id, ResponseCode rc) const {
+        if (nullptr != p_async_ack_handler_) {
+            p_async_ack_handler_(action_id, rc);
+        }
+        if (nullptr != p_completion_token_) {
+            p_completion_token_->Complete(action_id, rc);
+        }
+    }
+
+    ClientCoreState::ClientCoreState()
+        : pending_acks_((size_t) UINT16_MAX + 1),
+          dispatching_acks_((size_t) UINT16_MAX + 1, false),
+          pending_ack_timers_((size_t) UINT16_MAX + 1, 0),
+          outbound_rate_limiter_(DEFAULT_CORE_ACTION_PROCESSING_RATE_HZ, DEFAULT_CORE_ACTION_PROCESSING_BURST_SIZE) {
+        ack_timeout_ = std::chrono::milliseconds(DEFAULT_ACK_TIMEOUT_MS);
+        ack_timer_epoch_ = std::chrono::steady_clock::now();
+        // One lane per ActionPriority value
+        for (int itr = (int) ActionPriority::CONTROL; itr <= (int) ActionPriority::LOW; itr++) {
+            outbound_action_queues_.push_back(std::unique_ptr<OutboundActionQueue>(
+                new OutboundActionQueue(MAX_OUTBOUND_ACTION_QUEUE_CAPACITY)));
+            std::unique_ptr<OverflowState> p_overflow_state = std::unique_ptr<OverflowState>(new OverflowState());
+            p_overflow_state->policy_ = OverflowPolicy::DROP_NEWEST;
+            p_overflow_state->block_timeout_ms_ = DEFAULT_OUTBOUND_ACTION_BLOCK_TIMEOUT_MS;
+            p_overflow_state->dropped_action_count_ = 0;
+            outbound_overflow_states_.push_back(std::move(p_overflow_state));
+        }
         continue_execution_ = std::make_shared<std::atomic_bool>(true);
-        max_queue_size_ = DEFAULT_MAX_QUEUE_SIZE;
+        is_outbound_consumer_parked_ = false;
+        has_outbound_rate_limit_token_ = false;
+        blocked_producer_count_ = 0;
+        SetMaxActionQueueSize(DEFAULT_MAX_QUEUE_SIZE);
         max_hardware_threads_ = std::thread::hardware_concurrency();
         cur_core_threads_ = 0;
-        next_action_id_ = 1;
+        last_action_id_ = 0;
     }
 
     ClientCoreState::~ClientCoreState() {
@@ -66,21 +90,161 @@ namespace awsiotsdk {
         return rc;
     }
 
+    ActionPriority ClientCoreState::GetDefaultActionPriority(ActionType action_type) {
+        if (ActionType::PUBLISH == action_type) {
+            return ActionPriority::HIGH;
+        }
+        return ActionPriority::CONTROL;
+    }
+
     ResponseCode
     ClientCoreState::EnqueueOutboundAction(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
                                            uint16_t &action_id_out) {
-        if (outbound_action_queue_.size() >= max_queue_size_) {
-            // TODO : Add option to overwrite oldest action
-            return ResponseCode::ACTION_QUEUE_FULL;
+        return EnqueueOutboundAction(action_type, p_action_data, GetDefaultActionPriority(action_type), action_id_out);
+    }
+
+    ResponseCode
+    ClientCoreState::EnqueueOutboundAction(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
+                                           ActionPriority priority, uint16_t &action_id_out) {
+        OutboundActionQueue &outbound_action_queue = *outbound_action_queues_[(size_t) priority];
+        OverflowState &overflow_state = *outbound_overflow_states_[(size_t) priority];
+        OverflowPolicy policy = overflow_state.policy_;
+        std::chrono::steady_clock::time_point block_deadline;
+        if (OverflowPolicy::BLOCK == policy) {
+            block_deadline = std::chrono::steady_clock::now()
+                + std::chrono::milliseconds(overflow_state.block_timeout_ms_);
         }
 
-        action_id_out = GetNextActionId();
-        p_action_data->SetActionId(action_id_out);
-        outbound_action_queue_.push(std::make_pair(action_type, p_action_data));
+        OutboundAction outbound_action = std::make_pair(action_type, p_action_data);
+        bool has_action_id = false;
+        for (;;) {
+            if (outbound_action_queue.Size() < outbound_action_queue.GetMaxSize()) {
+                // IDs are only assigned to Actions that get a chance to be queued
+                if (!has_action_id) {
+                    action_id_out = GetNextActionId();
+                    p_action_data->SetActionId(action_id_out);
+                    has_action_id = true;
+                }
+                // Only moved from on success. On failure another producer took the last free slot
+                if (outbound_action_queue.TryPush(std::move(outbound_action))) {
+                    break;
+                }
+            }
 
+            if (OverflowPolicy::DROP_OLDEST == policy && 0 < outbound_action_queue.GetMaxSize()) {
+                OutboundAction dropped_action;
+                if (outbound_action_queue.TryPop(dropped_action)) {
+                    overflow_state.dropped_action_count_++;
+                    dropped_action.second->NotifyAckListeners(dropped_action.second->GetActionId(),
+                                                              ResponseCode::ACTION_QUEUE_FULL);
+                } else {
+                    // Consumer took the oldest Action first or a producer has not finished writing it yet
+                    std::this_thread::yield();
+                }
+            } else if (OverflowPolicy::BLOCK != policy
+                || !WaitForOutboundActionQueueSpace(outbound_action_queue, block_deadline)) {
+                overflow_state.dropped_action_count_++;
+                return ResponseCode::ACTION_QUEUE_FULL;
+            }
+        }
+
+        NotifyOutboundActionConsumer();
         return ResponseCode::SUCCESS;
     }
 
+    void ClientCoreState::SetOutboundActionOverflowPolicy(OverflowPolicy policy,
+                                                          std::chrono::milliseconds block_timeout) {
+        for (int itr = (int) ActionPriority::CONTROL; itr <= (int) ActionPriority::LOW; itr++) {
+            SetOutboundActionOverflowPolicy((ActionPriority) itr, policy, block_timeout);
+        }
+    }
+
+    void ClientCoreState::SetOutboundActionOverflowPolicy(ActionPriority priority, OverflowPolicy policy,
+                                                          std::chrono::milliseconds block_timeout) {
+        OverflowState &overflow_state = *outbound_overflow_states_[(size_t) priority];
+        overflow_state.policy_ = policy;
+        overflow_state.block_timeout_ms_ = block_timeout.count();
+    }
+
+    size_t ClientCoreState::GetDroppedActionCount() {
+        size_t dropped_action_count = 0;
+        for (auto &p_overflow_state : outbound_overflow_states_) {
+            dropped_action_count += p_overflow_state->dropped_action_count_;
+        }
+        return dropped_action_count;
+    }
+
+    void ClientCoreState::NotifyOutboundActionProducers() {
+        // Pairs with the increment in WaitForOutboundActionQueueSpace, same reasoning as NotifyOutboundActionConsumer
+        if (0 < blocked_producer_count_) {
+            std::lock_guard<std::mutex> wait_lock(outbound_space_wait_lock_);
+            outbound_space_wait_.notify_all();
+        }
+    }
+
+    bool ClientCoreState::WaitForOutboundActionQueueSpace(OutboundActionQueue &outbound_action_queue,
+                                                          std::chrono::steady_clock::time_point deadline) {
+        std::unique_lock<std::mutex> wait_lock(outbound_space_wait_lock_);
+        blocked_producer_count_++;
+        bool has_space = outbound_space_wait_.wait_until(wait_lock, deadline, [&outbound_action_queue] {
+            return outbound_action_queue.Size() < outbound_action_queue.GetMaxSize();
+        });
+        blocked_producer_count_--;
+        return has_space;
+    }
+
+    bool ClientCoreState::IsOutboundActionQueueEmpty() {
+        for (auto &p_queue : outbound_action_queues_) {
+            if (!p_queue->IsEmpty()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool ClientCoreState::PopNextOutboundAction(OutboundAction &outbound_action_out) {
+        // Strict priority, lower lanes are only served when all higher lanes are empty
+        for (auto &p_queue : outbound_action_queues_) {
+            if (p_queue->TryPop(outbound_action_out)) {
+                NotifyOutboundActionProducers();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ClientCoreState::NotifyOutboundActionConsumer() {
+        // Pairs with the store in WaitForOutboundAction. Either the consumer sees the new element before parking
+        // or we see the parked flag here, so a wakeup cannot be lost
+        if (is_outbound_consumer_parked_) {
+            if (nullptr != p_outbound_wake_handler_) {
+                p_outbound_wake_handler_();
+                return;
+            }
+            std::lock_guard<std::mutex> wait_lock(outbound_action_wait_lock_);
+            outbound_action_wait_.notify_one();
+        }
+    }
+
+    void ClientCoreState::WaitForOutboundAction() {
+        std::unique_lock<std::mutex> wait_lock(outbound_action_wait_lock_);
+        is_outbound_consumer_parked_ = true;
+        if (!process_queued_actions_ || IsOutboundActionQueueEmpty()) {
+            outbound_action_wait_.wait_for(wait_lock,
+                                           std::chrono::milliseconds(DEFAULT_CORE_THREAD_SLEEP_DURATION_MS));
+        }
+        is_outbound_consumer_parked_ = false;
+    }
+
+    void ClientCoreState::WaitForOutboundRateLimit(std::chrono::microseconds wait_time) {
+        std::chrono::microseconds max_wait_time = std::chrono::milliseconds(DEFAULT_CORE_THREAD_SLEEP_DURATION_MS);
+        std::unique_lock<std::mutex> wait_lock(outbound_action_wait_lock_);
+        // Rate limit changes and new actions can wake the thread early, the caller simply checks the limiter again
+        is_outbound_consumer_parked_ = true;
+        outbound_action_wait_.wait_for(wait_lock, wait_time < max_wait_time ? wait_time : max_wait_time);
+        is_outbound_consumer_parked_ = false;
+    }
+
     ResponseCode
     ClientCoreState::GetActionCreateHandler(ActionType action_type, Action::CreateHandlerPtr *p_action_create_handler) {
         ResponseCode rc = ResponseCode::FAILURE;
@@ -94,95 +258,227 @@ namespace awsiotsdk {
         return rc;
     }
 
-    void ClientCoreState::SyncActionHandler(uint16_t action_id, ResponseCode rc) {
-        std::lock_guard<std::mutex> block_handler_lock(sync_action_response_lock_);
-        sync_action_response_ = rc;
-        sync_action_response_wait_.notify_all();
+    uint16_t ClientCoreState::AllocateActionId(uint16_t &last_action_id) {
+        std::lock_guard<std::mutex> ack_map_lock(ack_map_lock_);
+        size_t action_id = 0;
+        // Start after the last ID so IDs are not reused right after their Ack was received
+        if (!pending_acks_.FindNextFree((size_t) last_action_id + 1, 1, action_id)) {
+            AWS_LOG_WARN(LOG_TAG_CLIENT_CORE_STATE, "All Action IDs have a pending Ack, reusing Action ID");
+            action_id = (UINT16_MAX == last_action_id) ? 1 : (size_t) last_action_id + 1;
+        }
+        last_action_id = (uint16_t) action_id;
+        return last_action_id;
     }
 
-    ResponseCode ClientCoreState::PerformAction(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
-                                                std::chrono::milliseconds action_reponse_timeout) {
-        std::lock_guard<std::mutex> sync_action_lock(sync_action_request_lock_);
-        ResponseCode rc = ResponseCode::FAILURE;
+    size_t ClientCoreState::GetPendingAckCount() {
+        std::lock_guard<std::mutex> ack_map_lock(ack_map_lock_);
+        return pending_acks_.Size();
+    }
+
+    util::Threading::TimingWheel::Tick
+    ClientCoreState::GetAckTimerTick(std::chrono::steady_clock::time_point time_point) {
+        if (time_point <= ack_timer_epoch_) {
+            return 0;
+        }
+        return (util::Threading::TimingWheel::Tick) (std::chrono::duration_cast<std::chrono::milliseconds>(
+            time_point - ack_timer_epoch_).count() / ACK_TIMER_WHEEL_TICK_MS);
+    }
+
+    std::chrono::milliseconds ClientCoreState::GetAckTimeout() {
+        std::lock_guard<std::mutex> ack_map_lock(ack_map_lock_);
+        return ack_timeout_;
+    }
+
+    void ClientCoreState::SetAckTimeout(std::chrono::milliseconds ack_timeout) {
+        std::lock_guard<std::mutex> ack_map_lock(ack_map_lock_);
+        ack_timeout_ = ack_timeout;
+    }
+
+    bool ClientCoreState::IsSyncActionResponseExpected(uint16_t action_id,
+                                                       std::shared_ptr<CompletionToken> p_completion_token) {
+        {
+            std::lock_guard<std::mutex> ack_map_lock(ack_map_lock_);
+            if (pending_acks_.IsInFlight(action_id) || dispatching_acks_[action_id]) {
+                return true;
+            }
+        }
+        // Dispatch is marked finished after the token is completed, so a delivered response is visible here
+        return p_completion_token->IsComplete();
+    }
 
+    ResponseCode ClientCoreState::StartAction(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
+                                              std::shared_ptr<CompletionToken> p_completion_token) {
         util::Map<ActionType, std::unique_ptr<Action>>::const_iterator itr = action_map_.find(action_type);
         if (itr == action_map_.end()) {
-            rc = ResponseCode::ACTION_NOT_REGISTERED_ERROR;
-        } else {
-            std::unique_lock<std::mutex> block_handler_lock(sync_action_response_lock_);
-            {
-                sync_action_response_ = ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR;
-                p_action_data->p_async_ack_handler_ = std::bind(&ClientCoreState::SyncActionHandler, this,
-                                                                std::placeholders::_1, std::placeholders::_2);
-                p_action_data->SetActionId(GetNextActionId());
-                rc = itr->second->PerformAction(p_network_connection_, p_action_data);
-            }
+            p_completion_token->Complete(0, ResponseCode::ACTION_NOT_REGISTERED_ERROR);
+            return ResponseCode::ACTION_NOT_REGISTERED_ERROR;
+        }
 
-            if (ResponseCode::SUCCESS == rc
-                && pending_ack_map_.find(p_action_data->GetActionId()) != pending_ack_map_.end()) {
-                sync_action_response_wait_.wait_for(block_handler_lock, action_reponse_timeout);
-                rc = sync_action_response_;
-            }
+        // Each call has its own completion token, only sending the request is serialized
+        p_action_data->p_async_ack_handler_ = nullptr;
+        p_action_data->p_completion_token_ = p_completion_token;
+        ResponseCode rc = ResponseCode::FAILURE;
+        {
+            std::lock_guard<std::mutex> sync_action_lock(sync_action_request_lock_);
+            p_action_data->SetActionId(GetNextActionId());
+            rc = itr->second->PerformAction(p_network_connection_, p_action_data);
+        }
+
+        // Actions may change the ID while being performed, CONNECT uses the reserved CONNACK ID
+        uint16_t action_id = p_action_data->GetActionId();
+        if (ResponseCode::SUCCESS != rc) {
+            p_completion_token->Complete(action_id, rc);
+        } else if (!IsSyncActionResponseExpected(action_id, p_completion_token)) {
+            // Nothing to wait for, the Action is done once it has been sent
+            p_completion_token->Complete(action_id, rc);
+        }
+
+        return rc;
+    }
+
+    ResponseCode ClientCoreState::PerformAction(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
+                                                std::chrono::milliseconds action_reponse_timeout) {
+        std::shared_ptr<CompletionToken> p_completion_token = CompletionToken::Create();
+        ResponseCode rc = StartAction(action_type, p_action_data, p_completion_token);
+        if (ResponseCode::SUCCESS != rc) {
+            return rc;
+        }
+
+        p_completion_token->WaitFor(action_reponse_timeout);
+        rc = p_completion_token->GetResponse();
+        if (!p_completion_token->IsComplete()) {
+            // Stop waiting for the Ack so a late response or expiry does not reach a reused Action ID
+            DeletePendingAck(p_action_data->GetActionId());
         }
 
         return rc;
     }
 
     void ClientCoreState::ProcessOutboundActionQueue(std::shared_ptr<std::atomic_bool> thread_task_out_sync) {
-        ResponseCode rc = ResponseCode::SUCCESS;
-        int action_execution_delay = 1000 / MAX_CORE_ACTION_PROCESSING_RATE_HZ;
         std::atomic_bool &_thread_task_out_sync = *thread_task_out_sync;
         do {
-            // Reset ResponseCode state
-            rc = ResponseCode::SUCCESS;
-            if (/*!process_queued_actions_ || */outbound_action_queue_.empty()) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(DEFAULT_CORE_THREAD_SLEEP_DURATION_MS));
-                continue;
+            bool is_idle = false;
+            std::chrono::microseconds rate_limit_wait_time = ProcessOutboundActionQueueStep(is_idle);
+            if (is_idle) {
+                WaitForOutboundAction();
+            } else if (0 < rate_limit_wait_time.count()) {
+                WaitForOutboundRateLimit(rate_limit_wait_time);
             }
-            std::lock_guard<std::mutex> sync_action_lock(sync_action_request_lock_);
-            auto next = std::chrono::system_clock::now() + std::chrono::milliseconds(action_execution_delay);
-            ActionType action_type = outbound_action_queue_.front().first;
-            std::shared_ptr<ActionData> p_action_data = outbound_action_queue_.front().second;
-
-            outbound_action_queue_.pop();
-            util::Map<ActionType, std::unique_ptr<Action>>::const_iterator itr = action_map_.find(action_type);
-            ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler = p_action_data->p_async_ack_handler_;
-            if (itr != action_map_.end()) {
-                if (nullptr != p_async_ack_handler) {
-                    // Add Ack before sending request. Read request runs in separate thread and may receive response
-                    // before ack is added, if we add it after sending the request.
-                    rc = RegisterPendingAck(p_action_data->GetActionId(), p_async_ack_handler);
-                    if (ResponseCode::SUCCESS != rc) {
-                        p_async_ack_handler(p_action_data->GetActionId(), rc);
-                        AWS_LOG_ERROR(LOG_TAG_CLIENT_CORE_STATE,
-                                      "Registering Ack Handler for Outbound Queued Action failed. %s",
-                                      ResponseHelper::ToString(rc).c_str());
-                    }
+        } while (_thread_task_out_sync);
+    }
+
+    std::chrono::microseconds ClientCoreState::RunOutboundActionQueueStep() {
+        std::chrono::microseconds max_wait_time = std::chrono::milliseconds(DEFAULT_CORE_THREAD_SLEEP_DURATION_MS);
+        is_outbound_consumer_parked_ = false;
+        bool is_idle = false;
+        std::chrono::microseconds rate_limit_wait_time = ProcessOutboundActionQueueStep(is_idle);
+        if (!is_idle && 0 == rate_limit_wait_time.count()) {
+            return rate_limit_wait_time;
+        }
+
+        // Same handshake as WaitForOutboundAction, with the wake handler taking the place of the condition variable
+        is_outbound_consumer_parked_ = true;
+        if (is_idle && process_queued_actions_ && !IsOutboundActionQueueEmpty()) {
+            is_outbound_consumer_parked_ = false;
+            return std::chrono::microseconds(0);
+        }
+        // Expired Acks are only cleaned up by this task, so it is run periodically even while idle
+        return (is_idle || rate_limit_wait_time > max_wait_time) ? max_wait_time : rate_limit_wait_time;
+    }
+
+    std::chrono::microseconds ClientCoreState::ProcessOutboundActionQueueStep(bool &is_idle_out) {
+        std::chrono::microseconds rate_limit_wait_time(0);
+        is_idle_out = false;
+        DeleteExpiredAcks();
+        OutboundAction outbound_action;
+        if (!process_queued_actions_ || IsOutboundActionQueueEmpty()) {
+            is_idle_out = true;
+            return rate_limit_wait_time;
+        }
+        // Take the token before popping so that actions waiting on the rate limit still count against the
+        // queue size
+        if (!has_outbound_rate_limit_token_) {
+            if (!outbound_rate_limiter_.TryConsume(rate_limit_wait_time)) {
+                return rate_limit_wait_time;
+            }
+            has_outbound_rate_limit_token_ = true;
+        }
+        // Popped with the lock held, so TryPerformOutboundAction can not overtake an Action that left the queue
+        std::unique_lock<std::mutex> sync_action_lock(sync_action_request_lock_);
+        // Priority is picked after the rate limit wait so that actions queued in the meantime are considered
+        if (!PopNextOutboundAction(outbound_action)) {
+            // Producer has claimed the slot but not finished writing it yet, token is kept for the next attempt
+            sync_action_lock.unlock();
+            std::this_thread::yield();
+            return std::chrono::microseconds(0);
+        }
+        has_outbound_rate_limit_token_ = false;
+        PerformOutboundAction(outbound_action.first, outbound_action.second);
+        return std::chrono::microseconds(0);
+    }
+
+    void ClientCoreState::PerformOutboundAction(ActionType action_type, std::shared_ptr<ActionData> p_action_data) {
+        ResponseCode rc = ResponseCode::SUCCESS;
+        util::Map<ActionType, std::unique_ptr<Action>>::const_iterator itr = action_map_.find(action_type);
+        bool has_ack_listener = p_action_data->HasAckListener();
+        bool is_ack_expected = has_ack_listener && p_action_data->IsAckExpected();
+        if (itr != action_map_.end()) {
+            if (is_ack_expected) {
+                // Add Ack before sending request. Read request runs in separate thread and may receive response
+                // before ack is added, if we add it after sending the request.
+                rc = RegisterPendingAck(p_action_data->GetActionId(), p_action_data);
+                if (ResponseCode::SUCCESS != rc) {
+                    p_action_data->NotifyAckListeners(p_action_data->GetActionId(), rc);
+                    AWS_LOG_ERROR(LOG_TAG_CLIENT_CORE_STATE,
+                                  "Registering Ack Handler for Outbound Action failed. %s",
+                                  ResponseHelper::ToString(rc).c_str());
                 }
-                // rc will be ResponseCode::SUCCESS by default at this point if no Ack handler was provided
-                if (ResponseCode::SUCCESS == rc) {
-                    rc = itr->second->PerformAction(p_network_connection_, p_action_data);
-                    if (ResponseCode::SUCCESS != rc) {
-                        if (nullptr != p_async_ack_handler) {
-                            // Delete waiting for Ack for Failed Actions
-                            DeletePendingAck(p_action_data->GetActionId());
-                            p_async_ack_handler(p_action_data->GetActionId(), rc);
-                        }
-                        AWS_LOG_ERROR(LOG_TAG_CLIENT_CORE_STATE,
-                                      "Performing Outbound Queued Action failed. %s",
-                                      ResponseHelper::ToString(rc).c_str());
+            }
+            // rc will be ResponseCode::SUCCESS by default at this point if no Ack handler was provided
+            if (ResponseCode::SUCCESS == rc) {
+                rc = itr->second->PerformAction(p_network_connection_, p_action_data);
+                if (ResponseCode::SUCCESS != rc) {
+                    if (has_ack_listener) {
+                        // Delete waiting for Ack for Failed Actions
+                        DeletePendingAck(p_action_data->GetActionId());
+                        p_action_data->NotifyAckListeners(p_action_data->GetActionId(), rc);
                     }
+                    AWS_LOG_ERROR(LOG_TAG_CLIENT_CORE_STATE,
+                                  "Performing Outbound Action failed. %s",
+                                  ResponseHelper::ToString(rc).c_str());
+                } else if (has_ack_listener && !is_ack_expected) {
+                    // Nothing will be received for this Action, it is complete once it has been sent
+                    p_action_data->NotifyAckListeners(p_action_data->GetActionId(), rc);
                 }
-            } else {
-                rc = ResponseCode::ACTION_NOT_REGISTERED_ERROR;
-                AWS_LOG_ERROR(LOG_TAG_CLIENT_CORE_STATE,
-                              "Performing Outbound Queued Action failed. %s",
-                              ResponseHelper::ToString(rc).c_str());
             }
-            // This is not perfect since we have no control over how long an action takes.
-            // But it will definitely ensure that we don't exceed the max rate
-            std::this_thread::sleep_until(next);
-        } while (_thread_task_out_sync);
+        } else {
+            rc = ResponseCode::ACTION_NOT_REGISTERED_ERROR;
+            AWS_LOG_ERROR(LOG_TAG_CLIENT_CORE_STATE,
+                          "Performing Outbound Action failed. %s",
+                          ResponseHelper::ToString(rc).c_str());
+        }
+    }
+
+    bool ClientCoreState::TryPerformOutboundAction(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
+                                                   uint16_t &action_id_out) {
+        if (!process_queued_actions_) {
+            return false;
+        }
+        std::unique_lock<std::mutex> sync_action_lock(sync_action_request_lock_, std::try_to_lock);
+        // Queued Actions go first, so Actions enqueued earlier by the same thread are not overtaken
+        if (!sync_action_lock.owns_lock() || !IsOutboundActionQueueEmpty()) {
+            return false;
+        }
+        // Shares the rate limit with queued Actions, without a token the Action waits in the queue instead
+        std::chrono::microseconds rate_limit_wait_time(0);
+        if (!outbound_rate_limiter_.TryConsume(rate_limit_wait_time)) {
+            return false;
+        }
+
+        action_id_out = GetNextActionId();
+        p_action_data->SetActionId(action_id_out);
+        PerformOutboundAction(action_type, p_action_data);
+        return true;
     }
 
     ResponseCode ClientCoreState::RegisterPendingAck(uint16_t action_id,
@@ -191,44 +487,93 @@ namespace awsiotsdk {
             return ResponseCode::NULL_VALUE_ERROR;
         }
 
-        std::unique_ptr<PendingAckData> p_pending_ack_data = std::unique_ptr<PendingAckData>(new PendingAckData());
-        p_pending_ack_data->p_async_ack_handler_ = p_async_ack_handler;
-        p_pending_ack_data->time_of_request_ = std::chrono::system_clock::now();
+        PendingAckData pending_ack;
+        pending_ack.p_async_ack_handler_ = std::move(p_async_ack_handler);
+
+        std::lock_guard<std::mutex> sync_action_lock(ack_map_lock_);
+        // An Ack that is already registered for this ID is kept as is
+        if (pending_acks_.Insert(action_id, std::move(pending_ack))) {
+            pending_ack_timers_.Schedule(action_id,
+                                         GetAckTimerTick(std::chrono::steady_clock::now() + ack_timeout_));
+        }
+        return ResponseCode::SUCCESS;
+    }
+
+    ResponseCode ClientCoreState::RegisterPendingAck(uint16_t action_id, std::shared_ptr<ActionData> p_action_data) {
+        if (nullptr == p_action_data || !p_action_data->HasAckListener()) {
+            return ResponseCode::NULL_VALUE_ERROR;
+        }
+
+        PendingAckData pending_ack;
+        pending_ack.p_async_ack_handler_ = p_action_data->p_async_ack_handler_;
+        pending_ack.p_completion_token_ = p_action_data->p_completion_token_;
 
         std::lock_guard<std::mutex> sync_action_lock(ack_map_lock_);
-        pending_ack_map_.insert(std::make_pair(action_id, std::move(p_pending_ack_data)));
+        if (pending_acks_.Insert(action_id, std::move(pending_ack))) {
+            pending_ack_timers_.Schedule(action_id,
+                                         GetAckTimerTick(std::chrono::steady_clock::now() + ack_timeout_));
+        }
         return ResponseCode::SUCCESS;
     }
 
     void ClientCoreState::DeletePendingAck(uint16_t action_id) {
         std::lock_guard<std::mutex> sync_action_lock(ack_map_lock_);
-        util::Map<uint16_t, std::unique_ptr<PendingAckData>>::const_iterator itr = pending_ack_map_.find(action_id);
-        if (itr != pending_ack_map_.end()) {
-            pending_ack_map_.erase(itr);
+        if (pending_acks_.Erase(action_id)) {
+            pending_ack_timers_.Cancel(action_id);
+        }
+    }
+
+    bool ClientCoreState::TakePendingAck(uint16_t action_id, PendingAckData &pending_ack_out) {
+        if (!pending_acks_.Take(action_id, pending_ack_out)) {
+            return false;
         }
+        pending_ack_timers_.Cancel(action_id);
+        dispatching_acks_[action_id] = true;
+        return true;
+    }
+
+    void ClientCoreState::DispatchAck(uint16_t action_id, const PendingAckData &pending_ack, ResponseCode rc) {
+        pending_ack.Notify(action_id, rc);
+        std::lock_guard<std::mutex> ack_map_lock(ack_map_lock_);
+        dispatching_acks_[action_id] = false;
     }
 
     void ClientCoreState::DeleteExpiredAcks() {
-        std::lock_guard<std::mutex> sync_action_lock(ack_map_lock_);
-        std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
-        util::Map<uint16_t, std::unique_ptr<PendingAckData>>::const_iterator itr = pending_ack_map_.begin();
-        while (itr != pending_ack_map_.end()) {
-            std::chrono::seconds diff = std::chrono::duration_cast<std::chrono::seconds>(
-                now - itr->second->time_of_request_);
-            if (diff > ack_timeout_) {
-                itr->second->p_async_ack_handler_(itr->first, ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR);
-                pending_ack_map_.erase(itr);
+        util::Vector<std::pair<uint16_t, PendingAckData>> expired_acks;
+        {
+            std::lock_guard<std::mutex> sync_action_lock(ack_map_lock_);
+            if (0 == pending_ack_timers_.Size()) {
+                return;
             }
+            pending_ack_timers_.Advance(GetAckTimerTick(std::chrono::steady_clock::now()),
+                                        [this, &expired_acks](size_t entry_id) {
+                                            PendingAckData pending_ack;
+                                            if (TakePendingAck((uint16_t) entry_id, pending_ack)) {
+                                                expired_acks.push_back(std::make_pair(
+                                                    (uint16_t) entry_id, std::move(pending_ack)));
+                                            }
+                                        });
+        }
+
+        // Listeners are notified without holding the lock so they can register new Acks
+        for (auto &expired_ack : expired_acks) {
+            AWS_LOG_ERROR(LOG_TAG_CLIENT_CORE_STATE, "Ack not received in time for Action ID %u",
+                          (unsigned int) expired_ack.first);
+            DispatchAck(expired_ack.first, expired_ack.second, ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR);
         }
     }
 
     void ClientCoreState::ForwardReceivedAck(uint16_t action_id, ResponseCode rc) {
-        std::lock_guard<std::mutex> sync_action_lock(ack_map_lock_);
-        // No response code because all Acks might not have registered handlers. No other possible error
-        util::Map<uint16_t, std::unique_ptr<PendingAckData>>::const_iterator itr = pending_ack_map_.find(action_id);
-        if (itr != pending_ack_map_.end()) {
-            itr->second->p_async_ack_handler_(action_id, rc);
-            pending_ack_map_.erase(itr);
+        PendingAckData pending_ack;
+        bool is_ack_pending = false;
+        {
+            std::lock_guard<std::mutex> sync_action_lock(ack_map_lock_);
+            // No response code because all Acks might not have registered handlers. No other possible error
+            is_ack_pending = TakePendingAck(action_id, pending_ack);
+        }
+
+        if (is_ack_pending) {
+            DispatchAck(action_id, pending_ack, rc);
         }
     }
 
@@ -237,6 +582,9 @@ namespace awsiotsdk {
     }
 
     void ClientCoreState::ClearOutboundActionQueue() {
-        util::Queue<std::pair<ActionType, std::shared_ptr<ActionData>>>().swap(outbound_action_queue_);
+        for (auto &p_queue : outbound_action_queues_) {
+            p_queue->Clear();
+        }
+        NotifyOutboundActionProducers();
     }
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file CompletionToken.cpp
+ * @brief
+ *
+ */
+
+#include "CompletionToken.hpp"
+
+namespace awsiotsdk {
+    CompletionToken::CompletionToken() {
+        is_complete_ = false;
+        action_id_ = 0;
+        response_ = ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR;
+    }
+
+    std::shared_ptr<CompletionToken> CompletionToken::Create() {
+        return std::make_shared<CompletionToken>();
+    }
+
+    void CompletionToken::Complete(uint16_t action_id, ResponseCode rc) {
+        ContinuationPtr p_continuation = nullptr;
+        {
+            std::lock_guard<std::mutex> completion_lock(completion_lock_);
+            if (is_complete_) {
+                return;
+            }
+            action_id_ = action_id;
+            response_ = rc;
+            is_complete_ = true;
+            p_continuation.swap(p_continuation_);
+            wait_.notify_all();
+        }
+
+        // The continuation may destroy the token's owner, nothing is touched after calling it
+        if (nullptr != p_continuation) {
+            p_continuation();
+        }
+    }
+
+    bool CompletionToken::SetContinuation(ContinuationPtr p_continuation) {
+        std::lock_guard<std::mutex> completion_lock(completion_lock_);
+        if (is_complete_) {
+            return false;
+        }
+        p_continuation_ = p_continuation;
+        return true;
+    }
+
+    bool CompletionToken::WaitFor(std::chrono::milliseconds timeout) {
+        return WaitUntil(std::chrono::steady_clock::now() + timeout);
+    }
+
+    bool CompletionToken::WaitUntil(std::chrono::steady_clock::time_point deadline) {
+        if (is_complete_) {
+            return true;
+        }
+        std::unique_lock<std::mutex> completion_lock(completion_lock_);
+        return wait_.wait_until(completion_lock, deadline, [this] { return (bool) is_complete_; });
+    }
+
+    ResponseCode CompletionToken::GetResponse() {
+        std::lock_guard<std::mutex> completion_lock(completion_lock_);
+        return response_;
+    }
+
+    uint16_t CompletionToken::GetActionId() {
+        std::lock_guard<std::mutex> completion_lock(completion_lock_);
+        return action_id_;
+    }
+
+    size_t CompletionToken::WaitForAll(const util::Vector<std::shared_ptr<CompletionToken>> &tokens,
+                                       std::chrono::milliseconds timeout) {
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+        size_t completed_count = 0;
+        for (const std::shared_ptr<CompletionToken> &p_token : tokens) {
+            if (nullptr != p_token && p_token->WaitUntil(deadline)) {
+                completed_count++;
+            }
+        }
+        return completed_count;
+    }
+}
@@ -22,14 +22,22 @@
  *
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
 #include "util/memory/stl/String.hpp"
 #include "NetworkConnection.hpp"
 
+// Free space requested from each read ahead, more is used if a single packet needs it
+#define DEFAULT_RECEIVE_BUFFER_SIZE 4096
+
 namespace awsiotsdk {
     ResponseCode NetworkConnection::Connect() {
         std::lock(read_mutex, write_mutex);
         std::lock_guard<std::mutex> read_guard(read_mutex, std::adopt_lock);
         std::lock_guard<std::mutex> write_guard(write_mutex, std::adopt_lock);
+        ResetReceiveBuffer();
         return ConnectInternal();
     }
 
@@ -47,6 +55,37 @@ namespace awsiotsdk {
         return rc;
     }
 
+    ResponseCode NetworkConnection::WriteSegments(const util::Vector<WriteSegment> &segments,
+                                                  size_t &size_written_bytes_out) {
+        ResponseCode rc;
+        std::lock_guard<std::mutex> write_guard(write_mutex);
+        {
+            size_written_bytes_out = 0;
+            // Check connection state before calling internal write
+            if (IsConnected()) {
+                rc = WriteSegmentsInternal(segments, size_written_bytes_out);
+            } else {
+                rc = ResponseCode::NETWORK_DISCONNECTED_ERROR;
+            }
+        }
+        return rc;
+    }
+
+    ResponseCode NetworkConnection::WriteSegmentsInternal(const util::Vector<WriteSegment> &segments,
+                                                          size_t &size_written_bytes_out) {
+        size_t total_length = 0;
+        for (const WriteSegment &segment : segments) {
+            total_length += segment.length_;
+        }
+        segments_buf_.clear();
+        segments_buf_.reserve(total_length);
+        for (const WriteSegment &segment : segments) {
+            segments_buf_.append(segment.p_data_, segment.length_);
+        }
+        size_written_bytes_out = 0;
+        return WriteInternal(segments_buf_, size_written_bytes_out);
+    }
+
     ResponseCode NetworkConnection::Read(util::Vector<unsigned char> &buf, size_t buf_read_offset,
                                          size_t size_bytes_to_read, size_t &size_read_bytes_out) {
         ResponseCode rc;
@@ -54,7 +93,28 @@ namespace awsiotsdk {
         {
             // Check connection state before calling internal read
             if (IsConnected()) {
-                rc = ReadInternal(buf, buf_read_offset, size_bytes_to_read, size_read_bytes_out);
+                size_t buffered_bytes = std::min(receive_buf_end_ - receive_buf_start_, size_bytes_to_read);
+                if (0 < buffered_bytes) {
+                    if (buf.size() < buf_read_offset + size_bytes_to_read) {
+                        buf.resize(buf_read_offset + size_bytes_to_read);
+                    }
+                    memcpy(&buf[buf_read_offset], p_receive_buf_->data() + receive_buf_start_, buffered_bytes);
+                    receive_buf_start_ += buffered_bytes;
+                }
+
+                size_read_bytes_out = buffered_bytes;
+                rc = ResponseCode::SUCCESS;
+                if (buffered_bytes < size_bytes_to_read) {
+                    size_t read_bytes = 0;
+                    rc = ReadInternal(buf, buf_read_offset + buffered_bytes, size_bytes_to_read - buffered_bytes,
+                                      read_bytes);
+                    if (ResponseCode::SUCCESS == rc) {
+                        size_read_bytes_out += read_bytes;
+                    } else if (0 < buffered_bytes) {
+                        // Report the buffered bytes, the error will be seen again by the next read
+                        rc = ResponseCode::SUCCESS;
+                    }
+                }
             } else {
                 rc = ResponseCode::NETWORK_DISCONNECTED_ERROR;
             }
@@ -62,11 +122,82 @@ namespace awsiotsdk {
         return rc;
     }
 
+    ResponseCode NetworkConnection::FillReceiveBuffer(size_t min_bytes, bool is_wait_allowed) {
+        std::lock_guard<std::mutex> read_guard(read_mutex);
+        if (!IsConnected()) {
+            return ResponseCode::NETWORK_DISCONNECTED_ERROR;
+        }
+
+        ResponseCode rc = ResponseCode::SUCCESS;
+        while (receive_buf_end_ - receive_buf_start_ < min_bytes) {
+            size_t buffered_bytes = receive_buf_end_ - receive_buf_start_;
+            size_t required_size = std::max(min_bytes, (size_t) DEFAULT_RECEIVE_BUFFER_SIZE);
+            if (1 < p_receive_buf_.use_count()) {
+                // Views of received packets are still held, continue in a new buffer with only the unconsumed bytes
+                std::shared_ptr<util::Vector<unsigned char>> p_new_receive_buf =
+                    std::make_shared<util::Vector<unsigned char>>(required_size);
+                if (0 < buffered_bytes) {
+                    memcpy(p_new_receive_buf->data(), p_receive_buf_->data() + receive_buf_start_, buffered_bytes);
+                }
+                p_receive_buf_ = p_new_receive_buf;
+                receive_buf_start_ = 0;
+                receive_buf_end_ = buffered_bytes;
+            } else {
+                // Views may have been released on other threads, their reads must happen before the buffer is reused
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (0 < receive_buf_start_) {
+                    // Move unconsumed bytes to the front, then make room for the rest of the request and read ahead
+                    if (0 < buffered_bytes) {
+                        memmove(p_receive_buf_->data(), p_receive_buf_->data() + receive_buf_start_, buffered_bytes);
+                    }
+                    receive_buf_start_ = 0;
+                    receive_buf_end_ = buffered_bytes;
+                }
+            }
+            if (p_receive_buf_->size() < required_size) {
+                p_receive_buf_->resize(required_size);
+            }
+
+            size_t read_bytes = 0;
+            size_t min_read_bytes = is_wait_allowed ? min_bytes - buffered_bytes : 0;
+            rc = ReadAvailableInternal(*p_receive_buf_, receive_buf_end_, min_read_bytes,
+                                       p_receive_buf_->size() - receive_buf_end_, read_bytes);
+            receive_buf_end_ += read_bytes;
+            if (ResponseCode::SUCCESS != rc) {
+                break;
+            }
+            if (0 == read_bytes) {
+                // Nothing more has arrived, reads that do not wait only continue while they make progress
+                rc = ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+                break;
+            }
+        }
+        if (ResponseCode::SUCCESS != rc && receive_buf_end_ - receive_buf_start_ >= min_bytes) {
+            // The request was met before the error, report the error with the next read instead
+            rc = ResponseCode::SUCCESS;
+        }
+        return rc;
+    }
+
+    util::SharedBufferView NetworkConnection::GetReceiveBuffer() {
+        std::lock_guard<std::mutex> read_guard(read_mutex);
+        return util::SharedBufferView(p_receive_buf_, receive_buf_start_, receive_buf_end_ - receive_buf_start_);
+    }
+
+    void NetworkConnection::ConsumeReceiveBuffer(size_t size_bytes) {
+        std::lock_guard<std::mutex> read_guard(read_mutex);
+        receive_buf_start_ += std::min(size_bytes, receive_buf_end_ - receive_buf_start_);
+        if (receive_buf_start_ == receive_buf_end_) {
+            ResetReceiveBuffer();
+        }
+    }
+
     ResponseCode NetworkConnection::Disconnect() {
         // Disconnect irrespective of state of other requests
         std::lock(read_mutex, write_mutex);
         std::lock_guard<std::mutex> read_guard(read_mutex, std::adopt_lock);
         std::lock_guard<std::mutex> write_guard(write_mutex, std::adopt_lock);
+        ResetReceiveBuffer();
         return DisconnectInternal();
     }
 }
@@ -79,6 +79,37 @@ namespace awsiotsdk {
                                                           p_resubscribe_app_handler_data));
     }
 
+    std::unique_ptr<MqttClient> MqttClient::Create(std::shared_ptr<NetworkConnection> p_network_connection,
+                                                   std::chrono::milliseconds mqtt_command_timeout,
+                                                   std::shared_ptr<util::Threading::Executor> p_executor) {
+        return Create(p_network_connection, mqtt_command_timeout, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+                      p_executor);
+    }
+
+    std::unique_ptr<MqttClient> MqttClient::Create(std::shared_ptr<NetworkConnection> p_network_connection,
+                                                   std::chrono::milliseconds mqtt_command_timeout,
+                                                   ClientCoreState::ApplicationDisconnectCallbackPtr disconnect_callback_ptr,
+                                                   std::shared_ptr<DisconnectCallbackContextData> p_disconnect_app_handler_data,
+                                                   ClientCoreState::ApplicationReconnectCallbackPtr reconnect_callback_ptr,
+                                                   std::shared_ptr<ReconnectCallbackContextData> p_reconnect_app_handler_data,
+                                                   ClientCoreState::ApplicationResubscribeCallbackPtr resubscribe_callback_ptr,
+                                                   std::shared_ptr<ResubscribeCallbackContextData> p_resubscribe_app_handler_data,
+                                                   std::shared_ptr<util::Threading::Executor> p_executor) {
+        if (nullptr == p_network_connection || nullptr == p_executor) {
+            return nullptr;
+        }
+
+        return std::unique_ptr<MqttClient>(new MqttClient(p_network_connection,
+                                                          mqtt_command_timeout,
+                                                          disconnect_callback_ptr,
+                                                          p_disconnect_app_handler_data,
+                                                          reconnect_callback_ptr,
+                                                          p_reconnect_app_handler_data,
+                                                          resubscribe_callback_ptr,
+                                                          p_resubscribe_app_handler_data,
+                                                          p_executor));
+    }
+
     MqttClient::MqttClient(std::shared_ptr<NetworkConnection> p_network_connection,
                            std::chrono::milliseconds mqtt_command_timeout,
                            ClientCoreState::ApplicationDisconnectCallbackPtr disconnect_callback_ptr,
@@ -86,7 +117,21 @@ namespace awsiotsdk {
                            ClientCoreState::ApplicationReconnectCallbackPtr reconnect_callback_ptr,
                            std::shared_ptr<ReconnectCallbackContextData> p_reconnect_app_handler_data,
                            ClientCoreState::ApplicationResubscribeCallbackPtr resubscribe_callback_ptr,
-                           std::shared_ptr<ResubscribeCallbackContextData> p_resubscribe_app_handler_data) {
+                           std::shared_ptr<ResubscribeCallbackContextData> p_resubscribe_app_handler_data)
+        : MqttClient(p_network_connection, mqtt_command_timeout, disconnect_callback_ptr, p_disconnect_app_handler_data,
+                     reconnect_callback_ptr, p_reconnect_app_handler_data, resubscribe_callback_ptr,
+                     p_resubscribe_app_handler_data, nullptr) {
+    }
+
+    MqttClient::MqttClient(std::shared_ptr<NetworkConnection> p_network_connection,
+                           std::chrono::milliseconds mqtt_command_timeout,
+                           ClientCoreState::ApplicationDisconnectCallbackPtr disconnect_callback_ptr,
+                           std::shared_ptr<DisconnectCallbackContextData> p_disconnect_app_handler_data,
+                           ClientCoreState::ApplicationReconnectCallbackPtr reconnect_callback_ptr,
+                           std::shared_ptr<ReconnectCallbackContextData> p_reconnect_app_handler_data,
+                           ClientCoreState::ApplicationResubscribeCallbackPtr resubscribe_callback_ptr,
+                           std::shared_ptr<ResubscribeCallbackContextData> p_resubscribe_app_handler_data,
+                           std::shared_ptr<util::Threading::Executor> p_executor) {
         p_client_state_ = mqtt::ClientState::Create(mqtt_command_timeout);
         p_client_state_->disconnect_handler_ptr_ = disconnect_callback_ptr;
         p_client_state_->p_disconnect_app_handler_data_ = p_disconnect_app_handler_data;
@@ -96,7 +141,11 @@ namespace awsiotsdk {
         p_client_state_->p_resubscribe_app_handler_data_ = p_resubscribe_app_handler_data;
 
         // Construct Full MQTT Client
-        p_client_core_ = std::unique_ptr<ClientCore>(ClientCore::Create(p_network_connection, p_client_state_));
+        if (nullptr != p_executor) {
+            p_client_core_ = ClientCore::Create(p_network_connection, p_client_state_, p_executor);
+        } else {
+            p_client_core_ = std::unique_ptr<ClientCore>(ClientCore::Create(p_network_connection, p_client_state_));
+        }
         p_client_core_->RegisterAction(ActionType::CONNECT, mqtt::ConnectActionAsync::Create);
         p_client_core_->RegisterAction(ActionType::PUBLISH, mqtt::PublishActionAsync::Create);
         p_client_core_->RegisterAction(ActionType::PUBACK, mqtt::PubackActionAsync::Create);
@@ -156,23 +205,51 @@ namespace awsiotsdk {
         return p_client_core_->PerformAction(ActionType::CONNECT, p_connect_packet, action_response_timeout);
     }
 
+    ResponseCode MqttClient::ConnectAsync(bool is_clean_session, mqtt::Version mqtt_version,
+                                          std::chrono::seconds keep_alive_timeout,
+                                          std::unique_ptr<Utf8String> p_client_id,
+                                          std::unique_ptr<Utf8String> p_username,
+                                          std::unique_ptr<Utf8String> p_password,
+                                          std::unique_ptr<mqtt::WillOptions> p_will_msg, bool is_metrics_enabled,
+                                          std::shared_ptr<CompletionToken> &p_completion_token_out) {
+        p_client_core_->CreateActionRunner(ActionType::READ_INCOMING, nullptr);
+        p_client_core_->CreateActionRunner(ActionType::KEEP_ALIVE, nullptr);
+
+        std::shared_ptr<mqtt::ConnectPacket> p_connect_packet
+            = std::make_shared<mqtt::ConnectPacket>(is_clean_session, mqtt_version, keep_alive_timeout,
+                                                    std::move(p_client_id), std::move(p_username),
+                                                    std::move(p_password), std::move(p_will_msg), is_metrics_enabled);
+        // Outbound queue is only processed once connected, CONNECT is sent from this thread
+        p_completion_token_out = CompletionToken::Create();
+        return p_client_core_->StartAction(ActionType::CONNECT, p_connect_packet, p_completion_token_out);
+    }
+
     ResponseCode MqttClient::Disconnect(std::chrono::milliseconds action_response_timeout) {
         std::shared_ptr<mqtt::DisconnectPacket> p_disconnect_packet = std::make_shared<mqtt::DisconnectPacket>();
         return p_client_core_->PerformAction(ActionType::DISCONNECT, p_disconnect_packet, action_response_timeout);
     }
 
-    ResponseCode MqttClient::Publish(std::unique_ptr<Utf8String> p_topic_name, bool is_retained, bool is_duplicate,
-                                     mqtt::QoS qos, const util::String &payload,
-                                     std::chrono::milliseconds action_response_timeout) {
-        if (nullptr == p_topic_name) {
+    ResponseCode MqttClient::PerformPublish(std::shared_ptr<mqtt::PublishPacket> p_publish_packet,
+                                            std::chrono::milliseconds action_response_timeout) {
+        if (nullptr == p_publish_packet) {
             return ResponseCode::MQTT_INVALID_DATA_ERROR;
         }
-        std::shared_ptr<mqtt::PublishPacket> p_publish_packet
-            = std::make_shared<mqtt::PublishPacket>(std::move(p_topic_name), is_retained, is_duplicate, qos,
-                                                    payload);
         return p_client_core_->PerformAction(ActionType::PUBLISH, p_publish_packet, action_response_timeout);
     }
 
+    ResponseCode MqttClient::Publish(std::unique_ptr<Utf8String> p_topic_name, bool is_retained, bool is_duplicate,
+                                     mqtt::QoS qos, const util::String &payload,
+                                     std::chrono::milliseconds action_response_timeout) {
+        return PerformPublish(p_client_state_->AcquirePublishPacket(std::move(p_topic_name), is_retained,
+                                                                    is_duplicate, qos, payload),
+                              action_response_timeout);
+    }
+
+    ResponseCode MqttClient::Publish(mqtt::PublishRequest request,
+                                     std::chrono::milliseconds action_response_timeout) {
+        return PerformPublish(p_client_state_->AcquirePublishPacket(request), action_response_timeout);
+    }
+
     ResponseCode MqttClient::Subscribe(util::Vector<std::shared_ptr<mqtt::Subscription>> subscription_list,
                                        std::chrono::milliseconds action_response_timeout) {
         if (subscription_list.empty()) {
@@ -206,14 +283,62 @@ namespace awsiotsdk {
                                           const util::String &payload,
                                           ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
                                           uint16_t &packet_id_out) {
-        if (nullptr == p_topic_name) {
-            return ResponseCode::MQTT_INVALID_DATA_ERROR;
+        ActionPriority priority = (mqtt::QoS::QOS1 == qos) ? ActionPriority::HIGH : ActionPriority::LOW;
+        return PerformPublishAsync(p_client_state_->AcquirePublishPacket(std::move(p_topic_name), is_retained,
+                                                                         is_duplicate, qos, payload),
+                                   p_async_ack_handler, packet_id_out, priority);
+    }
+
+    ResponseCode MqttClient::SendPublishAsync(std::shared_ptr<mqtt::PublishPacket> p_publish_packet,
+                                              ActionPriority priority, uint16_t &packet_id_out) {
+        if (mqtt::QoS::QOS0 == p_publish_packet->GetQoS() && p_client_state_->IsQoS0DirectWriteEnabled()
+            && p_client_state_->TryPerformOutboundAction(ActionType::PUBLISH, p_publish_packet, packet_id_out)) {
+            return ResponseCode::SUCCESS;
         }
+        return p_client_core_->PerformActionAsync(ActionType::PUBLISH, p_publish_packet, priority, packet_id_out);
+    }
 
-        std::shared_ptr<mqtt::PublishPacket> p_publish_packet =
-            std::make_shared<mqtt::PublishPacket>(std::move(p_topic_name), is_retained, is_duplicate, qos, payload);
+    ResponseCode MqttClient::PerformPublishAsync(std::shared_ptr<mqtt::PublishPacket> p_publish_packet,
+                                                 ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
+                                                 uint16_t &packet_id_out, ActionPriority priority) {
+        if (nullptr == p_publish_packet) {
+            return ResponseCode::MQTT_INVALID_DATA_ERROR;
+        }
         p_publish_packet->p_async_ack_handler_ = p_async_ack_handler;
-        return p_client_core_->PerformActionAsync(ActionType::PUBLISH, p_publish_packet, packet_id_out);
+        return SendPublishAsync(p_publish_packet, priority, packet_id_out);
+    }
+
+    ResponseCode MqttClient::PublishAsync(mqtt::PublishRequest request,
+                                          ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
+                                          uint16_t &packet_id_out) {
+        std::shared_ptr<mqtt::PublishPacket> p_publish_packet = p_client_state_->AcquirePublishPacket(request);
+        return PerformPublishAsync(p_publish_packet, p_async_ack_handler, packet_id_out, request.priority_);
+    }
+
+    ResponseCode MqttClient::PerformPublishAsync(std::shared_ptr<mqtt::PublishPacket> p_publish_packet,
+                                                 ActionPriority priority, uint16_t &packet_id_out,
+                                                 std::shared_ptr<CompletionToken> &p_completion_token_out) {
+        p_completion_token_out = CompletionToken::Create();
+        ResponseCode rc = ResponseCode::MQTT_INVALID_DATA_ERROR;
+        if (nullptr != p_publish_packet) {
+            p_publish_packet->p_completion_token_ = p_completion_token_out;
+            rc = SendPublishAsync(p_publish_packet, priority, packet_id_out);
+        }
+
+        if (ResponseCode::SUCCESS != rc) {
+            p_completion_token_out->Complete(0, rc);
+        }
+        return rc;
+    }
+
+    ResponseCode MqttClient::PublishAsync(mqtt::PublishRequest request, uint16_t &packet_id_out,
+                                          std::shared_ptr<CompletionToken> &p_completion_token_out) {
+        std::shared_ptr<mqtt::PublishPacket> p_publish_packet = p_client_state_->AcquirePublishPacket(request);
+        return PerformPublishAsync(p_publish_packet, request.priority_, packet_id_out, p_completion_token_out);
+    }
+
+    std::shared_ptr<const mqtt::TopicHandle> MqttClient::InternTopic(const util::String &topic_name) {
+        return p_client_state_->InternTopic(topic_name);
     }
 
     ResponseCode MqttClient::SubscribeAsync(util::Vector<std::shared_ptr<mqtt::Subscription>> subscription_list,
@@ -231,6 +356,28 @@ namespace awsiotsdk {
         return p_client_core_->PerformActionAsync(ActionType::SUBSCRIBE, p_subscribe_packet, packet_id_out);
     }
 
+    ResponseCode MqttClient::SubscribeAsync(util::Vector<std::shared_ptr<mqtt::Subscription>> subscription_list,
+                                            uint16_t &packet_id_out,
+                                            std::shared_ptr<CompletionToken> &p_completion_token_out) {
+        p_completion_token_out = CompletionToken::Create();
+        ResponseCode rc = ResponseCode::SUCCESS;
+        if (subscription_list.empty()) {
+            rc = ResponseCode::MQTT_INVALID_DATA_ERROR;
+        } else if (MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET < subscription_list.size()) {
+            rc = ResponseCode::MQTT_TOO_MANY_SUBSCRIPTIONS_IN_REQUEST;
+        } else {
+            std::shared_ptr<mqtt::SubscribePacket>
+                p_subscribe_packet = std::make_shared<mqtt::SubscribePacket>(subscription_list);
+            p_subscribe_packet->p_completion_token_ = p_completion_token_out;
+            rc = p_client_core_->PerformActionAsync(ActionType::SUBSCRIBE, p_subscribe_packet, packet_id_out);
+        }
+
+        if (ResponseCode::SUCCESS != rc) {
+            p_completion_token_out->Complete(0, rc);
+        }
+        return rc;
+    }
+
     ResponseCode MqttClient::UnsubscribeAsync(util::Vector<std::unique_ptr<Utf8String>> topic_list,
                                               ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
                                               uint16_t &packet_id_out) {
@@ -245,6 +392,28 @@ namespace awsiotsdk {
         return p_client_core_->PerformActionAsync(ActionType::UNSUBSCRIBE, p_unsubscribe_packet, packet_id_out);
     }
 
+    ResponseCode MqttClient::UnsubscribeAsync(util::Vector<std::unique_ptr<Utf8String>> topic_list,
+                                              uint16_t &packet_id_out,
+                                              std::shared_ptr<CompletionToken> &p_completion_token_out) {
+        p_completion_token_out = CompletionToken::Create();
+        ResponseCode rc = ResponseCode::SUCCESS;
+        if (topic_list.empty()) {
+            rc = ResponseCode::MQTT_INVALID_DATA_ERROR;
+        } else if (MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET < topic_list.size()) {
+            rc = ResponseCode::MQTT_TOO_MANY_SUBSCRIPTIONS_IN_REQUEST;
+        } else {
+            std::shared_ptr<mqtt::UnsubscribePacket>
+                p_unsubscribe_packet = std::make_shared<mqtt::UnsubscribePacket>(std::move(topic_list));
+            p_unsubscribe_packet->p_completion_token_ = p_completion_token_out;
+            rc = p_client_core_->PerformActionAsync(ActionType::UNSUBSCRIBE, p_unsubscribe_packet, packet_id_out);
+        }
+
+        if (ResponseCode::SUCCESS != rc) {
+            p_completion_token_out->Complete(0, rc);
+        }
+        return rc;
+    }
+
     bool MqttClient::IsConnected() {
         return p_client_state_->IsConnected();
     }
@@ -259,6 +428,41 @@ namespace awsiotsdk {
         p_client_state_->SetMaxReconnectBackoffTimeout(max_reconnect_backoff_timeout);
     }
 
+    void MqttClient::SetOutboundRateLimit(double actions_per_second, size_t burst_size) {
+        p_client_state_->SetOutboundActionRateLimit(actions_per_second, burst_size);
+    }
+
+    double MqttClient::GetOutboundRateLimit() { return p_client_state_->GetOutboundActionRate(); }
+
+    size_t MqttClient::GetOutboundBurstSize() { return p_client_state_->GetOutboundActionBurstSize(); }
+
+    void MqttClient::SetOutboundOverflowPolicy(OverflowPolicy policy, std::chrono::milliseconds block_timeout) {
+        p_client_state_->SetOutboundActionOverflowPolicy(policy, block_timeout);
+    }
+
+    void MqttClient::SetOutboundOverflowPolicy(ActionPriority priority, OverflowPolicy policy,
+                                               std::chrono::milliseconds block_timeout) {
+        p_client_state_->SetOutboundActionOverflowPolicy(priority, policy, block_timeout);
+    }
+
+    OverflowPolicy MqttClient::GetOutboundOverflowPolicy(ActionPriority priority) {
+        return p_client_state_->GetOutboundActionOverflowPolicy(priority);
+    }
+
+    size_t MqttClient::GetDroppedRequestCount() { return p_client_state_->GetDroppedActionCount(); }
+
+    size_t MqttClient::GetDroppedRequestCount(ActionPriority priority) {
+        return p_client_state_->GetDroppedActionCount(priority);
+    }
+
+    void MqttClient::SetAckTimeout(std::chrono::milliseconds ack_timeout) {
+        p_client_state_->SetAckTimeout(ack_timeout);
+    }
+
+    std::chrono::milliseconds MqttClient::GetAckTimeout() { return p_client_state_->GetAckTimeout(); }
+
+    size_t MqttClient::GetInFlightRequestCount() { return p_client_state_->GetPendingAckCount(); }
+
     ResponseCode MqttClient::SetDisconnectCallbackPtr(ClientCoreState::ApplicationDisconnectCallbackPtr p_callback_ptr,
                                                       std::shared_ptr<DisconnectCallbackContextData> p_app_handler_data) {
         p_client_state_->disconnect_handler_ptr_ = p_callback_ptr;
@@ -292,9 +496,9 @@ namespace awsiotsdk {
             }
         }
 
-        // p_client_state_.action_map_ and p_client_state_.outbound_action_queue_ retains p_client_state_
+        // p_client_state_.action_map_ and p_client_state_.outbound_action_queues_ retains p_client_state_
         // hence, calling p_client_state_->RegisterAction() or p_client_state_->EnqueueOutboundAction() introduces cyclic references inside p_client_state_
-        // make sure that p_client_state_.action_map_ and p_client_state_.outbound_action_queue_ are cleared prior to p_client_state_ destructor
+        // make sure that p_client_state_.action_map_ and p_client_state_.outbound_action_queues_ are cleared prior to p_client_state_ destructor
         // to break the cyclic references.
         p_client_state_->ClearRegisteredActions();
         p_client_state_->ClearOutboundActionQueue();
@@ -19,126 +19,439 @@
  *
  */
 
-#include <regex>
+#include <algorithm>
 
 #include "mqtt/ClientState.hpp"
+#include "mqtt/Publish.hpp"
 
 #define MIN_RECONNECT_BACKOFF_DEFAULT_SEC 1
 #define MAX_RECONNECT_BACKOFF_DEFAULT_SEC 128
 
 namespace awsiotsdk {
     namespace mqtt {
-        ClientState::ClientState(std::chrono::milliseconds mqtt_command_timeout) {
+        ClientState::ClientState(std::chrono::milliseconds mqtt_command_timeout)
+            : publish_packet_pool_(DEFAULT_PACKET_POOL_SIZE), puback_packet_pool_(DEFAULT_PACKET_POOL_SIZE) {
             is_session_present_ = false;
             is_connected_ = false;
             is_pingreq_pending_ = false;
+            is_inbound_paused_ = false;
             is_auto_reconnect_required_ = false;
             is_auto_reconnect_enabled_ = true;
+            is_qos0_direct_write_enabled_ = false;
+            inbound_message_count_ = 0;
+            inbound_bytes_ = 0;
+            max_inbound_messages_ = 0;
+            max_inbound_bytes_ = 0;
             last_sent_packet_id_ = 0;
             mqtt_command_timeout_ = mqtt_command_timeout;
             p_connect_data_ = nullptr;
             min_reconnect_backoff_timeout_ = std::chrono::seconds(MIN_RECONNECT_BACKOFF_DEFAULT_SEC);
             max_reconnect_backoff_timeout_ = std::chrono::seconds(MAX_RECONNECT_BACKOFF_DEFAULT_SEC);
+            PublishSubscriptionSnapshot();
         }
         std::shared_ptr<ClientState> ClientState::Create(std::chrono::milliseconds mqtt_command_timeout) {
             return std::make_shared<ClientState>(mqtt_command_timeout);
         }
 
         uint16_t ClientState::GetNextPacketId() {
-            if (UINT16_MAX == last_sent_packet_id_) {
-                // 0 is reserved for CONNACK
-                last_sent_packet_id_ = 1;
-            } else {
-                ++last_sent_packet_id_;
-            }
-            return last_sent_packet_id_;
+            // Skips 0, which is reserved for CONNACK, and Packet IDs that are still waiting for an Ack
+            return AllocateActionId(last_sent_packet_id_);
+        }
+
+        void ClientState::PublishSubscriptionSnapshot() {
+            std::shared_ptr<const TopicTrie<std::shared_ptr<Subscription>>> p_snapshot =
+                std::make_shared<TopicTrie<std::shared_ptr<Subscription>>>(subscription_trie_);
+            std::atomic_store(&p_subscription_snapshot_, p_snapshot);
         }
 
         std::shared_ptr<Subscription> ClientState::GetSubscription(util::String p_topic_name) {
-            std::shared_ptr<Subscription> p_sub = nullptr;
+            std::shared_ptr<const TopicTrie<std::shared_ptr<Subscription>>> p_snapshot =
+                std::atomic_load(&p_subscription_snapshot_);
+            std::shared_ptr<Subscription> p_subscription;
+            if (p_snapshot->Find(p_topic_name, p_subscription)) {
+                return p_subscription;
+            }
+
+            util::Vector<std::shared_ptr<Subscription>> matches;
+            p_snapshot->Match(p_topic_name, matches);
+            if (matches.empty()) {
+                return nullptr;
+            }
+            return matches.front();
+        }
+
+        void ClientState::GetSubscriptions(const util::String &p_topic_name,
+                                           util::Vector<std::shared_ptr<Subscription>> &subscriptions_out) {
+            std::atomic_load(&p_subscription_snapshot_)->Match(p_topic_name, subscriptions_out);
+        }
+
+        std::shared_ptr<Subscription> ClientState::FindSubscription(const util::String &topic_filter) {
+            std::lock_guard<std::mutex> subscriptions_guard(subscriptions_lock_);
+            util::Map<util::String, std::shared_ptr<Subscription>>::const_iterator
+                itr = subscription_map_.find(topic_filter);
+            return (subscription_map_.end() == itr) ? nullptr : itr->second;
+        }
+
+        void ClientState::GetAllSubscriptions(util::Vector<std::shared_ptr<Subscription>> &subscriptions_out) {
+            std::lock_guard<std::mutex> subscriptions_guard(subscriptions_lock_);
+            subscriptions_out.reserve(subscriptions_out.size() + subscription_map_.size());
+            for (const auto &subscription_entry : subscription_map_) {
+                subscriptions_out.push_back(subscription_entry.second);
+            }
+        }
+
+        bool ClientState::HasSubscriptions() {
+            std::lock_guard<std::mutex> subscriptions_guard(subscriptions_lock_);
+            return !subscription_map_.empty();
+        }
 
-            util::Map<util::String, std::shared_ptr<Subscription >>::const_iterator find_itr =
-                std::find_if(subscription_map_.begin(),
-                             subscription_map_.end(),
-                             [p_topic_name](const std::pair<util::String, std::shared_ptr<Subscription>> &s) -> bool {
-                                 if (s.first == p_topic_name) {
-                                     return true;
-                                 }
-                                 if (0 < s.second->p_topic_regex_.length()) {
-                                     std::regex wildcard_regex(s.second->p_topic_regex_, std::regex::ECMAScript);
-                                     return std::regex_match(p_topic_name.c_str(),
-                                                             wildcard_regex);
-                                 }
-                                 return false;
-                             });
-            if (find_itr != subscription_map_.end()) {
-                p_sub = find_itr->second;
+        void ClientState::DeactivateAllSubscriptions() {
+            std::lock_guard<std::mutex> subscriptions_guard(subscriptions_lock_);
+            for (const auto &subscription_entry : subscription_map_) {
+                subscription_entry.second->SetActive(false);
             }
+        }
 
-            return p_sub;
+        ResponseCode ClientState::AddSubscription(std::shared_ptr<Subscription> p_subscription) {
+            if (nullptr == p_subscription || nullptr == p_subscription->GetTopicName()) {
+                return ResponseCode::NULL_VALUE_ERROR;
+            }
+
+            std::lock_guard<std::mutex> subscriptions_guard(subscriptions_lock_);
+            InsertSubscription(p_subscription);
+            PublishSubscriptionSnapshot();
+            return ResponseCode::SUCCESS;
+        }
+
+        ResponseCode ClientState::AddSubscriptions(const util::Vector<std::shared_ptr<Subscription>> &subscription_list) {
+            for (const std::shared_ptr<Subscription> &p_subscription : subscription_list) {
+                if (nullptr == p_subscription || nullptr == p_subscription->GetTopicName()) {
+                    return ResponseCode::NULL_VALUE_ERROR;
+                }
+            }
+
+            std::lock_guard<std::mutex> subscriptions_guard(subscriptions_lock_);
+            for (const std::shared_ptr<Subscription> &p_subscription : subscription_list) {
+                InsertSubscription(p_subscription);
+            }
+            if (!subscription_list.empty()) {
+                PublishSubscriptionSnapshot();
+            }
+            return ResponseCode::SUCCESS;
+        }
+
+        void ClientState::InsertSubscription(const std::shared_ptr<Subscription> &p_subscription) {
+            util::String topic_name = p_subscription->GetTopicName()->ToStdString();
+            std::shared_ptr<Subscription> &p_map_entry = subscription_map_[topic_name];
+            if (nullptr != p_map_entry && p_map_entry != p_subscription) {
+                // Acks for the replaced Subscription must not resolve to it anymore
+                UnindexSubscription(p_map_entry);
+            }
+            p_map_entry = p_subscription;
+            subscription_trie_.Insert(topic_name, p_subscription);
+        }
+
+        bool ClientState::EraseSubscription(const std::shared_ptr<Subscription> &p_subscription) {
+            util::String topic_name = p_subscription->GetTopicName()->ToStdString();
+            util::Map<util::String, std::shared_ptr<Subscription>>::iterator itr = subscription_map_.find(topic_name);
+            if (subscription_map_.end() == itr || p_subscription != itr->second) {
+                return false;
+            }
+            subscription_map_.erase(itr);
+            return subscription_trie_.Remove(topic_name);
+        }
+
+        void ClientState::UnindexSubscription(const std::shared_ptr<Subscription> &p_subscription) {
+            util::Map<uint16_t, util::Vector<std::shared_ptr<Subscription>>>::iterator
+                index_itr = subscriptions_by_packet_id_.find(p_subscription->GetPacketId());
+            if (subscriptions_by_packet_id_.end() == index_itr) {
+                return;
+            }
+
+            util::Vector<std::shared_ptr<Subscription>> &indexed = index_itr->second;
+            indexed.erase(std::remove(indexed.begin(), indexed.end(), p_subscription), indexed.end());
+            if (indexed.empty()) {
+                subscriptions_by_packet_id_.erase(index_itr);
+            }
+        }
+
+        std::shared_ptr<Subscription> ClientState::TakeIndexedSubscription(uint16_t packet_id,
+                                                                           uint8_t index_in_packet) {
+            util::Map<uint16_t, util::Vector<std::shared_ptr<Subscription>>>::iterator
+                index_itr = subscriptions_by_packet_id_.find(packet_id);
+            if (subscriptions_by_packet_id_.end() == index_itr) {
+                return nullptr;
+            }
+
+            // Holds at most one request's Subscriptions, unless Acks for a reused packet ID never arrived
+            util::Vector<std::shared_ptr<Subscription>> &indexed = index_itr->second;
+            for (util::Vector<std::shared_ptr<Subscription>>::iterator itr = indexed.begin(); itr != indexed.end();
+                 ++itr) {
+                if ((*itr)->IsInSuback(packet_id, index_in_packet)) {
+                    std::shared_ptr<Subscription> p_subscription = *itr;
+                    indexed.erase(itr);
+                    if (indexed.empty()) {
+                        subscriptions_by_packet_id_.erase(index_itr);
+                    }
+                    return p_subscription;
+                }
+            }
+            return nullptr;
+        }
+
+        void ClientState::IndexSubscribePacket(uint16_t packet_id,
+                                               const util::Vector<std::shared_ptr<Subscription>> &subscription_list) {
+            std::lock_guard<std::mutex> subscriptions_guard(subscriptions_lock_);
+            uint8_t index_in_packet = 1;
+            for (const std::shared_ptr<Subscription> &p_subscription : subscription_list) {
+                // A Subscription is resolved by the Ack of the packet that carried it last
+                UnindexSubscription(p_subscription);
+                p_subscription->SetAckIndex(packet_id, index_in_packet++);
+                subscriptions_by_packet_id_[packet_id].push_back(p_subscription);
+            }
         }
 
         std::shared_ptr<Subscription> ClientState::SetSubscriptionPacketInfo(util::String p_topic_name,
                                                                              uint16_t packet_id,
                                                                              uint8_t index_in_packet) {
-            std::shared_ptr<Subscription> p_sub = nullptr;
-            util::Map<util::String, std::shared_ptr<Subscription >>::const_iterator
+            std::lock_guard<std::mutex> subscriptions_guard(subscriptions_lock_);
+            util::Map<util::String, std::shared_ptr<Subscription>>::const_iterator
                 itr = subscription_map_.find(p_topic_name);
-            if (itr != subscription_map_.end()) {
-                itr->second->SetAckIndex(packet_id, index_in_packet);
+            if (itr == subscription_map_.end()) {
+                return nullptr;
             }
 
-            return p_sub;
+            UnindexSubscription(itr->second);
+            itr->second->SetAckIndex(packet_id, index_in_packet);
+            subscriptions_by_packet_id_[packet_id].push_back(itr->second);
+            return itr->second;
         }
 
         ResponseCode ClientState::SetSubscriptionActive(uint16_t packet_id,
                                                         uint8_t index_in_sub_packet,
                                                         mqtt::QoS max_qos) {
-            ResponseCode rc = ResponseCode::FAILURE;
-            util::Map<util::String, std::shared_ptr<Subscription >>::const_iterator itr = subscription_map_.begin();
-            while (itr != subscription_map_.end()) {
-                if (itr->second->IsInSuback(packet_id, index_in_sub_packet)) {
-                    itr->second->SetActive(true);
-                    itr->second->SetMaxQos(max_qos);
-                    itr->second->SetAckIndex(0, 0); // Reset Packet index to prevent corruptions when packetid cycles back
-                    rc = ResponseCode::SUCCESS;
-                    break;
-                }
-                itr++;
+            std::lock_guard<std::mutex> subscriptions_guard(subscriptions_lock_);
+            std::shared_ptr<Subscription> p_subscription = TakeIndexedSubscription(packet_id, index_in_sub_packet);
+            if (nullptr == p_subscription) {
+                return ResponseCode::FAILURE;
             }
-            return rc;
+
+            p_subscription->SetActive(true);
+            p_subscription->SetMaxQos(max_qos);
+            p_subscription->SetAckIndex(0, 0); // Reset Packet index to prevent corruptions when packetid cycles back
+            return ResponseCode::SUCCESS;
         }
 
         ResponseCode ClientState::RemoveSubscription(util::String p_topic_name) {
-            subscription_map_.erase(p_topic_name);
+            std::lock_guard<std::mutex> subscriptions_guard(subscriptions_lock_);
+            util::Map<util::String, std::shared_ptr<Subscription>>::iterator itr = subscription_map_.find(p_topic_name);
+            if (subscription_map_.end() != itr) {
+                UnindexSubscription(itr->second);
+                subscription_map_.erase(itr);
+            }
+            if (subscription_trie_.Remove(p_topic_name)) {
+                PublishSubscriptionSnapshot();
+            }
             return ResponseCode::SUCCESS;
         }
 
         ResponseCode ClientState::RemoveSubscription(uint16_t packet_id, uint8_t index_in_sub_packet) {
-            ResponseCode rc = ResponseCode::FAILURE;
-            util::Map<util::String, std::shared_ptr<Subscription >>::const_iterator itr = subscription_map_.begin();
-            while (itr != subscription_map_.end()) {
-                if (itr->second->IsInSuback(packet_id, index_in_sub_packet)) {
-                    itr = subscription_map_.erase(itr);
-                    break;
+            std::lock_guard<std::mutex> subscriptions_guard(subscriptions_lock_);
+            std::shared_ptr<Subscription> p_subscription = TakeIndexedSubscription(packet_id, index_in_sub_packet);
+            if (nullptr == p_subscription) {
+                return ResponseCode::FAILURE;
+            }
+
+            if (EraseSubscription(p_subscription)) {
+                PublishSubscriptionSnapshot();
+            }
+            return ResponseCode::SUCCESS;
+        }
+
+        ResponseCode ClientState::RemoveSubscriptions(uint16_t packet_id,
+                                                      const util::Vector<uint8_t> &indexes_in_sub_packet) {
+            ResponseCode rc = ResponseCode::SUCCESS;
+            bool is_trie_changed = false;
+            std::lock_guard<std::mutex> subscriptions_guard(subscriptions_lock_);
+            for (uint8_t index_in_sub_packet : indexes_in_sub_packet) {
+                std::shared_ptr<Subscription> p_subscription = TakeIndexedSubscription(packet_id, index_in_sub_packet);
+                if (nullptr == p_subscription) {
+                    rc = ResponseCode::FAILURE;
+                } else if (EraseSubscription(p_subscription)) {
+                    is_trie_changed = true;
                 }
-                itr++;
+            }
+            if (is_trie_changed) {
+                PublishSubscriptionSnapshot();
             }
             return rc;
         }
 
+        void ClientState::RemoveSubscriptions(const util::Vector<std::shared_ptr<Subscription>> &subscription_list) {
+            bool is_trie_changed = false;
+            std::lock_guard<std::mutex> subscriptions_guard(subscriptions_lock_);
+            for (const std::shared_ptr<Subscription> &p_subscription : subscription_list) {
+                if (EraseSubscription(p_subscription)) {
+                    UnindexSubscription(p_subscription);
+                    is_trie_changed = true;
+                }
+            }
+            if (is_trie_changed) {
+                PublishSubscriptionSnapshot();
+            }
+        }
+
         ResponseCode ClientState::RemoveAllSubscriptionsForPacketId(uint16_t packet_id) {
-            ResponseCode rc = ResponseCode::FAILURE;
-            util::Map<util::String, std::shared_ptr<Subscription >>::const_iterator itr = subscription_map_.begin();
-            while (itr != subscription_map_.end()) {
-                if (itr->second->GetPacketId() == packet_id) {
-                    itr = subscription_map_.erase(itr);
-                } else {
-                    itr++;
+            std::lock_guard<std::mutex> subscriptions_guard(subscriptions_lock_);
+            util::Map<uint16_t, util::Vector<std::shared_ptr<Subscription>>>::iterator
+                index_itr = subscriptions_by_packet_id_.find(packet_id);
+            if (subscriptions_by_packet_id_.end() == index_itr) {
+                return ResponseCode::FAILURE;
+            }
+
+            bool is_trie_changed = false;
+            for (const std::shared_ptr<Subscription> &p_subscription : index_itr->second) {
+                if (EraseSubscription(p_subscription)) {
+                    is_trie_changed = true;
                 }
             }
-            return rc;
+            subscriptions_by_packet_id_.erase(index_itr);
+            if (is_trie_changed) {
+                PublishSubscriptionSnapshot();
+            }
+            return ResponseCode::SUCCESS;
+        }
+
+        /**
+         * @brief Get a Publish packet from the pool, reset for the message, or a new one if the pool is exhausted
+         *
+         * TopicType and PayloadType are among the topic and payload types accepted by PublishPacket. The topic and
+         * payload are only consumed once, either by the packet that is created or by resetting a reused one.
+         */
+        template<typename TopicType, typename PayloadType>
+        static std::shared_ptr<PublishPacket> AcquireFromPool(util::SharedObjectPool<PublishPacket> &pool,
+                                                              TopicType p_topic_name,
+                                                              bool is_retained,
+                                                              bool is_duplicate,
+                                                              QoS qos,
+                                                              PayloadType &&payload) {
+            if (nullptr == p_topic_name) {
+                return nullptr;
+            }
+            std::shared_ptr<PublishPacket> p_publish_packet = pool.Acquire([&]() {
+                return std::make_shared<PublishPacket>(std::move(p_topic_name), is_retained, is_duplicate, qos,
+                                                       std::forward<PayloadType>(payload));
+            });
+            if (nullptr == p_publish_packet) {
+                return std::make_shared<PublishPacket>(std::move(p_topic_name), is_retained, is_duplicate, qos,
+                                                       std::forward<PayloadType>(payload));
+            } else if (nullptr != p_topic_name) {
+                // Reused packet, the topic name has not been consumed by the create function
+                p_publish_packet->Reset(std::move(p_topic_name), is_retained, is_duplicate, qos,
+                                        std::forward<PayloadType>(payload));
+            }
+            return p_publish_packet;
+        }
+
+        std::shared_ptr<PublishPacket> ClientState::AcquirePublishPacket(std::unique_ptr<Utf8String> p_topic_name,
+                                                                         bool is_retained,
+                                                                         bool is_duplicate,
+                                                                         QoS qos,
+                                                                         const util::String &payload) {
+            return AcquireFromPool(publish_packet_pool_, std::move(p_topic_name), is_retained, is_duplicate, qos,
+                                   payload);
+        }
+
+        std::shared_ptr<PublishPacket> ClientState::AcquirePublishPacket(std::unique_ptr<Utf8String> p_topic_name,
+                                                                         bool is_retained,
+                                                                         bool is_duplicate,
+                                                                         QoS qos,
+                                                                         util::String &&payload) {
+            return AcquireFromPool(publish_packet_pool_, std::move(p_topic_name), is_retained, is_duplicate, qos,
+                                   std::move(payload));
+        }
+
+        std::shared_ptr<PublishPacket> ClientState::AcquirePublishPacket(std::unique_ptr<Utf8String> p_topic_name,
+                                                                         bool is_retained,
+                                                                         bool is_duplicate,
+                                                                         QoS qos,
+                                                                         const util::SharedBufferView &payload) {
+            return AcquireFromPool(publish_packet_pool_, std::move(p_topic_name), is_retained, is_duplicate, qos,
+                                   payload);
+        }
+
+        std::shared_ptr<PublishPacket>
+        ClientState::AcquirePublishPacket(std::shared_ptr<const TopicHandle> p_topic_handle,
+                                          bool is_retained,
+                                          bool is_duplicate,
+                                          QoS qos,
+                                          const util::String &payload) {
+            return AcquireFromPool(publish_packet_pool_, std::move(p_topic_handle), is_retained, is_duplicate, qos,
+                                   payload);
+        }
+
+        std::shared_ptr<PublishPacket>
+        ClientState::AcquirePublishPacket(std::shared_ptr<const TopicHandle> p_topic_handle,
+                                          bool is_retained,
+                                          bool is_duplicate,
+                                          QoS qos,
+                                          util::String &&payload) {
+            return AcquireFromPool(publish_packet_pool_, std::move(p_topic_handle), is_retained, is_duplicate, qos,
+                                   std::move(payload));
+        }
+
+        std::shared_ptr<PublishPacket>
+        ClientState::AcquirePublishPacket(std::shared_ptr<const TopicHandle> p_topic_handle,
+                                          bool is_retained,
+                                          bool is_duplicate,
+                                          QoS qos,
+                                          const util::SharedBufferView &payload) {
+            return AcquireFromPool(publish_packet_pool_, std::move(p_topic_handle), is_retained, is_duplicate, qos,
+                                   payload);
+        }
+
+        std::shared_ptr<PublishPacket> ClientState::AcquirePublishPacket(PublishRequest &request) {
+            if (nullptr != request.p_topic_handle_) {
+                if (!request.shared_payload_.IsEmpty()) {
+                    return AcquirePublishPacket(std::move(request.p_topic_handle_), request.is_retained_,
+                                                request.is_duplicate_, request.qos_, request.shared_payload_);
+                }
+                return AcquirePublishPacket(std::move(request.p_topic_handle_), request.is_retained_,
+                                            request.is_duplicate_, request.qos_, std::move(request.payload_));
+            }
+
+            if (!request.shared_payload_.IsEmpty()) {
+                return AcquirePublishPacket(std::move(request.p_topic_name_), request.is_retained_,
+                                            request.is_duplicate_, request.qos_, request.shared_payload_);
+            }
+            return AcquirePublishPacket(std::move(request.p_topic_name_), request.is_retained_, request.is_duplicate_,
+                                        request.qos_, std::move(request.payload_));
+        }
+
+        std::shared_ptr<const TopicHandle> ClientState::InternTopic(const util::String &topic_name) {
+            std::lock_guard<std::mutex> topic_handles_guard(topic_handles_lock_);
+            util::Map<util::String, std::shared_ptr<const TopicHandle>>::const_iterator
+                itr = topic_handles_.find(topic_name);
+            if (topic_handles_.end() != itr) {
+                return itr->second;
+            }
+
+            std::shared_ptr<const TopicHandle> p_topic_handle = TopicHandle::Create(topic_name);
+            if (nullptr != p_topic_handle) {
+                topic_handles_.insert(std::make_pair(topic_name, p_topic_handle));
+            }
+            return p_topic_handle;
+        }
+
+        std::shared_ptr<PubackPacket> ClientState::AcquirePubackPacket(uint16_t publish_packet_id) {
+            std::shared_ptr<PubackPacket> p_puback_packet = puback_packet_pool_.Acquire([publish_packet_id]() {
+                return std::make_shared<PubackPacket>(publish_packet_id);
+            });
+            if (nullptr == p_puback_packet) {
+                return std::make_shared<PubackPacket>(publish_packet_id);
+            }
+            p_puback_packet->Reset(publish_packet_id);
+            return p_puback_packet;
         }
     }
 }
-
@@ -157,6 +157,68 @@ namespace awsiotsdk {
                                                                   p_app_handler_data));
         }
 
+        std::shared_ptr<Subscription> Subscription::CreateWithViewHandler(std::unique_ptr<Utf8String> p_topic_name,
+                                                                          QoS max_qos,
+                                                                          ApplicationViewCallbackHandlerPtr p_app_view_handler,
+                                                                          std::shared_ptr<SubscriptionHandlerContextData> p_app_handler_data) {
+            if (nullptr == p_topic_name || nullptr == p_app_view_handler) {
+                return nullptr;
+            }
+
+            if (false == IsValidTopicName(p_topic_name->ToStdString())) {
+                return nullptr;
+            }
+
+            std::shared_ptr<Subscription> p_subscription =
+                std::shared_ptr<Subscription>(new Subscription(std::move(p_topic_name), max_qos, nullptr,
+                                                               p_app_handler_data));
+            p_subscription->p_app_view_handler_ = p_app_view_handler;
+            return p_subscription;
+        }
+
+        Subscription::Subscription(const Subscription &other)
+            : p_app_handler_(other.p_app_handler_), p_app_view_handler_(other.p_app_view_handler_),
+              p_app_handler_data_(other.p_app_handler_data_), p_topic_regex_(other.p_topic_regex_),
+              is_active_(other.is_active_.load()), packet_id_(other.packet_id_),
+              index_in_packet_(other.index_in_packet_), max_qos_(other.max_qos_), p_topic_name_(other.p_topic_name_) {
+        }
+
+        Subscription::Subscription(Subscription &&other)
+            : p_app_handler_(std::move(other.p_app_handler_)),
+              p_app_view_handler_(std::move(other.p_app_view_handler_)),
+              p_app_handler_data_(std::move(other.p_app_handler_data_)),
+              p_topic_regex_(std::move(other.p_topic_regex_)),
+              is_active_(other.is_active_.load()), packet_id_(other.packet_id_),
+              index_in_packet_(other.index_in_packet_), max_qos_(other.max_qos_),
+              p_topic_name_(std::move(other.p_topic_name_)) {
+        }
+
+        Subscription &Subscription::operator=(const Subscription &other) & {
+            p_app_handler_ = other.p_app_handler_;
+            p_app_view_handler_ = other.p_app_view_handler_;
+            p_app_handler_data_ = other.p_app_handler_data_;
+            p_topic_regex_ = other.p_topic_regex_;
+            is_active_ = other.is_active_.load();
+            packet_id_ = other.packet_id_;
+            index_in_packet_ = other.index_in_packet_;
+            max_qos_ = other.max_qos_;
+            p_topic_name_ = other.p_topic_name_;
+            return *this;
+        }
+
+        Subscription &Subscription::operator=(Subscription &&other) & {
+            p_app_handler_ = std::move(other.p_app_handler_);
+            p_app_view_handler_ = std::move(other.p_app_view_handler_);
+            p_app_handler_data_ = std::move(other.p_app_handler_data_);
+            p_topic_regex_ = std::move(other.p_topic_regex_);
+            is_active_ = other.is_active_.load();
+            packet_id_ = other.packet_id_;
+            index_in_packet_ = other.index_in_packet_;
+            max_qos_ = other.max_qos_;
+            p_topic_name_ = std::move(other.p_topic_name_);
+            return *this;
+        }
+
         Subscription::Subscription(std::unique_ptr<Utf8String> p_topic_name,
                                    QoS max_qos,
                                    ApplicationCallbackHandlerPtr p_app_handler,
@@ -310,9 +310,8 @@ namespace awsiotsdk {
             }
 
             p_connect_packet->SetPacketId(CONNACK_RESERVED_PACKET_ID);
-            if (nullptr != p_connect_packet->p_async_ack_handler_) {
-                rc = p_client_state_->RegisterPendingAck(CONNACK_RESERVED_PACKET_ID,
-                                                         p_connect_packet->p_async_ack_handler_);
+            if (p_connect_packet->HasAckListener()) {
+                rc = p_client_state_->RegisterPendingAck(CONNACK_RESERVED_PACKET_ID, p_connect_packet);
                 if (ResponseCode::SUCCESS != rc) {
                     AWS_LOG_ERROR(CONNECT_LOG_TAG,
                                   "Registering Ack Handler for Connect Action. %s",
@@ -327,6 +326,8 @@ namespace awsiotsdk {
             if (ResponseCode::SUCCESS != rc) {
                 return rc;
             }
+            // The read runner may be parked on the descriptor of the previous connection, the CONNACK arrives here
+            p_client_state_->NotifyNetworkConnected();
 
             const util::String packet_data = p_connect_packet->ToString();
             rc = WriteToNetworkBuffer(p_network_connection, packet_data);
@@ -388,10 +389,7 @@ namespace awsiotsdk {
             }
 
             /* convert all subscriptions to inactive */
-            for (auto itr = p_client_state_->subscription_map_.begin(); itr != p_client_state_->subscription_map_.end();
-                 ++itr) {
-                itr->second->SetActive(false);
-            }
+            p_client_state_->DeactivateAllSubscriptions();
 
             rc = p_network_connection->Disconnect();
             if (ResponseCode::SUCCESS != rc) {
@@ -406,6 +404,7 @@ namespace awsiotsdk {
         KeepaliveActionRunner::KeepaliveActionRunner(std::shared_ptr<ClientState> p_client_state)
             : Action(ActionType::KEEP_ALIVE, KEEPALIVE_ACTION_DESCRIPTION) {
             p_client_state_ = p_client_state;
+            is_step_started_ = false;
         }
 
         std::unique_ptr<Action> KeepaliveActionRunner::Create(std::shared_ptr<ActionState> p_action_state) {
@@ -420,188 +419,324 @@ namespace awsiotsdk {
 
         ResponseCode KeepaliveActionRunner::PerformAction(std::shared_ptr<NetworkConnection> p_network_connection,
                                                           std::shared_ptr<ActionData> p_action_data) {
+            is_step_started_ = false;
+            p_reconnect_token_ = nullptr;
+            return RunActionSteps(p_network_connection, p_action_data);
+        }
+
+        ResponseCode KeepaliveActionRunner::PerformActionStep(std::shared_ptr<NetworkConnection> p_network_connection,
+                                                              std::shared_ptr<ActionData> p_action_data,
+                                                              std::chrono::microseconds &next_step_delay_out) {
             // TODO : This action needs cleanup in the future
-            std::atomic_bool &_p_thread_continue_ = *p_thread_continue_;
+            IOT_UNUSED(p_action_data);
             std::chrono::milliseconds thread_sleep_duration(DEFAULT_CORE_THREAD_SLEEP_DURATION_MS);
+            next_step_delay_out = thread_sleep_duration;
 
-            // Wait for first connect, keep alive data will not be available until then
-            while (_p_thread_continue_ && !p_client_state_->IsConnected()) {
-                std::this_thread::sleep_for(thread_sleep_duration);
-            }
+            if (!is_step_started_) {
+                // Wait for first connect, keep alive data will not be available until then
+                if (!p_client_state_->IsConnected()) {
+                    return ResponseCode::SUCCESS;
+                }
 
-            std::shared_ptr<PingreqPacket> p_pingreq_packet = PingreqPacket::Create();
-            if (nullptr == p_pingreq_packet) {
-                return ResponseCode::NULL_VALUE_ERROR;
+                p_pingreq_packet_ = PingreqPacket::Create();
+                if (nullptr == p_pingreq_packet_) {
+                    next_step_delay_out = std::chrono::microseconds(-1);
+                    return ResponseCode::NULL_VALUE_ERROR;
+                }
+
+                p_client_state_->setDisconnectCallbackPending(true);
+                reconnect_backoff_timer_ = p_client_state_->GetMinReconnectBackoffTimeout();
+                max_backoff_value_ = p_client_state_->GetMaxReconnectBackoffTimeout();
+                keep_alive_interval_ = p_client_state_->GetKeepAliveTimeout() / 2;
+                next_pingreq_time_ = std::chrono::system_clock::now() + keep_alive_interval_;
+                is_step_started_ = true;
             }
 
             ResponseCode rc = ResponseCode::SUCCESS;
-            p_client_state_->setDisconnectCallbackPending(true);
-
-            std::chrono::seconds reconnect_backoff_timer = p_client_state_->GetMinReconnectBackoffTimeout();
-            std::chrono::seconds max_backoff_value = p_client_state_->GetMaxReconnectBackoffTimeout();
-            std::chrono::seconds keep_alive_interval = p_client_state_->GetKeepAliveTimeout() / 2;
-            auto next = std::chrono::system_clock::now() + std::chrono::seconds(keep_alive_interval);
-
-            do {
-                if (p_client_state_->IsAutoReconnectEnabled() && p_client_state_->IsAutoReconnectRequired()) {
-                    p_client_state_->SetPingreqPending(false);
-                    if (p_client_state_->isDisconnectCallbackPending()) {
-
-                        std::shared_ptr<ConnectPacket> p_connect_packet =
-                            std::dynamic_pointer_cast<ConnectPacket>(p_client_state_->GetAutoReconnectData());
-
-                        /**
-                         * NOTE: All callbacks used by the keepalive should be non-blocking
-                         */
-                        if (nullptr != p_client_state_->disconnect_handler_ptr_ && nullptr != p_connect_packet) {
-                            p_client_state_->disconnect_handler_ptr_(p_connect_packet->GetClientID(),
-                                                                   p_client_state_->p_disconnect_app_handler_data_);
-                        }
+            if (nullptr != p_reconnect_token_
+                || (p_client_state_->IsAutoReconnectEnabled() && p_client_state_->IsAutoReconnectRequired())) {
+                return PerformReconnectStep(p_network_connection, next_step_delay_out);
+            } else if (p_client_state_->IsAutoReconnectRequired()) {
+                if (p_client_state_->isDisconnectCallbackPending()) {
+                    std::shared_ptr<ConnectPacket> p_connect_packet =
+                        std::dynamic_pointer_cast<ConnectPacket>(p_client_state_->GetAutoReconnectData());
 
-                        reconnect_backoff_timer = p_client_state_->GetMinReconnectBackoffTimeout();
-                        max_backoff_value = p_client_state_->GetMaxReconnectBackoffTimeout();
-                        AWS_LOG_INFO(KEEPALIVE_LOG_TAG,
-                                     "Initial value of reconnect timer : %ld!!",
-                                     reconnect_backoff_timer.count());
-                        AWS_LOG_INFO(KEEPALIVE_LOG_TAG, "Max backoff value : %ld!!", max_backoff_value.count());
+                    if (nullptr != p_client_state_->disconnect_handler_ptr_ && nullptr != p_connect_packet) {
+                        p_client_state_->disconnect_handler_ptr_(p_connect_packet->GetClientID(),
+                                                               p_client_state_->p_disconnect_app_handler_data_);
                     }
-                    AWS_LOG_INFO(KEEPALIVE_LOG_TAG, "Attempting Reconnect");
 
-                    std::shared_ptr<ConnectPacket> p_connect_packet =
-                        std::dynamic_pointer_cast<ConnectPacket>(p_client_state_->GetAutoReconnectData());
+                    p_client_state_->setDisconnectCallbackPending(false);
+                }
+            }
 
-                    rc = p_client_state_->PerformAction(ActionType::CONNECT,
-                                                        p_connect_packet,
-                                                        p_client_state_->GetMqttCommandTimeout());
+            if (p_client_state_->IsPingreqPending() && p_client_state_->IsInboundPaused()) {
+                // The PINGRESP may be waiting unread behind a slow handler. Reconnecting would drop the buffered
+                // backlog, so hold the deadline off until reads resume
+                next_pingreq_time_ = std::chrono::system_clock::now() + keep_alive_interval_;
+            }
 
-                    if (nullptr != p_client_state_->reconnect_handler_ptr_) {
-                        p_client_state_->reconnect_handler_ptr_(p_connect_packet->GetClientID(),
-                                                              p_client_state_->p_reconnect_app_handler_data_,
-                                                              rc);
-                    }
-                    if (ResponseCode::MQTT_CONNACK_CONNECTION_ACCEPTED == rc) {
-
-                        // if no subscriptions, skip resubscribe
-                        if (!p_client_state_->subscription_map_.empty()) {
-
-                            util::Vector<std::shared_ptr<mqtt::Subscription>> topic_vector;
-
-                            util::Map<util::String, std::shared_ptr<Subscription>>::const_iterator
-                                itr = p_client_state_->subscription_map_.begin();
-                            while (itr != p_client_state_->subscription_map_.end()) {
-                                topic_vector.push_back(itr->second);
-                                itr++;
-                                if (topic_vector.size() == MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET) {
-                                    std::shared_ptr<mqtt::SubscribePacket>
-                                        p_subscribe_packet = mqtt::SubscribePacket::Create(topic_vector);
-                                    rc = WriteToNetworkBuffer(p_network_connection, p_subscribe_packet->ToString());
-                                    if (ResponseCode::SUCCESS != rc) {
-                                        AWS_LOG_ERROR(KEEPALIVE_LOG_TAG,
-                                                      "Resubscribe attempt returned unhandled error. \n%s",
-                                                      ResponseHelper::ToString(rc).c_str());
-                                        break;
-                                    }
-                                    topic_vector.clear();
-                                }
-                            }
-
-                            if (ResponseCode::SUCCESS == rc || ResponseCode::MQTT_CONNACK_CONNECTION_ACCEPTED == rc) {
-                                if (!topic_vector.empty()) {
-                                    std::shared_ptr<mqtt::SubscribePacket>
-                                        p_subscribe_packet = mqtt::SubscribePacket::Create(topic_vector);
-                                    rc = WriteToNetworkBuffer(p_network_connection, p_subscribe_packet->ToString());
-                                }
-                            }
-
-                            if (nullptr != p_client_state_->resubscribe_handler_ptr_) {
-                                p_client_state_->resubscribe_handler_ptr_(p_connect_packet->GetClientID(),
-                                                                        p_client_state_->p_resubscribe_app_handler_data_,
-                                                                        rc);
-                            }
+            if (std::chrono::system_clock::now() > next_pingreq_time_) {
+                if (p_client_state_->IsPingreqPending()) {
+                    if (p_client_state_->IsConnected()) {
+                        rc = p_client_state_->PerformAction(ActionType::DISCONNECT,
+                                                            DisconnectPacket::Create(),
+                                                            p_client_state_->GetMqttCommandTimeout());
+                        if (ResponseCode::SUCCESS != rc && ResponseCode::NETWORK_DISCONNECTED_ERROR != rc) {
+                            AWS_LOG_ERROR(KEEPALIVE_LOG_TAG,
+                                          "Network Disconnect attempt returned unhandled error. \n%s",
+                                          ResponseHelper::ToString(rc).c_str());
                         }
-                        /**
-                         * NOTE :The resubscribe response can be NETWORK_DISCONNECTED_ERROR as the network might have
-                         * disconnected again after the reconnect was successful.
-                         */
-                        if (ResponseCode::NETWORK_DISCONNECTED_ERROR != rc) {
-                            p_client_state_->SetAutoReconnectRequired(false);
-                        } else {
-                            p_client_state_->PerformAction(ActionType::DISCONNECT,
-                                                           DisconnectPacket::Create(),
-                                                           p_client_state_->GetMqttCommandTimeout());
+                    }
+                    p_client_state_->SetAutoReconnectRequired(true);
+                    next_step_delay_out = std::chrono::microseconds(0);
+                    return rc;
+                } else if (p_client_state_->IsConnected()) {
+                    rc = WriteToNetworkBuffer(p_network_connection, p_pingreq_packet_->ToString());
+
+                    if (ResponseCode::SUCCESS != rc) {
+                        AWS_LOG_ERROR(KEEPALIVE_LOG_TAG,
+                                      "Writing PingReq to Network Failed. \n%s. \nDisconnecting!",
+                                      ResponseHelper::ToString(rc).c_str());
+                        rc = p_client_state_->PerformAction(ActionType::DISCONNECT,
+                                                            DisconnectPacket::Create(),
+                                                            p_client_state_->GetMqttCommandTimeout());
+                        if (ResponseCode::SUCCESS != rc) {
+                            AWS_LOG_ERROR(KEEPALIVE_LOG_TAG,
+                                          "Network Disconnect attempt returned unhandled error. \n%s",
+                                          ResponseHelper::ToString(rc).c_str());
                         }
-                        continue;
+                        p_client_state_->SetAutoReconnectRequired(true);
+                        next_step_delay_out = std::chrono::microseconds(0);
+                        return rc;
                     }
 
-                    p_client_state_->setDisconnectCallbackPending(false);
-                    AWS_LOG_ERROR(KEEPALIVE_LOG_TAG, "Reconnect failed. %s", ResponseHelper::ToString(rc).c_str());
+                    p_client_state_->SetPingreqPending(true);
+                    next_pingreq_time_ = std::chrono::system_clock::now() + keep_alive_interval_;
+                }
+            }
 
-                    AWS_LOG_INFO(KEEPALIVE_LOG_TAG,
-                                 "Current value of reconnect timer : %ld!!",
-                                 reconnect_backoff_timer.count());
-                    if (max_backoff_value > reconnect_backoff_timer) {
-                        reconnect_backoff_timer += reconnect_backoff_timer;
-                    }
+            return rc;
+        }
 
-                    AWS_LOG_INFO(KEEPALIVE_LOG_TAG,
-                                 "Updated value of reconnect timer : %ld!!",
-                                 reconnect_backoff_timer.count());
-                    std::this_thread::sleep_for(reconnect_backoff_timer);
-                    continue;
-                } else if (p_client_state_->IsAutoReconnectRequired()) {
-                    if (p_client_state_->isDisconnectCallbackPending()) {
-                        std::shared_ptr<ConnectPacket> p_connect_packet =
-                            std::dynamic_pointer_cast<ConnectPacket>(p_client_state_->GetAutoReconnectData());
-
-                        if (nullptr != p_client_state_->disconnect_handler_ptr_ && nullptr != p_connect_packet) {
-                            p_client_state_->disconnect_handler_ptr_(p_connect_packet->GetClientID(),
-                                                                   p_client_state_->p_disconnect_app_handler_data_);
-                        }
+        void KeepaliveActionRunner::ResubscribeProgress::AddPendingPacket() {
+            std::lock_guard<std::mutex> progress_guard(progress_lock_);
+            pending_count_++;
+        }
 
-                        p_client_state_->setDisconnectCallbackPending(false);
-                    }
+        void KeepaliveActionRunner::ResubscribeProgress::OnSuback(ResponseCode rc) {
+            {
+                std::lock_guard<std::mutex> progress_guard(progress_lock_);
+                if (ResponseCode::SUCCESS == rc || ResponseCode::MQTT_SUBSCRIBE_PARTIALLY_FAILED == rc) {
+                    has_success_ = true;
                 }
+                if (ResponseCode::SUCCESS != rc) {
+                    failure_rc_ = rc;
+                }
+            }
+            ReleasePending();
+        }
 
-                if (std::chrono::system_clock::now() > next) {
-                    if (p_client_state_->IsPingreqPending()) {
-                        if (p_client_state_->IsConnected()) {
-                            rc = p_client_state_->PerformAction(ActionType::DISCONNECT,
-                                                                DisconnectPacket::Create(),
-                                                                p_client_state_->GetMqttCommandTimeout());
-                            if (ResponseCode::SUCCESS != rc && ResponseCode::NETWORK_DISCONNECTED_ERROR != rc) {
-                                AWS_LOG_ERROR(KEEPALIVE_LOG_TAG,
-                                              "Network Disconnect attempt returned unhandled error. \n%s",
-                                              ResponseHelper::ToString(rc).c_str());
-                            }
-                        }
-                        p_client_state_->SetAutoReconnectRequired(true);
-                        continue;
-                    } else if (p_client_state_->IsConnected()) {
-                        rc = WriteToNetworkBuffer(p_network_connection, p_pingreq_packet->ToString());
+        void KeepaliveActionRunner::ResubscribeProgress::OnAllPacketsSent() {
+            ReleasePending();
+        }
+
+        void KeepaliveActionRunner::ResubscribeProgress::ReleasePending() {
+            ResponseCode resubscribe_rc;
+            {
+                std::lock_guard<std::mutex> progress_guard(progress_lock_);
+                if (0 == pending_count_ || 0 != --pending_count_) {
+                    return;
+                }
 
+                resubscribe_rc = failure_rc_;
+                if (ResponseCode::SUCCESS != failure_rc_ && has_success_) {
+                    resubscribe_rc = ResponseCode::MQTT_SUBSCRIBE_PARTIALLY_FAILED;
+                }
+            }
+            Report(resubscribe_rc);
+        }
+
+        void KeepaliveActionRunner::ResubscribeProgress::Report(ResponseCode rc) {
+            {
+                std::lock_guard<std::mutex> progress_guard(progress_lock_);
+                if (is_reported_) {
+                    return;
+                }
+                is_reported_ = true;
+            }
+
+            std::shared_ptr<ClientState> p_client_state = p_client_state_.lock();
+            if (nullptr != p_client_state && nullptr != p_client_state->resubscribe_handler_ptr_) {
+                p_client_state->resubscribe_handler_ptr_(client_id_, p_client_state->p_resubscribe_app_handler_data_,
+                                                         rc);
+            }
+        }
+
+        ResponseCode KeepaliveActionRunner::Resubscribe(std::shared_ptr<NetworkConnection> p_network_connection,
+                                                        const util::String &client_id) {
+            util::Vector<std::shared_ptr<Subscription>> subscriptions;
+            p_client_state_->GetAllSubscriptions(subscriptions);
+            if (subscriptions.empty()) {
+                return ResponseCode::SUCCESS;
+            }
+
+            std::shared_ptr<ResubscribeProgress> p_progress =
+                std::make_shared<ResubscribeProgress>(p_client_state_, client_id);
+            ActionData::AsyncAckNotificationHandlerPtr p_suback_handler = [p_progress](uint16_t action_id,
+                                                                                      ResponseCode rc) {
+                IOT_UNUSED(action_id);
+                p_progress->OnSuback(rc);
+            };
+
+            util::Vector<uint16_t> packet_ids;
+            util::Vector<std::shared_ptr<Subscription>> topic_vector;
+            util::String write_buf;
+            write_buf.reserve(DEFAULT_RESUBSCRIBE_WRITE_SIZE);
+            auto append_subscribe_packet = [&]() {
+                // Registered before the packet is written so the Suback cannot arrive first
+                std::shared_ptr<SubscribePacket> p_subscribe_packet = std::make_shared<SubscribePacket>(topic_vector);
+                uint16_t packet_id = p_client_state_->GetNextPacketId();
+                p_subscribe_packet->SetPacketId(packet_id);
+                p_progress->AddPendingPacket();
+                p_client_state_->RegisterPendingAck(packet_id, p_suback_handler);
+                packet_ids.push_back(packet_id);
+                write_buf.append(p_subscribe_packet->ToString());
+                p_client_state_->IndexSubscribePacket(packet_id, topic_vector);
+                topic_vector.clear();
+            };
+
+            ResponseCode rc = ResponseCode::SUCCESS;
+            size_t packet_size = 2; // Packet ID requires 2 bytes
+            for (const std::shared_ptr<Subscription> &p_subscription : subscriptions) {
+                // 2 bytes for topic length, 1 for QoS
+                size_t topic_size = p_subscription->GetTopicNameLength() + 2 + 1;
+                if (!topic_vector.empty() && (DEFAULT_RESUBSCRIBE_MAX_TOPICS_PER_PACKET <= topic_vector.size()
+                    || DEFAULT_RESUBSCRIBE_MAX_PACKET_SIZE < packet_size + topic_size)) {
+                    append_subscribe_packet();
+                    packet_size = 2;
+                    if (DEFAULT_RESUBSCRIBE_WRITE_SIZE <= write_buf.length()) {
+                        rc = WriteToNetworkBuffer(p_network_connection, write_buf);
+                        write_buf.clear();
                         if (ResponseCode::SUCCESS != rc) {
-                            AWS_LOG_ERROR(KEEPALIVE_LOG_TAG,
-                                          "Writing PingReq to Network Failed. \n%s. \nDisconnecting!",
-                                          ResponseHelper::ToString(rc).c_str());
-                            rc = p_client_state_->PerformAction(ActionType::DISCONNECT,
-                                                                DisconnectPacket::Create(),
-                                                                p_client_state_->GetMqttCommandTimeout());
-                            if (ResponseCode::SUCCESS != rc) {
-                                AWS_LOG_ERROR(KEEPALIVE_LOG_TAG,
-                                              "Network Disconnect attempt returned unhandled error. \n%s",
-                                              ResponseHelper::ToString(rc).c_str());
-                            }
-                            p_client_state_->SetAutoReconnectRequired(true);
-                            continue;
+                            break;
                         }
+                    }
+                }
+                topic_vector.push_back(p_subscription);
+                packet_size += topic_size;
+            }
+
+            if (ResponseCode::SUCCESS == rc && !topic_vector.empty()) {
+                append_subscribe_packet();
+                rc = WriteToNetworkBuffer(p_network_connection, write_buf);
+            }
+
+            AWS_LOG_INFO(KEEPALIVE_LOG_TAG, "Sent %u Subscribe packets to resubscribe to %u topics",
+                         (unsigned int) packet_ids.size(), (unsigned int) subscriptions.size());
+            if (ResponseCode::SUCCESS != rc) {
+                AWS_LOG_ERROR(KEEPALIVE_LOG_TAG,
+                              "Resubscribe attempt returned unhandled error. \n%s",
+                              ResponseHelper::ToString(rc).c_str());
+                // Subacks of packets that were written are no longer waited for
+                for (uint16_t packet_id : packet_ids) {
+                    p_client_state_->DeletePendingAck(packet_id);
+                }
+                p_progress->Report(rc);
+            } else {
+                p_progress->OnAllPacketsSent();
+            }
+            return rc;
+        }
+
+        ResponseCode KeepaliveActionRunner::PerformReconnectStep(std::shared_ptr<NetworkConnection> p_network_connection,
+                                                                 std::chrono::microseconds &next_step_delay_out) {
+            ResponseCode rc = ResponseCode::SUCCESS;
+            if (nullptr == p_reconnect_token_) {
+                p_client_state_->SetPingreqPending(false);
+                if (p_client_state_->isDisconnectCallbackPending()) {
 
-                        p_client_state_->SetPingreqPending(true);
-                        next = std::chrono::system_clock::now() + std::chrono::seconds(keep_alive_interval);
+                    std::shared_ptr<ConnectPacket> p_connect_packet =
+                        std::dynamic_pointer_cast<ConnectPacket>(p_client_state_->GetAutoReconnectData());
+
+                    /**
+                     * NOTE: All callbacks used by the keepalive should be non-blocking
+                     */
+                    if (nullptr != p_client_state_->disconnect_handler_ptr_ && nullptr != p_connect_packet) {
+                        p_client_state_->disconnect_handler_ptr_(p_connect_packet->GetClientID(),
+                                                               p_client_state_->p_disconnect_app_handler_data_);
                     }
+
+                    reconnect_backoff_timer_ = p_client_state_->GetMinReconnectBackoffTimeout();
+                    max_backoff_value_ = p_client_state_->GetMaxReconnectBackoffTimeout();
+                    AWS_LOG_INFO(KEEPALIVE_LOG_TAG,
+                                 "Initial value of reconnect timer : %ld!!",
+                                 reconnect_backoff_timer_.count());
+                    AWS_LOG_INFO(KEEPALIVE_LOG_TAG, "Max backoff value : %ld!!", max_backoff_value_.count());
                 }
-                std::this_thread::sleep_for(thread_sleep_duration);
-            } while (_p_thread_continue_);
+                AWS_LOG_INFO(KEEPALIVE_LOG_TAG, "Attempting Reconnect");
+
+                p_reconnect_packet_ = std::dynamic_pointer_cast<ConnectPacket>(p_client_state_->GetAutoReconnectData());
+                p_reconnect_token_ = CompletionToken::Create();
+                reconnect_deadline_ = std::chrono::steady_clock::now() + p_client_state_->GetMqttCommandTimeout();
+                // Failures complete the token right away
+                p_client_state_->StartAction(ActionType::CONNECT, p_reconnect_packet_, p_reconnect_token_);
+            }
+
+            if (!p_reconnect_token_->IsComplete() && std::chrono::steady_clock::now() < reconnect_deadline_) {
+                // Connack is handled by the read runner, check again on the next step
+                next_step_delay_out = std::chrono::milliseconds(DEFAULT_CORE_THREAD_SLEEP_DURATION_MS);
+                return rc;
+            }
+
+            std::shared_ptr<ConnectPacket> p_connect_packet = p_reconnect_packet_;
+            rc = p_reconnect_token_->GetResponse();
+            if (!p_reconnect_token_->IsComplete()) {
+                // Stop waiting for the Connack so a late response does not reach a reused Action ID
+                p_client_state_->DeletePendingAck(p_connect_packet->GetActionId());
+            }
+            p_reconnect_token_ = nullptr;
+            p_reconnect_packet_ = nullptr;
+
+            if (nullptr != p_client_state_->reconnect_handler_ptr_) {
+                p_client_state_->reconnect_handler_ptr_(p_connect_packet->GetClientID(),
+                                                      p_client_state_->p_reconnect_app_handler_data_,
+                                                      rc);
+            }
+            if (ResponseCode::MQTT_CONNACK_CONNECTION_ACCEPTED == rc) {
+                // if no subscriptions, skip resubscribe
+                if (p_client_state_->HasSubscriptions()) {
+                    rc = Resubscribe(p_network_connection, p_connect_packet->GetClientID());
+                }
+                /**
+                 * NOTE :The resubscribe response can be NETWORK_DISCONNECTED_ERROR as the network might have
+                 * disconnected again after the reconnect was successful.
+                 */
+                if (ResponseCode::NETWORK_DISCONNECTED_ERROR != rc) {
+                    p_client_state_->SetAutoReconnectRequired(false);
+                } else {
+                    p_client_state_->PerformAction(ActionType::DISCONNECT,
+                                                   DisconnectPacket::Create(),
+                                                   p_client_state_->GetMqttCommandTimeout());
+                }
+                next_step_delay_out = std::chrono::microseconds(0);
+                return rc;
+            }
+
+            p_client_state_->setDisconnectCallbackPending(false);
+            AWS_LOG_ERROR(KEEPALIVE_LOG_TAG, "Reconnect failed. %s", ResponseHelper::ToString(rc).c_str());
+
+            AWS_LOG_INFO(KEEPALIVE_LOG_TAG,
+                         "Current value of reconnect timer : %ld!!",
+                         reconnect_backoff_timer_.count());
+            if (max_backoff_value_ > reconnect_backoff_timer_) {
+                reconnect_backoff_timer_ += reconnect_backoff_timer_;
+            }
 
+            AWS_LOG_INFO(KEEPALIVE_LOG_TAG,
+                         "Updated value of reconnect timer : %ld!!",
+                         reconnect_backoff_timer_.count());
+            next_step_delay_out = reconnect_backoff_timer_;
             return rc;
         }
     }
@@ -41,6 +41,9 @@ namespace awsiotsdk {
             : Action(ActionType::READ_INCOMING, "TLS Read Action Runner") {
             p_client_state_ = p_client_state;
             is_waiting_for_connack_ = true;
+            is_step_started_ = false;
+            is_read_wait_allowed_ = false;
+            is_deferred_publish_limit_reached_ = false;
         }
 
         std::unique_ptr<Action> NetworkReadActionRunner::Create(std::shared_ptr<ActionState> p_action_state) {
@@ -53,52 +56,78 @@ namespace awsiotsdk {
             return std::unique_ptr<NetworkReadActionRunner>(new NetworkReadActionRunner(p_client_state));
         }
 
-        ResponseCode NetworkReadActionRunner::DecodeRemainingLength(size_t &rem_len) {
-            util::String encoded_byte_str;
-            encoded_byte_str.reserve(1);
+        ResponseCode NetworkReadActionRunner::DecodeRemainingLength(const unsigned char *p_data, size_t data_len,
+                                                                     size_t &rem_len, size_t &header_len) {
             size_t multiplier = 1;
-            size_t len = 0;
-            ResponseCode rc;
             rem_len = 0;
-            util::Vector<unsigned char> temp_buf;
-
-            do {
-                temp_buf.clear();
-                if (++len > MAX_NO_OF_REMAINING_LENGTH_BYTES) {
-                    /* bad data */
-                    rc = ResponseCode::FAILURE;
-                    break;
+            // First byte is the fixed header byte
+            for (size_t len = 1; len <= MAX_NO_OF_REMAINING_LENGTH_BYTES; len++) {
+                if (len >= data_len) {
+                    header_len = len + 1;
+                    return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
                 }
-
-                rc = ReadFromNetworkBuffer(p_network_connection_, temp_buf, 1);
-                if (ResponseCode::SUCCESS != rc) {
-                    break;
-                }
-                rem_len += (size_t) ((temp_buf[0] & 127) * multiplier);
+                rem_len += (size_t) ((p_data[len] & 127) * multiplier);
                 multiplier *= 128;
-            } while (0 != (temp_buf[0] & 128));
+                if (0 == (p_data[len] & 128)) {
+                    header_len = len + 1;
+                    return ResponseCode::SUCCESS;
+                }
+            }
 
-            return rc;
+            /* bad data */
+            return ResponseCode::MQTT_DECODE_REMAINING_LENGTH_ERROR;
         }
 
-        ResponseCode NetworkReadActionRunner::ReadPacketFromNetwork(unsigned char &fixed_header_byte,
-                                                                    util::Vector<unsigned char> &read_buf) {
-            read_buf.clear();
-            ResponseCode rc = ReadFromNetworkBuffer(p_network_connection_, read_buf, 1);
-            if (ResponseCode::SUCCESS != rc) {
-                return rc;
+        ResponseCode NetworkReadActionRunner::TakeBufferedPacket(unsigned char &fixed_header_byte,
+                                                                 util::SharedBufferView &packet_out,
+                                                                 size_t &required_bytes_out) {
+            util::SharedBufferView buffered = p_network_connection_->GetReceiveBuffer();
+            const unsigned char *p_data = buffered.Data();
+            size_t buffered_bytes = buffered.Length();
+            // Fixed header byte and at least one remaining length byte
+            required_bytes_out = 2;
+            if (buffered_bytes < required_bytes_out) {
+                return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
             }
 
-            fixed_header_byte = read_buf[0];
-            read_buf.clear();
             size_t rem_len = 0;
-            rc = DecodeRemainingLength(rem_len);
+            size_t header_len = 0;
+            ResponseCode rc = DecodeRemainingLength(p_data, buffered_bytes, rem_len, header_len);
             if (ResponseCode::SUCCESS != rc) {
+                required_bytes_out = header_len;
                 return rc;
             }
 
-            if (0 < rem_len) {
-                rc = ReadFromNetworkBuffer(p_network_connection_, read_buf, rem_len);
+            required_bytes_out = header_len + rem_len;
+            if (buffered_bytes < required_bytes_out) {
+                return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+            }
+
+            fixed_header_byte = p_data[0];
+            packet_out = buffered.SubView(header_len, rem_len);
+            p_network_connection_->ConsumeReceiveBuffer(required_bytes_out);
+            return ResponseCode::SUCCESS;
+        }
+
+        ResponseCode NetworkReadActionRunner::ReadPacketFromNetwork(unsigned char &fixed_header_byte,
+                                                                    util::SharedBufferView &packet_out) {
+            // Release the previous packet first, the receive buffer is only reused if no views of it are held
+            packet_out = util::SharedBufferView();
+            size_t required_bytes = 0;
+            ResponseCode rc = TakeBufferedPacket(fixed_header_byte, packet_out, required_bytes);
+            // Read until the packet is complete, each read takes everything that has arrived so far
+            while (ResponseCode::NETWORK_SSL_NOTHING_TO_READ == rc) {
+                if (p_client_state_->IsInboundLimitReached()) {
+                    // Leave further data with the connection until handlers catch up
+                    break;
+                }
+                // Kept back Publishes are retried between reads, do not wait for data while there are any
+                rc = p_network_connection_->FillReceiveBuffer(required_bytes,
+                                                              is_read_wait_allowed_ && deferred_publishes_.empty());
+                if (ResponseCode::SUCCESS != rc) {
+                    break;
+                }
+                rc = TakeBufferedPacket(fixed_header_byte, packet_out, required_bytes);
             }
             return rc;
         }
@@ -109,65 +138,71 @@ namespace awsiotsdk {
                 return ResponseCode::NULL_VALUE_ERROR;
             }
 
-            bool is_duplicate;
-            bool is_retained;
-            QoS qos;
+            is_step_started_ = false;
+            // The thread is dedicated to this connection, waiting for the rest of a packet holds up nothing else
+            is_read_wait_allowed_ = true;
+            return RunActionSteps(p_network_connection, p_action_data);
+        }
+
+        bool NetworkReadActionRunner::IsStepPending() {
+            return !deferred_publishes_.empty() || p_client_state_->IsInboundLimitReached();
+        }
+
+        ResponseCode NetworkReadActionRunner::PerformActionStep(std::shared_ptr<NetworkConnection> p_network_connection,
+                                                                std::shared_ptr<ActionData> p_action_data,
+                                                                std::chrono::microseconds &next_step_delay_out) {
+            IOT_UNUSED(p_action_data);
+            if (nullptr == p_network_connection) {
+                next_step_delay_out = std::chrono::microseconds(-1);
+                return ResponseCode::NULL_VALUE_ERROR;
+            }
+
+            if (!is_step_started_) {
+                p_network_connection_ = p_network_connection;
+                is_waiting_for_connack_ = !(p_client_state_->IsConnected());
+                is_step_started_ = true;
+            }
+
+            SubmitDeferredPublishes();
+            p_client_state_->SetInboundPaused(is_deferred_publish_limit_reached_
+                                                  || p_client_state_->IsInboundLimitReached());
+            if (is_deferred_publish_limit_reached_) {
+                // Packets stay buffered until the full shard has room for the Publishes kept back for it
+                next_step_delay_out = std::chrono::milliseconds(DEFAULT_INBOUND_PAUSE_DURATION_MS);
+                return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+            }
+
             unsigned char fixed_header_byte;
-            unsigned char message_type_byte;
-            util::Vector<unsigned char> read_buf;
             ResponseCode rc = ResponseCode::SUCCESS;
-            p_network_connection_ = p_network_connection;
             std::atomic_bool &_p_thread_continue_ = *p_thread_continue_;
-            std::chrono::milliseconds thread_sleep_duration(DEFAULT_CORE_THREAD_SLEEP_DURATION_MS);
-
-            is_waiting_for_connack_ = !(p_client_state_->IsConnected());
-
-            do {
-                AWS_LOG_TRACE(NETWORK_READ_LOG_TAG,
-                              " Network Read Thread, TLS Status : %d",
-                              p_network_connection->IsConnected());
-                // Clear buffers
-                fixed_header_byte = 0x00;
-                read_buf.clear();
-                rc = ReadPacketFromNetwork(fixed_header_byte, read_buf);
-                if (ResponseCode::NETWORK_SSL_NOTHING_TO_READ == rc) {
-                    std::this_thread::sleep_for(thread_sleep_duration);
-                    continue;
-                } else if (ResponseCode::SUCCESS == rc) {
-                    message_type_byte = fixed_header_byte;
-                    message_type_byte >>= 4; // Packet type is in first 4 bits
-                    message_type_byte &= 0x0F; // Only keep the least significant 4 bits
-                    MessageTypes messageType = (MessageTypes) message_type_byte;
-                    switch (messageType) {
-                        case MessageTypes::CONNACK:
-                            rc = HandleConnack(read_buf);
-                            break;
-                        case MessageTypes::PUBLISH: {
-                            is_retained = ((fixed_header_byte & 0x01) == 0x01);
-                            is_duplicate = ((fixed_header_byte & 0x08) == 0x08);
-                            qos = ((fixed_header_byte & 0x02) == 0x02) ? QoS::QOS1 : QoS::QOS0;
-                            rc = HandlePublish(read_buf, is_duplicate, is_retained, qos);
-                        }
-                            break;
-                        case MessageTypes::PUBACK:
-                            rc = HandlePuback(read_buf);
-                            break;
-                        case MessageTypes::SUBACK:
-                            rc = HandleSuback(read_buf);
-                            break;
-                        case MessageTypes::UNSUBACK:
-                            rc = HandleUnsuback(read_buf);
-                            break;
-                        case MessageTypes::PINGRESP:
-                            p_client_state_->SetPingreqPending(false);
-                            rc = ResponseCode::SUCCESS;
-                            break;
-                        default:
-                            // Any type values other than above are either unsupported or invalid
-                            // Packet types used for QoS2 are currently unsupported
-                            break;
-                    }
-                } else if (!is_waiting_for_connack_) {
+            next_step_delay_out = std::chrono::microseconds(0);
+
+            AWS_LOG_TRACE(NETWORK_READ_LOG_TAG,
+                          " Network Read Thread, TLS Status : %d",
+                          p_network_connection->IsConnected());
+            fixed_header_byte = 0x00;
+            util::SharedBufferView packet;
+            rc = ReadPacketFromNetwork(fixed_header_byte, packet);
+            if (ResponseCode::NETWORK_SSL_NOTHING_TO_READ == rc) {
+                next_step_delay_out = IsStepPending()
+                                      ? std::chrono::milliseconds(DEFAULT_INBOUND_PAUSE_DURATION_MS)
+                                      : std::chrono::milliseconds(DEFAULT_CORE_THREAD_SLEEP_DURATION_MS);
+            } else if (ResponseCode::SUCCESS == rc) {
+                rc = HandlePacket(fixed_header_byte, packet);
+                // Handle the rest of the packets that arrived with the same read. They are not visible on the socket
+                // anymore, watchers would not be woken up for them
+                size_t required_bytes = 0;
+                while (_p_thread_continue_ && !is_deferred_publish_limit_reached_
+                    && ResponseCode::SUCCESS == TakeBufferedPacket(fixed_header_byte, packet, required_bytes)) {
+                    rc = HandlePacket(fixed_header_byte, packet);
+                }
+                if (is_deferred_publish_limit_reached_) {
+                    next_step_delay_out = std::chrono::milliseconds(DEFAULT_INBOUND_PAUSE_DURATION_MS);
+                }
+            } else {
+                // Reads fail right away while disconnected, do not spin until the reconnect completes
+                next_step_delay_out = std::chrono::milliseconds(DEFAULT_CORE_THREAD_SLEEP_DURATION_MS);
+                if (!is_waiting_for_connack_) {
                     is_waiting_for_connack_ = true;
                     if (_p_thread_continue_ && p_client_state_->IsConnected()) {
                         AWS_LOG_ERROR(NETWORK_READ_LOG_TAG,
@@ -185,7 +220,53 @@ namespace awsiotsdk {
                         p_client_state_->SetAutoReconnectRequired(true);
                     }
                 }
-            } while (_p_thread_continue_);
+            }
+            return rc;
+        }
+
+        ResponseCode NetworkReadActionRunner::HandlePacket(unsigned char fixed_header_byte,
+                                                           const util::SharedBufferView &packet) {
+            ResponseCode rc = ResponseCode::SUCCESS;
+            bool is_duplicate;
+            bool is_retained;
+            QoS qos;
+            unsigned char message_type_byte = fixed_header_byte;
+            message_type_byte >>= 4; // Packet type is in first 4 bits
+            message_type_byte &= 0x0F; // Only keep the least significant 4 bits
+            MessageTypes messageType = (MessageTypes) message_type_byte;
+            if (MessageTypes::PUBLISH != messageType) {
+                // Only PUBLISH payloads are delivered without copying, the other packets are small
+                read_buf_.assign(packet.Data(), packet.Data() + packet.Length());
+            }
+            switch (messageType) {
+                case MessageTypes::CONNACK:
+                    rc = HandleConnack(read_buf_);
+                    break;
+                case MessageTypes::PUBLISH: {
+                    is_retained = ((fixed_header_byte & 0x01) == 0x01);
+                    is_duplicate = ((fixed_header_byte & 0x08) == 0x08);
+                    qos = ((fixed_header_byte & 0x02) == 0x02) ? QoS::QOS1 : QoS::QOS0;
+                    rc = HandlePublish(packet, is_duplicate, is_retained, qos);
+                }
+                    break;
+                case MessageTypes::PUBACK:
+                    rc = HandlePuback(read_buf_);
+                    break;
+                case MessageTypes::SUBACK:
+                    rc = HandleSuback(read_buf_);
+                    break;
+                case MessageTypes::UNSUBACK:
+                    rc = HandleUnsuback(read_buf_);
+                    break;
+                case MessageTypes::PINGRESP:
+                    p_client_state_->SetPingreqPending(false);
+                    rc = ResponseCode::SUCCESS;
+                    break;
+                default:
+                    // Any type values other than above are either unsupported or invalid
+                    // Packet types used for QoS2 are currently unsupported
+                    break;
+            }
             return rc;
         }
 
@@ -229,35 +310,169 @@ namespace awsiotsdk {
             return rc;
         }
 
-        ResponseCode NetworkReadActionRunner::HandlePublish(const util::Vector<unsigned char> &read_buf,
-                                                            bool is_retained,
+        ResponseCode NetworkReadActionRunner::HandlePublish(const util::SharedBufferView &packet,
                                                             bool is_duplicate,
+                                                            bool is_retained,
                                                             QoS qos) {
-            ResponseCode rc = ResponseCode::FAILURE;
-            std::shared_ptr<mqtt::PublishPacket>
-                p_publish_packet = PublishPacket::Create(read_buf, is_retained, is_duplicate, qos);
+            IOT_UNUSED(is_duplicate);
+            IOT_UNUSED(is_retained);
+            // Topic and payload are passed to view handlers as views of the packet, without copying
+            const unsigned char *p_data = packet.Data();
+            size_t packet_len = packet.Length();
+            if (3 > packet_len) {
+                // Must be at least length 3 to be contain a valid topic name
+                return ResponseCode::MQTT_UNEXPECTED_PACKET_FORMAT_ERROR;
+            }
+            size_t topic_len = (size_t) (p_data[1] + (256 * p_data[0]));
+            size_t extract_index = 2;
+            if (0 == topic_len || topic_len > packet_len - extract_index) {
+                return ResponseCode::MQTT_UNEXPECTED_PACKET_FORMAT_ERROR;
+            }
+            util::SharedBufferView topic_view = packet.SubView(extract_index, topic_len);
+            const char *p_topic = reinterpret_cast<const char *>(topic_view.Data());
+            if (!Utf8String::IsValidInput(p_topic, topic_len)) {
+                return ResponseCode::MQTT_UNEXPECTED_PACKET_FORMAT_ERROR;
+            }
+            extract_index += topic_len;
 
-            util::String topic_name = p_publish_packet->GetTopicName();
-            std::shared_ptr<Subscription> p_sub = p_client_state_->GetSubscription(topic_name);
+            uint16_t packet_id = 0;
+            if (QoS::QOS0 != qos) {
+                if (2 > packet_len - extract_index) {
+                    return ResponseCode::MQTT_UNEXPECTED_PACKET_FORMAT_ERROR;
+                }
+                packet_id = (uint16_t) (p_data[extract_index + 1] + (256 * p_data[extract_index]));
+                extract_index += 2;
+            }
+            util::SharedBufferView payload_view = packet.SubView(extract_index, packet_len - extract_index);
+
+            util::String topic_name(p_topic, topic_len);
+            util::Vector<std::shared_ptr<Subscription>> matching_subscriptions;
+            p_client_state_->GetSubscriptions(topic_name, matching_subscriptions);
+
+            std::shared_ptr<util::Threading::KeyedExecutor>
+                p_handler_executor = p_client_state_->GetSubscriptionHandlerExecutor();
+            size_t inbound_bytes = packet.Length();
+            if (nullptr == p_handler_executor) {
+                p_client_state_->AddInboundMessage(inbound_bytes);
+                ResponseCode rc = DeliverPublish(p_client_state_, topic_name, topic_view, payload_view,
+                                                 matching_subscriptions, qos, packet_id);
+                p_client_state_->RemoveInboundMessage(inbound_bytes);
+                return rc;
+            }
 
-            if (nullptr != p_sub) {
+            // Messages without an active subscription are reported right away, as on the synchronous path
+            ResponseCode rc = ResponseCode::MQTT_NO_SUBSCRIPTION_FOUND;
+            for (const std::shared_ptr<Subscription> &p_sub : matching_subscriptions) {
                 if (p_sub->IsActive()) {
-                    p_sub->p_app_handler_(topic_name, p_publish_packet->GetPayload(), p_sub->p_app_handler_data_);
                     rc = ResponseCode::SUCCESS;
+                    break;
+                }
+                rc = ResponseCode::MQTT_SUBSCRIPTION_NOT_ACTIVE;
+            }
+            if (ResponseCode::SUCCESS != rc) {
+                return rc;
+            }
+
+            // Handlers run on the executor, in order for each topic. The views keep the receive buffer alive
+            std::weak_ptr<ClientState> p_weak_client_state = p_client_state_;
+            p_client_state_->AddInboundMessage(inbound_bytes);
+            util::Threading::KeyedExecutor::WorkItemPtr p_work_item = [p_weak_client_state, topic_name, topic_view,
+                                                                       payload_view, matching_subscriptions, qos,
+                                                                       packet_id, inbound_bytes]() {
+                std::shared_ptr<ClientState> p_client_state = p_weak_client_state.lock();
+                if (nullptr != p_client_state) {
+                    DeliverPublish(p_client_state, topic_name, topic_view, payload_view, matching_subscriptions, qos,
+                                   packet_id);
+                    p_client_state->RemoveInboundMessage(inbound_bytes);
+                }
+            };
+            // Waiting for room could block the worker the shard needs if the executor is shared with this runner.
+            // Publishes of a shard with kept back Publishes queue behind them, handlers must see them in order
+            size_t shard_index = p_handler_executor->GetShardIndex(topic_name);
+            util::Map<size_t, std::deque<DeferredPublish>>::iterator
+                deferred_itr = deferred_publishes_.find(shard_index);
+            if (deferred_publishes_.end() != deferred_itr || !p_handler_executor->TrySubmit(topic_name, p_work_item)) {
+                std::deque<DeferredPublish> &shard_publishes = deferred_publishes_[shard_index];
+                DeferredPublish deferred_publish;
+                deferred_publish.topic_name_ = std::move(topic_name);
+                deferred_publish.p_work_item_ = std::move(p_work_item);
+                shard_publishes.push_back(std::move(deferred_publish));
+                // Bounds memory for a shard that does not catch up, the kept back Publishes count as inbound too
+                if (shard_publishes.size() >= p_handler_executor->GetMaxQueueDepth()) {
+                    is_deferred_publish_limit_reached_ = true;
+                }
+            }
+            return ResponseCode::SUCCESS;
+        }
+
+        void NetworkReadActionRunner::SubmitDeferredPublishes() {
+            if (deferred_publishes_.empty()) {
+                return;
+            }
+
+            std::shared_ptr<util::Threading::KeyedExecutor>
+                p_handler_executor = p_client_state_->GetSubscriptionHandlerExecutor();
+            is_deferred_publish_limit_reached_ = false;
+            util::Map<size_t, std::deque<DeferredPublish>>::iterator itr = deferred_publishes_.begin();
+            while (deferred_publishes_.end() != itr) {
+                std::deque<DeferredPublish> &shard_publishes = itr->second;
+                while (!shard_publishes.empty()) {
+                    DeferredPublish &deferred_publish = shard_publishes.front();
+                    if (nullptr == p_handler_executor) {
+                        deferred_publish.p_work_item_();
+                    } else if (!p_handler_executor->TrySubmit(deferred_publish.topic_name_,
+                                                              deferred_publish.p_work_item_)) {
+                        break;
+                    }
+                    shard_publishes.pop_front();
+                }
+
+                if (shard_publishes.empty()) {
+                    itr = deferred_publishes_.erase(itr);
                 } else {
+                    if (shard_publishes.size() >= p_handler_executor->GetMaxQueueDepth()) {
+                        is_deferred_publish_limit_reached_ = true;
+                    }
+                    ++itr;
+                }
+            }
+        }
+
+        ResponseCode NetworkReadActionRunner::DeliverPublish(const std::shared_ptr<ClientState> &p_client_state,
+                                                             const util::String &topic_name,
+                                                             const util::SharedBufferView &topic_view,
+                                                             const util::SharedBufferView &payload_view,
+                                                             const util::Vector<std::shared_ptr<Subscription>> &matching_subscriptions,
+                                                             QoS qos,
+                                                             uint16_t packet_id) {
+            // Every matching subscription receives the message, overlapping filters each get a callback
+            // The payload is copied at most once, and only if a subscription uses a String handler
+            ResponseCode rc = ResponseCode::MQTT_NO_SUBSCRIPTION_FOUND;
+            util::String payload;
+            bool is_payload_copied = false;
+            for (const std::shared_ptr<Subscription> &p_sub : matching_subscriptions) {
+                if (p_sub->IsActive()) {
+                    if (nullptr != p_sub->p_app_view_handler_) {
+                        p_sub->p_app_view_handler_(topic_view, payload_view, p_sub->p_app_handler_data_);
+                    } else {
+                        if (!is_payload_copied) {
+                            payload = payload_view.ToString();
+                            is_payload_copied = true;
+                        }
+                        p_sub->p_app_handler_(topic_name, payload, p_sub->p_app_handler_data_);
+                    }
+                    rc = ResponseCode::SUCCESS;
+                } else if (ResponseCode::SUCCESS != rc) {
                     rc = ResponseCode::MQTT_SUBSCRIPTION_NOT_ACTIVE;
                 }
-            } else {
-                rc = ResponseCode::MQTT_NO_SUBSCRIPTION_FOUND;
             }
 
             if (ResponseCode::SUCCESS == rc && QoS::QOS0 != qos) {
-                std::shared_ptr<mqtt::PubackPacket>
-                    p_puback_packet = PubackPacket::Create(p_publish_packet->GetPacketId());
+                std::shared_ptr<mqtt::PubackPacket> p_puback_packet = p_client_state->AcquirePubackPacket(packet_id);
                 uint16_t action_id = 0;
                 /* TODO: nullchecks */
                 //Ignore action_id, we don't support QoS2 at the moment
-                rc = p_client_state_->EnqueueOutboundAction(ActionType::PUBACK, p_puback_packet, action_id);
+                rc = p_client_state->EnqueueOutboundAction(ActionType::PUBACK, p_puback_packet, action_id);
             }
 
             return rc;
@@ -278,13 +493,16 @@ namespace awsiotsdk {
             uint8_t itr = 0;
             bool has_atleast_one_success = false;
             bool has_atleast_one_failure = false;
+            util::Vector<uint8_t> failed_indexes;
 
             std::shared_ptr<mqtt::SubackPacket> p_suback_packet = SubackPacket::Create(read_buf);
             uint16_t packet_id = p_suback_packet->GetPacketId();
             for (uint8_t qos : p_suback_packet->suback_list_) {
+                rc = ResponseCode::SUCCESS;
                 if (128 == qos) { // MQTT spec specifies 128 is returned when subscribe fails
                     has_atleast_one_failure = true;
-                    rc = p_client_state_->RemoveSubscription(packet_id, static_cast<uint8_t>(itr + 1));
+                    // Removed together below, so the subscription snapshot is published once per SUBACK
+                    failed_indexes.push_back(static_cast<uint8_t>(itr + 1));
                 } else if (0 == qos) {
                     has_atleast_one_success = true;
                     rc = p_client_state_->SetSubscriptionActive(packet_id,
@@ -303,6 +521,13 @@ namespace awsiotsdk {
                 }
                 itr++;
             }
+            if (!failed_indexes.empty()) {
+                rc = p_client_state_->RemoveSubscriptions(packet_id, failed_indexes);
+                if (ResponseCode::SUCCESS != rc) {
+                    AWS_LOG_ERROR(NETWORK_READ_LOG_TAG, "Subscription update attempt returned unhandled error. %s",
+                                  ResponseHelper::ToString(rc).c_str());
+                }
+            }
 
             rc = ResponseCode::MQTT_SUBSCRIBE_FAILED;
             if (has_atleast_one_success && has_atleast_one_failure) {
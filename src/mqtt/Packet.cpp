@@ -206,9 +206,10 @@ namespace awsiotsdk {
             uint16_t len = (uint16_t)(second_byte + (256 * first_byte));
 
             if ((1 <= len) && (len <= (buf.size() - extract_index))) {
-                util::String out_str(buf.begin() + extract_index, buf.begin() + extract_index + len);
+                // Validated in place, the string is only allocated for valid input
+                const char *p_str = reinterpret_cast<const char *>(buf.data()) + extract_index;
                 extract_index += len;
-                return Utf8String::Create(out_str);
+                return Utf8String::Create(p_str, len);
             }
 
             return nullptr;
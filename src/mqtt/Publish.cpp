@@ -35,6 +35,34 @@
 namespace awsiotsdk {
     namespace mqtt {
 
+        /*********************************************
+         * PublishRequest class function definitions *
+         ********************************************/
+        PublishRequest::PublishRequest(std::unique_ptr<Utf8String> p_topic_name, QoS qos)
+            : p_topic_name_(std::move(p_topic_name)), is_retained_(false), is_duplicate_(false), qos_(qos),
+              priority_((QoS::QOS1 == qos) ? ActionPriority::HIGH : ActionPriority::LOW) {
+        }
+
+        PublishRequest::PublishRequest(std::shared_ptr<const TopicHandle> p_topic_handle, QoS qos)
+            : p_topic_handle_(std::move(p_topic_handle)), is_retained_(false), is_duplicate_(false), qos_(qos),
+              priority_((QoS::QOS1 == qos) ? ActionPriority::HIGH : ActionPriority::LOW) {
+        }
+
+        void PublishRequest::SetPayload(const util::String &payload) {
+            shared_payload_ = util::SharedBufferView();
+            payload_ = payload;
+        }
+
+        void PublishRequest::SetPayload(util::String &&payload) {
+            shared_payload_ = util::SharedBufferView();
+            payload_ = std::move(payload);
+        }
+
+        void PublishRequest::SetPayload(const util::SharedBufferView &payload) {
+            payload_.clear();
+            shared_payload_ = payload;
+        }
+
         /********************************************
          * PublishPacket class function definitions *
          *******************************************/
@@ -43,18 +71,140 @@ namespace awsiotsdk {
                                      bool is_duplicate,
                                      QoS qos,
                                      const util::String &payload) {
-            packet_size_ = p_topic_name->Length() + 2 + payload.length(); // length of topic name requires 2 bytes
+            Reset(std::move(p_topic_name), is_retained, is_duplicate, qos, payload);
+        }
 
-            if (QoS::QOS0 != qos) {
-                packet_size_ += 2; // Packet ID requires 2 bytes in case of QoS1 and QoS2
-            }
+        PublishPacket::PublishPacket(std::unique_ptr<Utf8String> p_topic_name,
+                                     bool is_retained,
+                                     bool is_duplicate,
+                                     QoS qos,
+                                     util::String &&payload) {
+            Reset(std::move(p_topic_name), is_retained, is_duplicate, qos, std::move(payload));
+        }
+
+        PublishPacket::PublishPacket(std::unique_ptr<Utf8String> p_topic_name,
+                                     bool is_retained,
+                                     bool is_duplicate,
+                                     QoS qos,
+                                     const util::SharedBufferView &payload) {
+            Reset(std::move(p_topic_name), is_retained, is_duplicate, qos, payload);
+        }
+
+        PublishPacket::PublishPacket(std::shared_ptr<const TopicHandle> p_topic_handle,
+                                     bool is_retained,
+                                     bool is_duplicate,
+                                     QoS qos,
+                                     const util::String &payload) {
+            Reset(std::move(p_topic_handle), is_retained, is_duplicate, qos, payload);
+        }
+
+        PublishPacket::PublishPacket(std::shared_ptr<const TopicHandle> p_topic_handle,
+                                     bool is_retained,
+                                     bool is_duplicate,
+                                     QoS qos,
+                                     util::String &&payload) {
+            Reset(std::move(p_topic_handle), is_retained, is_duplicate, qos, std::move(payload));
+        }
+
+        PublishPacket::PublishPacket(std::shared_ptr<const TopicHandle> p_topic_handle,
+                                     bool is_retained,
+                                     bool is_duplicate,
+                                     QoS qos,
+                                     const util::SharedBufferView &payload) {
+            Reset(std::move(p_topic_handle), is_retained, is_duplicate, qos, payload);
+        }
+
+        void PublishPacket::Reset(std::unique_ptr<Utf8String> p_topic_name,
+                                  bool is_retained,
+                                  bool is_duplicate,
+                                  QoS qos,
+                                  const util::String &payload) {
+            SetTopic(std::move(p_topic_name));
+            SetPayload(payload);
+            InitializeHeader(is_retained, is_duplicate, qos);
+        }
+
+        void PublishPacket::Reset(std::unique_ptr<Utf8String> p_topic_name,
+                                  bool is_retained,
+                                  bool is_duplicate,
+                                  QoS qos,
+                                  util::String &&payload) {
+            SetTopic(std::move(p_topic_name));
+            SetPayload(std::move(payload));
+            InitializeHeader(is_retained, is_duplicate, qos);
+        }
+
+        void PublishPacket::Reset(std::unique_ptr<Utf8String> p_topic_name,
+                                  bool is_retained,
+                                  bool is_duplicate,
+                                  QoS qos,
+                                  const util::SharedBufferView &payload) {
+            SetTopic(std::move(p_topic_name));
+            SetPayload(payload);
+            InitializeHeader(is_retained, is_duplicate, qos);
+        }
+
+        void PublishPacket::Reset(std::shared_ptr<const TopicHandle> p_topic_handle,
+                                  bool is_retained,
+                                  bool is_duplicate,
+                                  QoS qos,
+                                  const util::String &payload) {
+            SetTopic(std::move(p_topic_handle));
+            SetPayload(payload);
+            InitializeHeader(is_retained, is_duplicate, qos);
+        }
 
+        void PublishPacket::Reset(std::shared_ptr<const TopicHandle> p_topic_handle,
+                                  bool is_retained,
+                                  bool is_duplicate,
+                                  QoS qos,
+                                  util::String &&payload) {
+            SetTopic(std::move(p_topic_handle));
+            SetPayload(std::move(payload));
+            InitializeHeader(is_retained, is_duplicate, qos);
+        }
+
+        void PublishPacket::Reset(std::shared_ptr<const TopicHandle> p_topic_handle,
+                                  bool is_retained,
+                                  bool is_duplicate,
+                                  QoS qos,
+                                  const util::SharedBufferView &payload) {
+            SetTopic(std::move(p_topic_handle));
+            SetPayload(payload);
+            InitializeHeader(is_retained, is_duplicate, qos);
+        }
+
+        void PublishPacket::SetTopic(std::unique_ptr<Utf8String> p_topic_name) {
+            p_topic_handle_ = nullptr;
             p_topic_name_ = std::move(p_topic_name);
+        }
+
+        void PublishPacket::SetTopic(std::shared_ptr<const TopicHandle> p_topic_handle) {
+            p_topic_name_ = nullptr;
+            p_topic_handle_ = std::move(p_topic_handle);
+        }
+
+        void PublishPacket::SetPayload(const util::String &payload) {
+            shared_payload_ = util::SharedBufferView();
+            // Assigning keeps the capacity of a reused packet
+            payload_.assign(payload);
+        }
+
+        void PublishPacket::SetPayload(util::String &&payload) {
+            shared_payload_ = util::SharedBufferView();
+            payload_ = std::move(payload);
+        }
+
+        void PublishPacket::SetPayload(const util::SharedBufferView &payload) {
             payload_.clear();
+            shared_payload_ = payload;
+        }
 
-            // If payload is not zero length, add it to the packet
-            if (0 != payload.length()) {
-                payload_ = payload;
+        void PublishPacket::InitializeHeader(bool is_retained, bool is_duplicate, QoS qos) {
+            packet_size_ = GetEncodedTopicLength() + GetPayloadLen();
+
+            if (QoS::QOS0 != qos) {
+                packet_size_ += 2; // Packet ID requires 2 bytes in case of QoS1 and QoS2
             }
 
             is_retained_ = is_retained;
@@ -65,12 +215,22 @@ namespace awsiotsdk {
             }
             packet_id_ = 0; // Initialized by ClientCore
             qos_ = qos;
+            p_async_ack_handler_ = nullptr;
+            p_completion_token_ = nullptr;
 
             fixed_header_.Initialize(MessageTypes::PUBLISH, is_duplicate, qos, is_retained, packet_size_);
 
             serialized_packet_length_ = packet_size_ + fixed_header_.Length();
         }
 
+        void PublishPacket::AppendTopicToBuffer(util::String &buf) {
+            if (nullptr != p_topic_handle_) {
+                buf.append(p_topic_handle_->GetEncodedTopicName());
+            } else {
+                AppendUtf8StringToBuffer(buf, p_topic_name_);
+            }
+        }
+
         PublishPacket::PublishPacket(const util::Vector<unsigned char> &buf,
                                      bool is_retained,
                                      bool is_duplicate,
@@ -128,22 +288,47 @@ namespace awsiotsdk {
             buf.reserve(serialized_packet_length_);
 
             fixed_header_.AppendToBuffer(buf);
-            AppendUtf8StringToBuffer(buf, p_topic_name_);
+            AppendTopicToBuffer(buf);
 
             if (QoS::QOS0 != qos_) {
                 AppendUInt16ToBuffer(buf, GetPacketId());
             }
 
-            buf.append(payload_);
+            buf.append(GetPayloadData(), GetPayloadLen());
             return buf;
         }
 
+        void PublishPacket::ToSegments(util::String &header_buf, util::Vector<WriteSegment> &segments_out) {
+            header_buf.clear();
+            header_buf.reserve(serialized_packet_length_ - GetPayloadLen());
+
+            fixed_header_.AppendToBuffer(header_buf);
+            AppendTopicToBuffer(header_buf);
+
+            if (QoS::QOS0 != qos_) {
+                AppendUInt16ToBuffer(header_buf, GetPacketId());
+            }
+
+            segments_out.clear();
+            segments_out.push_back(WriteSegment(header_buf.data(), header_buf.length()));
+            if (0 != GetPayloadLen()) {
+                segments_out.push_back(WriteSegment(GetPayloadData(), GetPayloadLen()));
+            }
+        }
+
         /*******************************************
          * PubackPacket class function definitions *
          ******************************************/
         PubackPacket::PubackPacket(uint16_t publish_packet_id) {
+            Reset(publish_packet_id);
+        }
+
+        void PubackPacket::Reset(uint16_t publish_packet_id) {
             packet_size_ = 2; // Packet ID requires 2 bytes in case of QoS1 and QoS2
             publish_packet_id_ = publish_packet_id;
+            packet_id_ = 0;
+            p_async_ack_handler_ = nullptr;
+            p_completion_token_ = nullptr;
             fixed_header_.Initialize(MessageTypes::PUBACK, false, QoS::QOS0, false, packet_size_);
             serialized_packet_length_ = packet_size_ + fixed_header_.Length();
         }
@@ -189,8 +374,8 @@ namespace awsiotsdk {
             bool is_ack_registered = false;
             ResponseCode rc = ResponseCode::SUCCESS;
             uint16_t packet_id = p_publish_packet->GetPacketId();
-            if (QoS::QOS0 != p_publish_packet->GetQoS() && nullptr != p_publish_packet->p_async_ack_handler_) {
-                rc = p_client_state_->RegisterPendingAck(packet_id, p_publish_packet->p_async_ack_handler_);
+            if (p_publish_packet->IsAckExpected() && p_publish_packet->HasAckListener()) {
+                rc = p_client_state_->RegisterPendingAck(packet_id, p_publish_packet);
                 if (ResponseCode::SUCCESS != rc) {
                     AWS_LOG_ERROR(PUBLISH_ACTION_LOG_TAG,
                                   "Registering Ack Handler for Connect Action failed. %s",
@@ -200,8 +385,10 @@ namespace awsiotsdk {
                 }
             }
 
-            const util::String packet_data = p_publish_packet->ToString();
-            rc = WriteToNetworkBuffer(p_network_connection, packet_data);
+            // The payload is written from the packet, only the header is serialized. Actions are not run
+            // concurrently, so the buffers are kept for the next Publish
+            p_publish_packet->ToSegments(header_buf_, segments_);
+            rc = WriteToNetworkBuffer(p_network_connection, segments_);
             if (ResponseCode::SUCCESS != rc) {
                 if (is_ack_registered) {
                     p_client_state_->DeletePendingAck(packet_id);
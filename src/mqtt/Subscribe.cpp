@@ -71,9 +71,9 @@ namespace awsiotsdk {
             fixed_header_.AppendToBuffer(buf);
             AppendUInt16ToBuffer(buf, static_cast<uint16_t>(packet_id_));
 
-            uint8_t itr_index;
+            // Ack indexes are set by ClientState::IndexSubscribePacket, under the lock the read thread uses
             util::Vector<std::shared_ptr<Subscription>>::iterator itr;
-            for (itr = subscription_list_.begin(), itr_index = 1; itr < subscription_list_.end(); ++itr, ++itr_index) {
+            for (itr = subscription_list_.begin(); itr < subscription_list_.end(); ++itr) {
                 std::shared_ptr<Utf8String> utf8_str = (*itr)->GetTopicName();
                 AppendUtf8StringToBuffer(buf, utf8_str);
                 switch ((*itr)->GetMaxQos()) {
@@ -85,7 +85,6 @@ namespace awsiotsdk {
                         break;
                 }
                 buf.append(&temp_qos_byte, 1);
-                (*itr)->SetAckIndex(static_cast<uint16_t>(packet_id_), itr_index);
             }
 
             return buf;
@@ -234,8 +233,8 @@ namespace awsiotsdk {
             }
 
             uint16_t packet_id = p_subscribe_packet->GetPacketId();
-            if (nullptr != p_subscribe_packet->p_async_ack_handler_) {
-                rc = p_client_state_->RegisterPendingAck(packet_id, p_subscribe_packet->p_async_ack_handler_);
+            if (p_subscribe_packet->HasAckListener()) {
+                rc = p_client_state_->RegisterPendingAck(packet_id, p_subscribe_packet);
                 if (ResponseCode::SUCCESS != rc) {
                     AWS_LOG_ERROR(SUBSCRIBE_ACTION_LOG_TAG,
                                   "Registering Ack Handler for Connect Action failed. %s",
@@ -249,34 +248,24 @@ namespace awsiotsdk {
             util::Vector<std::shared_ptr<Subscription>>::iterator itr = p_subscribe_packet->subscription_list_.begin();
             while (itr != p_subscribe_packet->subscription_list_.end()) {
                 util::String topic_name = (*itr)->GetTopicName()->ToStdString();
-                auto existing_itr = p_client_state_->subscription_map_.find(topic_name);
-                if (p_client_state_->subscription_map_.end() != existing_itr) {
-                    if (existing_itr->second->IsActive()) {
-                        itr = p_subscribe_packet->subscription_list_.erase(itr);
-                        // TODO: This needs to be reworked
-                        continue;
-                    } else {
-                        p_client_state_->subscription_map_.erase(existing_itr);
-                        p_client_state_->subscription_map_.insert(std::make_pair(topic_name, (*itr)));
-                    }
-                } else {
-                    p_client_state_->subscription_map_.insert(std::make_pair(topic_name, (*itr)));
+                std::shared_ptr<Subscription> p_existing_subscription = p_client_state_->FindSubscription(topic_name);
+                if (nullptr != p_existing_subscription && p_existing_subscription->IsActive()) {
+                    itr = p_subscribe_packet->subscription_list_.erase(itr);
+                    // TODO: This needs to be reworked
+                    continue;
                 }
-
                 itr++;
             }
+            p_client_state_->AddSubscriptions(p_subscribe_packet->subscription_list_);
 
             const util::String packet_data = p_subscribe_packet->ToString();
+            p_client_state_->IndexSubscribePacket(packet_id, p_subscribe_packet->subscription_list_);
             rc = WriteToNetworkBuffer(p_network_connection, packet_data);
             if (ResponseCode::SUCCESS != rc) {
                 AWS_LOG_ERROR(SUBSCRIBE_ACTION_LOG_TAG, "Subscribe Write to Network Failed. %s",
                               ResponseHelper::ToString(rc).c_str());
                 // Remove acks
-                for (itr = p_subscribe_packet->subscription_list_.begin();
-                     itr < p_subscribe_packet->subscription_list_.end(); ++itr) {
-                    util::String topic_name = (*itr)->GetTopicName()->ToStdString();
-                    p_client_state_->subscription_map_.erase(topic_name);
-                }
+                p_client_state_->RemoveSubscriptions(p_subscribe_packet->subscription_list_);
                 if (is_ack_registered) {
                     p_client_state_->DeletePendingAck(packet_id);
                 }
@@ -315,9 +304,8 @@ namespace awsiotsdk {
             ResponseCode rc = ResponseCode::SUCCESS;
             bool is_ack_registered = false;
 
-            if (nullptr != p_unsubscribe_packet->p_async_ack_handler_) {
-                rc = p_client_state_->RegisterPendingAck(p_unsubscribe_packet->GetPacketId(),
-                                                         p_unsubscribe_packet->p_async_ack_handler_);
+            if (p_unsubscribe_packet->HasAckListener()) {
+                rc = p_client_state_->RegisterPendingAck(p_unsubscribe_packet->GetPacketId(), p_unsubscribe_packet);
                 if (ResponseCode::SUCCESS != rc) {
                     AWS_LOG_ERROR(UNSUBSCRIBE_ACTION_LOG_TAG,
                                   "Registering Ack Handler for Connect Action failed. %s",
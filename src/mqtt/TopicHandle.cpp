@@ -0,0 +1,44 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TopicHandle.cpp
+ * @brief Topic name that has been validated and encoded for MQTT once, for repeated publishes
+ *
+ */
+
+#include "util/Utf8String.hpp"
+
+#include "mqtt/TopicHandle.hpp"
+
+namespace awsiotsdk {
+    namespace mqtt {
+        TopicHandle::TopicHandle(const util::String &topic_name) : topic_name_(topic_name) {
+            size_t length = topic_name.length();
+            encoded_topic_name_.reserve(length + 2);
+            encoded_topic_name_.push_back((char) (length / 256));
+            encoded_topic_name_.push_back((char) (length % 256));
+            encoded_topic_name_.append(topic_name);
+        }
+
+        std::shared_ptr<const TopicHandle> TopicHandle::Create(const util::String &topic_name) {
+            if (topic_name.empty() || MAX_MQTT_TOPIC_NAME_LENGTH < topic_name.length()
+                || !Utf8String::IsValidInput(topic_name)) {
+                return nullptr;
+            }
+            return std::shared_ptr<const TopicHandle>(new TopicHandle(topic_name));
+        }
+    }
+}
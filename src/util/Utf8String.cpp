@@ -19,11 +19,25 @@
  *
  */
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
 #include <rapidjson/encodings.h>
 #include <rapidjson/stream.h>
 #include <rapidjson/stringbuffer.h>
 #include "util/Utf8String.hpp"
 
+// Vector instructions are selected at runtime, the rest of the SDK is built for the baseline instruction set
+#if !defined(DISABLE_SIMD_UTF8_VALIDATION) && (defined(__GNUC__) || defined(__clang__)) \
+    && (defined(__x86_64__) || defined(__i386__))
+#define UTF8_VALIDATION_USE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+// Maximum number of bytes validated by the scalar decoder before checking for ASCII blocks again
+#define UTF8_VALIDATION_SCALAR_RUN_LENGTH 32
+
 namespace awsiotsdk {
     namespace utf8 {
         // The typedefs for 8-bit, 16-bit and 32-bit unsigned integers
@@ -276,29 +290,129 @@ namespace awsiotsdk {
         inline bool is_valid(octet_iterator start, octet_iterator end) {
             return (utf8::find_invalid(start, end) == end);
         }
+
+        // ASCII prefix search - returns the length of the longest prefix made of whole ASCII only blocks
+        namespace ascii {
+            typedef std::size_t (*prefix_length_function)(const uint8_t *str, std::size_t length);
+
+            std::size_t prefix_length_scalar(const uint8_t *str, std::size_t length) {
+                std::size_t offset = 0;
+                for (; offset + sizeof(std::uint64_t) <= length; offset += sizeof(std::uint64_t)) {
+                    std::uint64_t block;
+                    std::memcpy(&block, str + offset, sizeof(block));
+                    if (0 != (block & 0x8080808080808080ULL)) {
+                        break;
+                    }
+                }
+                return offset;
+            }
+
+#ifdef UTF8_VALIDATION_USE_X86_SIMD
+            __attribute__((target("sse2")))
+            std::size_t prefix_length_sse2(const uint8_t *str, std::size_t length) {
+                std::size_t offset = 0;
+                for (; offset + sizeof(__m128i) <= length; offset += sizeof(__m128i)) {
+                    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str + offset));
+                    if (0 != _mm_movemask_epi8(block)) {
+                        break;
+                    }
+                }
+                return offset;
+            }
+
+            __attribute__((target("avx2")))
+            std::size_t prefix_length_avx2(const uint8_t *str, std::size_t length) {
+                std::size_t offset = 0;
+                // Two blocks per iteration, the OR keeps the high bit of any non-ASCII byte
+                for (; offset + 2 * sizeof(__m256i) <= length; offset += 2 * sizeof(__m256i)) {
+                    __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(str + offset));
+                    __m256i second =
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(str + offset + sizeof(__m256i)));
+                    if (0 != _mm256_movemask_epi8(_mm256_or_si256(first, second))) {
+                        break;
+                    }
+                }
+                for (; offset + sizeof(__m256i) <= length; offset += sizeof(__m256i)) {
+                    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(str + offset));
+                    if (0 != _mm256_movemask_epi8(block)) {
+                        break;
+                    }
+                }
+                return offset;
+            }
+#endif
+
+            prefix_length_function select_prefix_length() {
+#ifdef UTF8_VALIDATION_USE_X86_SIMD
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx2")) {
+                    return prefix_length_avx2;
+                }
+                if (__builtin_cpu_supports("sse2")) {
+                    return prefix_length_sse2;
+                }
+#endif
+                return prefix_length_scalar;
+            }
+        } // namespace ascii
+
+        /**
+         * @brief Check that a range of bytes is valid UTF-8
+         *
+         * ASCII blocks are skipped with the widest vector instructions the CPU supports. Bytes from the first block
+         * that is not all ASCII are decoded one sequence at a time, for up to UTF8_VALIDATION_SCALAR_RUN_LENGTH
+         * bytes, before looking for ASCII blocks again. Inputs too short for a block are decoded entirely.
+         *
+         * @param str - first byte of the range
+         * @param length - number of bytes in the range
+         * @return bool - true if the bytes are valid UTF-8
+         */
+        bool is_valid_bytes(const uint8_t *str, std::size_t length) {
+            // Selected on first use, so validation also works during static initialization of other files
+            static const ascii::prefix_length_function prefix_length = ascii::select_prefix_length();
+            const uint8_t *end = str + length;
+            while (str != end) {
+                str += prefix_length(str, static_cast<std::size_t>(end - str));
+                const uint8_t *run_end =
+                    str + std::min(static_cast<std::size_t>(end - str),
+                                   static_cast<std::size_t>(UTF8_VALIDATION_SCALAR_RUN_LENGTH));
+                while (str < run_end) {
+                    if (*str < 0x80) {
+                        ++str;
+                    } else if (internal::UTF8_OK != internal::validate_next(str, end)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
     } // namespace utf8
 
-    bool Utf8String::IsValidInput(util::String str) {
-        return utf8::is_valid(str.begin(), str.end());
+    bool Utf8String::IsValidInput(const util::String &str) {
+        return utf8::is_valid_bytes(reinterpret_cast<const utf8::uint8_t *>(str.data()), str.length());
+    }
+
+    bool Utf8String::IsValidInput(const char *str, std::size_t length) {
+        return utf8::is_valid_bytes(reinterpret_cast<const utf8::uint8_t *>(str), length);
     }
 
     std::unique_ptr<Utf8String> Utf8String::Create(util::String str) {
         if (!IsValidInput(str)) {
             return nullptr;
         }
-        return std::unique_ptr<Utf8String>(new Utf8String(str));
+        return std::unique_ptr<Utf8String>(new Utf8String(std::move(str)));
     }
 
     std::unique_ptr<Utf8String> Utf8String::Create(const char *str, std::size_t length) {
-        if (!IsValidInput(util::String(str, length))) {
+        if (!IsValidInput(str, length)) {
             return nullptr;
         }
         return std::unique_ptr<Utf8String>(new Utf8String(str, length));
     }
 
     Utf8String::Utf8String(util::String str) {
-        this->data = str;
         this->length = str.length();
+        this->data = std::move(str);
     }
 
     Utf8String::Utf8String(const char *str, std::size_t length) {
@@ -310,7 +424,7 @@ namespace awsiotsdk {
         return length;
     }
 
-    util::String Utf8String::ToStdString() {
+    const util::String &Utf8String::ToStdString() const {
         return data;
     }
 }
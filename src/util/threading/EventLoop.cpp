@@ -0,0 +1,235 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file EventLoop.cpp
+ * @brief
+ *
+ */
+
+#include <climits>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+#include "util/logging/LogMacros.hpp"
+#include "util/threading/EventLoop.hpp"
+#include "ResponseCode.hpp"
+
+#define LOG_TAG_EVENT_LOOP "[Event Loop]"
+
+// Max number of epoll events handled per wake up
+#define MAX_EPOLL_EVENTS 256
+
+namespace awsiotsdk {
+    namespace util {
+        namespace Threading {
+            EventLoop::EventLoop(const ExecutorConfig &config) : Executor(config) {
+                config_.worker_count_ = 1;
+                epoll_fd_ = -1;
+                wake_fd_ = -1;
+                is_polling_ = false;
+                is_wake_pending_ = false;
+#if defined(__linux__)
+                epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+                wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+                if (0 > epoll_fd_ || 0 > wake_fd_) {
+                    AWS_LOG_ERROR(LOG_TAG_EVENT_LOOP, "Unable to create epoll set. Error : %d", errno);
+                    return;
+                }
+
+                struct epoll_event wake_event;
+                wake_event.events = EPOLLIN;
+                wake_event.data.fd = wake_fd_;
+                if (0 != epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &wake_event)) {
+                    AWS_LOG_ERROR(LOG_TAG_EVENT_LOOP, "Unable to watch wake up descriptor. Error : %d", errno);
+                    close(wake_fd_);
+                    wake_fd_ = -1;
+                }
+#endif
+            }
+
+            EventLoop::~EventLoop() {
+                // Loop thread calls the overridden wait functions, it must be gone before members are destroyed
+                StopWorkers();
+#if defined(__linux__)
+                if (0 <= wake_fd_) {
+                    close(wake_fd_);
+                }
+                if (0 <= epoll_fd_) {
+                    close(epoll_fd_);
+                }
+#endif
+            }
+
+            std::shared_ptr<EventLoop> EventLoop::Create(const ExecutorConfig &config) {
+#if defined(__linux__)
+                std::shared_ptr<EventLoop> p_event_loop = std::shared_ptr<EventLoop>(new EventLoop(config));
+                if (0 > p_event_loop->epoll_fd_ || 0 > p_event_loop->wake_fd_) {
+                    return nullptr;
+                }
+                p_event_loop->StartWorkers();
+                if (p_event_loop->worker_threads_.empty()) {
+                    return nullptr;
+                }
+                return p_event_loop;
+#else
+                IOT_UNUSED(config);
+                AWS_LOG_ERROR(LOG_TAG_EVENT_LOOP, "Event loop is only supported on Linux");
+                return nullptr;
+#endif
+            }
+
+            void EventLoop::WaitForWork(std::unique_lock<std::mutex> &executor_lock, bool has_due,
+                                        std::chrono::steady_clock::time_point due) {
+#if defined(__linux__)
+                int timeout_ms = -1;
+                if (has_due) {
+                    // Rounded up, waking up early would spin until the step is due
+                    std::chrono::steady_clock::duration wait_time = due - std::chrono::steady_clock::now();
+                    std::chrono::milliseconds::rep wait_ms
+                        = std::chrono::duration_cast<std::chrono::milliseconds>(wait_time).count();
+                    if (std::chrono::milliseconds(wait_ms) < wait_time) {
+                        wait_ms++;
+                    }
+                    timeout_ms = (0 > wait_ms) ? 0 : (int) std::min<std::chrono::milliseconds::rep>(wait_ms, INT_MAX);
+                }
+
+                struct epoll_event events[MAX_EPOLL_EVENTS];
+                is_polling_ = true;
+                executor_lock.unlock();
+                int event_count = epoll_wait(epoll_fd_, events, MAX_EPOLL_EVENTS, timeout_ms);
+                executor_lock.lock();
+                is_polling_ = false;
+
+                for (int itr = 0; itr < event_count; itr++) {
+                    int descriptor = events[itr].data.fd;
+                    if (descriptor == wake_fd_) {
+                        uint64_t wake_count = 0;
+                        ssize_t read_count = read(wake_fd_, &wake_count, sizeof(wake_count));
+                        IOT_UNUSED(read_count);
+                        is_wake_pending_ = false;
+                        continue;
+                    }
+
+                    util::Map<int, std::shared_ptr<Task>>::iterator task_itr = watched_tasks_.find(descriptor);
+                    if (watched_tasks_.end() != task_itr) {
+                        task_itr->second->is_descriptor_ready_ = true;
+                        WakeLocked(task_itr->second);
+                    }
+                }
+#else
+                Executor::WaitForWork(executor_lock, has_due, due);
+#endif
+            }
+
+            void EventLoop::NotifyWork(bool notify_all) {
+#if defined(__linux__)
+                IOT_UNUSED(notify_all);
+                // Steps queued by the loop thread itself are picked up without a wake up
+                if (is_polling_ && !is_wake_pending_) {
+                    uint64_t wake_count = 1;
+                    ssize_t write_count = write(wake_fd_, &wake_count, sizeof(wake_count));
+                    IOT_UNUSED(write_count);
+                    is_wake_pending_ = true;
+                }
+#else
+                Executor::NotifyWork(notify_all);
+#endif
+            }
+
+            void EventLoop::OnTaskFinished(const std::shared_ptr<Task> &p_task) {
+                UnwatchLocked(p_task);
+            }
+
+            bool EventLoop::Watch(const std::shared_ptr<Task> &p_task, int descriptor) {
+                if (nullptr == p_task || 0 > descriptor) {
+                    return false;
+                }
+#if defined(__linux__)
+                std::lock_guard<std::mutex> executor_lock(executor_lock_);
+                if (p_task->is_finished_) {
+                    return false;
+                }
+                if (descriptor != p_task->watched_descriptor_) {
+                    UnwatchLocked(p_task);
+                }
+
+                struct epoll_event watch_event;
+                watch_event.events = EPOLLIN | EPOLLONESHOT;
+                watch_event.data.fd = descriptor;
+                util::Map<int, std::shared_ptr<Task>>::iterator task_itr = watched_tasks_.find(descriptor);
+                int op = (watched_tasks_.end() == task_itr) ? EPOLL_CTL_ADD : EPOLL_CTL_MOD;
+                int ctl_rc = epoll_ctl(epoll_fd_, op, descriptor, &watch_event);
+                if (0 != ctl_rc && EPOLL_CTL_MOD == op && ENOENT == errno) {
+                    // Descriptor was closed and reused, closing removed it from the epoll set
+                    ctl_rc = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, descriptor, &watch_event);
+                } else if (0 != ctl_rc && EPOLL_CTL_ADD == op && EEXIST == errno) {
+                    ctl_rc = epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, descriptor, &watch_event);
+                }
+                if (0 != ctl_rc) {
+                    AWS_LOG_WARN(LOG_TAG_EVENT_LOOP, "Unable to watch descriptor %d. Error : %d", descriptor, errno);
+                    return false;
+                }
+
+                if (watched_tasks_.end() != task_itr && task_itr->second != p_task) {
+                    // Previous owner closed the descriptor without unwatching it
+                    task_itr->second->watched_descriptor_ = -1;
+                }
+                watched_tasks_[descriptor] = p_task;
+                p_task->watched_descriptor_ = descriptor;
+                return true;
+#else
+                return false;
+#endif
+            }
+
+            void EventLoop::Unwatch(const std::shared_ptr<Task> &p_task) {
+                if (nullptr == p_task) {
+                    return;
+                }
+                std::lock_guard<std::mutex> executor_lock(executor_lock_);
+                UnwatchLocked(p_task);
+            }
+
+            void EventLoop::UnwatchLocked(const std::shared_ptr<Task> &p_task) {
+                int descriptor = p_task->watched_descriptor_;
+                if (0 > descriptor) {
+                    return;
+                }
+                p_task->watched_descriptor_ = -1;
+
+                util::Map<int, std::shared_ptr<Task>>::iterator task_itr = watched_tasks_.find(descriptor);
+                if (watched_tasks_.end() == task_itr || task_itr->second != p_task) {
+                    return;
+                }
+                watched_tasks_.erase(task_itr);
+#if defined(__linux__)
+                // Fails harmlessly if the descriptor has already been closed
+                epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, descriptor, nullptr);
+#endif
+            }
+
+            size_t EventLoop::GetWatchCount() {
+                std::lock_guard<std::mutex> executor_lock(executor_lock_);
+                return watched_tasks_.size();
+            }
+        }
+    }
+}
@@ -0,0 +1,331 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file Executor.cpp
+ * @brief
+ *
+ */
+
+#include <algorithm>
+#include <functional>
+
+#if defined(__linux__)
+#include <climits>
+#include <sched.h>
+#endif
+
+#include "util/logging/LogMacros.hpp"
+#include "ResponseCode.hpp"
+#include "util/threading/Executor.hpp"
+
+#define LOG_TAG_EXECUTOR "[Executor]"
+
+// Linux limits thread names to 15 characters
+#define MAX_THREAD_NAME_LENGTH 15
+
+namespace awsiotsdk {
+    namespace util {
+        namespace Threading {
+            ExecutorConfig::ExecutorConfig() {
+                worker_count_ = 0;
+                stack_size_bytes_ = 0;
+                thread_name_prefix_ = "iot-exec-";
+            }
+
+            Executor::Executor(const ExecutorConfig &config) {
+                config_ = config;
+                task_count_ = 0;
+                is_stopping_ = false;
+            }
+
+            void Executor::StartWorkers() {
+                size_t worker_count = config_.worker_count_;
+                if (0 == worker_count) {
+                    worker_count = std::thread::hardware_concurrency();
+                }
+                if (0 == worker_count) {
+                    worker_count = 1;
+                }
+
+                for (size_t itr = 0; itr < worker_count; itr++) {
+                    util::String thread_name = config_.thread_name_prefix_ + std::to_string(itr);
+#if defined(__linux__)
+                    pthread_attr_t thread_attr;
+                    pthread_attr_init(&thread_attr);
+                    if (0 != config_.stack_size_bytes_) {
+                        size_t stack_size = std::max(config_.stack_size_bytes_, (size_t) PTHREAD_STACK_MIN);
+                        pthread_attr_setstacksize(&thread_attr, stack_size);
+                    }
+                    if (!config_.cpu_affinity_.empty()) {
+                        cpu_set_t cpu_set;
+                        CPU_ZERO(&cpu_set);
+                        CPU_SET(config_.cpu_affinity_[itr % config_.cpu_affinity_.size()], &cpu_set);
+                        pthread_attr_setaffinity_np(&thread_attr, sizeof(cpu_set), &cpu_set);
+                    }
+
+                    pthread_t worker_thread;
+                    int create_rc = pthread_create(&worker_thread, &thread_attr, &Executor::RunWorkerThread, this);
+                    pthread_attr_destroy(&thread_attr);
+                    if (0 != create_rc) {
+                        AWS_LOG_ERROR(LOG_TAG_EXECUTOR, "Unable to start worker thread %s. Error : %d",
+                                      thread_name.c_str(), create_rc);
+                        continue;
+                    }
+                    pthread_setname_np(worker_thread, thread_name.substr(0, MAX_THREAD_NAME_LENGTH).c_str());
+                    worker_threads_.push_back(worker_thread);
+#else
+                    worker_threads_.push_back(std::thread(&Executor::RunWorker, this));
+#endif
+                }
+
+#if !defined(__linux__)
+                if (0 != config_.stack_size_bytes_ || !config_.cpu_affinity_.empty()) {
+                    AWS_LOG_WARN(LOG_TAG_EXECUTOR,
+                                 "Worker stack size and CPU affinity are not supported on this platform, ignoring");
+                }
+#endif
+            }
+
+            void Executor::StopWorkers() {
+                {
+                    std::lock_guard<std::mutex> executor_lock(executor_lock_);
+                    is_stopping_ = true;
+                    NotifyWork(true);
+                }
+
+#if defined(__linux__)
+                for (pthread_t worker_thread : worker_threads_) {
+                    pthread_join(worker_thread, nullptr);
+                }
+#else
+                for (std::thread &worker_thread : worker_threads_) {
+                    worker_thread.join();
+                }
+#endif
+                worker_threads_.clear();
+            }
+
+            Executor::~Executor() {
+                StopWorkers();
+            }
+
+            std::shared_ptr<Executor> Executor::Create(const ExecutorConfig &config) {
+                std::shared_ptr<Executor> p_executor = std::shared_ptr<Executor>(new Executor(config));
+                p_executor->StartWorkers();
+                if (p_executor->worker_threads_.empty()) {
+                    return nullptr;
+                }
+                return p_executor;
+            }
+
+#if defined(__linux__)
+            void *Executor::RunWorkerThread(void *p_executor) {
+                static_cast<Executor *>(p_executor)->RunWorker();
+                return nullptr;
+            }
+#endif
+
+            void Executor::Enqueue(const std::shared_ptr<Task> &p_task, std::chrono::steady_clock::time_point due) {
+                p_task->generation_++;
+                p_task->due_ = due;
+                p_task->is_queued_ = true;
+
+                QueueEntry entry;
+                entry.due_ = due;
+                entry.generation_ = p_task->generation_;
+                entry.p_task_ = p_task;
+                ready_queue_.push_back(std::move(entry));
+                std::push_heap(ready_queue_.begin(), ready_queue_.end(), std::greater<QueueEntry>());
+
+                // Idle workers sleep until the previous earliest due time, wake one up if that changed
+                if (ready_queue_.front().p_task_ == p_task) {
+                    NotifyWork(false);
+                }
+            }
+
+            void Executor::WakeLocked(const std::shared_ptr<Task> &p_task) {
+                if (p_task->is_finished_) {
+                    return;
+                } else if (p_task->is_running_) {
+                    p_task->is_wake_requested_ = true;
+                    return;
+                }
+
+                std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                if (!p_task->is_queued_ || p_task->due_ > now) {
+                    Enqueue(p_task, now);
+                }
+            }
+
+            void Executor::WaitForWork(std::unique_lock<std::mutex> &executor_lock, bool has_due,
+                                       std::chrono::steady_clock::time_point due) {
+                if (has_due) {
+                    work_wait_.wait_until(executor_lock, due);
+                } else {
+                    work_wait_.wait(executor_lock);
+                }
+            }
+
+            void Executor::NotifyWork(bool notify_all) {
+                if (notify_all) {
+                    work_wait_.notify_all();
+                } else {
+                    work_wait_.notify_one();
+                }
+            }
+
+            void Executor::OnTaskFinished(const std::shared_ptr<Task> &p_task) {
+                IOT_UNUSED(p_task);
+            }
+
+            bool Executor::Watch(const std::shared_ptr<Task> &p_task, int descriptor) {
+                IOT_UNUSED(p_task);
+                IOT_UNUSED(descriptor);
+                return false;
+            }
+
+            void Executor::Unwatch(const std::shared_ptr<Task> &p_task) {
+                IOT_UNUSED(p_task);
+            }
+
+            void Executor::RunWorker() {
+                std::unique_lock<std::mutex> executor_lock(executor_lock_);
+                while (!is_stopping_) {
+                    if (ready_queue_.empty()) {
+                        WaitForWork(executor_lock, false, std::chrono::steady_clock::time_point());
+                        continue;
+                    }
+
+                    QueueEntry &next_entry = ready_queue_.front();
+                    if (next_entry.generation_ != next_entry.p_task_->generation_ || !next_entry.p_task_->is_queued_) {
+                        // Task was rescheduled or cancelled after this entry was added
+                        std::pop_heap(ready_queue_.begin(), ready_queue_.end(), std::greater<QueueEntry>());
+                        ready_queue_.pop_back();
+                        continue;
+                    }
+
+                    std::chrono::steady_clock::time_point due = next_entry.due_;
+                    if (due > std::chrono::steady_clock::now()) {
+                        WaitForWork(executor_lock, true, due);
+                        continue;
+                    }
+
+                    std::shared_ptr<Task> p_task = next_entry.p_task_;
+                    std::pop_heap(ready_queue_.begin(), ready_queue_.end(), std::greater<QueueEntry>());
+                    ready_queue_.pop_back();
+                    p_task->is_queued_ = false;
+                    p_task->is_running_ = true;
+                    p_task->is_wake_requested_ = false;
+                    p_task->running_thread_id_ = std::this_thread::get_id();
+
+                    // Step function is not modified while the task is running, it is safe to call without the lock
+                    executor_lock.unlock();
+                    std::chrono::microseconds next_step_delay = p_task->p_step_();
+                    executor_lock.lock();
+
+                    if (0 > next_step_delay.count() && !p_task->is_finished_) {
+                        p_task->is_finished_ = true;
+                        task_count_--;
+                        OnTaskFinished(p_task);
+                    }
+
+                    if (p_task->is_finished_) {
+                        // Released outside the lock, destroying captured state may call back into the executor
+                        TaskStepPtr p_step = std::move(p_task->p_step_);
+                        p_task->p_step_ = nullptr;
+                        executor_lock.unlock();
+                        p_step = nullptr;
+                        executor_lock.lock();
+                        p_task->is_running_ = false;
+                        step_done_wait_.notify_all();
+                        continue;
+                    }
+
+                    p_task->is_running_ = false;
+                    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                    if (p_task->is_wake_requested_) {
+                        Enqueue(p_task, now);
+                    } else if (ParkedStepDelay() != next_step_delay) {
+                        Enqueue(p_task, now + next_step_delay);
+                    }
+                }
+            }
+
+            std::shared_ptr<Executor::Task> Executor::Schedule(TaskStepPtr p_step,
+                                                               std::chrono::microseconds initial_delay) {
+                if (nullptr == p_step) {
+                    return nullptr;
+                }
+
+                std::shared_ptr<Task> p_task = std::make_shared<Task>();
+                p_task->p_step_ = std::move(p_step);
+
+                std::lock_guard<std::mutex> executor_lock(executor_lock_);
+                task_count_++;
+                if (ParkedStepDelay() != initial_delay) {
+                    Enqueue(p_task, std::chrono::steady_clock::now() + initial_delay);
+                }
+                return p_task;
+            }
+
+            void Executor::Wake(const std::shared_ptr<Task> &p_task) {
+                if (nullptr == p_task) {
+                    return;
+                }
+
+                std::lock_guard<std::mutex> executor_lock(executor_lock_);
+                WakeLocked(p_task);
+            }
+
+            void Executor::Cancel(const std::shared_ptr<Task> &p_task) {
+                if (nullptr == p_task) {
+                    return;
+                }
+
+                TaskStepPtr p_step = nullptr;
+                {
+                    std::unique_lock<std::mutex> executor_lock(executor_lock_);
+                    if (!p_task->is_finished_) {
+                        p_task->is_finished_ = true;
+                        p_task->is_queued_ = false;
+                        p_task->generation_++;
+                        task_count_--;
+                        OnTaskFinished(p_task);
+                    }
+
+                    if (p_task->is_running_) {
+                        // The worker releases the step function once the running step returns
+                        if (std::this_thread::get_id() != p_task->running_thread_id_) {
+                            step_done_wait_.wait(executor_lock, [&p_task] { return !p_task->is_running_; });
+                        }
+                    } else {
+                        p_step = std::move(p_task->p_step_);
+                        p_task->p_step_ = nullptr;
+                    }
+                }
+            }
+
+            size_t Executor::GetWorkerCount() {
+                return worker_threads_.size();
+            }
+
+            size_t Executor::GetTaskCount() {
+                std::lock_guard<std::mutex> executor_lock(executor_lock_);
+                return task_count_;
+            }
+        }
+    }
+}
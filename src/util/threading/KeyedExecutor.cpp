@@ -0,0 +1,142 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/**
+ * @file KeyedExecutor.cpp
+ * @brief
+ *
+ */
+
+#include "util/threading/KeyedExecutor.hpp"
+
+// Idle shards are woken up by Submit, the delay only bounds how long a lost wake up could stall a shard
+#define KEYED_EXECUTOR_IDLE_STEP_DELAY_MS 1000
+
+namespace awsiotsdk {
+    namespace util {
+        namespace Threading {
+            KeyedExecutor::KeyedExecutor(std::shared_ptr<Executor> p_executor, size_t shard_count,
+                                         size_t max_queue_depth)
+                : p_executor_(std::move(p_executor)), max_queue_depth_(max_queue_depth) {
+                shards_.reserve(shard_count);
+                for (size_t itr = 0; itr < shard_count; itr++) {
+                    shards_.push_back(std::unique_ptr<Shard>(new Shard()));
+                }
+            }
+
+            KeyedExecutor::~KeyedExecutor() {
+                for (std::unique_ptr<Shard> &p_shard : shards_) {
+                    std::lock_guard<std::mutex> shard_lock(p_shard->shard_lock_);
+                    p_shard->is_stopping_ = true;
+                    p_shard->not_full_wait_.notify_all();
+                }
+                // Cancel waits for running steps, shards are not accessed by their tasks once this returns
+                for (std::unique_ptr<Shard> &p_shard : shards_) {
+                    p_executor_->Cancel(p_shard->p_task_);
+                }
+            }
+
+            std::shared_ptr<KeyedExecutor> KeyedExecutor::Create(std::shared_ptr<Executor> p_executor,
+                                                                 size_t shard_count, size_t max_queue_depth) {
+                if (nullptr == p_executor || 0 == shard_count || 0 == max_queue_depth) {
+                    return nullptr;
+                }
+
+                std::shared_ptr<KeyedExecutor> p_keyed_executor =
+                    std::shared_ptr<KeyedExecutor>(new KeyedExecutor(std::move(p_executor), shard_count,
+                                                                     max_queue_depth));
+                for (std::unique_ptr<Shard> &p_shard : p_keyed_executor->shards_) {
+                    Shard *p_raw_shard = p_shard.get();
+                    p_shard->p_task_ = p_keyed_executor->p_executor_->Schedule(
+                        [p_raw_shard]() { return RunShardStep(p_raw_shard); },
+                        std::chrono::milliseconds(KEYED_EXECUTOR_IDLE_STEP_DELAY_MS));
+                }
+                return p_keyed_executor;
+            }
+
+            std::chrono::microseconds KeyedExecutor::RunShardStep(Shard *p_shard) {
+                for (size_t itr = 0; itr < DEFAULT_KEYED_EXECUTOR_MAX_ITEMS_PER_STEP; itr++) {
+                    WorkItemPtr p_work_item;
+                    {
+                        std::lock_guard<std::mutex> shard_lock(p_shard->shard_lock_);
+                        if (p_shard->queue_.empty()) {
+                            return std::chrono::milliseconds(KEYED_EXECUTOR_IDLE_STEP_DELAY_MS);
+                        }
+                        p_work_item = std::move(p_shard->queue_.front());
+                        p_shard->queue_.pop_front();
+                        p_shard->not_full_wait_.notify_one();
+                    }
+                    p_work_item();
+                }
+
+                std::lock_guard<std::mutex> shard_lock(p_shard->shard_lock_);
+                return p_shard->queue_.empty() ? std::chrono::microseconds(
+                    std::chrono::milliseconds(KEYED_EXECUTOR_IDLE_STEP_DELAY_MS)) : std::chrono::microseconds(0);
+            }
+
+            KeyedExecutor::Shard *KeyedExecutor::GetShard(const util::String &key) {
+                return shards_[GetShardIndex(key)].get();
+            }
+
+            bool KeyedExecutor::Submit(const util::String &key, WorkItemPtr p_work_item) {
+                if (nullptr == p_work_item) {
+                    return false;
+                }
+
+                Shard *p_shard = GetShard(key);
+                {
+                    std::unique_lock<std::mutex> shard_lock(p_shard->shard_lock_);
+                    p_shard->not_full_wait_.wait(shard_lock, [this, p_shard] {
+                        return p_shard->is_stopping_ || p_shard->queue_.size() < max_queue_depth_;
+                    });
+                    if (p_shard->is_stopping_) {
+                        return false;
+                    }
+                    p_shard->queue_.push_back(std::move(p_work_item));
+                }
+                // A running step picks the item up itself, Wake then only requests one more step
+                p_executor_->Wake(p_shard->p_task_);
+                return true;
+            }
+
+            bool KeyedExecutor::TrySubmit(const util::String &key, WorkItemPtr &p_work_item) {
+                if (nullptr == p_work_item) {
+                    return false;
+                }
+
+                Shard *p_shard = GetShard(key);
+                {
+                    std::lock_guard<std::mutex> shard_lock(p_shard->shard_lock_);
+                    if (p_shard->is_stopping_ || p_shard->queue_.size() >= max_queue_depth_) {
+                        return false;
+                    }
+                    p_shard->queue_.push_back(std::move(p_work_item));
+                }
+                p_executor_->Wake(p_shard->p_task_);
+                return true;
+            }
+
+            size_t KeyedExecutor::GetQueuedCount() {
+                size_t queued_count = 0;
+                for (std::unique_ptr<Shard> &p_shard : shards_) {
+                    std::lock_guard<std::mutex> shard_lock(p_shard->shard_lock_);
+                    queued_count += p_shard->queue_.size();
+                }
+                return queued_count;
+            }
+        }
+    }
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TimingWheel.cpp
+ * @brief
+ *
+ */
+
+#include "util/threading/TimingWheel.hpp"
+
+namespace awsiotsdk {
+    namespace util {
+        namespace Threading {
+            const size_t TimingWheel::SLOTS_PER_LEVEL;
+            const size_t TimingWheel::SLOT_MASK;
+            const size_t TimingWheel::BUCKET_COUNT;
+            const size_t TimingWheel::OVERDUE_BUCKET;
+            const uint32_t TimingWheel::INVALID_INDEX;
+
+            TimingWheel::TimingWheel(size_t capacity, Tick start_tick) {
+                Node empty_node;
+                empty_node.next_ = INVALID_INDEX;
+                empty_node.prev_ = INVALID_INDEX;
+                empty_node.bucket_ = INVALID_INDEX;
+                empty_node.expiry_ = 0;
+                nodes_.assign(capacity, empty_node);
+                bucket_heads_.assign(BUCKET_COUNT + 1, INVALID_INDEX);
+                current_tick_ = start_tick;
+                scheduled_count_ = 0;
+            }
+
+            void TimingWheel::Link(uint32_t entry_id, uint32_t bucket) {
+                Node &node = nodes_[entry_id];
+                node.bucket_ = bucket;
+                node.prev_ = INVALID_INDEX;
+                node.next_ = bucket_heads_[bucket];
+                if (INVALID_INDEX != node.next_) {
+                    nodes_[node.next_].prev_ = entry_id;
+                }
+                bucket_heads_[bucket] = entry_id;
+            }
+
+            void TimingWheel::Unlink(uint32_t entry_id) {
+                Node &node = nodes_[entry_id];
+                if (INVALID_INDEX != node.prev_) {
+                    nodes_[node.prev_].next_ = node.next_;
+                } else {
+                    bucket_heads_[node.bucket_] = node.next_;
+                }
+                if (INVALID_INDEX != node.next_) {
+                    nodes_[node.next_].prev_ = node.prev_;
+                }
+                node.next_ = INVALID_INDEX;
+                node.prev_ = INVALID_INDEX;
+                node.bucket_ = INVALID_INDEX;
+            }
+
+            void TimingWheel::Place(uint32_t entry_id) {
+                const Tick max_delta = (((Tick) 1) << (TIMING_WHEEL_LEVEL_BITS * TIMING_WHEEL_LEVEL_COUNT)) - 1;
+                Tick expiry = nodes_[entry_id].expiry_;
+                if (expiry < current_tick_) {
+                    // Tick has already been processed, expire on the next Advance call
+                    Link(entry_id, (uint32_t) OVERDUE_BUCKET);
+                    return;
+                } else if (expiry - current_tick_ > max_delta) {
+                    expiry = current_tick_ + max_delta;
+                }
+
+                Tick delta = expiry - current_tick_;
+                size_t level = 0;
+                while (level < TIMING_WHEEL_LEVEL_COUNT - 1
+                    && delta >= (((Tick) 1) << (TIMING_WHEEL_LEVEL_BITS * (level + 1)))) {
+                    level++;
+                }
+                size_t slot = (size_t) ((expiry >> (TIMING_WHEEL_LEVEL_BITS * level)) & SLOT_MASK);
+                Link(entry_id, (uint32_t) (level * SLOTS_PER_LEVEL + slot));
+            }
+
+            bool TimingWheel::Cascade(size_t level) {
+                size_t slot = (size_t) ((current_tick_ >> (TIMING_WHEEL_LEVEL_BITS * level)) & SLOT_MASK);
+                size_t bucket = level * SLOTS_PER_LEVEL + slot;
+
+                // Detach the whole list first, entries may be placed back in the same bucket
+                uint32_t entry_id = bucket_heads_[bucket];
+                bucket_heads_[bucket] = INVALID_INDEX;
+                while (INVALID_INDEX != entry_id) {
+                    uint32_t next_entry_id = nodes_[entry_id].next_;
+                    nodes_[entry_id].next_ = INVALID_INDEX;
+                    nodes_[entry_id].prev_ = INVALID_INDEX;
+                    Place(entry_id);
+                    entry_id = next_entry_id;
+                }
+
+                return 0 == slot;
+            }
+
+            bool TimingWheel::Schedule(size_t entry_id, Tick expiry) {
+                if (entry_id >= nodes_.size()) {
+                    return false;
+                }
+
+                if (INVALID_INDEX != nodes_[entry_id].bucket_) {
+                    Unlink((uint32_t) entry_id);
+                } else {
+                    scheduled_count_++;
+                }
+                nodes_[entry_id].expiry_ = expiry;
+                Place((uint32_t) entry_id);
+                return true;
+            }
+
+            void TimingWheel::Cancel(size_t entry_id) {
+                if (IsScheduled(entry_id)) {
+                    Unlink((uint32_t) entry_id);
+                    scheduled_count_--;
+                }
+            }
+
+            bool TimingWheel::IsScheduled(size_t entry_id) const {
+                return entry_id < nodes_.size() && INVALID_INDEX != nodes_[entry_id].bucket_;
+            }
+
+            void TimingWheel::ExpireBucket(size_t bucket) {
+                uint32_t entry_id = bucket_heads_[bucket];
+                bucket_heads_[bucket] = INVALID_INDEX;
+                while (INVALID_INDEX != entry_id) {
+                    Node &node = nodes_[entry_id];
+                    uint32_t next_entry_id = node.next_;
+                    node.next_ = INVALID_INDEX;
+                    node.prev_ = INVALID_INDEX;
+                    node.bucket_ = INVALID_INDEX;
+                    scheduled_count_--;
+                    expired_.push_back(entry_id);
+                    entry_id = next_entry_id;
+                }
+            }
+
+            size_t TimingWheel::Advance(Tick now, const ExpiryHandlerPtr &expiry_handler) {
+                expired_.clear();
+                ExpireBucket(OVERDUE_BUCKET);
+                while (current_tick_ <= now) {
+                    if (0 == scheduled_count_) {
+                        // Nothing to cascade or expire, jump straight to the target tick
+                        current_tick_ = now + 1;
+                        break;
+                    }
+
+                    size_t slot = (size_t) (current_tick_ & SLOT_MASK);
+                    if (0 == slot) {
+                        for (size_t level = 1; level < TIMING_WHEEL_LEVEL_COUNT && Cascade(level); level++) {
+                        }
+                    }
+
+                    ExpireBucket(slot);
+                    current_tick_++;
+                }
+
+                // Handlers are called once the wheel is consistent so they can schedule or cancel entries
+                if (nullptr != expiry_handler) {
+                    for (uint32_t expired_entry_id : expired_) {
+                        expiry_handler(expired_entry_id);
+                    }
+                }
+                return expired_.size();
+            }
+        }
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TokenBucket.cpp
+ * @brief
+ *
+ */
+
+#include "util/threading/TokenBucket.hpp"
+
+namespace awsiotsdk {
+    namespace util {
+        namespace Threading {
+            TokenBucket::TokenBucket(double rate_per_second, size_t burst_size) {
+                rate_per_second_ = rate_per_second;
+                burst_size_ = (0 == burst_size) ? 1 : burst_size;
+                available_tokens_ = (double) burst_size_;
+                last_refill_time_ = Clock::now();
+            }
+
+            void TokenBucket::Refill(Clock::time_point now) {
+                if (now <= last_refill_time_) {
+                    return;
+                }
+                std::chrono::duration<double> elapsed = now - last_refill_time_;
+                available_tokens_ += elapsed.count() * rate_per_second_;
+                if (available_tokens_ > (double) burst_size_) {
+                    available_tokens_ = (double) burst_size_;
+                }
+                last_refill_time_ = now;
+            }
+
+            void TokenBucket::SetRate(double rate_per_second, size_t burst_size) {
+                std::lock_guard<std::mutex> bucket_lock(bucket_lock_);
+                // Account for tokens earned at the old rate before switching
+                if (0 < rate_per_second_) {
+                    Refill(Clock::now());
+                } else {
+                    last_refill_time_ = Clock::now();
+                }
+                rate_per_second_ = rate_per_second;
+                burst_size_ = (0 == burst_size) ? 1 : burst_size;
+                if (available_tokens_ > (double) burst_size_) {
+                    available_tokens_ = (double) burst_size_;
+                }
+            }
+
+            double TokenBucket::GetRate() {
+                std::lock_guard<std::mutex> bucket_lock(bucket_lock_);
+                return rate_per_second_;
+            }
+
+            size_t TokenBucket::GetBurstSize() {
+                std::lock_guard<std::mutex> bucket_lock(bucket_lock_);
+                return burst_size_;
+            }
+
+            bool TokenBucket::TryConsume(Clock::time_point now, std::chrono::microseconds &wait_time_out) {
+                std::lock_guard<std::mutex> bucket_lock(bucket_lock_);
+                if (0 >= rate_per_second_) {
+                    wait_time_out = std::chrono::microseconds(0);
+                    return true;
+                }
+
+                Refill(now);
+                if (1.0 <= available_tokens_) {
+                    available_tokens_ -= 1.0;
+                    wait_time_out = std::chrono::microseconds(0);
+                    return true;
+                }
+
+                double missing_seconds = (1.0 - available_tokens_) / rate_per_second_;
+                // Round up so the caller does not wake up just before the token is available
+                wait_time_out = std::chrono::microseconds((long long) (missing_seconds * 1000000.0) + 1);
+                return false;
+            }
+        }
+    }
+}
@@ -22,9 +22,15 @@
 #include <atomic>
 #include <gtest/gtest.h>
 
+#if defined(__linux__)
+#include <poll.h>
+#include <unistd.h>
+#endif
+
 #include "MockNetworkConnection.hpp"
 
 #include "ClientCore.hpp"
+#include "util/threading/EventLoop.hpp"
 
 namespace awsiotsdk {
     namespace tests {
@@ -35,11 +41,13 @@ namespace awsiotsdk {
                 public:
                     uint16_t action_id_;
                     std::atomic_int perform_action_count_;
+                    std::atomic_int last_call_index_;
 
                     uint16_t GetActionId() { return action_id_; }
                     void SetActionId(uint16_t action_id) { action_id_ = action_id; }
                     TestActionData() {
                         perform_action_count_ = 0;
+                        last_call_index_ = 0;
                     }
                 };
 
@@ -114,7 +122,7 @@ namespace awsiotsdk {
                 }
 
                 p_test_action_data->perform_action_count_++;
-                total_perform_action_call_count_++;
+                p_test_action_data->last_call_index_ = ++total_perform_action_call_count_;
                 p_client_state_->ForwardReceivedAck(p_test_action_data->GetActionId(), ResponseCode::SUCCESS);
                 return ResponseCode::SUCCESS;
             }
@@ -358,6 +366,375 @@ namespace awsiotsdk {
                 p_core_state_->SetMaxActionQueueSize(cur_max_queue_size);
             }
 
+            // Test outbound rate limit - queued actions are processed in a burst, then at the sustained rate.
+            // Rate limit can be changed while actions are queued
+            TEST_F(ClientCoreTester, OutboundRateLimit) {
+                EXPECT_NE(nullptr, p_client_core_);
+                EXPECT_NE(nullptr, p_core_state_);
+
+                uint16_t action_id = 0;
+
+                TestAction::Reset();
+
+                EXPECT_EQ(DEFAULT_CORE_ACTION_PROCESSING_RATE_HZ, p_core_state_->GetOutboundActionRate());
+                EXPECT_EQ((size_t) DEFAULT_CORE_ACTION_PROCESSING_BURST_SIZE,
+                          p_core_state_->GetOutboundActionBurstSize());
+
+                // 10 per second after a burst of 4. Bucket is refilled while processing is disabled
+                p_core_state_->SetOutboundActionRateLimit(10, 4);
+                p_client_core_->SetProcessQueuedActions(false);
+                std::this_thread::sleep_for(std::chrono::milliseconds(400));
+
+                std::shared_ptr<TestActionData> p_test_action_data = std::make_shared<TestActionData>();
+
+                ResponseCode rc = p_client_core_->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create);
+                EXPECT_EQ(ResponseCode::SUCCESS, rc);
+                for (size_t itr = 0; itr < 8; itr++) {
+                    rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_test_action_data,
+                                                            action_id);
+                    EXPECT_EQ(ResponseCode::SUCCESS, rc);
+                }
+
+                // Burst is processed right away, the rest is held back with one token every 100ms
+                p_client_core_->SetProcessQueuedActions(true);
+                for (size_t itr = 0; itr < 100; itr++) {
+                    if (4 <= p_test_action_data->perform_action_count_) {
+                        break;
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+                EXPECT_LE(4, p_test_action_data->perform_action_count_);
+                EXPECT_GT(8, p_test_action_data->perform_action_count_);
+
+                // Disabling the limit releases the remaining actions immediately
+                p_core_state_->SetOutboundActionRateLimit(0, 1);
+                for (size_t itr = 0; itr < 10; itr++) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                    if (8 == p_test_action_data->perform_action_count_) {
+                        break;
+                    }
+                }
+                EXPECT_EQ(8, p_test_action_data->perform_action_count_);
+                EXPECT_EQ(8, TestAction::total_perform_action_call_count_);
+            }
+
+            // Test direct outbound actions - performed on the calling thread only while queued actions are processed
+            // and the rate limit allows it, otherwise left to the caller to enqueue
+            TEST_F(ClientCoreTester, TryPerformOutboundAction) {
+                uint16_t action_id = 0;
+
+                TestAction::Reset();
+
+                ResponseCode rc = p_client_core_->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create);
+                EXPECT_EQ(ResponseCode::SUCCESS, rc);
+                std::shared_ptr<TestActionData> p_test_action_data = std::make_shared<TestActionData>();
+                std::atomic_int ack_count(0);
+                p_test_action_data->p_async_ack_handler_ = [&ack_count](uint16_t action_id, ResponseCode rc) {
+                    EXPECT_EQ(ResponseCode::SUCCESS, rc);
+                    ack_count++;
+                };
+
+                p_client_core_->SetProcessQueuedActions(false);
+                EXPECT_FALSE(p_core_state_->TryPerformOutboundAction(ActionType::RESERVED_ACTION, p_test_action_data,
+                                                                     action_id));
+                EXPECT_EQ(0, p_test_action_data->perform_action_count_);
+
+                // Performed and acknowledged before the call returns
+                p_core_state_->SetOutboundActionRateLimit(1, 1);
+                p_client_core_->SetProcessQueuedActions(true);
+                EXPECT_TRUE(p_core_state_->TryPerformOutboundAction(ActionType::RESERVED_ACTION, p_test_action_data,
+                                                                    action_id));
+                EXPECT_EQ(1, p_test_action_data->perform_action_count_);
+                EXPECT_EQ(1, ack_count);
+                EXPECT_NE(0, action_id);
+                EXPECT_EQ(action_id, p_test_action_data->GetActionId());
+
+                // Burst is used up, the action has to wait in the queue
+                EXPECT_FALSE(p_core_state_->TryPerformOutboundAction(ActionType::RESERVED_ACTION, p_test_action_data,
+                                                                     action_id));
+                EXPECT_EQ(1, p_test_action_data->perform_action_count_);
+                rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_test_action_data, action_id);
+                EXPECT_EQ(ResponseCode::SUCCESS, rc);
+                for (size_t itr = 0; itr < 100; itr++) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                    if (2 == p_test_action_data->perform_action_count_) {
+                        break;
+                    }
+                }
+                EXPECT_EQ(2, p_test_action_data->perform_action_count_);
+                EXPECT_EQ(2, ack_count);
+            }
+
+            // Test outbound priority lanes - queued actions are processed in priority order, FIFO within a lane.
+            // Max queue size applies to each lane separately
+            TEST_F(ClientCoreTester, OutboundPriority) {
+                EXPECT_NE(nullptr, p_client_core_);
+                EXPECT_NE(nullptr, p_core_state_);
+
+                uint16_t action_id = 0;
+
+                TestAction::Reset();
+
+                size_t cur_max_queue_size = p_core_state_->GetMaxActionQueueSize();
+                p_core_state_->SetMaxActionQueueSize(2);
+                p_core_state_->SetOutboundActionRateLimit(0, 1);
+                p_client_core_->SetProcessQueuedActions(false);
+
+                ResponseCode rc = p_client_core_->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create);
+                EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+                std::shared_ptr<TestActionData> p_low_first = std::make_shared<TestActionData>();
+                std::shared_ptr<TestActionData> p_low_second = std::make_shared<TestActionData>();
+                std::shared_ptr<TestActionData> p_high = std::make_shared<TestActionData>();
+                std::shared_ptr<TestActionData> p_control = std::make_shared<TestActionData>();
+
+                rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_low_first,
+                                                        ActionPriority::LOW, action_id);
+                EXPECT_EQ(ResponseCode::SUCCESS, rc);
+                rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_low_second,
+                                                        ActionPriority::LOW, action_id);
+                EXPECT_EQ(ResponseCode::SUCCESS, rc);
+                rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_low_second,
+                                                        ActionPriority::LOW, action_id);
+                EXPECT_EQ(ResponseCode::ACTION_QUEUE_FULL, rc);
+                rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_high,
+                                                        ActionPriority::HIGH, action_id);
+                EXPECT_EQ(ResponseCode::SUCCESS, rc);
+                // Default priority for non publish actions is CONTROL
+                rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_control, action_id);
+                EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+                p_client_core_->SetProcessQueuedActions(true);
+                for (size_t itr = 0; itr < 50; itr++) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                    if (4 == TestAction::total_perform_action_call_count_) {
+                        break;
+                    }
+                }
+                EXPECT_EQ(4, TestAction::total_perform_action_call_count_);
+                EXPECT_EQ(1, p_control->last_call_index_);
+                EXPECT_EQ(2, p_high->last_call_index_);
+                EXPECT_EQ(3, p_low_first->last_call_index_);
+                EXPECT_EQ(4, p_low_second->last_call_index_);
+
+                EXPECT_EQ(ActionPriority::HIGH, ClientCoreState::GetDefaultActionPriority(ActionType::PUBLISH));
+                EXPECT_EQ(ActionPriority::CONTROL, ClientCoreState::GetDefaultActionPriority(ActionType::PUBACK));
+
+                p_core_state_->SetMaxActionQueueSize(cur_max_queue_size);
+            }
+
+            // Test overflow policies - each lane applies its own policy when full and counts dropped actions.
+            // Dropped actions are notified, blocked producers proceed once the lane has room
+            TEST_F(ClientCoreTester, OutboundOverflowPolicy) {
+                EXPECT_NE(nullptr, p_client_core_);
+                EXPECT_NE(nullptr, p_core_state_);
+
+                uint16_t action_id = 0;
+
+                TestAction::Reset();
+
+                size_t cur_max_queue_size = p_core_state_->GetMaxActionQueueSize();
+                p_core_state_->SetMaxActionQueueSize(2);
+                p_core_state_->SetOutboundActionRateLimit(0, 1);
+                p_client_core_->SetProcessQueuedActions(false);
+
+                ResponseCode rc = p_client_core_->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create);
+                EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+                // Default policy rejects the new action
+                EXPECT_EQ(OverflowPolicy::DROP_NEWEST,
+                          p_core_state_->GetOutboundActionOverflowPolicy(ActionPriority::LOW));
+                std::shared_ptr<TestActionData> p_low_oldest = std::make_shared<TestActionData>();
+                std::shared_ptr<TestActionData> p_low = std::make_shared<TestActionData>();
+                std::shared_ptr<TestActionData> p_low_newest = std::make_shared<TestActionData>();
+                std::shared_ptr<CompletionToken> p_oldest_token = CompletionToken::Create();
+                p_low_oldest->p_completion_token_ = p_oldest_token;
+                rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_low_oldest,
+                                                        ActionPriority::LOW, action_id);
+                EXPECT_EQ(ResponseCode::SUCCESS, rc);
+                rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_low,
+                                                        ActionPriority::LOW, action_id);
+                EXPECT_EQ(ResponseCode::SUCCESS, rc);
+                rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_low_newest,
+                                                        ActionPriority::LOW, action_id);
+                EXPECT_EQ(ResponseCode::ACTION_QUEUE_FULL, rc);
+                EXPECT_EQ(1u, p_core_state_->GetDroppedActionCount(ActionPriority::LOW));
+
+                // Drop oldest makes room for the new action and notifies the dropped one
+                p_core_state_->SetOutboundActionOverflowPolicy(ActionPriority::LOW, OverflowPolicy::DROP_OLDEST,
+                                                               std::chrono::milliseconds(0));
+                rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_low_newest,
+                                                        ActionPriority::LOW, action_id);
+                EXPECT_EQ(ResponseCode::SUCCESS, rc);
+                EXPECT_TRUE(p_oldest_token->IsComplete());
+                EXPECT_EQ(ResponseCode::ACTION_QUEUE_FULL, p_oldest_token->GetResponse());
+                EXPECT_EQ(2u, p_core_state_->GetDroppedActionCount(ActionPriority::LOW));
+
+                // Block waits for the timeout while nothing is processed
+                p_core_state_->SetOutboundActionOverflowPolicy(ActionPriority::HIGH, OverflowPolicy::BLOCK,
+                                                               std::chrono::milliseconds(50));
+                std::shared_ptr<TestActionData> p_high = std::make_shared<TestActionData>();
+                for (size_t itr = 0; itr < 2; itr++) {
+                    rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_high,
+                                                            ActionPriority::HIGH, action_id);
+                    EXPECT_EQ(ResponseCode::SUCCESS, rc);
+                }
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_high,
+                                                        ActionPriority::HIGH, action_id);
+                EXPECT_EQ(ResponseCode::ACTION_QUEUE_FULL, rc);
+                EXPECT_LE(std::chrono::milliseconds(50), std::chrono::steady_clock::now() - start);
+                EXPECT_EQ(1u, p_core_state_->GetDroppedActionCount(ActionPriority::HIGH));
+                EXPECT_EQ(3u, p_core_state_->GetDroppedActionCount());
+
+                // Blocked producer is released as soon as the consumer makes room
+                p_core_state_->SetOutboundActionOverflowPolicy(ActionPriority::HIGH, OverflowPolicy::BLOCK,
+                                                               std::chrono::milliseconds(5000));
+                ResponseCode blocked_rc = ResponseCode::FAILURE;
+                std::thread blocked_producer([this, p_high, &blocked_rc]() {
+                    uint16_t blocked_action_id = 0;
+                    blocked_rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_high,
+                                                                    ActionPriority::HIGH, blocked_action_id);
+                });
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                p_client_core_->SetProcessQueuedActions(true);
+                blocked_producer.join();
+                EXPECT_EQ(ResponseCode::SUCCESS, blocked_rc);
+
+                for (size_t itr = 0; itr < 50; itr++) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                    if (5 == TestAction::total_perform_action_call_count_) {
+                        break;
+                    }
+                }
+                EXPECT_EQ(5, TestAction::total_perform_action_call_count_);
+                EXPECT_EQ(3, p_high->perform_action_count_);
+                EXPECT_EQ(0, p_low_oldest->perform_action_count_);
+                EXPECT_EQ(1, p_low->perform_action_count_);
+                EXPECT_EQ(1, p_low_newest->perform_action_count_);
+                EXPECT_EQ(3u, p_core_state_->GetDroppedActionCount());
+
+                p_core_state_->SetMaxActionQueueSize(cur_max_queue_size);
+            }
+
+            // Test pending Ack expiry - handler is called once with timeout error, acknowledged or deleted Acks
+            // are not expired
+            TEST_F(ClientCoreTester, PendingAckExpiry) {
+                EXPECT_NE(nullptr, p_client_core_);
+                EXPECT_NE(nullptr, p_core_state_);
+
+                std::atomic_int timeout_count(0);
+                std::atomic_int success_count(0);
+                ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler =
+                    [&timeout_count, &success_count](uint16_t action_id, ResponseCode rc) {
+                        if (ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR == rc) {
+                            timeout_count++;
+                        } else if (ResponseCode::SUCCESS == rc) {
+                            success_count++;
+                        }
+                    };
+
+                EXPECT_EQ(std::chrono::milliseconds(DEFAULT_ACK_TIMEOUT_MS), p_core_state_->GetAckTimeout());
+                p_core_state_->SetAckTimeout(std::chrono::milliseconds(50));
+                EXPECT_EQ(std::chrono::milliseconds(50), p_core_state_->GetAckTimeout());
+
+                EXPECT_EQ(ResponseCode::SUCCESS, p_core_state_->RegisterPendingAck(10, p_async_ack_handler));
+                EXPECT_EQ(ResponseCode::SUCCESS, p_core_state_->RegisterPendingAck(11, p_async_ack_handler));
+                EXPECT_EQ(ResponseCode::SUCCESS, p_core_state_->RegisterPendingAck(12, p_async_ack_handler));
+                p_core_state_->ForwardReceivedAck(11, ResponseCode::SUCCESS);
+                p_core_state_->DeletePendingAck(12);
+
+                // Expiry is driven by the outbound processing thread
+                for (size_t itr = 0; itr < 50; itr++) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                    if (0 != timeout_count) {
+                        break;
+                    }
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                EXPECT_EQ(1, timeout_count);
+                EXPECT_EQ(1, success_count);
+
+                // Expired Ack is removed, late response is ignored
+                p_core_state_->ForwardReceivedAck(10, ResponseCode::SUCCESS);
+                EXPECT_EQ(1, success_count);
+            }
+
+            // Test Action ID allocation - IDs with a pending Ack are never handed out, 0 is skipped on wrap around
+            // and occupancy reflects the number of pending Acks
+            TEST_F(ClientCoreTester, ActionIdSkipsPendingAcks) {
+                EXPECT_NE(nullptr, p_core_state_);
+
+                ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler = [](uint16_t, ResponseCode) {};
+                EXPECT_EQ(0u, p_core_state_->GetPendingAckCount());
+                EXPECT_EQ(ResponseCode::SUCCESS, p_core_state_->RegisterPendingAck(2, p_async_ack_handler));
+                EXPECT_EQ(ResponseCode::SUCCESS, p_core_state_->RegisterPendingAck(3, p_async_ack_handler));
+                EXPECT_EQ(ResponseCode::SUCCESS, p_core_state_->RegisterPendingAck(1, p_async_ack_handler));
+                EXPECT_EQ(3u, p_core_state_->GetPendingAckCount());
+
+                EXPECT_EQ(4, p_core_state_->GetNextActionId());
+                p_core_state_->ForwardReceivedAck(2, ResponseCode::SUCCESS);
+                EXPECT_EQ(2u, p_core_state_->GetPendingAckCount());
+                EXPECT_EQ(5, p_core_state_->GetNextActionId());
+
+                // Run through the whole ID space, IDs 1 and 3 are still pending so 2 is the next after wrapping
+                for (size_t itr = 6; itr <= UINT16_MAX; itr++) {
+                    EXPECT_EQ(itr, p_core_state_->GetNextActionId());
+                }
+                EXPECT_EQ(2, p_core_state_->GetNextActionId());
+                EXPECT_EQ(4, p_core_state_->GetNextActionId());
+
+                p_core_state_->DeletePendingAck(1);
+                p_core_state_->DeletePendingAck(3);
+                EXPECT_EQ(0u, p_core_state_->GetPendingAckCount());
+            }
+
+            // Test completion tokens - many queued Actions can be waited on in bulk, each token is completed with
+            // the response for its own Action
+            TEST_F(ClientCoreTester, CompletionTokenBulkWait) {
+                EXPECT_NE(nullptr, p_client_core_);
+                EXPECT_NE(nullptr, p_core_state_);
+
+                TestAction::Reset();
+                ResponseCode rc = p_client_core_->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create);
+                EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+                size_t cur_max_queue_size = p_core_state_->GetMaxActionQueueSize();
+                p_core_state_->SetMaxActionQueueSize(MAX_OUTBOUND_ACTION_QUEUE_CAPACITY);
+                p_core_state_->SetOutboundActionRateLimit(0, 1);
+                p_client_core_->SetProcessQueuedActions(true);
+
+                const size_t action_count = 500;
+                util::Vector<std::shared_ptr<CompletionToken>> tokens;
+                util::Vector<uint16_t> action_ids;
+                for (size_t itr = 0; itr < action_count; itr++) {
+                    std::shared_ptr<TestActionData> p_test_action_data = std::make_shared<TestActionData>();
+                    p_test_action_data->p_completion_token_ = CompletionToken::Create();
+                    tokens.push_back(p_test_action_data->p_completion_token_);
+                    uint16_t action_id = 0;
+                    rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_test_action_data,
+                                                            ActionPriority::LOW, action_id);
+                    if (ResponseCode::ACTION_QUEUE_FULL == rc) {
+                        // Consumer is behind, wait for it to catch up
+                        tokens.pop_back();
+                        itr--;
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    EXPECT_EQ(ResponseCode::SUCCESS, rc);
+                    action_ids.push_back(action_id);
+                }
+
+                EXPECT_EQ(action_count, CompletionToken::WaitForAll(tokens, std::chrono::milliseconds(5000)));
+                for (size_t itr = 0; itr < tokens.size(); itr++) {
+                    EXPECT_EQ(ResponseCode::SUCCESS, tokens[itr]->GetResponse());
+                    EXPECT_EQ(action_ids[itr], tokens[itr]->GetActionId());
+                }
+                EXPECT_EQ(0u, p_core_state_->GetPendingAckCount());
+
+                p_core_state_->SetMaxActionQueueSize(cur_max_queue_size);
+            }
+
             // Test creation of action thread runner, thread should execute successfully,
             // Action instance count is incremented, Action instance count decremented on thread destroy
             TEST_F(ClientCoreTester, ActionRunner) {
@@ -382,6 +759,327 @@ namespace awsiotsdk {
                 EXPECT_EQ(2, TestAction::total_instance_count_);
             }
 
+            // Outbound queues of many Client Core instances are processed by one shared worker thread
+            TEST_F(ClientCoreTester, SharedExecutor) {
+                util::Threading::ExecutorConfig config;
+                config.worker_count_ = 1;
+                std::shared_ptr<util::Threading::Executor> p_executor = util::Threading::Executor::Create(config);
+                ASSERT_NE(nullptr, p_executor);
+
+                TestAction::Reset();
+                const int client_count = 8;
+                std::atomic_int ack_count(0);
+                util::Vector<std::unique_ptr<ClientCore>> client_cores;
+                for (int itr = 0; itr < client_count; itr++) {
+                    std::shared_ptr<NetworkConnection>
+                        p_network_connection = std::make_shared<tests::mocks::MockNetworkConnection>();
+                    std::unique_ptr<ClientCore> p_client_core
+                        = ClientCore::Create(p_network_connection, std::make_shared<ClientCoreState>(), p_executor);
+                    ASSERT_NE(nullptr, p_client_core);
+                    EXPECT_EQ(ResponseCode::SUCCESS,
+                              p_client_core->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create));
+                    p_client_core->SetProcessQueuedActions(true);
+                    client_cores.push_back(std::move(p_client_core));
+                }
+                EXPECT_EQ((size_t) client_count, p_executor->GetTaskCount());
+
+                for (std::unique_ptr<ClientCore> &p_client_core : client_cores) {
+                    std::shared_ptr<TestActionData> p_test_action_data = std::make_shared<TestActionData>();
+                    p_test_action_data->p_async_ack_handler_ = [&ack_count](uint16_t action_id, ResponseCode rc) {
+                        IOT_UNUSED(action_id);
+                        if (ResponseCode::SUCCESS == rc) {
+                            ack_count++;
+                        }
+                    };
+                    uint16_t action_id = 0;
+                    EXPECT_EQ(ResponseCode::SUCCESS,
+                              p_client_core->PerformActionAsync(ActionType::RESERVED_ACTION, p_test_action_data,
+                                                                action_id));
+                }
+
+                std::chrono::steady_clock::time_point deadline
+                    = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+                while (client_count != ack_count && std::chrono::steady_clock::now() < deadline) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                EXPECT_EQ(client_count, ack_count);
+                EXPECT_EQ(client_count, TestAction::total_perform_action_call_count_);
+
+                // Runners that are not steppable still get a dedicated thread
+                std::shared_ptr<TestActionData> p_test_action_data = std::make_shared<TestActionData>();
+                EXPECT_EQ(ResponseCode::SUCCESS,
+                          client_cores[0]->CreateActionRunner(ActionType::RESERVED_ACTION, p_test_action_data));
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                EXPECT_EQ(1, p_test_action_data->perform_action_count_);
+                EXPECT_EQ((size_t) client_count, p_executor->GetTaskCount());
+
+                client_cores.clear();
+                EXPECT_EQ(0u, p_executor->GetTaskCount());
+            }
+
+#if defined(__linux__)
+            // Mock connection backed by a pipe, data is "received" by writing to the pipe
+            class PipeNetworkConnection : public tests::mocks::MockNetworkConnection {
+            public:
+                int pipe_fds_[2];
+
+                PipeNetworkConnection() {
+                    if (0 != pipe(pipe_fds_)) {
+                        pipe_fds_[0] = -1;
+                        pipe_fds_[1] = -1;
+                    }
+                }
+
+                ~PipeNetworkConnection() {
+                    close(pipe_fds_[0]);
+                    close(pipe_fds_[1]);
+                }
+
+                // Replaces the pipe like a reconnect replaces the socket, the new descriptors may reuse the numbers
+                bool Reconnect() {
+                    close(pipe_fds_[0]);
+                    close(pipe_fds_[1]);
+                    return 0 == pipe(pipe_fds_);
+                }
+
+                int GetPollDescriptor() { return pipe_fds_[0]; }
+
+                bool IsReadPending() {
+                    struct pollfd pipe_poll_fd = {pipe_fds_[0], POLLIN, 0};
+                    return 0 != poll(&pipe_poll_fd, 1, 0);
+                }
+            };
+
+            // Steppable runner that consumes one byte of the pipe per step
+            class PipeReadAction : public Action {
+            public:
+                static std::atomic_int step_count_;
+                static std::atomic_int read_count_;
+
+                PipeReadAction() : Action(ActionType::RESERVED_ACTION, "Pipe Read Action") {}
+
+                static std::unique_ptr<Action> Create(std::shared_ptr<ActionState> p_action_state) {
+                    IOT_UNUSED(p_action_state);
+                    return std::unique_ptr<Action>(new PipeReadAction());
+                }
+
+                ResponseCode PerformAction(std::shared_ptr<NetworkConnection> p_network_connection,
+                                           std::shared_ptr<ActionData> p_action_data) {
+                    IOT_UNUSED(p_network_connection);
+                    IOT_UNUSED(p_action_data);
+                    return ResponseCode::FAILURE;
+                }
+
+                bool IsSteppable() { return true; }
+
+                bool WaitsForNetworkData() { return true; }
+
+                ResponseCode PerformActionStep(std::shared_ptr<NetworkConnection> p_network_connection,
+                                               std::shared_ptr<ActionData> p_action_data,
+                                               std::chrono::microseconds &next_step_delay_out) {
+                    IOT_UNUSED(p_action_data);
+                    step_count_++;
+                    next_step_delay_out = std::chrono::microseconds(0);
+                    if (!p_network_connection->IsReadPending()) {
+                        next_step_delay_out = std::chrono::milliseconds(DEFAULT_CORE_THREAD_SLEEP_DURATION_MS);
+                        return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+                    }
+                    char data_byte;
+                    if (1 == read(p_network_connection->GetPollDescriptor(), &data_byte, 1)) {
+                        read_count_++;
+                    }
+                    return ResponseCode::SUCCESS;
+                }
+            };
+
+            std::atomic_int PipeReadAction::step_count_(0);
+            std::atomic_int PipeReadAction::read_count_(0);
+
+            // Runners that wait for network data only run on an event loop when their descriptor is readable
+            TEST_F(ClientCoreTester, EventLoopRunsWatchedRunnerOnData) {
+                util::Threading::ExecutorConfig config;
+                std::shared_ptr<util::Threading::EventLoop> p_event_loop = util::Threading::EventLoop::Create(config);
+                ASSERT_NE(nullptr, p_event_loop);
+                EXPECT_EQ(1u, p_event_loop->GetWorkerCount());
+
+                std::shared_ptr<PipeNetworkConnection> p_network_connection = std::make_shared<PipeNetworkConnection>();
+                ASSERT_LE(0, p_network_connection->pipe_fds_[0]);
+                std::unique_ptr<ClientCore> p_client_core
+                    = ClientCore::Create(p_network_connection, std::make_shared<ClientCoreState>(), p_event_loop);
+                ASSERT_NE(nullptr, p_client_core);
+                EXPECT_EQ(ResponseCode::SUCCESS,
+                          p_client_core->RegisterAction(ActionType::RESERVED_ACTION, PipeReadAction::Create));
+
+                PipeReadAction::step_count_ = 0;
+                PipeReadAction::read_count_ = 0;
+                EXPECT_EQ(ResponseCode::SUCCESS,
+                          p_client_core->CreateActionRunner(ActionType::RESERVED_ACTION, nullptr));
+
+                // Idle connection is watched, not polled
+                std::this_thread::sleep_for(std::chrono::milliseconds(300));
+                EXPECT_EQ(0, PipeReadAction::step_count_);
+                EXPECT_EQ(1u, p_event_loop->GetWatchCount());
+
+                const char data[] = {1, 2, 3};
+                ASSERT_EQ((ssize_t) sizeof(data), write(p_network_connection->pipe_fds_[1], data, sizeof(data)));
+                std::chrono::steady_clock::time_point deadline
+                    = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+                while ((int) sizeof(data) != PipeReadAction::read_count_
+                    && std::chrono::steady_clock::now() < deadline) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                EXPECT_EQ((int) sizeof(data), PipeReadAction::read_count_);
+
+                // Watch is re-armed once the data is consumed
+                std::this_thread::sleep_for(std::chrono::milliseconds(300));
+                EXPECT_EQ(PipeReadAction::read_count_, PipeReadAction::step_count_);
+
+                p_client_core.reset();
+                EXPECT_EQ(0u, p_event_loop->GetTaskCount());
+                EXPECT_EQ(0u, p_event_loop->GetWatchCount());
+            }
+
+            // A runner parked on the descriptor of a closed connection is woken up to watch the new one
+            TEST_F(ClientCoreTester, EventLoopWakesParkedRunnerOnReconnect) {
+                util::Threading::ExecutorConfig config;
+                std::shared_ptr<util::Threading::EventLoop> p_event_loop = util::Threading::EventLoop::Create(config);
+                ASSERT_NE(nullptr, p_event_loop);
+
+                std::shared_ptr<PipeNetworkConnection> p_network_connection = std::make_shared<PipeNetworkConnection>();
+                ASSERT_LE(0, p_network_connection->pipe_fds_[0]);
+                std::shared_ptr<ClientCoreState> p_core_state = std::make_shared<ClientCoreState>();
+                std::unique_ptr<ClientCore> p_client_core
+                    = ClientCore::Create(p_network_connection, p_core_state, p_event_loop);
+                ASSERT_NE(nullptr, p_client_core);
+                EXPECT_EQ(ResponseCode::SUCCESS,
+                          p_client_core->RegisterAction(ActionType::RESERVED_ACTION, PipeReadAction::Create));
+
+                PipeReadAction::step_count_ = 0;
+                PipeReadAction::read_count_ = 0;
+                EXPECT_EQ(ResponseCode::SUCCESS,
+                          p_client_core->CreateActionRunner(ActionType::RESERVED_ACTION, nullptr));
+                std::chrono::steady_clock::time_point deadline
+                    = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+                while (0 == p_event_loop->GetWatchCount() && std::chrono::steady_clock::now() < deadline) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                EXPECT_EQ(1u, p_event_loop->GetWatchCount());
+
+                ASSERT_TRUE(p_network_connection->Reconnect());
+                p_core_state->NotifyNetworkConnected();
+
+                const char data = 1;
+                ASSERT_EQ(1, write(p_network_connection->pipe_fds_[1], &data, 1));
+                deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+                while (0 == PipeReadAction::read_count_ && std::chrono::steady_clock::now() < deadline) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                EXPECT_EQ(1, PipeReadAction::read_count_);
+
+                p_client_core.reset();
+                p_core_state->ClearRegisteredActions();
+                EXPECT_EQ(0u, p_event_loop->GetTaskCount());
+                EXPECT_EQ(0u, p_event_loop->GetWatchCount());
+            }
+
+            // Steppable runner that needs two bytes of the pipe, like a packet that arrives in two parts. Asks for a
+            // long delay when it only has part of it
+            class PipePartialReadAction : public Action {
+            public:
+                static std::atomic_int step_count_;
+                static std::atomic_int complete_count_;
+
+                size_t buffered_bytes_;
+
+                PipePartialReadAction() : Action(ActionType::RESERVED_ACTION, "Pipe Partial Read Action"),
+                                          buffered_bytes_(0) {}
+
+                static std::unique_ptr<Action> Create(std::shared_ptr<ActionState> p_action_state) {
+                    IOT_UNUSED(p_action_state);
+                    return std::unique_ptr<Action>(new PipePartialReadAction());
+                }
+
+                ResponseCode PerformAction(std::shared_ptr<NetworkConnection> p_network_connection,
+                                           std::shared_ptr<ActionData> p_action_data) {
+                    IOT_UNUSED(p_network_connection);
+                    IOT_UNUSED(p_action_data);
+                    return ResponseCode::FAILURE;
+                }
+
+                bool IsSteppable() { return true; }
+
+                bool WaitsForNetworkData() { return true; }
+
+                ResponseCode PerformActionStep(std::shared_ptr<NetworkConnection> p_network_connection,
+                                               std::shared_ptr<ActionData> p_action_data,
+                                               std::chrono::microseconds &next_step_delay_out) {
+                    IOT_UNUSED(p_action_data);
+                    step_count_++;
+                    char data[2];
+                    if (p_network_connection->IsReadPending()) {
+                        ssize_t read_bytes = read(p_network_connection->GetPollDescriptor(), data,
+                                                  sizeof(data) - buffered_bytes_);
+                        if (0 < read_bytes) {
+                            buffered_bytes_ += (size_t) read_bytes;
+                        }
+                    }
+                    if (sizeof(data) == buffered_bytes_) {
+                        buffered_bytes_ = 0;
+                        complete_count_++;
+                        next_step_delay_out = std::chrono::microseconds(0);
+                        return ResponseCode::SUCCESS;
+                    }
+                    next_step_delay_out = std::chrono::seconds(10);
+                    return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+                }
+            };
+
+            std::atomic_int PipePartialReadAction::step_count_(0);
+            std::atomic_int PipePartialReadAction::complete_count_(0);
+
+            // The watch is armed again right after a step that read part of a packet, the rest is handled as soon as
+            // it arrives instead of after the delay the step asked for
+            TEST_F(ClientCoreTester, EventLoopRearmsWatchAfterPartialRead) {
+                util::Threading::ExecutorConfig config;
+                std::shared_ptr<util::Threading::EventLoop> p_event_loop = util::Threading::EventLoop::Create(config);
+                ASSERT_NE(nullptr, p_event_loop);
+
+                std::shared_ptr<PipeNetworkConnection> p_network_connection = std::make_shared<PipeNetworkConnection>();
+                ASSERT_LE(0, p_network_connection->pipe_fds_[0]);
+                std::unique_ptr<ClientCore> p_client_core
+                    = ClientCore::Create(p_network_connection, std::make_shared<ClientCoreState>(), p_event_loop);
+                ASSERT_NE(nullptr, p_client_core);
+                EXPECT_EQ(ResponseCode::SUCCESS,
+                          p_client_core->RegisterAction(ActionType::RESERVED_ACTION, PipePartialReadAction::Create));
+
+                PipePartialReadAction::step_count_ = 0;
+                PipePartialReadAction::complete_count_ = 0;
+                EXPECT_EQ(ResponseCode::SUCCESS,
+                          p_client_core->CreateActionRunner(ActionType::RESERVED_ACTION, nullptr));
+
+                const char data[] = {1, 2};
+                ASSERT_EQ(1, write(p_network_connection->pipe_fds_[1], &data[0], 1));
+                std::chrono::steady_clock::time_point deadline
+                    = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+                while (0 == PipePartialReadAction::step_count_ && std::chrono::steady_clock::now() < deadline) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                EXPECT_EQ(1, PipePartialReadAction::step_count_);
+                EXPECT_EQ(0, PipePartialReadAction::complete_count_);
+
+                ASSERT_EQ(1, write(p_network_connection->pipe_fds_[1], &data[1], 1));
+                deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+                while (0 == PipePartialReadAction::complete_count_ && std::chrono::steady_clock::now() < deadline) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                EXPECT_EQ(1, PipePartialReadAction::complete_count_);
+
+                p_client_core.reset();
+                EXPECT_EQ(0u, p_event_loop->GetTaskCount());
+                EXPECT_EQ(0u, p_event_loop->GetWatchCount());
+            }
+#endif
+
             // Test Client Core destroy, all threads should successfully stop, no exceptions
         }
     }
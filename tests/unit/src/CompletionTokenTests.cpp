@@ -0,0 +1,90 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file CompletionTokenTests.cpp
+ * @brief
+ *
+ */
+
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "CompletionToken.hpp"
+
+namespace awsiotsdk {
+    namespace tests {
+        namespace unit {
+            class CompletionTokenTester : public ::testing::Test {
+            };
+
+            // Only the first completion is kept, waiting on a completed token returns immediately
+            TEST_F(CompletionTokenTester, CompleteOnce) {
+                std::shared_ptr<CompletionToken> p_token = CompletionToken::Create();
+                EXPECT_FALSE(p_token->IsComplete());
+                EXPECT_EQ(ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR, p_token->GetResponse());
+                EXPECT_FALSE(p_token->WaitFor(std::chrono::milliseconds(10)));
+
+                p_token->Complete(12, ResponseCode::SUCCESS);
+                p_token->Complete(13, ResponseCode::FAILURE);
+                EXPECT_TRUE(p_token->IsComplete());
+                EXPECT_TRUE(p_token->WaitFor(std::chrono::milliseconds(0)));
+                EXPECT_EQ(ResponseCode::SUCCESS, p_token->GetResponse());
+                EXPECT_EQ(12, p_token->GetActionId());
+            }
+
+            // Tokens completed from another thread wake up the waiting thread, the deadline is shared by the batch
+            TEST_F(CompletionTokenTester, WaitForAll) {
+                util::Vector<std::shared_ptr<CompletionToken>> tokens;
+                for (uint16_t itr = 0; itr < 100; itr++) {
+                    tokens.push_back(CompletionToken::Create());
+                }
+                tokens.push_back(nullptr);
+
+                std::thread completer([&tokens]() {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                    // Leave the last token pending
+                    for (size_t itr = 0; itr < 99; itr++) {
+                        tokens[itr]->Complete((uint16_t) itr, ResponseCode::SUCCESS);
+                    }
+                });
+
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                EXPECT_EQ(99u, CompletionToken::WaitForAll(tokens, std::chrono::milliseconds(200)));
+                EXPECT_GT(std::chrono::milliseconds(1000), std::chrono::steady_clock::now() - start);
+                completer.join();
+                EXPECT_FALSE(tokens[99]->IsComplete());
+            }
+
+            // Continuations run once on completion, they can't be set on a completed token
+            TEST_F(CompletionTokenTester, Continuation) {
+                std::shared_ptr<CompletionToken> p_token = CompletionToken::Create();
+                int call_count = 0;
+                ResponseCode response = ResponseCode::FAILURE;
+                EXPECT_TRUE(p_token->SetContinuation([&call_count, &response, p_token]() {
+                    call_count++;
+                    response = p_token->GetResponse();
+                }));
+
+                p_token->Complete(5, ResponseCode::SUCCESS);
+                p_token->Complete(6, ResponseCode::FAILURE);
+                EXPECT_EQ(1, call_count);
+                EXPECT_EQ(ResponseCode::SUCCESS, response);
+                EXPECT_FALSE(p_token->SetContinuation([&call_count]() { call_count++; }));
+                EXPECT_EQ(1, call_count);
+            }
+        }
+    }
+}
@@ -19,6 +19,8 @@
  *
  */
 
+#include <algorithm>
+
 #include "MockNetworkConnection.hpp"
 
 namespace awsiotsdk {
@@ -58,21 +60,14 @@ namespace awsiotsdk {
 
                 if (has_read_buf_) {
                     size_t remaining_bytes_in_buf = next_read_buf_.size();
-                    size_t cur_read_bytes = 0;
                     size_read_bytes_out = ((size_bytes_to_read <= remaining_bytes_in_buf) ? size_bytes_to_read
                                                                                           : remaining_bytes_in_buf);
-                    //size_t cur_read_bytes = 0;
+                    if (buf.size() < buf_read_offset + size_read_bytes_out) {
+                        buf.resize(buf_read_offset + size_read_bytes_out);
+                    }
                     auto begin_itr = next_read_buf_.begin();
                     auto end_itr = next_read_buf_.begin() + size_read_bytes_out;
-                    auto insert_itr = buf.begin() + buf_read_offset;
-                    auto insert_end_itr = buf.begin() + buf_read_offset + size_read_bytes_out;
-                    buf.erase(insert_itr, insert_end_itr);
-                    for (unsigned char c : next_read_buf_) {
-                        buf.push_back(c);
-                        if (cur_read_bytes >= size_read_bytes_out) {
-                            break;
-                        }
-                    }
+                    std::copy(begin_itr, end_itr, buf.begin() + buf_read_offset);
 
                     next_read_buf_.erase(begin_itr, end_itr);
 
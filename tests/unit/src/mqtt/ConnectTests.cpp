@@ -19,6 +19,7 @@
  *
  */
 
+#include <algorithm>
 #include <chrono>
 
 #include <gtest/gtest.h>
@@ -42,6 +43,47 @@
 namespace awsiotsdk {
     namespace tests {
         namespace unit {
+            // Connection that accepts every write at once and keeps everything written
+            class RecordingNetworkConnection : public NetworkConnection {
+            public:
+                util::String written_buf_;
+                size_t write_count_;
+
+                RecordingNetworkConnection() : write_count_(0) {}
+
+                bool IsConnected() { return true; }
+                bool IsPhysicalLayerConnected() { return true; }
+
+            protected:
+                ResponseCode ConnectInternal() { return ResponseCode::SUCCESS; }
+                ResponseCode DisconnectInternal() { return ResponseCode::SUCCESS; }
+
+                ResponseCode WriteInternal(const util::String &buf, size_t &size_written_bytes_out) {
+                    write_count_++;
+                    written_buf_ += buf;
+                    size_written_bytes_out = buf.length();
+                    return ResponseCode::SUCCESS;
+                }
+
+                ResponseCode ReadInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+                                          size_t size_bytes_to_read, size_t &size_read_bytes_out) {
+                    IOT_UNUSED(buf);
+                    IOT_UNUSED(buf_read_offset);
+                    IOT_UNUSED(size_bytes_to_read);
+                    size_read_bytes_out = 0;
+                    return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+                }
+            };
+
+            // Exposes the resubscribe of the keepalive runner
+            class ResubscribeTestRunner : public mqtt::KeepaliveActionRunner {
+            public:
+                explicit ResubscribeTestRunner(std::shared_ptr<mqtt::ClientState> p_client_state)
+                    : mqtt::KeepaliveActionRunner(p_client_state) {}
+
+                using mqtt::KeepaliveActionRunner::Resubscribe;
+            };
+
             class ConnectDisconnectActionTester : public ::testing::Test {
             protected:
                 std::shared_ptr<mqtt::ClientState> p_core_state_;
@@ -511,6 +553,64 @@ namespace awsiotsdk {
                 p_core_state_->p_network_connection_ = nullptr;
             }
 
+            // A ping response left unread while handlers hold up inbound reads does not lead to a reconnect
+            TEST_F(ConnectDisconnectActionTester, KeepAliveWaitsWhileInboundPausedTest) {
+                EXPECT_NE(nullptr, p_network_connection_);
+                EXPECT_NE(nullptr, p_core_state_);
+
+                p_network_connection_->last_write_buf_.clear();
+                p_network_connection_->was_write_called_ = false;
+
+                // Pings are due every half keepalive, whole seconds only
+                std::chrono::seconds keepalive = std::chrono::seconds(2);
+                p_core_state_->SetConnected(true);
+                p_core_state_->SetAutoReconnectEnabled(true);
+                p_core_state_->SetAutoReconnectRequired(false);
+                p_core_state_->SetPingreqPending(true);
+                p_core_state_->SetKeepAliveTimeout(keepalive);
+                p_core_state_->p_network_connection_ = p_network_connection_;
+                p_core_state_->RegisterAction(ActionType::DISCONNECT,
+                                              mqtt::DisconnectActionAsync::Create,
+                                              p_core_state_);
+
+                EXPECT_CALL(*p_network_mock_, IsConnected()).WillRepeatedly(::testing::Return(true));
+                EXPECT_CALL(*p_network_mock_, WriteInternalProxy(::testing::_, ::testing::_)).Times(0);
+                EXPECT_CALL(*p_network_mock_, DisconnectInternal()).Times(0);
+
+                // A slow handler holds the whole inbound budget, the read runner stops reading
+                p_core_state_->SetInboundLimit(1, 0);
+                p_core_state_->AddInboundMessage(1);
+                std::shared_ptr<RecordingNetworkConnection> p_read_connection =
+                    std::make_shared<RecordingNetworkConnection>();
+                std::unique_ptr<Action> p_read_action = mqtt::NetworkReadActionRunner::Create(p_core_state_);
+                std::chrono::microseconds next_step_delay(-1);
+                EXPECT_EQ(ResponseCode::NETWORK_SSL_NOTHING_TO_READ,
+                          p_read_action->PerformActionStep(p_read_connection, nullptr, next_step_delay));
+                EXPECT_TRUE(p_core_state_->IsInboundPaused());
+
+                std::unique_ptr<Action> p_keepalive_action = mqtt::KeepaliveActionRunner::Create(p_core_state_);
+
+                std::shared_ptr<std::atomic_bool> thread_task_out_sync = std::make_shared<std::atomic_bool>(true);
+                p_keepalive_action->SetParentThreadSync(thread_task_out_sync);
+                {
+                    util::Threading::ThreadTask temp_task(util::Threading::DestructorAction::JOIN,
+                                                          thread_task_out_sync, "TestKeepAliveInboundPaused");
+                    temp_task.Run(&Action::PerformAction, std::move(p_keepalive_action), p_network_connection_,
+                                  nullptr);
+
+                    // Two ping intervals, the missing ping response would have been acted upon after the first
+                    std::this_thread::sleep_for(keepalive);
+                    EXPECT_FALSE(p_network_connection_->was_write_called_);
+                    EXPECT_FALSE(p_core_state_->IsAutoReconnectRequired());
+                    EXPECT_TRUE(p_core_state_->IsConnected());
+                    EXPECT_TRUE(p_core_state_->IsPingreqPending());
+                }
+
+                p_core_state_->RemoveInboundMessage(1);
+                p_core_state_->ClearRegisteredActions();
+                p_core_state_->p_network_connection_ = nullptr;
+            }
+
             TEST_F(ConnectDisconnectActionTester, KeepAliveSendPingreqFailedTest) {
                 EXPECT_NE(nullptr, p_network_connection_);
                 EXPECT_NE(nullptr, p_core_state_);
@@ -696,6 +796,86 @@ namespace awsiotsdk {
                 EXPECT_EQ(keep_alive_timeout_, std::chrono::seconds(keep_alive_timeout));
                 EXPECT_EQ(KEEP_ALIVE_TIMEOUT_SECS, keep_alive_timeout);
             }
+
+            // Resubscribe writes every Subscribe packet at once, Subscriptions become active as their Suback
+            // arrives and the handler gets the combined result after the last one
+            TEST_F(ConnectDisconnectActionTester, ResubscribeIsPipelined) {
+                mqtt::Subscription::ApplicationCallbackHandlerPtr p_app_handler =
+                    [](util::String topic_name, util::String payload,
+                       std::shared_ptr<mqtt::SubscriptionHandlerContextData> p_app_handler_data) {
+                        return ResponseCode::SUCCESS;
+                    };
+                util::Vector<std::shared_ptr<mqtt::Subscription>> subscriptions;
+                for (int itr = 10; itr < 30; itr++) {
+                    std::shared_ptr<mqtt::Subscription> p_subscription =
+                        mqtt::Subscription::Create(Utf8String::Create(test_topic_name_ + "/" + std::to_string(itr)),
+                                                   mqtt::QoS::QOS1, p_app_handler, nullptr);
+                    EXPECT_EQ(ResponseCode::SUCCESS, p_core_state_->AddSubscription(p_subscription));
+                    subscriptions.push_back(p_subscription);
+                }
+
+                int resubscribe_count = 0;
+                ResponseCode resubscribe_rc = ResponseCode::FAILURE;
+                p_core_state_->resubscribe_handler_ptr_ =
+                    [&resubscribe_count, &resubscribe_rc](util::String mqtt_client_id,
+                                                          std::shared_ptr<ResubscribeCallbackContextData> p_app_handler_data,
+                                                          ResponseCode resubscribe_result) {
+                        EXPECT_EQ(test_client_id_, mqtt_client_id);
+                        resubscribe_count++;
+                        resubscribe_rc = resubscribe_result;
+                        return ResponseCode::SUCCESS;
+                    };
+
+                std::shared_ptr<RecordingNetworkConnection> p_recording_connection =
+                    std::make_shared<RecordingNetworkConnection>();
+                ResubscribeTestRunner runner(p_core_state_);
+                runner.SetParentThreadSync(std::make_shared<std::atomic_bool>(true));
+                EXPECT_EQ(ResponseCode::SUCCESS, runner.Resubscribe(p_recording_connection, test_client_id_));
+                EXPECT_EQ(1u, p_recording_connection->write_count_);
+
+                // 20 topics of equal length, packed into packets of DEFAULT_RESUBSCRIBE_MAX_TOPICS_PER_PACKET topics
+                util::Vector<uint16_t> packet_ids;
+                size_t topic_size = 2 + test_topic_name_.length() + 3 + 1;
+                unsigned char *p_next_msg = (unsigned char *) (p_recording_connection->written_buf_.c_str());
+                unsigned char *p_buf_end = p_next_msg + p_recording_connection->written_buf_.length();
+                while (p_next_msg < p_buf_end) {
+                    EXPECT_EQ(0x82, (int) *(p_next_msg++));
+                    size_t rem_len = TestHelper::ParseRemLenFromBuffer(&p_next_msg);
+                    unsigned char *p_packet_end = p_next_msg + rem_len;
+                    uint16_t packet_id = TestHelper::ReadUint16FromBuffer(&p_next_msg);
+                    EXPECT_NE(0, packet_id);
+                    EXPECT_EQ(packet_ids.end(), std::find(packet_ids.begin(), packet_ids.end(), packet_id));
+                    packet_ids.push_back(packet_id);
+                    size_t topic_count = std::min((size_t) DEFAULT_RESUBSCRIBE_MAX_TOPICS_PER_PACKET,
+                                                  subscriptions.size() - (packet_ids.size() - 1)
+                                                      * DEFAULT_RESUBSCRIBE_MAX_TOPICS_PER_PACKET);
+                    EXPECT_EQ(2 + topic_count * topic_size, rem_len);
+                    p_next_msg = p_packet_end;
+                }
+                size_t packet_count = (subscriptions.size() + DEFAULT_RESUBSCRIBE_MAX_TOPICS_PER_PACKET - 1)
+                    / DEFAULT_RESUBSCRIBE_MAX_TOPICS_PER_PACKET;
+                ASSERT_EQ(packet_count, packet_ids.size());
+                ASSERT_LE(2u, packet_count);
+
+                // Suback for the first packet, handled as NetworkReadActionRunner::HandleSuback does
+                for (uint8_t itr = 1; itr <= DEFAULT_RESUBSCRIBE_MAX_TOPICS_PER_PACKET; itr++) {
+                    EXPECT_EQ(ResponseCode::SUCCESS,
+                              p_core_state_->SetSubscriptionActive(packet_ids[0], itr, mqtt::QoS::QOS1));
+                }
+                p_core_state_->ForwardReceivedAck(packet_ids[0], ResponseCode::SUCCESS);
+                for (size_t itr = 0; itr < subscriptions.size(); itr++) {
+                    EXPECT_EQ(itr < DEFAULT_RESUBSCRIBE_MAX_TOPICS_PER_PACKET, subscriptions[itr]->IsActive());
+                }
+                EXPECT_EQ(0, resubscribe_count);
+
+                p_core_state_->ForwardReceivedAck(packet_ids[1], ResponseCode::MQTT_SUBSCRIBE_FAILED);
+                for (size_t itr = 2; itr < packet_count; itr++) {
+                    p_core_state_->ForwardReceivedAck(packet_ids[itr], ResponseCode::SUCCESS);
+                }
+                EXPECT_EQ(1, resubscribe_count);
+                EXPECT_EQ(ResponseCode::MQTT_SUBSCRIBE_PARTIALLY_FAILED, resubscribe_rc);
+                EXPECT_EQ(0u, p_core_state_->GetPendingAckCount());
+            }
         }
     }
 }
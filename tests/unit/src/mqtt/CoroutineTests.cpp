@@ -0,0 +1,102 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file CoroutineTests.cpp
+ * @brief Only built with C++20 coroutine support
+ *
+ */
+
+#include "mqtt/Coroutine.hpp"
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include <gtest/gtest.h>
+
+namespace awsiotsdk {
+    namespace tests {
+        namespace unit {
+            class CoroutineTester : public ::testing::Test {
+            };
+
+            static mqtt::coro::DetachedTask AwaitToken(std::shared_ptr<CompletionToken> p_token,
+                                                       ResponseCode &response_out, bool &is_done_out) {
+                response_out = co_await mqtt::coro::CompletionAwaiter(p_token);
+                is_done_out = true;
+            }
+
+            static mqtt::coro::DetachedTask ReadMessages(std::shared_ptr<mqtt::coro::MessageStream> p_stream,
+                                                         util::Vector<util::String> &payloads_out, bool &is_done_out) {
+                while (true) {
+                    std::optional<mqtt::coro::MessageStream::Message> message = co_await p_stream->Next();
+                    if (!message) {
+                        break;
+                    }
+                    payloads_out.push_back(message->payload_);
+                }
+                is_done_out = true;
+            }
+
+            // Awaiting a pending token suspends until it is completed, a completed token does not suspend
+            TEST_F(CoroutineTester, CompletionAwaiter) {
+                std::shared_ptr<CompletionToken> p_token = CompletionToken::Create();
+                ResponseCode response = ResponseCode::FAILURE;
+                bool is_done = false;
+                AwaitToken(p_token, response, is_done);
+                EXPECT_FALSE(is_done);
+                p_token->Complete(3, ResponseCode::SUCCESS);
+                EXPECT_TRUE(is_done);
+                EXPECT_EQ(ResponseCode::SUCCESS, response);
+
+                is_done = false;
+                AwaitToken(p_token, response, is_done);
+                EXPECT_TRUE(is_done);
+            }
+
+            // Messages delivered through the subscription are awaited in order, oldest are dropped when full
+            TEST_F(CoroutineTester, MessageStream) {
+                std::shared_ptr<mqtt::coro::MessageStream> p_stream = mqtt::coro::MessageStream::Create(2);
+                std::shared_ptr<mqtt::Subscription> p_subscription
+                    = p_stream->CreateSubscription(Utf8String::Create("test/topic"), mqtt::QoS::QOS0);
+                p_subscription->p_app_handler_("test/topic", "1", nullptr);
+                p_subscription->p_app_handler_("test/topic", "2", nullptr);
+                p_subscription->p_app_handler_("test/topic", "3", nullptr);
+                EXPECT_EQ(1u, p_stream->GetDroppedMessageCount());
+
+                util::Vector<util::String> payloads;
+                bool is_done = false;
+                ReadMessages(p_stream, payloads, is_done);
+                ASSERT_EQ(2u, payloads.size());
+                EXPECT_EQ("2", payloads[0]);
+                EXPECT_EQ("3", payloads[1]);
+
+                // Consumer is suspended now, it is resumed by the next message
+                p_subscription->p_app_handler_("test/topic", "4", nullptr);
+                EXPECT_EQ(3u, payloads.size());
+                EXPECT_FALSE(is_done);
+                p_stream->Close();
+                EXPECT_TRUE(is_done);
+
+                // Subscriptions do not keep the stream alive
+                std::weak_ptr<mqtt::coro::MessageStream> p_weak_stream = p_stream;
+                p_stream.reset();
+                EXPECT_TRUE(p_weak_stream.expired());
+                EXPECT_EQ(ResponseCode::SUCCESS, p_subscription->p_app_handler_("test/topic", "5", nullptr));
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,511 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file NetworkReadTests.cpp
+ * @brief
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "mqtt/ClientState.hpp"
+#include "mqtt/NetworkRead.hpp"
+
+#include "MockNetworkConnection.hpp"
+#include "TestHelper.hpp"
+
+namespace awsiotsdk {
+    namespace tests {
+        namespace unit {
+            // Stream like connection, every read returns as much queued data as fits
+            class ReadAheadNetworkConnection : public tests::mocks::MockNetworkConnection {
+            public:
+                std::atomic_int read_available_count_;
+                std::atomic_int waiting_read_count_;
+
+                ReadAheadNetworkConnection() : read_available_count_(0), waiting_read_count_(0) {}
+
+            protected:
+                ResponseCode ReadAvailableInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+                                                   size_t min_bytes_to_read, size_t max_bytes_to_read,
+                                                   size_t &size_read_bytes_out) {
+                    read_available_count_++;
+                    if (0 < min_bytes_to_read) {
+                        waiting_read_count_++;
+                    }
+                    size_read_bytes_out = std::min(max_bytes_to_read, next_read_buf_.size());
+                    if (0 == size_read_bytes_out) {
+                        return (0 < min_bytes_to_read) ? ResponseCode::NETWORK_SSL_NOTHING_TO_READ
+                                                       : ResponseCode::SUCCESS;
+                    }
+                    std::copy(next_read_buf_.begin(), next_read_buf_.begin() + size_read_bytes_out,
+                              buf.begin() + buf_read_offset);
+                    next_read_buf_.erase(next_read_buf_.begin(), next_read_buf_.begin() + size_read_bytes_out);
+                    return ResponseCode::SUCCESS;
+                }
+            };
+
+            class NetworkReadTester : public ::testing::Test {
+            protected:
+                static const util::String test_topic_;
+                static const util::String test_payload_;
+
+                std::shared_ptr<mqtt::ClientState> p_core_state_;
+                std::shared_ptr<ReadAheadNetworkConnection> p_network_connection_;
+                std::unique_ptr<Action> p_network_read_action_;
+                std::atomic_int callback_count_;
+
+                NetworkReadTester() : callback_count_(0) {
+                    p_core_state_ = mqtt::ClientState::Create(std::chrono::milliseconds(200));
+                    p_network_connection_ = std::make_shared<ReadAheadNetworkConnection>();
+                    p_network_read_action_ = mqtt::NetworkReadActionRunner::Create(p_core_state_);
+                    EXPECT_CALL(*p_network_connection_, IsConnected()).WillRepeatedly(::testing::Return(true));
+
+                    std::atomic_int &callback_count = callback_count_;
+                    mqtt::Subscription::ApplicationCallbackHandlerPtr p_app_handler =
+                        [&callback_count](util::String topic_name, util::String payload,
+                                          std::shared_ptr<mqtt::SubscriptionHandlerContextData> p_app_handler_data) {
+                            EXPECT_EQ(test_topic_, topic_name);
+                            EXPECT_EQ(test_payload_, payload);
+                            callback_count++;
+                            return ResponseCode::SUCCESS;
+                        };
+                    std::shared_ptr<mqtt::Subscription> p_subscription =
+                        mqtt::Subscription::Create(Utf8String::Create(test_topic_), mqtt::QoS::QOS0, p_app_handler,
+                                                   nullptr);
+                    p_core_state_->AddSubscription(p_subscription);
+                    p_subscription->SetActive(true);
+                }
+
+                static util::String GetPublishMessage() {
+                    return TestHelper::GetSerializedPublishMessage(test_topic_, 0, mqtt::QoS::QOS0, false, false,
+                                                                   test_payload_);
+                }
+
+                ResponseCode RunStep(std::chrono::microseconds &next_step_delay) {
+                    return p_network_read_action_->PerformActionStep(p_network_connection_, nullptr, next_step_delay);
+                }
+            };
+
+            const util::String NetworkReadTester::test_topic_ = "testTopic";
+            const util::String NetworkReadTester::test_payload_ = "Hello From C++ SDK Tester";
+
+            // Packets received with one read are all handled by the same step
+            TEST_F(NetworkReadTester, BatchedPacketsHandledWithOneRead) {
+                p_network_read_action_->SetParentThreadSync(std::make_shared<std::atomic_bool>(true));
+                p_core_state_->SetPingreqPending(true);
+                util::String pingresp_message("\xD0\x00", 2);
+                p_network_connection_->SetNextReadBuf(GetPublishMessage() + GetPublishMessage() + GetPublishMessage()
+                                                          + pingresp_message);
+
+                std::chrono::microseconds next_step_delay(-1);
+                EXPECT_EQ(ResponseCode::SUCCESS, RunStep(next_step_delay));
+                EXPECT_EQ(0, next_step_delay.count());
+                EXPECT_EQ(3, callback_count_);
+                EXPECT_FALSE(p_core_state_->IsPingreqPending());
+                EXPECT_EQ(1, p_network_connection_->read_available_count_);
+
+                EXPECT_EQ(0u, p_network_connection_->GetReceiveBuffer().Length());
+            }
+
+            // One time runs handle a single packet, the rest is handled from the buffer by the next run
+            TEST_F(NetworkReadTester, OneTimeRunHandlesOnePacket) {
+                p_network_connection_->SetNextReadBuf(GetPublishMessage() + GetPublishMessage());
+
+                EXPECT_EQ(ResponseCode::SUCCESS, p_network_read_action_->PerformAction(p_network_connection_, nullptr));
+                EXPECT_EQ(1, callback_count_);
+                EXPECT_EQ(ResponseCode::SUCCESS, p_network_read_action_->PerformAction(p_network_connection_, nullptr));
+                EXPECT_EQ(2, callback_count_);
+                EXPECT_EQ(1, p_network_connection_->read_available_count_);
+                // Runs on a dedicated thread may wait for the packet
+                EXPECT_EQ(1, p_network_connection_->waiting_read_count_);
+            }
+
+            // Bytes of an incomplete packet stay buffered until the rest arrives
+            TEST_F(NetworkReadTester, PartialPacketKeptAcrossSteps) {
+                util::String publish_message = GetPublishMessage();
+                size_t split_offset = publish_message.length() / 2;
+                p_network_connection_->SetNextReadBuf(publish_message.substr(0, split_offset));
+
+                std::chrono::microseconds next_step_delay(-1);
+                EXPECT_EQ(ResponseCode::NETWORK_SSL_NOTHING_TO_READ, RunStep(next_step_delay));
+                EXPECT_LT(0, next_step_delay.count());
+                EXPECT_EQ(0, callback_count_);
+
+                p_network_connection_->SetNextReadBuf(publish_message.substr(split_offset));
+                EXPECT_EQ(ResponseCode::SUCCESS, RunStep(next_step_delay));
+                EXPECT_EQ(1, callback_count_);
+                // Steps only take what has arrived, they never wait for the rest of the packet
+                EXPECT_EQ(0, p_network_connection_->waiting_read_count_);
+            }
+
+            // View handlers get views into the receive buffer that stay valid after further reads
+            TEST_F(NetworkReadTester, ViewHandlerRetainsViews) {
+                util::String view_topic = "viewTopic";
+                util::Vector<util::SharedBufferView> retained_topics;
+                util::Vector<util::SharedBufferView> retained_payloads;
+                mqtt::Subscription::ApplicationViewCallbackHandlerPtr p_app_view_handler =
+                    [&retained_topics, &retained_payloads](const util::SharedBufferView &topic_name,
+                                                           const util::SharedBufferView &payload,
+                                                           std::shared_ptr<mqtt::SubscriptionHandlerContextData> p_app_handler_data) {
+                        retained_topics.push_back(topic_name);
+                        retained_payloads.push_back(payload);
+                        return ResponseCode::SUCCESS;
+                    };
+                EXPECT_EQ(nullptr, mqtt::Subscription::CreateWithViewHandler(Utf8String::Create(view_topic),
+                                                                             mqtt::QoS::QOS0, nullptr, nullptr));
+                std::shared_ptr<mqtt::Subscription> p_subscription =
+                    mqtt::Subscription::CreateWithViewHandler(Utf8String::Create(view_topic), mqtt::QoS::QOS0,
+                                                              p_app_view_handler, nullptr);
+                ASSERT_NE(nullptr, p_subscription);
+                p_core_state_->AddSubscription(p_subscription);
+                p_subscription->SetActive(true);
+
+                std::chrono::microseconds next_step_delay(-1);
+                p_network_connection_->SetNextReadBuf(
+                    TestHelper::GetSerializedPublishMessage(view_topic, 0, mqtt::QoS::QOS0, false, false, "first"));
+                EXPECT_EQ(ResponseCode::SUCCESS, RunStep(next_step_delay));
+                p_network_connection_->SetNextReadBuf(
+                    TestHelper::GetSerializedPublishMessage(view_topic, 0, mqtt::QoS::QOS0, false, false, "second"));
+                EXPECT_EQ(ResponseCode::SUCCESS, RunStep(next_step_delay));
+
+                ASSERT_EQ(2u, retained_payloads.size());
+                EXPECT_EQ(view_topic, retained_topics[0].ToString());
+                EXPECT_EQ("first", retained_payloads[0].ToString());
+                EXPECT_EQ(view_topic, retained_topics[1].ToString());
+                EXPECT_EQ("second", retained_payloads[1].ToString());
+                // Payload follows the topic name in the same buffer, nothing was copied
+                EXPECT_EQ(retained_topics[0].Data() + view_topic.length(), retained_payloads[0].Data());
+                EXPECT_NE(retained_payloads[0].Data(), retained_payloads[1].Data());
+                EXPECT_EQ(0, callback_count_);
+            }
+
+            // String and view handlers on overlapping filters both receive the message
+            TEST_F(NetworkReadTester, StringAndViewHandlersOnOverlappingFilters) {
+                std::atomic_int view_callback_count(0);
+                mqtt::Subscription::ApplicationViewCallbackHandlerPtr p_app_view_handler =
+                    [&view_callback_count](const util::SharedBufferView &topic_name,
+                                           const util::SharedBufferView &payload,
+                                           std::shared_ptr<mqtt::SubscriptionHandlerContextData> p_app_handler_data) {
+                        EXPECT_EQ(test_topic_, topic_name.ToString());
+                        EXPECT_EQ(test_payload_, payload.ToString());
+                        view_callback_count++;
+                        return ResponseCode::SUCCESS;
+                    };
+                std::shared_ptr<mqtt::Subscription> p_subscription =
+                    mqtt::Subscription::CreateWithViewHandler(Utf8String::Create("#"), mqtt::QoS::QOS0,
+                                                              p_app_view_handler, nullptr);
+                p_core_state_->AddSubscription(p_subscription);
+                p_subscription->SetActive(true);
+
+                p_network_connection_->SetNextReadBuf(GetPublishMessage());
+                std::chrono::microseconds next_step_delay(-1);
+                EXPECT_EQ(ResponseCode::SUCCESS, RunStep(next_step_delay));
+                EXPECT_EQ(1, callback_count_);
+                EXPECT_EQ(1, view_callback_count);
+            }
+
+            // A handler blocked on the executor holds up neither the read thread nor handlers of other topics
+            TEST_F(NetworkReadTester, BlockedHandlerOnExecutorDoesNotStallReads) {
+                util::Threading::ExecutorConfig config;
+                config.worker_count_ = 2;
+                std::shared_ptr<util::Threading::KeyedExecutor> p_handler_executor =
+                    util::Threading::KeyedExecutor::Create(util::Threading::Executor::Create(config), 2, 4);
+                ASSERT_NE(nullptr, p_handler_executor);
+                p_core_state_->SetSubscriptionHandlerExecutor(p_handler_executor);
+
+                // Topic that is handled by the other shard
+                util::String slow_topic;
+                for (int itr = 0; slow_topic.empty(); itr++) {
+                    util::String topic = "slowTopic" + std::to_string(itr);
+                    if (std::hash<util::String>()(topic) % 2 != std::hash<util::String>()(test_topic_) % 2) {
+                        slow_topic = topic;
+                    }
+                }
+                std::atomic_bool is_released(false);
+                std::atomic_int slow_callback_count(0);
+                mqtt::Subscription::ApplicationCallbackHandlerPtr p_slow_handler =
+                    [&is_released, &slow_callback_count](util::String topic_name, util::String payload,
+                                                         std::shared_ptr<mqtt::SubscriptionHandlerContextData> p_app_handler_data) {
+                        while (!is_released) {
+                            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                        }
+                        EXPECT_EQ("slow", payload);
+                        slow_callback_count++;
+                        return ResponseCode::SUCCESS;
+                    };
+                std::shared_ptr<mqtt::Subscription> p_subscription =
+                    mqtt::Subscription::Create(Utf8String::Create(slow_topic), mqtt::QoS::QOS0, p_slow_handler, nullptr);
+                p_core_state_->AddSubscription(p_subscription);
+                p_subscription->SetActive(true);
+
+                p_network_read_action_->SetParentThreadSync(std::make_shared<std::atomic_bool>(true));
+                p_core_state_->SetPingreqPending(true);
+                util::String pingresp_message("\xD0\x00", 2);
+                p_network_connection_->SetNextReadBuf(
+                    TestHelper::GetSerializedPublishMessage(slow_topic, 0, mqtt::QoS::QOS0, false, false, "slow")
+                        + GetPublishMessage() + pingresp_message);
+
+                std::chrono::microseconds next_step_delay(-1);
+                EXPECT_EQ(ResponseCode::SUCCESS, RunStep(next_step_delay));
+                EXPECT_FALSE(p_core_state_->IsPingreqPending());
+
+                std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now()
+                    + std::chrono::seconds(5);
+                while (1 != callback_count_ && std::chrono::steady_clock::now() < deadline) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                EXPECT_EQ(1, callback_count_);
+                EXPECT_EQ(0, slow_callback_count);
+
+                is_released = true;
+                while (1 != slow_callback_count && std::chrono::steady_clock::now() < deadline) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                EXPECT_EQ(1, slow_callback_count);
+            }
+
+            // Publishes kept back for a full shard hold up neither other topics nor acks, and are handled in order
+            TEST_F(NetworkReadTester, FullShardDoesNotDelayOtherTopicsOrAcks) {
+                util::Threading::ExecutorConfig config;
+                config.worker_count_ = 2;
+                std::shared_ptr<util::Threading::KeyedExecutor> p_handler_executor =
+                    util::Threading::KeyedExecutor::Create(util::Threading::Executor::Create(config), 2, 3);
+                ASSERT_NE(nullptr, p_handler_executor);
+                p_core_state_->SetSubscriptionHandlerExecutor(p_handler_executor);
+
+                util::String slow_topic;
+                for (int itr = 0; slow_topic.empty(); itr++) {
+                    util::String topic = "slowTopic" + std::to_string(itr);
+                    if (p_handler_executor->GetShardIndex(topic) != p_handler_executor->GetShardIndex(test_topic_)) {
+                        slow_topic = topic;
+                    }
+                }
+                std::atomic_bool is_released(false);
+                std::atomic_int slow_callback_count(0);
+                mqtt::Subscription::ApplicationCallbackHandlerPtr p_slow_handler =
+                    [&is_released, &slow_callback_count](util::String topic_name, util::String payload,
+                                                         std::shared_ptr<mqtt::SubscriptionHandlerContextData> p_app_handler_data) {
+                        while (!is_released) {
+                            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                        }
+                        EXPECT_EQ("slow" + std::to_string(slow_callback_count), payload);
+                        slow_callback_count++;
+                        return ResponseCode::SUCCESS;
+                    };
+                std::shared_ptr<mqtt::Subscription> p_subscription =
+                    mqtt::Subscription::Create(Utf8String::Create(slow_topic), mqtt::QoS::QOS0, p_slow_handler, nullptr);
+                p_core_state_->AddSubscription(p_subscription);
+                p_subscription->SetActive(true);
+
+                std::atomic_int ack_count(0);
+                ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler =
+                    [&ack_count](uint16_t action_id, ResponseCode rc) {
+                        EXPECT_EQ(5, action_id);
+                        ack_count++;
+                    };
+                EXPECT_EQ(ResponseCode::SUCCESS, p_core_state_->RegisterPendingAck(5, p_async_ack_handler));
+
+                // More slow messages than the shard can queue, the rest is kept back
+                const int slow_message_count = 5;
+                util::String messages;
+                for (int itr = 0; itr < slow_message_count; itr++) {
+                    messages += TestHelper::GetSerializedPublishMessage(slow_topic, 0, mqtt::QoS::QOS0, false, false,
+                                                                        "slow" + std::to_string(itr));
+                }
+                util::String pingresp_message("\xD0\x00", 2);
+                messages += GetPublishMessage() + TestHelper::GetSerializedPubAckMessage(5) + pingresp_message;
+                p_network_read_action_->SetParentThreadSync(std::make_shared<std::atomic_bool>(true));
+                p_core_state_->SetPingreqPending(true);
+                p_network_connection_->SetNextReadBuf(messages);
+
+                std::chrono::microseconds next_step_delay(-1);
+                EXPECT_EQ(ResponseCode::SUCCESS, RunStep(next_step_delay));
+                EXPECT_TRUE(p_network_read_action_->IsStepPending());
+                EXPECT_EQ(1, ack_count);
+                EXPECT_FALSE(p_core_state_->IsPingreqPending());
+                EXPECT_EQ(0u, p_network_connection_->GetReceiveBuffer().Length());
+
+                std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now()
+                    + std::chrono::seconds(5);
+                while (1 != callback_count_ && std::chrono::steady_clock::now() < deadline) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                EXPECT_EQ(1, callback_count_);
+                EXPECT_EQ(0, slow_callback_count);
+
+                // Kept back Publishes are submitted by later steps once the shard has room
+                is_released = true;
+                while (slow_message_count != slow_callback_count && std::chrono::steady_clock::now() < deadline) {
+                    RunStep(next_step_delay);
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                EXPECT_EQ(slow_message_count, slow_callback_count);
+                EXPECT_FALSE(p_network_read_action_->IsStepPending());
+            }
+
+            // Reading pauses while the inbound limit is reached and resumes once handlers have returned
+            TEST_F(NetworkReadTester, InboundLimitPausesReads) {
+                util::Threading::ExecutorConfig config;
+                config.worker_count_ = 1;
+                p_core_state_->SetSubscriptionHandlerExecutor(
+                    util::Threading::KeyedExecutor::Create(util::Threading::Executor::Create(config), 1, 4));
+                p_core_state_->SetInboundLimit(1, 0);
+
+                std::atomic_bool is_released(false);
+                mqtt::Subscription::ApplicationViewCallbackHandlerPtr p_blocking_handler =
+                    [&is_released](const util::SharedBufferView &topic_name, const util::SharedBufferView &payload,
+                                   std::shared_ptr<mqtt::SubscriptionHandlerContextData> p_app_handler_data) {
+                        while (!is_released) {
+                            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                        }
+                        return ResponseCode::SUCCESS;
+                    };
+                std::shared_ptr<mqtt::Subscription> p_subscription =
+                    mqtt::Subscription::CreateWithViewHandler(Utf8String::Create("#"), mqtt::QoS::QOS0,
+                                                              p_blocking_handler, nullptr);
+                p_core_state_->AddSubscription(p_subscription);
+                p_subscription->SetActive(true);
+
+                util::String publish_message = GetPublishMessage();
+                std::chrono::microseconds next_step_delay(-1);
+                p_network_connection_->SetNextReadBuf(publish_message);
+                EXPECT_EQ(ResponseCode::SUCCESS, RunStep(next_step_delay));
+                EXPECT_EQ(1u, p_core_state_->GetInboundMessageCount());
+                EXPECT_EQ(publish_message.length() - 2, p_core_state_->GetInboundBytes());
+                EXPECT_TRUE(p_core_state_->IsInboundLimitReached());
+
+                p_network_connection_->SetNextReadBuf(publish_message);
+                EXPECT_EQ(ResponseCode::NETWORK_SSL_NOTHING_TO_READ, RunStep(next_step_delay));
+                EXPECT_EQ(std::chrono::microseconds(std::chrono::milliseconds(DEFAULT_INBOUND_PAUSE_DURATION_MS)),
+                          next_step_delay);
+                EXPECT_EQ(1, p_network_connection_->read_available_count_);
+                EXPECT_TRUE(p_core_state_->IsInboundPaused());
+
+                is_released = true;
+                std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now()
+                    + std::chrono::seconds(5);
+                while (0 != p_core_state_->GetInboundMessageCount() && std::chrono::steady_clock::now() < deadline) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                EXPECT_EQ(0u, p_core_state_->GetInboundBytes());
+                EXPECT_EQ(ResponseCode::SUCCESS, RunStep(next_step_delay));
+                EXPECT_EQ(2, p_network_connection_->read_available_count_);
+                EXPECT_FALSE(p_core_state_->IsInboundPaused());
+                while (2 != callback_count_ && std::chrono::steady_clock::now() < deadline) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                EXPECT_EQ(2, callback_count_);
+            }
+
+            // Handlers on the Executor the read runner shares with its Client Core. A full shard pauses reading instead
+            // of blocking the only worker, which the shard needs to make room
+            TEST_F(NetworkReadTester, HandlerExecutorSharedWithClientCore) {
+                util::Threading::ExecutorConfig config;
+                config.worker_count_ = 1;
+                std::shared_ptr<util::Threading::Executor> p_executor = util::Threading::Executor::Create(config);
+                ASSERT_NE(nullptr, p_executor);
+                p_core_state_->SetSubscriptionHandlerExecutor(util::Threading::KeyedExecutor::Create(p_executor, 1, 1));
+
+                const int message_count = 50;
+                util::String publish_messages;
+                for (int itr = 0; itr < message_count; itr++) {
+                    publish_messages += GetPublishMessage();
+                }
+                p_network_connection_->SetNextReadBuf(publish_messages);
+
+                std::unique_ptr<ClientCore> p_client_core = ClientCore::Create(p_network_connection_, p_core_state_,
+                                                                               p_executor);
+                ASSERT_NE(nullptr, p_client_core);
+                p_client_core->RegisterAction(ActionType::READ_INCOMING, mqtt::NetworkReadActionRunner::Create);
+                EXPECT_EQ(ResponseCode::SUCCESS, p_client_core->CreateActionRunner(ActionType::READ_INCOMING, nullptr));
+
+                std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now()
+                    + std::chrono::seconds(5);
+                while (message_count != callback_count_ && std::chrono::steady_clock::now() < deadline) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                EXPECT_EQ(message_count, callback_count_);
+                p_client_core.reset();
+                p_core_state_->ClearRegisteredActions();
+                EXPECT_EQ(0u, p_core_state_->GetInboundMessageCount());
+            }
+
+            // Subscriptions added and removed by another thread while messages arrive at 10k per second neither
+            // block nor drop messages for the Subscriptions that stay
+            TEST_F(NetworkReadTester, SubscriptionChurnDuringInboundMessages) {
+                std::atomic_bool is_churn_stopped(false);
+                std::atomic_int churn_count(0);
+                std::shared_ptr<mqtt::ClientState> p_core_state = p_core_state_;
+                std::thread churn_thread([p_core_state, &is_churn_stopped, &churn_count]() {
+                    mqtt::Subscription::ApplicationCallbackHandlerPtr p_app_handler =
+                        [](util::String topic_name, util::String payload,
+                           std::shared_ptr<mqtt::SubscriptionHandlerContextData> p_app_handler_data) {
+                            return ResponseCode::SUCCESS;
+                        };
+                    while (!is_churn_stopped) {
+                        int itr = churn_count++;
+                        util::String topic_filter = (0 == itr % 2) ? "churn/" + std::to_string(itr % 64) + "/#"
+                                                                   : "+/churn/" + std::to_string(itr % 64);
+                        std::shared_ptr<mqtt::Subscription> p_subscription =
+                            mqtt::Subscription::Create(Utf8String::Create(topic_filter), mqtt::QoS::QOS0,
+                                                       p_app_handler, nullptr);
+                        p_subscription->SetActive(true);
+                        EXPECT_EQ(ResponseCode::SUCCESS, p_core_state->AddSubscription(p_subscription));
+                        if (0 == itr % 3) {
+                            EXPECT_EQ(ResponseCode::SUCCESS, p_core_state->RemoveSubscription(topic_filter));
+                        }
+                    }
+                });
+
+                p_network_read_action_->SetParentThreadSync(std::make_shared<std::atomic_bool>(true));
+                // 10 messages every millisecond for one second
+                util::String publish_messages;
+                for (int itr = 0; itr < 10; itr++) {
+                    publish_messages += GetPublishMessage();
+                }
+                std::chrono::microseconds next_step_delay(-1);
+                std::chrono::steady_clock::time_point next_batch = std::chrono::steady_clock::now();
+                for (int itr = 0; itr < 1000; itr++) {
+                    std::this_thread::sleep_until(next_batch);
+                    next_batch += std::chrono::milliseconds(1);
+                    p_network_connection_->SetNextReadBuf(publish_messages);
+                    EXPECT_EQ(ResponseCode::SUCCESS, RunStep(next_step_delay));
+                }
+                is_churn_stopped = true;
+                churn_thread.join();
+
+                EXPECT_EQ(10000, callback_count_);
+                EXPECT_LT(0, churn_count);
+                EXPECT_NE(nullptr, p_core_state_->GetSubscription(test_topic_));
+            }
+
+            // Remaining length longer than four bytes is rejected
+            TEST_F(NetworkReadTester, InvalidRemainingLength) {
+                util::String invalid_packet("\x30\xFF\xFF\xFF\xFF\x01", 6);
+                p_network_connection_->SetNextReadBuf(invalid_packet);
+
+                std::chrono::microseconds next_step_delay(-1);
+                EXPECT_EQ(ResponseCode::MQTT_DECODE_REMAINING_LENGTH_ERROR, RunStep(next_step_delay));
+                EXPECT_EQ(0, callback_count_);
+            }
+        }
+    }
+}
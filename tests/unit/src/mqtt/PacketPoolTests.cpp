@@ -0,0 +1,237 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PacketPoolTests.cpp
+ * @brief
+ *
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <new>
+
+#include <gtest/gtest.h>
+
+#include "mqtt/ClientState.hpp"
+#include "mqtt/Publish.hpp"
+
+#define PACKET_POOL_TEST_WARMUP_PUBLISH_COUNT 8
+#define PACKET_POOL_TEST_MEASURED_PUBLISH_COUNT 256
+#define PACKET_POOL_TEST_PAYLOAD_SIZE 512
+
+namespace {
+    // Heap allocations are only counted while enabled, by any thread
+    std::atomic_bool is_allocation_counting_enabled(false);
+    std::atomic<size_t> allocation_count(0);
+}
+
+void *operator new(size_t size) {
+    if (is_allocation_counting_enabled) {
+        allocation_count++;
+    }
+    void *p_memory = malloc(0 == size ? 1 : size);
+    if (nullptr == p_memory) {
+        abort();
+    }
+    return p_memory;
+}
+
+void operator delete(void *p_memory) noexcept {
+    free(p_memory);
+}
+
+namespace awsiotsdk {
+    namespace tests {
+        namespace unit {
+            // Connection that accepts every write at once
+            class AcceptAllNetworkConnection : public NetworkConnection {
+            public:
+                size_t write_count_;
+                size_t written_bytes_;
+
+                AcceptAllNetworkConnection() : write_count_(0), written_bytes_(0) {}
+
+                bool IsConnected() { return true; }
+                bool IsPhysicalLayerConnected() { return true; }
+
+            protected:
+                ResponseCode ConnectInternal() { return ResponseCode::SUCCESS; }
+                ResponseCode DisconnectInternal() { return ResponseCode::SUCCESS; }
+
+                ResponseCode WriteInternal(const util::String &buf, size_t &size_written_bytes_out) {
+                    write_count_++;
+                    written_bytes_ += buf.length();
+                    size_written_bytes_out = buf.length();
+                    return ResponseCode::SUCCESS;
+                }
+
+                ResponseCode ReadInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+                                          size_t size_bytes_to_read, size_t &size_read_bytes_out) {
+                    IOT_UNUSED(buf);
+                    IOT_UNUSED(buf_read_offset);
+                    IOT_UNUSED(size_bytes_to_read);
+                    size_read_bytes_out = 0;
+                    return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+                }
+            };
+
+            class PacketPoolTester : public ::testing::Test {
+            protected:
+                static const util::String test_topic_;
+
+                std::shared_ptr<mqtt::ClientState> p_client_state_;
+                std::shared_ptr<AcceptAllNetworkConnection> p_network_connection_;
+
+                PacketPoolTester() {
+                    p_client_state_ = mqtt::ClientState::Create(std::chrono::milliseconds(200));
+                    p_network_connection_ = std::make_shared<AcceptAllNetworkConnection>();
+                }
+
+                std::shared_ptr<mqtt::PublishPacket> AcquirePublishPacket(mqtt::QoS qos, const util::String &payload) {
+                    return p_client_state_->AcquirePublishPacket(Utf8String::Create(test_topic_), false, false, qos,
+                                                                 payload);
+                }
+
+                /**
+                 * @brief Queue and send QoS0 Publishes through PublishActionAsync
+                 *
+                 * @param acquire_publish_packet - Returns the packet for the next Publish
+                 * @return size_t - Heap allocations made by the Publishes after the warmup
+                 */
+                size_t CountQoS0PublishAllocations(std::function<std::shared_ptr<mqtt::PublishPacket>()>
+                                                   acquire_publish_packet) {
+                    p_client_state_->p_network_connection_ = p_network_connection_;
+                    p_client_state_->SetOutboundActionRateLimit(1000000, PACKET_POOL_TEST_MEASURED_PUBLISH_COUNT);
+                    EXPECT_EQ(ResponseCode::SUCCESS,
+                              p_client_state_->RegisterAction(ActionType::PUBLISH, mqtt::PublishActionAsync::Create,
+                                                              p_client_state_));
+                    p_client_state_->SetProcessQueuedActions(true);
+
+                    size_t publish_count = PACKET_POOL_TEST_WARMUP_PUBLISH_COUNT;
+                    for (int pass = 0; pass < 2; pass++) {
+                        allocation_count = 0;
+                        is_allocation_counting_enabled = (1 == pass);
+                        for (size_t itr = 0; itr < publish_count; itr++) {
+                            std::shared_ptr<mqtt::PublishPacket> p_publish = acquire_publish_packet();
+                            uint16_t action_id = 0;
+                            ResponseCode rc = p_client_state_->EnqueueOutboundAction(ActionType::PUBLISH, p_publish,
+                                                                                     action_id);
+                            p_publish.reset();
+                            size_t write_count = p_network_connection_->write_count_;
+                            while (ResponseCode::SUCCESS == rc && write_count == p_network_connection_->write_count_) {
+                                p_client_state_->RunOutboundActionQueueStep();
+                            }
+                            if (ResponseCode::SUCCESS != rc) {
+                                is_allocation_counting_enabled = false;
+                                ADD_FAILURE() << ResponseHelper::ToString(rc);
+                                return allocation_count;
+                            }
+                        }
+                        is_allocation_counting_enabled = false;
+                        publish_count = PACKET_POOL_TEST_MEASURED_PUBLISH_COUNT;
+                    }
+
+                    EXPECT_EQ((size_t) (PACKET_POOL_TEST_WARMUP_PUBLISH_COUNT
+                                  + PACKET_POOL_TEST_MEASURED_PUBLISH_COUNT),
+                              p_network_connection_->write_count_);
+                    EXPECT_GT(p_network_connection_->written_bytes_,
+                              p_network_connection_->write_count_ * PACKET_POOL_TEST_PAYLOAD_SIZE);
+                    return allocation_count;
+                }
+            };
+
+            const util::String PacketPoolTester::test_topic_ = "sdk/test/pool";
+
+            // Packets are reused once released, packets still referenced anywhere are not handed out again
+            TEST_F(PacketPoolTester, ReleasedPacketsAreReused) {
+                std::shared_ptr<mqtt::PublishPacket> p_first = AcquirePublishPacket(mqtt::QoS::QOS1, "first");
+                std::shared_ptr<mqtt::PublishPacket> p_second = AcquirePublishPacket(mqtt::QoS::QOS1, "second");
+                ASSERT_NE(nullptr, p_first);
+                ASSERT_NE(nullptr, p_second);
+                EXPECT_NE(p_first.get(), p_second.get());
+                EXPECT_EQ(nullptr, p_client_state_->AcquirePublishPacket(std::unique_ptr<Utf8String>(), false, false,
+                                                                         mqtt::QoS::QOS0, ""));
+
+                mqtt::PublishPacket *p_released = p_first.get();
+                p_first.reset();
+                std::shared_ptr<mqtt::PublishPacket> p_reused = AcquirePublishPacket(mqtt::QoS::QOS0, "third");
+                EXPECT_EQ(p_released, p_reused.get());
+                EXPECT_EQ("third", p_reused->GetPayload());
+
+                std::shared_ptr<mqtt::PubackPacket> p_puback = p_client_state_->AcquirePubackPacket(5);
+                mqtt::PubackPacket *p_released_puback = p_puback.get();
+                p_puback.reset();
+                p_puback = p_client_state_->AcquirePubackPacket(6);
+                EXPECT_EQ(p_released_puback, p_puback.get());
+                EXPECT_EQ(6, p_puback->GetPublishPacketId());
+            }
+
+            // A reused packet carries nothing over from its previous message
+            TEST_F(PacketPoolTester, ReusedPacketIsReset) {
+                std::shared_ptr<mqtt::PublishPacket> p_publish = AcquirePublishPacket(mqtt::QoS::QOS1, "previous");
+                p_publish->SetPacketId(7);
+                p_publish->p_async_ack_handler_ = [](uint16_t action_id, ResponseCode rc) {
+                    IOT_UNUSED(action_id);
+                    IOT_UNUSED(rc);
+                };
+                p_publish->p_completion_token_ = CompletionToken::Create();
+                p_publish.reset();
+
+                p_publish = AcquirePublishPacket(mqtt::QoS::QOS0, "");
+                EXPECT_EQ(0, p_publish->GetPacketId());
+                EXPECT_FALSE(p_publish->HasAckListener());
+                EXPECT_EQ(mqtt::QoS::QOS0, p_publish->GetQoS());
+                EXPECT_EQ(0u, p_publish->GetPayloadLen());
+
+                std::shared_ptr<mqtt::PublishPacket> p_fresh =
+                    std::make_shared<mqtt::PublishPacket>(Utf8String::Create(test_topic_), false, false,
+                                                          mqtt::QoS::QOS0, "");
+                EXPECT_EQ(p_fresh->ToString(), p_publish->ToString());
+            }
+
+            // Once warmed up, queueing and sending a QoS0 Publish does not allocate. The topic name is allocated by
+            // the caller before the measurement, like applications publishing to prepared topics would
+            TEST_F(PacketPoolTester, SteadyStateQoS0PublishDoesNotAllocate) {
+                util::Vector<std::unique_ptr<Utf8String>> topics;
+                for (int itr = 0; itr < PACKET_POOL_TEST_WARMUP_PUBLISH_COUNT + PACKET_POOL_TEST_MEASURED_PUBLISH_COUNT;
+                     itr++) {
+                    topics.push_back(Utf8String::Create(test_topic_));
+                }
+
+                const util::String payload(PACKET_POOL_TEST_PAYLOAD_SIZE, 'x');
+                size_t topic_index = 0;
+                EXPECT_EQ(0u, CountQoS0PublishAllocations([&]() {
+                    return p_client_state_->AcquirePublishPacket(std::move(topics[topic_index++]), false, false,
+                                                                 mqtt::QoS::QOS0, payload);
+                }));
+            }
+
+            // Publishing by topic handle needs no per message topic name either
+            TEST_F(PacketPoolTester, SteadyStateQoS0PublishByHandleDoesNotAllocate) {
+                std::shared_ptr<const mqtt::TopicHandle> p_topic_handle =
+                    p_client_state_->InternTopic("sdk/test/pool/topic/long/enough/to/be/allocated");
+                ASSERT_NE(nullptr, p_topic_handle);
+
+                const util::String payload(PACKET_POOL_TEST_PAYLOAD_SIZE, 'x');
+                EXPECT_EQ(0u, CountQoS0PublishAllocations([&]() {
+                    return p_client_state_->AcquirePublishPacket(p_topic_handle, false, false, mqtt::QoS::QOS0,
+                                                                 payload);
+                }));
+            }
+        }
+    }
+}
@@ -19,6 +19,10 @@
  *
  */
 
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include "MockNetworkConnection.hpp"
@@ -36,6 +40,8 @@
 #define PUBLISH_QOS1_FIXED_HEADER_DUP_TRUE_RETAINED_FALSE_VAL 0x3A
 #define PUBLISH_QOS1_FIXED_HEADER_DUP_TRUE_RETAINED_TRUE_VAL 0x3B
 
+#define CONCURRENT_SYNC_PUBLISH_THREAD_COUNT 16
+
 namespace awsiotsdk {
     namespace tests {
         namespace unit {
@@ -372,6 +378,223 @@ namespace awsiotsdk {
                 EXPECT_TRUE(p_network_connection_->was_read_called_);
                 EXPECT_TRUE(callback_received_);
             }
+
+            // Segments of a Publish packet form the same bytes as ToString, with the payload in its own segment
+            TEST_F(PublishActionTester, PublishSegmentsMatchSerializedPacket) {
+                std::shared_ptr<mqtt::PublishPacket> p_publish_packet = mqtt::PublishPacket::Create(
+                    Utf8String::Create(test_topic_), false, false, mqtt::QoS::QOS1, test_payload_);
+                p_publish_packet->SetPacketId(test_packet_id_);
+
+                util::String header_buf;
+                util::Vector<WriteSegment> segments;
+                p_publish_packet->ToSegments(header_buf, segments);
+                ASSERT_EQ(2u, segments.size());
+                EXPECT_EQ(header_buf.data(), segments[0].p_data_);
+                EXPECT_EQ(test_payload_.length(), segments[1].length_);
+
+                util::String joined_segments;
+                for (const WriteSegment &segment : segments) {
+                    joined_segments.append(segment.p_data_, segment.length_);
+                }
+                EXPECT_EQ(p_publish_packet->ToString(), joined_segments);
+            }
+
+            // Moved in payloads are written from the caller's buffer, without copying it
+            TEST_F(PublishActionTester, PublishMovedPayloadNotCopied) {
+                util::String payload(1024, 'm');
+                const char *p_payload_data = payload.data();
+                std::shared_ptr<mqtt::PublishPacket> p_publish_packet = std::make_shared<mqtt::PublishPacket>(
+                    Utf8String::Create(test_topic_), false, false, mqtt::QoS::QOS0, std::move(payload));
+
+                util::String header_buf;
+                util::Vector<WriteSegment> segments;
+                p_publish_packet->ToSegments(header_buf, segments);
+                ASSERT_EQ(2u, segments.size());
+                EXPECT_EQ(p_payload_data, segments[1].p_data_);
+                EXPECT_EQ(1024u, p_publish_packet->GetPayloadLen());
+            }
+
+            // A shared payload is referenced by every packet it is published with and released when they are reused
+            TEST_F(PublishActionTester, PublishSharedPayload) {
+                std::shared_ptr<const util::Vector<unsigned char>> p_payload_buffer =
+                    std::make_shared<const util::Vector<unsigned char>>(test_payload_.begin(), test_payload_.end());
+                util::SharedBufferView payload(p_payload_buffer, 0, p_payload_buffer->size());
+                std::shared_ptr<mqtt::PublishPacket> p_first_packet =
+                    p_core_state_->AcquirePublishPacket(Utf8String::Create("first/topic"), false, false,
+                                                        mqtt::QoS::QOS0, payload);
+                std::shared_ptr<mqtt::PublishPacket> p_second_packet =
+                    p_core_state_->AcquirePublishPacket(Utf8String::Create("second/topic"), false, false,
+                                                        mqtt::QoS::QOS0, payload);
+
+                util::String header_buf;
+                util::Vector<WriteSegment> segments;
+                p_second_packet->ToSegments(header_buf, segments);
+                ASSERT_EQ(2u, segments.size());
+                EXPECT_EQ(reinterpret_cast<const char *>(payload.Data()), segments[1].p_data_);
+                EXPECT_EQ(test_payload_, p_first_packet->GetPayload());
+
+                std::shared_ptr<mqtt::PublishPacket> p_copied_packet = mqtt::PublishPacket::Create(
+                    Utf8String::Create("first/topic"), false, false, mqtt::QoS::QOS0, test_payload_);
+                EXPECT_EQ(p_copied_packet->ToString(), p_first_packet->ToString());
+
+                // Reusing the packets for other payloads drops their references to the shared payload
+                EXPECT_EQ(4, p_payload_buffer.use_count());
+                p_first_packet.reset();
+                p_second_packet.reset();
+                p_first_packet = p_core_state_->AcquirePublishPacket(Utf8String::Create(test_topic_), false, false,
+                                                                     mqtt::QoS::QOS0, test_payload_);
+                p_second_packet = p_core_state_->AcquirePublishPacket(Utf8String::Create(test_topic_), false, false,
+                                                                      mqtt::QoS::QOS0, util::String("moved"));
+                EXPECT_EQ(test_payload_, p_first_packet->GetPayload());
+                EXPECT_EQ("moved", p_second_packet->GetPayload());
+                EXPECT_EQ(2, p_payload_buffer.use_count());
+            }
+
+            // Requests copy, take over or share their payload depending on the SetPayload overload used
+            TEST_F(PublishActionTester, PublishRequestPayloads) {
+                mqtt::PublishRequest copy_request(Utf8String::Create(test_topic_), mqtt::QoS::QOS1);
+                copy_request.is_retained_ = true;
+                {
+                    // The request keeps its own copy of the payload
+                    util::String copied_payload = test_payload_;
+                    copy_request.SetPayload(copied_payload);
+                    copied_payload.assign(test_payload_.length(), 'x');
+                }
+                EXPECT_EQ(ActionPriority::HIGH, copy_request.priority_);
+                std::shared_ptr<mqtt::PublishPacket> p_copied_packet =
+                    p_core_state_->AcquirePublishPacket(copy_request);
+                ASSERT_NE(nullptr, p_copied_packet);
+                EXPECT_EQ(test_topic_, p_copied_packet->GetTopicName());
+                EXPECT_EQ(test_payload_, p_copied_packet->GetPayload());
+                EXPECT_EQ(mqtt::QoS::QOS1, p_copied_packet->GetQoS());
+                EXPECT_TRUE(p_copied_packet->IsRetained());
+
+                util::String payload(1024, 'm');
+                const char *p_payload_data = payload.data();
+                mqtt::PublishRequest move_request(p_core_state_->InternTopic(test_topic_), mqtt::QoS::QOS0);
+                move_request.SetPayload(std::move(payload));
+                EXPECT_EQ(ActionPriority::LOW, move_request.priority_);
+                std::shared_ptr<mqtt::PublishPacket> p_moved_packet = p_core_state_->AcquirePublishPacket(move_request);
+                ASSERT_NE(nullptr, p_moved_packet);
+                EXPECT_EQ(test_topic_, p_moved_packet->GetTopicName());
+                util::String header_buf;
+                util::Vector<WriteSegment> segments;
+                p_moved_packet->ToSegments(header_buf, segments);
+                ASSERT_EQ(2u, segments.size());
+                EXPECT_EQ(p_payload_data, segments[1].p_data_);
+
+                std::shared_ptr<const util::Vector<unsigned char>> p_payload_buffer =
+                    std::make_shared<const util::Vector<unsigned char>>(test_payload_.begin(), test_payload_.end());
+                util::SharedBufferView shared_payload(p_payload_buffer, 0, p_payload_buffer->size());
+                mqtt::PublishRequest share_request(Utf8String::Create(test_topic_), mqtt::QoS::QOS0);
+                share_request.SetPayload(shared_payload);
+                std::shared_ptr<mqtt::PublishPacket> p_shared_packet =
+                    p_core_state_->AcquirePublishPacket(share_request);
+                ASSERT_NE(nullptr, p_shared_packet);
+                segments.clear();
+                header_buf.clear();
+                p_shared_packet->ToSegments(header_buf, segments);
+                ASSERT_EQ(2u, segments.size());
+                EXPECT_EQ(reinterpret_cast<const char *>(shared_payload.Data()), segments[1].p_data_);
+
+                // Requests without a topic are rejected
+                mqtt::PublishRequest invalid_request(std::unique_ptr<Utf8String>(), mqtt::QoS::QOS0);
+                EXPECT_EQ(nullptr, p_core_state_->AcquirePublishPacket(invalid_request));
+            }
+
+            // Partial writes continue with the remaining bytes of the packet
+            TEST_F(PublishActionTester, PublishPartialWritesContinue) {
+                std::unique_ptr<Action> p_publish_action = mqtt::PublishActionAsync::Create(p_core_state_);
+                p_publish_action->SetParentThreadSync(std::make_shared<std::atomic_bool>(true));
+                std::shared_ptr<mqtt::PublishPacket> p_publish_packet = mqtt::PublishPacket::Create(
+                    Utf8String::Create(test_topic_), false, false, mqtt::QoS::QOS0, test_payload_);
+
+                // Accept at most 16 bytes per write so the packet takes several writes
+                util::String written_bytes;
+                EXPECT_CALL(*p_network_mock_, WriteInternalProxy(::testing::_, ::testing::_)).WillRepeatedly(
+                    ::testing::Invoke([&written_bytes](const util::String &buf,
+                                                       size_t &size_written_bytes_out) -> ResponseCode {
+                        size_written_bytes_out = std::min(buf.length(), (size_t) 16);
+                        written_bytes.append(buf, 0, size_written_bytes_out);
+                        return ResponseCode::SUCCESS;
+                    }));
+                EXPECT_EQ(ResponseCode::SUCCESS, p_publish_action->PerformAction(p_network_connection_,
+                                                                                 p_publish_packet));
+                EXPECT_EQ(p_publish_packet->ToString(), written_bytes);
+            }
+
+            // Sync publishes from many threads wait for their Pubacks concurrently instead of one round trip at a time
+            TEST_F(PublishActionTester, ConcurrentSyncPublishesInFlight) {
+                p_core_state_->p_network_connection_ = p_network_connection_;
+                ResponseCode rc = p_core_state_->RegisterAction(ActionType::PUBLISH, mqtt::PublishActionAsync::Create,
+                                                                p_core_state_);
+                EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+                std::mutex written_lock;
+                util::Vector<uint16_t> written_packet_ids;
+                EXPECT_CALL(*p_network_mock_, WriteInternalProxy(::testing::_, ::testing::_)).WillRepeatedly(
+                    ::testing::Invoke([&](const util::String &buf, size_t &size_written_bytes_out) -> ResponseCode {
+                        unsigned char *p_buf = (unsigned char *) buf.c_str();
+                        p_buf++;
+                        TestHelper::ParseRemLenFromBuffer(&p_buf);
+                        TestHelper::ReadUtf8StringFromBuffer(&p_buf);
+                        uint16_t packet_id = TestHelper::ReadUint16FromBuffer(&p_buf);
+                        {
+                            std::lock_guard<std::mutex> written_guard(written_lock);
+                            written_packet_ids.push_back(packet_id);
+                        }
+                        size_written_bytes_out = buf.length();
+                        return ResponseCode::SUCCESS;
+                    }));
+
+                util::Vector<ResponseCode> publish_results(CONCURRENT_SYNC_PUBLISH_THREAD_COUNT,
+                                                           ResponseCode::FAILURE);
+                util::Vector<std::thread> publishers;
+                for (size_t itr = 0; itr < CONCURRENT_SYNC_PUBLISH_THREAD_COUNT; itr++) {
+                    publishers.push_back(std::thread([this, itr, &publish_results]() {
+                        std::shared_ptr<mqtt::PublishPacket> p_publish_packet = mqtt::PublishPacket::Create(
+                            Utf8String::Create(test_topic_), false, false, mqtt::QoS::QOS1, test_payload_);
+                        publish_results[itr] = p_core_state_->PerformAction(ActionType::PUBLISH, p_publish_packet,
+                                                                            std::chrono::milliseconds(5000));
+                    }));
+                }
+
+                // No Puback is sent until every Publish is written, so all of them have to be waiting at once
+                size_t written_count = 0;
+                std::chrono::steady_clock::time_point deadline =
+                    std::chrono::steady_clock::now() + std::chrono::milliseconds(5000);
+                while (std::chrono::steady_clock::now() < deadline) {
+                    {
+                        std::lock_guard<std::mutex> written_guard(written_lock);
+                        written_count = written_packet_ids.size();
+                    }
+                    if (CONCURRENT_SYNC_PUBLISH_THREAD_COUNT == written_count
+                        && CONCURRENT_SYNC_PUBLISH_THREAD_COUNT == p_core_state_->GetPendingAckCount()) {
+                        break;
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                EXPECT_EQ((size_t) CONCURRENT_SYNC_PUBLISH_THREAD_COUNT, written_count);
+                EXPECT_EQ((size_t) CONCURRENT_SYNC_PUBLISH_THREAD_COUNT, p_core_state_->GetPendingAckCount());
+
+                util::Vector<uint16_t> acked_packet_ids;
+                {
+                    std::lock_guard<std::mutex> written_guard(written_lock);
+                    acked_packet_ids = written_packet_ids;
+                }
+                for (uint16_t packet_id : acked_packet_ids) {
+                    p_core_state_->ForwardReceivedAck(packet_id, ResponseCode::SUCCESS);
+                }
+                for (auto &publisher : publishers) {
+                    publisher.join();
+                }
+                for (ResponseCode publish_rc : publish_results) {
+                    EXPECT_EQ(ResponseCode::SUCCESS, publish_rc);
+                }
+                EXPECT_EQ(0u, p_core_state_->GetPendingAckCount());
+
+                p_core_state_->ClearRegisteredActions();
+            }
         }
     }
-}
\ No newline at end of file
+}
@@ -20,6 +20,7 @@
  */
 
 #include <atomic>
+#include <thread>
 #include <gtest/gtest.h>
 
 #include "MockNetworkConnection.hpp"
@@ -448,6 +449,80 @@ namespace awsiotsdk {
                 EXPECT_TRUE(callback_received_);
             }
 
+            TEST_F(SubUnsubActionTester, IncomingPublishOnOverlappingSubscriptionsTest) {
+                ASSERT_NE(nullptr, p_network_connection_);
+                ASSERT_NE(nullptr, p_core_state_);
+                ASSERT_NE(nullptr, p_subscribe_action_);
+
+                p_network_connection_->ClearNextReadBuf();
+                p_network_connection_->last_write_buf_.clear();
+                p_network_connection_->was_write_called_ = false;
+
+                std::unique_ptr<Action> p_network_read_action = mqtt::NetworkReadActionRunner::Create(p_core_state_);
+
+                std::atomic_int exact_callback_count(0);
+                std::atomic_int wildcard_callback_count(0);
+                mqtt::Subscription::ApplicationCallbackHandlerPtr p_exact_handler =
+                    [&exact_callback_count](util::String topic_name, util::String payload,
+                                            std::shared_ptr<mqtt::SubscriptionHandlerContextData> p_app_handler_data) {
+                        exact_callback_count++;
+                        return ResponseCode::SUCCESS;
+                    };
+                mqtt::Subscription::ApplicationCallbackHandlerPtr p_wildcard_handler =
+                    [&wildcard_callback_count](util::String topic_name, util::String payload,
+                                               std::shared_ptr<mqtt::SubscriptionHandlerContextData> p_app_handler_data) {
+                        wildcard_callback_count++;
+                        return ResponseCode::SUCCESS;
+                    };
+
+                util::Vector<std::shared_ptr<mqtt::Subscription>> topic_vector;
+                topic_vector.push_back(mqtt::Subscription::Create(Utf8String::Create(test_topic_base_),
+                                                                  mqtt::QoS::QOS0, p_exact_handler, nullptr));
+                topic_vector.push_back(mqtt::Subscription::Create(Utf8String::Create("#"),
+                                                                  mqtt::QoS::QOS0, p_wildcard_handler, nullptr));
+                ResponseCode rc = Subscribe(test_packet_id_, topic_vector);
+                EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+                std::vector<uint8_t> suback_list;
+                suback_list.push_back(0);
+                suback_list.push_back(0);
+                p_network_connection_->SetNextReadBuf(TestHelper::GetSerializedSubAckMessage(test_packet_id_,
+                                                                                             suback_list));
+                rc = p_network_read_action->PerformAction(p_network_connection_, nullptr);
+                EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+                // Both the exact and the wildcard subscription receive the message
+                p_network_connection_->SetNextReadBuf(TestHelper::GetSerializedPublishMessage(test_topic_base_,
+                                                                                              test_packet_id_,
+                                                                                              mqtt::QoS::QOS0,
+                                                                                              false,
+                                                                                              false,
+                                                                                              test_payload_));
+                rc = p_network_read_action->PerformAction(p_network_connection_, nullptr);
+                EXPECT_EQ(ResponseCode::SUCCESS, rc);
+                EXPECT_EQ(1, exact_callback_count);
+                EXPECT_EQ(1, wildcard_callback_count);
+
+                // Only the wildcard subscription matches other topics
+                p_network_connection_->SetNextReadBuf(TestHelper::GetSerializedPublishMessage(test_topic_base_ + "/child",
+                                                                                              test_packet_id_,
+                                                                                              mqtt::QoS::QOS0,
+                                                                                              false,
+                                                                                              false,
+                                                                                              test_payload_));
+                rc = p_network_read_action->PerformAction(p_network_connection_, nullptr);
+                EXPECT_EQ(ResponseCode::SUCCESS, rc);
+                EXPECT_EQ(1, exact_callback_count);
+                EXPECT_EQ(2, wildcard_callback_count);
+
+                // Removing the wildcard subscription also removes it from matching
+                EXPECT_EQ(ResponseCode::SUCCESS, p_core_state_->RemoveSubscription("#"));
+                util::Vector<std::shared_ptr<mqtt::Subscription>> matches;
+                p_core_state_->GetSubscriptions(test_topic_base_, matches);
+                ASSERT_EQ(1u, matches.size());
+                EXPECT_EQ(test_topic_base_, matches[0]->GetTopicName()->ToStdString());
+            }
+
             TEST_F(SubUnsubActionTester, IncomingLargePublishOnSubscribedTopicTest) {
                 ASSERT_NE(nullptr, p_network_connection_);
                 ASSERT_NE(nullptr, p_core_state_);
@@ -652,7 +727,7 @@ namespace awsiotsdk {
                 srand(time(0));
 
                 for (unsigned int i = 0; i < VALID_WILDCARD_TOPICS; i++) {
-                    util::String randomly_generated_topic = {0};
+                    util::String randomly_generated_topic;
                     for (unsigned int j = 0; j < valid_wildcard_test_topics[i].length(); ++j) {
                         if (valid_wildcard_test_topics[i][j] != '+' &&
                             valid_wildcard_test_topics[i][j] != '#') {
@@ -674,6 +749,107 @@ namespace awsiotsdk {
                     EXPECT_EQ(nullptr, p_core_state_->GetSubscription(unmatched_test_topics_for_wildcards[i]));
                 }
             }
+
+            // SUBACK entries resolve to the Subscriptions of their own request, among many others waiting for Acks
+            TEST_F(SubUnsubActionTester, SubackResolvedByPacketId) {
+                mqtt::Subscription::ApplicationCallbackHandlerPtr p_app_handler =
+                    std::bind(&SubUnsubActionTester::SubscribeCallback,
+                              this,
+                              std::placeholders::_1,
+                              std::placeholders::_2,
+                              std::placeholders::_3);
+                const uint16_t packet_count = 500;
+                util::Vector<util::Vector<std::shared_ptr<mqtt::Subscription>>> packets(packet_count);
+                for (uint16_t packet_id = 1; packet_id <= packet_count; packet_id++) {
+                    for (uint8_t index = 1; index <= MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET; index++) {
+                        std::shared_ptr<mqtt::Subscription> p_subscription =
+                            mqtt::Subscription::Create(Utf8String::Create("asset/" + std::to_string(packet_id) + "/"
+                                                                              + std::to_string(index)),
+                                                       mqtt::QoS::QOS1, p_app_handler, nullptr);
+                        p_core_state_->AddSubscription(p_subscription);
+                        packets[packet_id - 1].push_back(p_subscription);
+                    }
+                    p_core_state_->IndexSubscribePacket(packet_id, packets[packet_id - 1]);
+                }
+
+                // Accept all but the third entry of one packet
+                uint16_t acked_packet_id = packet_count / 2;
+                for (uint8_t index = 1; index <= MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET; index++) {
+                    if (3 == index) {
+                        EXPECT_EQ(ResponseCode::SUCCESS, p_core_state_->RemoveSubscription(acked_packet_id, index));
+                    } else {
+                        EXPECT_EQ(ResponseCode::SUCCESS,
+                                  p_core_state_->SetSubscriptionActive(acked_packet_id, index, mqtt::QoS::QOS0));
+                    }
+                }
+                // Each entry is resolved once
+                EXPECT_EQ(ResponseCode::FAILURE,
+                          p_core_state_->SetSubscriptionActive(acked_packet_id, 1, mqtt::QoS::QOS0));
+
+                for (uint16_t packet_id = 1; packet_id <= packet_count; packet_id++) {
+                    for (const std::shared_ptr<mqtt::Subscription> &p_subscription : packets[packet_id - 1]) {
+                        util::String topic_filter = p_subscription->GetTopicName()->ToStdString();
+                        if (acked_packet_id != packet_id) {
+                            EXPECT_FALSE(p_subscription->IsActive());
+                            EXPECT_EQ(p_subscription, p_core_state_->FindSubscription(topic_filter));
+                        } else if (packets[packet_id - 1][2] == p_subscription) {
+                            EXPECT_EQ(nullptr, p_core_state_->FindSubscription(topic_filter));
+                        } else {
+                            EXPECT_TRUE(p_subscription->IsActive());
+                            EXPECT_EQ(mqtt::QoS::QOS0, p_subscription->GetMaxQos());
+                        }
+                    }
+                }
+
+                // Unsubscribing a whole packet only removes its own Subscriptions
+                for (uint8_t index = 1; index <= MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET; index++) {
+                    util::String topic_filter = packets[0][index - 1]->GetTopicName()->ToStdString();
+                    EXPECT_NE(nullptr, p_core_state_->SetSubscriptionPacketInfo(topic_filter, packet_count + 1, 0));
+                }
+                EXPECT_EQ(ResponseCode::SUCCESS, p_core_state_->RemoveAllSubscriptionsForPacketId(packet_count + 1));
+                EXPECT_EQ(ResponseCode::FAILURE, p_core_state_->RemoveAllSubscriptionsForPacketId(packet_count + 1));
+                util::Vector<std::shared_ptr<mqtt::Subscription>> remaining_subscriptions;
+                p_core_state_->GetAllSubscriptions(remaining_subscriptions);
+                EXPECT_EQ((size_t) ((packet_count - 1) * MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET - 1),
+                          remaining_subscriptions.size());
+            }
+
+            // Received topics can be matched while the application adds and removes Subscriptions
+            TEST_F(SubUnsubActionTester, ConcurrentSubscribeAndMatch) {
+                mqtt::Subscription::ApplicationCallbackHandlerPtr p_app_handler =
+                    std::bind(&SubUnsubActionTester::SubscribeCallback,
+                              this,
+                              std::placeholders::_1,
+                              std::placeholders::_2,
+                              std::placeholders::_3);
+                p_core_state_->AddSubscription(mqtt::Subscription::Create(Utf8String::Create("asset/+/state"),
+                                                                          mqtt::QoS::QOS0, p_app_handler, nullptr));
+
+                std::atomic_bool is_done(false);
+                std::thread subscriber([&]() {
+                    for (int itr = 0; itr < 2000; itr++) {
+                        util::String topic_filter = "asset/" + std::to_string(itr % 50) + "/#";
+                        p_core_state_->AddSubscription(mqtt::Subscription::Create(Utf8String::Create(topic_filter),
+                                                                                  mqtt::QoS::QOS0, p_app_handler,
+                                                                                  nullptr));
+                        p_core_state_->RemoveSubscription(topic_filter);
+                    }
+                    is_done = true;
+                });
+
+                size_t match_count = 0;
+                while (!is_done) {
+                    util::Vector<std::shared_ptr<mqtt::Subscription>> matches;
+                    p_core_state_->GetSubscriptions("asset/7/state", matches);
+                    EXPECT_LE(1u, matches.size());
+                    match_count++;
+                }
+                subscriber.join();
+                EXPECT_LT(0u, match_count);
+                util::Vector<std::shared_ptr<mqtt::Subscription>> matches;
+                p_core_state_->GetSubscriptions("asset/7/state", matches);
+                EXPECT_EQ(1u, matches.size());
+            }
         }
     }
 }
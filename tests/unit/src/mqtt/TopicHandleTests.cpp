@@ -0,0 +1,86 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TopicHandleTests.cpp
+ * @brief
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "mqtt/ClientState.hpp"
+#include "mqtt/Publish.hpp"
+#include "mqtt/TopicHandle.hpp"
+
+namespace awsiotsdk {
+    namespace tests {
+        namespace unit {
+            class TopicHandleTester : public ::testing::Test {
+            protected:
+                static const util::String test_topic_;
+                static const util::String test_payload_;
+            };
+
+            const util::String TopicHandleTester::test_topic_ = "sdk/test/handle";
+            const util::String TopicHandleTester::test_payload_ = "Hello From C++ SDK Tester";
+
+            // Topic names are validated once and stored with their length prefix
+            TEST_F(TopicHandleTester, CreateValidatesAndEncodes) {
+                std::shared_ptr<const mqtt::TopicHandle> p_topic_handle = mqtt::TopicHandle::Create(test_topic_);
+                ASSERT_NE(nullptr, p_topic_handle);
+                EXPECT_EQ(test_topic_, p_topic_handle->GetTopicName());
+                EXPECT_EQ(util::String("\x00\x0F", 2) + test_topic_, p_topic_handle->GetEncodedTopicName());
+
+                EXPECT_EQ(nullptr, mqtt::TopicHandle::Create(""));
+                EXPECT_EQ(nullptr, mqtt::TopicHandle::Create(util::String("bad/\xC3\x28", 6)));
+                EXPECT_EQ(nullptr, mqtt::TopicHandle::Create(util::String(MAX_MQTT_TOPIC_NAME_LENGTH + 1, 'a')));
+                EXPECT_NE(nullptr, mqtt::TopicHandle::Create(util::String(MAX_MQTT_TOPIC_NAME_LENGTH, 'a')));
+            }
+
+            // Interning returns the same handle for the same topic name
+            TEST_F(TopicHandleTester, InternReturnsSameHandle) {
+                std::shared_ptr<mqtt::ClientState> p_client_state =
+                    mqtt::ClientState::Create(std::chrono::milliseconds(200));
+                std::shared_ptr<const mqtt::TopicHandle> p_topic_handle = p_client_state->InternTopic(test_topic_);
+                ASSERT_NE(nullptr, p_topic_handle);
+                EXPECT_EQ(p_topic_handle, p_client_state->InternTopic(test_topic_));
+                EXPECT_NE(p_topic_handle, p_client_state->InternTopic(test_topic_ + "/other"));
+                EXPECT_EQ(nullptr, p_client_state->InternTopic(""));
+            }
+
+            // Packets with a topic handle serialize exactly like packets with a topic name
+            TEST_F(TopicHandleTester, PublishByHandleMatchesPublishByName) {
+                std::shared_ptr<const mqtt::TopicHandle> p_topic_handle = mqtt::TopicHandle::Create(test_topic_);
+                for (mqtt::QoS qos : {mqtt::QoS::QOS0, mqtt::QoS::QOS1}) {
+                    mqtt::PublishPacket by_name(Utf8String::Create(test_topic_), true, false, qos, test_payload_);
+                    mqtt::PublishPacket by_handle(p_topic_handle, true, false, qos, test_payload_);
+                    by_name.SetPacketId(42);
+                    by_handle.SetPacketId(42);
+                    EXPECT_EQ(by_name.Size(), by_handle.Size());
+                    EXPECT_EQ(by_name.ToString(), by_handle.ToString());
+                    EXPECT_EQ(test_topic_, by_handle.GetTopicName());
+                }
+
+                // Reusing a packet switches between topic kinds
+                mqtt::PublishPacket packet(p_topic_handle, false, false, mqtt::QoS::QOS0, test_payload_);
+                packet.Reset(Utf8String::Create("sdk/other"), false, false, mqtt::QoS::QOS0, test_payload_);
+                EXPECT_EQ("sdk/other", packet.GetTopicName());
+                packet.Reset(p_topic_handle, false, false, mqtt::QoS::QOS0, test_payload_);
+                EXPECT_EQ(test_topic_, packet.GetTopicName());
+            }
+        }
+    }
+}
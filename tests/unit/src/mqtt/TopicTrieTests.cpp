@@ -0,0 +1,143 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TopicTrieTests.cpp
+ * @brief
+ *
+ */
+
+#include <algorithm>
+#include <gtest/gtest.h>
+
+#include "mqtt/TopicTrie.hpp"
+
+namespace awsiotsdk {
+    namespace tests {
+        namespace unit {
+            class TopicTrieTester : public ::testing::Test {
+            protected:
+                mqtt::TopicTrie<util::String> trie_;
+
+                void Add(const util::String &topic_filter) {
+                    EXPECT_TRUE(trie_.Insert(topic_filter, topic_filter));
+                }
+
+                util::Vector<util::String> Match(const util::String &topic_name) {
+                    util::Vector<util::String> matches;
+                    trie_.Match(topic_name, matches);
+                    std::sort(matches.begin(), matches.end());
+                    return matches;
+                }
+            };
+
+            // Examples from the MQTT 3.1.1 specification, section 4.7
+            TEST_F(TopicTrieTester, WildcardMatching) {
+                Add("sport/tennis/player1/#");
+                Add("sport/+/player1");
+                Add("sport/#");
+                Add("+/+");
+                Add("/+");
+                Add("+");
+                Add("sport/tennis/player1");
+
+                EXPECT_EQ(util::Vector<util::String>({"sport/#", "sport/+/player1", "sport/tennis/player1",
+                                                      "sport/tennis/player1/#"}),
+                          Match("sport/tennis/player1"));
+                EXPECT_EQ(util::Vector<util::String>({"sport/#", "sport/tennis/player1/#"}),
+                          Match("sport/tennis/player1/ranking"));
+                EXPECT_EQ(util::Vector<util::String>({"sport/#", "sport/tennis/player1/#"}),
+                          Match("sport/tennis/player1/score/wimbledon"));
+                EXPECT_EQ(util::Vector<util::String>({"+", "sport/#"}), Match("sport"));
+                EXPECT_EQ(util::Vector<util::String>({"+/+", "sport/#"}), Match("sport/"));
+                EXPECT_EQ(util::Vector<util::String>({"+/+", "/+"}), Match("/finance"));
+                EXPECT_EQ(util::Vector<util::String>({"sport/#"}), Match("sport/ball/tennis/long"));
+                EXPECT_TRUE(Match("finance/stock/ibm").empty());
+            }
+
+            // Topics starting with $ are not matched by filters starting with a wildcard
+            TEST_F(TopicTrieTester, ReservedTopicsSkipLeadingWildcards) {
+                Add("#");
+                Add("+/monitor/Clients");
+                Add("$SYS/#");
+                Add("$SYS/monitor/+");
+
+                EXPECT_EQ(util::Vector<util::String>({"$SYS/#", "$SYS/monitor/+"}), Match("$SYS/monitor/Clients"));
+                EXPECT_EQ(util::Vector<util::String>({"#", "+/monitor/Clients"}), Match("SYS/monitor/Clients"));
+            }
+
+            // Insert replaces values, Remove prunes the filter without affecting others
+            TEST_F(TopicTrieTester, InsertReplaceRemove) {
+                mqtt::TopicTrie<int> trie;
+                EXPECT_TRUE(trie.Insert("a/+/c", 1));
+                EXPECT_TRUE(trie.Insert("a/+/c", 2));
+                EXPECT_TRUE(trie.Insert("a/b/#", 3));
+                EXPECT_FALSE(trie.Insert("a/#/c", 4));
+                EXPECT_EQ(2u, trie.Size());
+
+                int value = 0;
+                EXPECT_TRUE(trie.Find("a/+/c", value));
+                EXPECT_EQ(2, value);
+                EXPECT_FALSE(trie.Find("a/b/c", value));
+                EXPECT_FALSE(trie.Find("a/+", value));
+
+                util::Vector<int> matches;
+                trie.Match("a/b/c", matches);
+                std::sort(matches.begin(), matches.end());
+                EXPECT_EQ(util::Vector<int>({2, 3}), matches);
+
+                EXPECT_FALSE(trie.Remove("a/+"));
+                EXPECT_FALSE(trie.Remove("a/b/c"));
+                EXPECT_TRUE(trie.Remove("a/+/c"));
+                EXPECT_FALSE(trie.Remove("a/+/c"));
+                EXPECT_EQ(1u, trie.Size());
+
+                matches.clear();
+                trie.Match("a/b/c", matches);
+                EXPECT_EQ(util::Vector<int>({3}), matches);
+
+                trie.Clear();
+                EXPECT_TRUE(trie.IsEmpty());
+                matches.clear();
+                trie.Match("a/b/c", matches);
+                EXPECT_TRUE(matches.empty());
+            }
+
+            // Writes to a trie and to its copies do not affect each other
+            TEST_F(TopicTrieTester, CopiesAreSnapshots) {
+                Add("sport/tennis/+");
+                Add("sport/#");
+                mqtt::TopicTrie<util::String> snapshot(trie_);
+
+                Add("sport/tennis/player1");
+                EXPECT_TRUE(trie_.Remove("sport/#"));
+                EXPECT_EQ(util::Vector<util::String>({"sport/tennis/+", "sport/tennis/player1"}),
+                          Match("sport/tennis/player1"));
+
+                util::Vector<util::String> matches;
+                snapshot.Match("sport/tennis/player1", matches);
+                std::sort(matches.begin(), matches.end());
+                EXPECT_EQ(util::Vector<util::String>({"sport/#", "sport/tennis/+"}), matches);
+                EXPECT_EQ(2u, snapshot.Size());
+
+                EXPECT_TRUE(snapshot.Insert("sport/golf", "sport/golf"));
+                EXPECT_TRUE(Match("sport/golf").empty());
+                trie_.Clear();
+                EXPECT_TRUE(snapshot.Find("sport/tennis/+", matches.front()));
+                EXPECT_EQ(3u, snapshot.Size());
+            }
+        }
+    }
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file BoundedMpscQueueTests.cpp
+ * @brief
+ *
+ */
+
+#include <atomic>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "util/memory/stl/Vector.hpp"
+#include "util/threading/BoundedMpscQueue.hpp"
+
+namespace awsiotsdk {
+    namespace tests {
+        namespace unit {
+            class BoundedMpscQueueTester : public ::testing::Test {
+            protected:
+                typedef util::Threading::BoundedMpscQueue<uint64_t> TestQueue;
+
+                // Encodes producer index in the upper bits so the consumer can verify per-producer FIFO ordering
+                static uint64_t EncodeItem(size_t producer, uint64_t seq) { return (((uint64_t) producer) << 32) | seq; }
+
+                /**
+                 * @brief Drive the queue from producer_count threads while the calling thread consumes, and check that
+                 * every item arrives once and in order for each producer
+                 *
+                 * @param capacity - Capacity of the queue
+                 * @param producer_count - Number of producer threads
+                 * @param items_per_producer - Items pushed by each producer
+                 */
+                static void RunProducers(size_t capacity, size_t producer_count, uint64_t items_per_producer) {
+                    TestQueue queue(capacity);
+                    std::atomic_bool start(false);
+                    util::Vector<std::thread> producers;
+                    util::Vector<uint64_t> next_expected(producer_count, 0);
+
+                    for (size_t itr = 0; itr < producer_count; itr++) {
+                        producers.push_back(std::thread([&queue, &start, itr, items_per_producer]() {
+                            while (!start) {
+                                std::this_thread::yield();
+                            }
+                            for (uint64_t seq = 0; seq < items_per_producer; seq++) {
+                                while (!queue.TryPush(EncodeItem(itr, seq))) {
+                                    std::this_thread::yield();
+                                }
+                            }
+                        }));
+                    }
+
+                    uint64_t total = producer_count * items_per_producer;
+                    uint64_t received = 0;
+                    bool in_order = true;
+                    start = true;
+                    while (received < total) {
+                        uint64_t item;
+                        if (!queue.TryPop(item)) {
+                            std::this_thread::yield();
+                            continue;
+                        }
+                        size_t producer = (size_t) (item >> 32);
+                        uint64_t seq = item & 0xFFFFFFFF;
+                        if (producer >= producer_count || next_expected[producer] != seq) {
+                            in_order = false;
+                        } else {
+                            next_expected[producer]++;
+                        }
+                        received++;
+                    }
+
+                    for (auto &producer : producers) {
+                        producer.join();
+                    }
+
+                    EXPECT_TRUE(in_order);
+                    EXPECT_TRUE(queue.IsEmpty());
+                    for (size_t itr = 0; itr < producer_count; itr++) {
+                        EXPECT_EQ(items_per_producer, next_expected[itr]);
+                    }
+                }
+            };
+
+            // Capacity is rounded up to a power of two, logical max size is clamped to capacity
+            TEST_F(BoundedMpscQueueTester, CapacityAndMaxSize) {
+                TestQueue queue(10);
+                EXPECT_EQ(16u, queue.Capacity());
+                EXPECT_EQ(16u, queue.GetMaxSize());
+
+                queue.SetMaxSize(4);
+                EXPECT_EQ(4u, queue.GetMaxSize());
+
+                queue.SetMaxSize(100);
+                EXPECT_EQ(16u, queue.GetMaxSize());
+            }
+
+            // Single threaded FIFO behavior across multiple laps of the ring
+            TEST_F(BoundedMpscQueueTester, FifoOrder) {
+                TestQueue queue(4);
+                uint64_t item = 0;
+                EXPECT_FALSE(queue.TryPop(item));
+                EXPECT_TRUE(queue.IsEmpty());
+
+                for (uint64_t lap = 0; lap < 10; lap++) {
+                    for (uint64_t itr = 0; itr < 3; itr++) {
+                        EXPECT_TRUE(queue.TryPush(lap * 10 + itr));
+                    }
+                    EXPECT_EQ(3u, queue.Size());
+                    for (uint64_t itr = 0; itr < 3; itr++) {
+                        EXPECT_TRUE(queue.TryPop(item));
+                        EXPECT_EQ(lap * 10 + itr, item);
+                    }
+                    EXPECT_TRUE(queue.IsEmpty());
+                }
+            }
+
+            // Push fails once logical max size is reached and succeeds again after a pop
+            TEST_F(BoundedMpscQueueTester, FullQueue) {
+                TestQueue queue(8);
+                queue.SetMaxSize(2);
+                EXPECT_TRUE(queue.TryPush(1));
+                EXPECT_TRUE(queue.TryPush(2));
+                EXPECT_FALSE(queue.TryPush(3));
+                EXPECT_EQ(2u, queue.Size());
+
+                uint64_t item = 0;
+                EXPECT_TRUE(queue.TryPop(item));
+                EXPECT_EQ(1u, item);
+                EXPECT_TRUE(queue.TryPush(3));
+                EXPECT_FALSE(queue.TryPush(4));
+
+                queue.SetMaxSize(8);
+                for (uint64_t itr = 4; itr < 10; itr++) {
+                    EXPECT_TRUE(queue.TryPush(std::move(itr)));
+                }
+                EXPECT_FALSE(queue.TryPush(10));
+                EXPECT_EQ(8u, queue.Size());
+
+                queue.Clear();
+                EXPECT_TRUE(queue.IsEmpty());
+                EXPECT_FALSE(queue.TryPop(item));
+            }
+
+            // Popped cells release their contents so the queue does not extend object lifetimes
+            TEST_F(BoundedMpscQueueTester, PopReleasesElement) {
+                util::Threading::BoundedMpscQueue<std::shared_ptr<int>> queue(4);
+                std::shared_ptr<int> p_value = std::make_shared<int>(5);
+                EXPECT_TRUE(queue.TryPush(std::shared_ptr<int>(p_value)));
+                EXPECT_EQ(2, p_value.use_count());
+
+                std::shared_ptr<int> p_out;
+                EXPECT_TRUE(queue.TryPop(p_out));
+                p_out.reset();
+                EXPECT_EQ(1, p_value.use_count());
+
+                EXPECT_TRUE(queue.TryPush(std::shared_ptr<int>(p_value)));
+                queue.Clear();
+                EXPECT_EQ(1, p_value.use_count());
+            }
+
+            // Producers contending for a small queue that wraps many times. No items are lost, duplicated or
+            // reordered per producer. Throughput is reported by the mpsc-queue-benchmark-sample
+            TEST_F(BoundedMpscQueueTester, ConcurrentProducers) {
+                RunProducers(16, 1, 5000);
+                RunProducers(16, 4, 5000);
+            }
+        }
+    }
+}
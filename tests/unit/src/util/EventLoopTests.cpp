@@ -0,0 +1,176 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file EventLoopTests.cpp
+ * @brief
+ *
+ */
+
+#if defined(__linux__)
+
+#include <atomic>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "util/threading/EventLoop.hpp"
+
+namespace awsiotsdk {
+    namespace tests {
+        namespace unit {
+            class EventLoopTester : public ::testing::Test {
+            protected:
+                std::shared_ptr<util::Threading::EventLoop> p_event_loop_;
+                int pipe_fds_[2];
+
+                EventLoopTester() {
+                    util::Threading::ExecutorConfig config;
+                    config.worker_count_ = 4;
+                    p_event_loop_ = util::Threading::EventLoop::Create(config);
+                    if (0 != pipe(pipe_fds_)) {
+                        pipe_fds_[0] = -1;
+                        pipe_fds_[1] = -1;
+                    }
+                }
+
+                ~EventLoopTester() {
+                    p_event_loop_ = nullptr;
+                    close(pipe_fds_[0]);
+                    close(pipe_fds_[1]);
+                }
+
+                static bool WaitFor(std::function<bool()> condition, std::chrono::milliseconds timeout) {
+                    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+                    while (!condition()) {
+                        if (std::chrono::steady_clock::now() > deadline) {
+                            return false;
+                        }
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                    return true;
+                }
+            };
+
+            // Loop always has a single thread and still runs timed steps of many tasks
+            TEST_F(EventLoopTester, SingleThreadRunsTimedSteps) {
+                ASSERT_NE(nullptr, p_event_loop_);
+                EXPECT_EQ(1u, p_event_loop_->GetWorkerCount());
+
+                const int task_count = 50;
+                std::atomic_int finished_count(0);
+                for (int itr = 0; itr < task_count; itr++) {
+                    std::shared_ptr<std::atomic_int> p_step_count = std::make_shared<std::atomic_int>(0);
+                    p_event_loop_->Schedule([p_step_count, &finished_count]() {
+                        if (3 == ++(*p_step_count)) {
+                            finished_count++;
+                            return std::chrono::microseconds(-1);
+                        }
+                        return std::chrono::microseconds(std::chrono::milliseconds(2));
+                    }, std::chrono::microseconds(0));
+                }
+
+                EXPECT_TRUE(WaitFor([&finished_count] { return task_count == finished_count; },
+                                    std::chrono::seconds(2)));
+            }
+
+            // Watched descriptor wakes a task that is waiting on a long delay, the watch is one shot
+            TEST_F(EventLoopTester, WatchIsOneShot) {
+                ASSERT_NE(nullptr, p_event_loop_);
+                ASSERT_LE(0, pipe_fds_[0]);
+
+                std::atomic_int step_count(0);
+                std::atomic_int ready_count(0);
+                std::shared_ptr<util::Threading::Executor::Task> p_task = nullptr;
+                std::mutex task_lock;
+                {
+                    std::lock_guard<std::mutex> lock(task_lock);
+                    p_task = p_event_loop_->Schedule([&step_count, &ready_count, &p_task, &task_lock]() {
+                        std::lock_guard<std::mutex> lock(task_lock);
+                        step_count++;
+                        if (p_task->TakeDescriptorReady()) {
+                            ready_count++;
+                        }
+                        return std::chrono::microseconds(std::chrono::seconds(60));
+                    }, std::chrono::microseconds(0));
+                }
+                ASSERT_TRUE(WaitFor([&step_count] { return 1 == step_count; }, std::chrono::seconds(1)));
+                EXPECT_TRUE(p_event_loop_->Watch(p_task, pipe_fds_[0]));
+                EXPECT_EQ(1u, p_event_loop_->GetWatchCount());
+
+                char data_byte = 0;
+                ASSERT_EQ(1, write(pipe_fds_[1], &data_byte, 1));
+                EXPECT_TRUE(WaitFor([&step_count] { return 2 == step_count; }, std::chrono::seconds(1)));
+                EXPECT_EQ(1, ready_count);
+
+                // Still readable, but not re-armed
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                EXPECT_EQ(2, step_count);
+
+                // Re-arming reports the data that is already waiting
+                EXPECT_TRUE(p_event_loop_->Watch(p_task, pipe_fds_[0]));
+                EXPECT_TRUE(WaitFor([&step_count] { return 3 == step_count; }, std::chrono::seconds(1)));
+                EXPECT_EQ(2, ready_count);
+
+                p_event_loop_->Cancel(p_task);
+            }
+
+            // Watches are removed by Unwatch and when the task finishes
+            TEST_F(EventLoopTester, WatchRemovedWithTask) {
+                ASSERT_NE(nullptr, p_event_loop_);
+                ASSERT_LE(0, pipe_fds_[0]);
+
+                std::atomic_int step_count(0);
+                std::shared_ptr<util::Threading::Executor::Task> p_task = p_event_loop_->Schedule([&step_count]() {
+                    step_count++;
+                    return std::chrono::microseconds(std::chrono::seconds(60));
+                }, std::chrono::microseconds(std::chrono::seconds(60)));
+
+                EXPECT_FALSE(p_event_loop_->Watch(p_task, -1));
+                EXPECT_TRUE(p_event_loop_->Watch(p_task, pipe_fds_[0]));
+                p_event_loop_->Unwatch(p_task);
+                EXPECT_EQ(0u, p_event_loop_->GetWatchCount());
+
+                char data_byte = 0;
+                ASSERT_EQ(1, write(pipe_fds_[1], &data_byte, 1));
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                EXPECT_EQ(0, step_count);
+
+                EXPECT_TRUE(p_event_loop_->Watch(p_task, pipe_fds_[0]));
+                EXPECT_TRUE(WaitFor([&step_count] { return 1 == step_count; }, std::chrono::seconds(1)));
+                EXPECT_TRUE(p_event_loop_->Watch(p_task, pipe_fds_[0]));
+                p_event_loop_->Cancel(p_task);
+                EXPECT_EQ(0u, p_event_loop_->GetWatchCount());
+                EXPECT_FALSE(p_event_loop_->Watch(p_task, pipe_fds_[0]));
+            }
+
+            // Base executor does not support watches
+            TEST(ExecutorWatchTester, WatchNotSupported) {
+                util::Threading::ExecutorConfig config;
+                config.worker_count_ = 1;
+                std::shared_ptr<util::Threading::Executor> p_executor = util::Threading::Executor::Create(config);
+                ASSERT_NE(nullptr, p_executor);
+                std::shared_ptr<util::Threading::Executor::Task> p_task = p_executor->Schedule([]() {
+                    return std::chrono::microseconds(-1);
+                }, std::chrono::microseconds(std::chrono::seconds(60)));
+                EXPECT_FALSE(p_executor->Watch(p_task, 0));
+                p_executor->Cancel(p_task);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file ExecutorTests.cpp
+ * @brief
+ *
+ */
+
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+#include "util/threading/Executor.hpp"
+
+namespace awsiotsdk {
+    namespace tests {
+        namespace unit {
+            class ExecutorTester : public ::testing::Test {
+            protected:
+                static bool WaitFor(std::function<bool()> condition, std::chrono::milliseconds timeout) {
+                    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+                    while (!condition()) {
+                        if (std::chrono::steady_clock::now() > deadline) {
+                            return false;
+                        }
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                    return true;
+                }
+            };
+
+            // Many more tasks than workers all make progress, a task finishes by returning a negative delay
+            TEST_F(ExecutorTester, ManyTasksOnFewWorkers) {
+                util::Threading::ExecutorConfig config;
+                config.worker_count_ = 2;
+                config.thread_name_prefix_ = "exec-test-";
+                std::shared_ptr<util::Threading::Executor> p_executor = util::Threading::Executor::Create(config);
+                ASSERT_NE(nullptr, p_executor);
+                EXPECT_EQ(2u, p_executor->GetWorkerCount());
+
+                const int task_count = 100;
+                std::atomic_int finished_count(0);
+                for (int itr = 0; itr < task_count; itr++) {
+                    std::shared_ptr<std::atomic_int> p_step_count = std::make_shared<std::atomic_int>(0);
+                    p_executor->Schedule([p_step_count, &finished_count]() {
+                        if (5 == ++(*p_step_count)) {
+                            finished_count++;
+                            return std::chrono::microseconds(-1);
+                        }
+                        return std::chrono::microseconds(100);
+                    }, std::chrono::microseconds(0));
+                }
+
+                EXPECT_TRUE(WaitFor([&finished_count] { return task_count == finished_count; },
+                                    std::chrono::seconds(5)));
+                EXPECT_TRUE(WaitFor([&p_executor] { return 0 == p_executor->GetTaskCount(); },
+                                    std::chrono::seconds(1)));
+            }
+
+            // Wake runs a task that is waiting on a long delay right away
+            TEST_F(ExecutorTester, WakeRunsStepEarly) {
+                util::Threading::ExecutorConfig config;
+                config.worker_count_ = 1;
+                std::shared_ptr<util::Threading::Executor> p_executor = util::Threading::Executor::Create(config);
+                ASSERT_NE(nullptr, p_executor);
+
+                std::atomic_int step_count(0);
+                std::shared_ptr<util::Threading::Executor::Task> p_task = p_executor->Schedule([&step_count]() {
+                    step_count++;
+                    return std::chrono::microseconds(std::chrono::seconds(60));
+                }, std::chrono::microseconds(0));
+                ASSERT_TRUE(WaitFor([&step_count] { return 1 == step_count; }, std::chrono::seconds(1)));
+
+                p_executor->Wake(p_task);
+                EXPECT_TRUE(WaitFor([&step_count] { return 2 == step_count; }, std::chrono::seconds(1)));
+                p_executor->Cancel(p_task);
+            }
+
+            // A parked task only runs again once it is woken up
+            TEST_F(ExecutorTester, ParkedTaskWaitsForWake) {
+                util::Threading::ExecutorConfig config;
+                config.worker_count_ = 1;
+                std::shared_ptr<util::Threading::Executor> p_executor = util::Threading::Executor::Create(config);
+                ASSERT_NE(nullptr, p_executor);
+
+                std::atomic_int step_count(0);
+                std::shared_ptr<util::Threading::Executor::Task> p_task = p_executor->Schedule([&step_count]() {
+                    step_count++;
+                    return util::Threading::Executor::ParkedStepDelay();
+                }, std::chrono::microseconds(0));
+                ASSERT_TRUE(WaitFor([&step_count] { return 1 == step_count; }, std::chrono::seconds(1)));
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                EXPECT_EQ(1, step_count);
+                EXPECT_EQ(1u, p_executor->GetTaskCount());
+
+                p_executor->Wake(p_task);
+                EXPECT_TRUE(WaitFor([&step_count] { return 2 == step_count; }, std::chrono::seconds(1)));
+                p_executor->Cancel(p_task);
+                EXPECT_EQ(0u, p_executor->GetTaskCount());
+            }
+
+            // No steps run after Cancel returns and the step function is released
+            TEST_F(ExecutorTester, CancelStopsTask) {
+                util::Threading::ExecutorConfig config;
+                config.worker_count_ = 2;
+                std::shared_ptr<util::Threading::Executor> p_executor = util::Threading::Executor::Create(config);
+                ASSERT_NE(nullptr, p_executor);
+
+                std::atomic_int step_count(0);
+                std::shared_ptr<int> p_captured = std::make_shared<int>(0);
+                std::weak_ptr<int> p_weak_captured = p_captured;
+                std::shared_ptr<util::Threading::Executor::Task> p_task = p_executor->Schedule(
+                    [p_captured, &step_count]() {
+                        step_count++;
+                        return std::chrono::microseconds(0);
+                    }, std::chrono::microseconds(0));
+                p_captured.reset();
+                ASSERT_TRUE(WaitFor([&step_count] { return 10 < step_count; }, std::chrono::seconds(1)));
+
+                p_executor->Cancel(p_task);
+                int cancelled_step_count = step_count;
+                EXPECT_TRUE(p_weak_captured.expired());
+                EXPECT_EQ(0u, p_executor->GetTaskCount());
+
+                p_executor->Wake(p_task);
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                EXPECT_EQ(cancelled_step_count, step_count);
+            }
+
+            // Initial delay is honoured and steps of one task never overlap
+            TEST_F(ExecutorTester, DelayedStepsDoNotOverlap) {
+                util::Threading::ExecutorConfig config;
+                config.worker_count_ = 4;
+                std::shared_ptr<util::Threading::Executor> p_executor = util::Threading::Executor::Create(config);
+                ASSERT_NE(nullptr, p_executor);
+
+                std::atomic_int running_count(0);
+                std::atomic_int max_running_count(0);
+                std::atomic_int step_count(0);
+                std::shared_ptr<util::Threading::Executor::Task> p_task = p_executor->Schedule(
+                    [&running_count, &max_running_count, &step_count]() {
+                        int running = ++running_count;
+                        if (running > max_running_count) {
+                            max_running_count = running;
+                        }
+                        step_count++;
+                        std::this_thread::sleep_for(std::chrono::microseconds(200));
+                        running_count--;
+                        return std::chrono::microseconds(std::chrono::milliseconds(1));
+                    }, std::chrono::microseconds(std::chrono::milliseconds(200)));
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                EXPECT_EQ(0, step_count);
+
+                // Wake from other threads must not run the task concurrently
+                for (int itr = 0; itr < 50; itr++) {
+                    p_executor->Wake(p_task);
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                }
+                ASSERT_TRUE(WaitFor([&step_count] { return 20 < step_count; }, std::chrono::seconds(2)));
+                p_executor->Cancel(p_task);
+
+                EXPECT_EQ(1, max_running_count);
+                EXPECT_EQ(0, running_count);
+            }
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file InFlightTableTests.cpp
+ * @brief
+ *
+ */
+
+#include <memory>
+#include <gtest/gtest.h>
+
+#include "util/InFlightTable.hpp"
+
+namespace awsiotsdk {
+    namespace tests {
+        namespace unit {
+            class InFlightTableTester : public ::testing::Test {
+            };
+
+            // Ids can only be occupied once, values are returned and released on Take
+            TEST_F(InFlightTableTester, InsertTakeErase) {
+                util::InFlightTable<int> table(130);
+                EXPECT_EQ(130u, table.Capacity());
+                EXPECT_TRUE(table.Insert(0, 10));
+                EXPECT_TRUE(table.Insert(129, 20));
+                EXPECT_FALSE(table.Insert(129, 30));
+                EXPECT_FALSE(table.Insert(130, 30));
+                EXPECT_EQ(2u, table.Size());
+                EXPECT_TRUE(table.IsInFlight(129));
+                EXPECT_FALSE(table.IsInFlight(64));
+                EXPECT_FALSE(table.IsInFlight(1000));
+
+                int value = 0;
+                EXPECT_TRUE(table.Take(129, value));
+                EXPECT_EQ(20, value);
+                EXPECT_FALSE(table.Take(129, value));
+                EXPECT_FALSE(table.IsInFlight(129));
+                EXPECT_TRUE(table.Erase(0));
+                EXPECT_FALSE(table.Erase(0));
+                EXPECT_EQ(0u, table.Size());
+            }
+
+            // Released values are destroyed right away instead of when the id is reused
+            TEST_F(InFlightTableTester, TakeReleasesValue) {
+                util::InFlightTable<std::shared_ptr<int>> table(4);
+                std::shared_ptr<int> p_value = std::make_shared<int>(1);
+                EXPECT_TRUE(table.Insert(2, p_value));
+                EXPECT_EQ(2, p_value.use_count());
+                EXPECT_TRUE(table.Erase(2));
+                EXPECT_EQ(1, p_value.use_count());
+            }
+
+            // Free id search skips occupied ids across word boundaries and wraps around to min_id
+            TEST_F(InFlightTableTester, FindNextFree) {
+                util::InFlightTable<int> table(200);
+                size_t id = 0;
+                EXPECT_TRUE(table.FindNextFree(5, 1, id));
+                EXPECT_EQ(5u, id);
+
+                for (size_t itr = 60; itr < 140; itr++) {
+                    table.Insert(itr, 0);
+                }
+                EXPECT_TRUE(table.FindNextFree(60, 1, id));
+                EXPECT_EQ(140u, id);
+
+                for (size_t itr = 140; itr < 200; itr++) {
+                    table.Insert(itr, 0);
+                }
+                EXPECT_TRUE(table.FindNextFree(70, 1, id));
+                EXPECT_EQ(1u, id);
+                EXPECT_TRUE(table.FindNextFree(200, 1, id));
+                EXPECT_EQ(1u, id);
+
+                for (size_t itr = 1; itr < 60; itr++) {
+                    table.Insert(itr, 0);
+                }
+                EXPECT_FALSE(table.FindNextFree(70, 1, id));
+                EXPECT_TRUE(table.FindNextFree(70, 0, id));
+                EXPECT_EQ(0u, id);
+
+                table.Erase(100);
+                EXPECT_TRUE(table.FindNextFree(101, 1, id));
+                EXPECT_EQ(100u, id);
+            }
+        }
+    }
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/**
+ * @file KeyedExecutorTests.cpp
+ * @brief
+ *
+ */
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "util/threading/KeyedExecutor.hpp"
+
+namespace awsiotsdk {
+    namespace tests {
+        namespace unit {
+            class KeyedExecutorTester : public ::testing::Test {
+            protected:
+                std::shared_ptr<util::Threading::Executor> p_executor_;
+
+                KeyedExecutorTester() {
+                    util::Threading::ExecutorConfig config;
+                    config.worker_count_ = 4;
+                    config.thread_name_prefix_ = "keyed-test-";
+                    p_executor_ = util::Threading::Executor::Create(config);
+                }
+
+                static bool WaitFor(std::function<bool()> condition, std::chrono::milliseconds timeout) {
+                    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+                    while (!condition()) {
+                        if (std::chrono::steady_clock::now() > deadline) {
+                            return false;
+                        }
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                    return true;
+                }
+            };
+
+            // Items with the same key run in submission order, never concurrently
+            TEST_F(KeyedExecutorTester, SameKeyRunsInOrder) {
+                ASSERT_NE(nullptr, p_executor_);
+                EXPECT_EQ(nullptr, util::Threading::KeyedExecutor::Create(nullptr, 4, 16));
+                EXPECT_EQ(nullptr, util::Threading::KeyedExecutor::Create(p_executor_, 0, 16));
+                EXPECT_EQ(nullptr, util::Threading::KeyedExecutor::Create(p_executor_, 4, 0));
+                std::shared_ptr<util::Threading::KeyedExecutor>
+                    p_keyed_executor = util::Threading::KeyedExecutor::Create(p_executor_, 4, 16);
+                ASSERT_NE(nullptr, p_keyed_executor);
+                EXPECT_EQ(4u, p_keyed_executor->GetShardCount());
+                EXPECT_FALSE(p_keyed_executor->Submit("key", nullptr));
+
+                const int key_count = 8;
+                const int item_count = 200;
+                std::mutex order_lock;
+                util::Vector<util::Vector<int>> run_order(key_count);
+                std::atomic_int run_count(0);
+                for (int itr = 0; itr < item_count; itr++) {
+                    for (int key = 0; key < key_count; key++) {
+                        EXPECT_TRUE(p_keyed_executor->Submit("key/" + std::to_string(key),
+                                                             [&order_lock, &run_order, &run_count, key, itr]() {
+                            std::lock_guard<std::mutex> order_guard(order_lock);
+                            run_order[key].push_back(itr);
+                            run_count++;
+                        }));
+                    }
+                }
+
+                EXPECT_TRUE(WaitFor([&run_count] { return key_count * item_count == run_count; },
+                                    std::chrono::seconds(5)));
+                for (int key = 0; key < key_count; key++) {
+                    ASSERT_EQ((size_t) item_count, run_order[key].size());
+                    for (int itr = 0; itr < item_count; itr++) {
+                        EXPECT_EQ(itr, run_order[key][itr]);
+                    }
+                }
+                EXPECT_EQ(0u, p_keyed_executor->GetQueuedCount());
+            }
+
+            // A blocked item only holds up its own shard, and Submit waits while that shard is full
+            TEST_F(KeyedExecutorTester, BlockedShardAppliesBackpressure) {
+                ASSERT_NE(nullptr, p_executor_);
+                std::shared_ptr<util::Threading::KeyedExecutor>
+                    p_keyed_executor = util::Threading::KeyedExecutor::Create(p_executor_, 2, 2);
+                ASSERT_NE(nullptr, p_keyed_executor);
+
+                // Find a key for the other shard
+                util::String blocked_key = "blocked";
+                util::String free_key;
+                for (int itr = 0; free_key.empty(); itr++) {
+                    util::String key = "free/" + std::to_string(itr);
+                    if (std::hash<util::String>()(key) % 2 != std::hash<util::String>()(blocked_key) % 2) {
+                        free_key = key;
+                    }
+                }
+
+                std::atomic_bool is_released(false);
+                std::atomic_bool is_blocking(false);
+                EXPECT_TRUE(p_keyed_executor->Submit(blocked_key, [&is_released, &is_blocking]() {
+                    is_blocking = true;
+                    while (!is_released) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                }));
+                ASSERT_TRUE(WaitFor([&is_blocking] { return is_blocking.load(); }, std::chrono::seconds(5)));
+
+                std::atomic_int blocked_run_count(0);
+                for (int itr = 0; itr < 2; itr++) {
+                    EXPECT_TRUE(p_keyed_executor->Submit(blocked_key, [&blocked_run_count]() { blocked_run_count++; }));
+                }
+                EXPECT_EQ(2u, p_keyed_executor->GetQueuedCount());
+
+                // TrySubmit returns right away and leaves the item with the caller
+                util::Threading::KeyedExecutor::WorkItemPtr p_kept_item = [&blocked_run_count]() {
+                    blocked_run_count++;
+                };
+                EXPECT_FALSE(p_keyed_executor->TrySubmit(blocked_key, p_kept_item));
+                EXPECT_NE(nullptr, p_kept_item);
+
+                std::atomic_bool is_third_submitted(false);
+                std::thread submit_thread([&]() {
+                    p_keyed_executor->Submit(blocked_key, [&blocked_run_count]() { blocked_run_count++; });
+                    is_third_submitted = true;
+                });
+
+                std::atomic_int free_run_count(0);
+                EXPECT_TRUE(p_keyed_executor->Submit(free_key, [&free_run_count]() { free_run_count++; }));
+                EXPECT_TRUE(WaitFor([&free_run_count] { return 1 == free_run_count; }, std::chrono::seconds(5)));
+                EXPECT_FALSE(is_third_submitted);
+                EXPECT_EQ(0, blocked_run_count);
+
+                is_released = true;
+                submit_thread.join();
+                EXPECT_TRUE(WaitFor([&blocked_run_count] { return 3 == blocked_run_count; }, std::chrono::seconds(5)));
+            }
+        }
+    }
+}
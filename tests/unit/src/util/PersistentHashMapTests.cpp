@@ -0,0 +1,165 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PersistentHashMapTests.cpp
+ * @brief
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "util/memory/stl/String.hpp"
+#include "util/PersistentHashMap.hpp"
+
+namespace awsiotsdk {
+    namespace tests {
+        namespace unit {
+            class PersistentHashMapTester : public ::testing::Test {
+            protected:
+                // Sends every key to the same collision list at the bottom of the trie
+                class ConstantHash {
+                public:
+                    size_t operator()(int) const { return 42; }
+                };
+
+                // Keys that share their lowest 5 bits, and so their first levels, but differ in higher ones
+                class ShiftedHash {
+                public:
+                    size_t operator()(int key) const { return static_cast<size_t>(key) << 20; }
+                };
+
+                template<typename Map>
+                static void ExpectAllFound(const Map &map, int count, int value_offset) {
+                    for (int itr = 0; itr < count; itr++) {
+                        const int *p_value = map.Find(itr);
+                        ASSERT_NE(nullptr, p_value);
+                        EXPECT_EQ(itr + value_offset, *p_value);
+                    }
+                }
+            };
+
+            TEST_F(PersistentHashMapTester, InsertReplaceErase) {
+                util::PersistentHashMap<util::String, int> map;
+                EXPECT_TRUE(map.IsEmpty());
+                EXPECT_EQ(nullptr, map.Find("a"));
+
+                map.Insert("a", 1);
+                map.Insert("b", 2);
+                map.Insert("a", 3);
+                EXPECT_EQ(2u, map.Size());
+                EXPECT_EQ(3, *map.Find("a"));
+                EXPECT_EQ(2, *map.Find("b"));
+
+                EXPECT_FALSE(map.Erase("c"));
+                EXPECT_TRUE(map.Erase("a"));
+                EXPECT_FALSE(map.Erase("a"));
+                EXPECT_EQ(nullptr, map.Find("a"));
+                EXPECT_EQ(1u, map.Size());
+
+                map.Clear();
+                EXPECT_TRUE(map.IsEmpty());
+                EXPECT_EQ(nullptr, map.Find("b"));
+            }
+
+            // Enough keys to need several levels, every key stays reachable while others are erased
+            TEST_F(PersistentHashMapTester, ManyKeys) {
+                const int count = 20000;
+                util::PersistentHashMap<int, int> map;
+                for (int itr = 0; itr < count; itr++) {
+                    map.Insert(itr, itr + 1);
+                }
+                EXPECT_EQ(static_cast<size_t>(count), map.Size());
+                ExpectAllFound(map, count, 1);
+
+                for (int itr = 0; itr < count; itr += 2) {
+                    EXPECT_TRUE(map.Erase(itr));
+                }
+                EXPECT_EQ(static_cast<size_t>(count / 2), map.Size());
+                for (int itr = 0; itr < count; itr++) {
+                    const int *p_value = map.Find(itr);
+                    if (0 == itr % 2) {
+                        EXPECT_EQ(nullptr, p_value);
+                    } else {
+                        ASSERT_NE(nullptr, p_value);
+                        EXPECT_EQ(itr + 1, *p_value);
+                    }
+                }
+
+                for (int itr = 1; itr < count; itr += 2) {
+                    EXPECT_TRUE(map.Erase(itr));
+                }
+                EXPECT_TRUE(map.IsEmpty());
+            }
+
+            TEST_F(PersistentHashMapTester, EqualHashes) {
+                util::PersistentHashMap<int, int, ConstantHash> map;
+                for (int itr = 0; itr < 10; itr++) {
+                    map.Insert(itr, itr);
+                }
+                map.Insert(3, 30);
+                EXPECT_EQ(10u, map.Size());
+                EXPECT_EQ(30, *map.Find(3));
+                EXPECT_EQ(nullptr, map.Find(10));
+
+                EXPECT_TRUE(map.Erase(3));
+                EXPECT_FALSE(map.Erase(3));
+                EXPECT_EQ(9, *map.Find(9));
+                EXPECT_EQ(0, *map.Find(0));
+            }
+
+            TEST_F(PersistentHashMapTester, SharedHashPrefix) {
+                util::PersistentHashMap<int, int, ShiftedHash> map;
+                for (int itr = 0; itr < 100; itr++) {
+                    map.Insert(itr, itr);
+                }
+                ExpectAllFound(map, 100, 0);
+                for (int itr = 99; itr > 0; itr--) {
+                    EXPECT_TRUE(map.Erase(itr));
+                    ExpectAllFound(map, itr, 0);
+                }
+                EXPECT_EQ(1u, map.Size());
+            }
+
+            // Writes to a map or its copy are not visible in the other
+            TEST_F(PersistentHashMapTester, CopiesAreSnapshots) {
+                const int count = 1000;
+                util::PersistentHashMap<int, int> map;
+                for (int itr = 0; itr < count; itr++) {
+                    map.Insert(itr, itr);
+                }
+
+                util::PersistentHashMap<int, int> snapshot(map);
+                for (int itr = 0; itr < count; itr++) {
+                    map.Insert(itr, itr + 1);
+                }
+                map.Insert(count, count + 1);
+                EXPECT_TRUE(map.Erase(0));
+
+                EXPECT_EQ(static_cast<size_t>(count), snapshot.Size());
+                ExpectAllFound(snapshot, count, 0);
+                EXPECT_EQ(nullptr, snapshot.Find(count));
+
+                snapshot.Erase(1);
+                EXPECT_EQ(2, *map.Find(1));
+                EXPECT_EQ(static_cast<size_t>(count), map.Size());
+
+                util::PersistentHashMap<int, int> moved(std::move(snapshot));
+                EXPECT_TRUE(snapshot.IsEmpty());
+                EXPECT_EQ(static_cast<size_t>(count - 1), moved.Size());
+            }
+        }
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file SharedObjectPoolTests.cpp
+ * @brief
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "util/SharedObjectPool.hpp"
+
+namespace awsiotsdk {
+    namespace tests {
+        namespace unit {
+            class SharedObjectPoolTester : public ::testing::Test {
+            protected:
+                int create_count_;
+
+                SharedObjectPoolTester() : create_count_(0) {}
+
+                std::shared_ptr<int> Acquire(util::SharedObjectPool<int> &pool) {
+                    return pool.Acquire([this]() {
+                        create_count_++;
+                        return std::make_shared<int>(create_count_);
+                    });
+                }
+            };
+
+            // Objects in use are never handed out twice, released objects are reused before new ones are created
+            TEST_F(SharedObjectPoolTester, ReleasedObjectsAreReused) {
+                util::SharedObjectPool<int> pool(2);
+                std::shared_ptr<int> p_first = Acquire(pool);
+                std::shared_ptr<int> p_second = Acquire(pool);
+                ASSERT_NE(nullptr, p_first);
+                ASSERT_NE(nullptr, p_second);
+                EXPECT_NE(p_first.get(), p_second.get());
+                EXPECT_EQ(nullptr, Acquire(pool));
+
+                int *p_released = p_second.get();
+                std::shared_ptr<int> p_copy = p_second;
+                p_second.reset();
+                EXPECT_EQ(nullptr, Acquire(pool));
+
+                p_copy.reset();
+                EXPECT_EQ(p_released, Acquire(pool).get());
+                EXPECT_EQ(2, create_count_);
+                EXPECT_EQ(2u, pool.Size());
+            }
+
+            // Objects that create fails for are not added to the pool
+            TEST_F(SharedObjectPoolTester, FailedCreateNotPooled) {
+                util::SharedObjectPool<int> pool(1);
+                EXPECT_EQ(nullptr, pool.Acquire([]() { return std::shared_ptr<int>(); }));
+                EXPECT_EQ(0u, pool.Size());
+                EXPECT_NE(nullptr, Acquire(pool));
+                EXPECT_EQ(1u, pool.Size());
+            }
+        }
+    }
+}
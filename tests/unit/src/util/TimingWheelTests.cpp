@@ -0,0 +1,142 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TimingWheelTests.cpp
+ * @brief
+ *
+ */
+
+#include <random>
+#include <gtest/gtest.h>
+
+#include "util/memory/stl/Map.hpp"
+#include "util/memory/stl/Vector.hpp"
+#include "util/threading/TimingWheel.hpp"
+
+namespace awsiotsdk {
+    namespace tests {
+        namespace unit {
+            class TimingWheelTester : public ::testing::Test {
+            protected:
+                typedef util::Threading::TimingWheel TimingWheel;
+
+                util::Vector<size_t> expired_;
+                TimingWheel::ExpiryHandlerPtr p_expiry_handler_;
+
+                TimingWheelTester() {
+                    p_expiry_handler_ = [this](size_t entry_id) { expired_.push_back(entry_id); };
+                }
+            };
+
+            // Entries expire exactly at their expiry tick, not before
+            TEST_F(TimingWheelTester, ExpiresAtTick) {
+                TimingWheel wheel(16, 0);
+                EXPECT_TRUE(wheel.Schedule(1, 5));
+                EXPECT_TRUE(wheel.Schedule(2, 70));
+                EXPECT_TRUE(wheel.Schedule(3, 5000));
+                EXPECT_FALSE(wheel.Schedule(16, 5));
+                EXPECT_EQ(3u, wheel.Size());
+
+                EXPECT_EQ(0u, wheel.Advance(4, p_expiry_handler_));
+                EXPECT_EQ(1u, wheel.Advance(5, p_expiry_handler_));
+                EXPECT_EQ(1u, expired_[0]);
+                EXPECT_FALSE(wheel.IsScheduled(1));
+
+                EXPECT_EQ(0u, wheel.Advance(69, p_expiry_handler_));
+                EXPECT_EQ(1u, wheel.Advance(70, p_expiry_handler_));
+                EXPECT_EQ(2u, expired_[1]);
+
+                EXPECT_EQ(0u, wheel.Advance(4999, p_expiry_handler_));
+                EXPECT_EQ(1u, wheel.Advance(5000, p_expiry_handler_));
+                EXPECT_EQ(3u, expired_[2]);
+                EXPECT_EQ(0u, wheel.Size());
+            }
+
+            // Cancelled entries never expire, rescheduled entries use the latest expiry
+            TEST_F(TimingWheelTester, CancelAndReschedule) {
+                TimingWheel wheel(16, 100);
+                wheel.Schedule(1, 110);
+                wheel.Schedule(2, 110);
+                wheel.Schedule(3, 110);
+                wheel.Cancel(2);
+                wheel.Cancel(2);
+                wheel.Schedule(3, 300);
+                EXPECT_EQ(2u, wheel.Size());
+
+                EXPECT_EQ(1u, wheel.Advance(200, p_expiry_handler_));
+                EXPECT_EQ(1u, expired_[0]);
+                EXPECT_TRUE(wheel.IsScheduled(3));
+                EXPECT_EQ(1u, wheel.Advance(300, p_expiry_handler_));
+                EXPECT_EQ(3u, expired_[1]);
+            }
+
+            // Expiry in the past expires on the next advance, idle wheel jumps ahead without losing new entries
+            TEST_F(TimingWheelTester, PastExpiryAndIdleJump) {
+                TimingWheel wheel(4, 1000);
+                wheel.Schedule(0, 10);
+                EXPECT_EQ(1u, wheel.Advance(1000, p_expiry_handler_));
+
+                EXPECT_EQ(0u, wheel.Advance(1000000, p_expiry_handler_));
+                wheel.Schedule(1, 1000064);
+                EXPECT_EQ(0u, wheel.Advance(1000063, p_expiry_handler_));
+                EXPECT_EQ(1u, wheel.Advance(1000064, p_expiry_handler_));
+            }
+
+            // Compare against a naive model with random schedule/cancel/advance operations across all levels
+            TEST_F(TimingWheelTester, RandomizedAgainstModel) {
+                const size_t capacity = 256;
+                TimingWheel wheel(capacity, 0);
+                util::Map<size_t, TimingWheel::Tick> model;
+                std::mt19937 generator(42);
+                TimingWheel::Tick now = 0;
+
+                for (size_t itr = 0; itr < 20000; itr++) {
+                    size_t entry_id = generator() % capacity;
+                    switch (generator() % 4) {
+                        case 0:
+                        case 1: {
+                            // Mix of short and long timeouts so every level is exercised
+                            TimingWheel::Tick delta = generator() % (1 << (6 * (1 + generator() % 3)));
+                            wheel.Schedule(entry_id, now + delta);
+                            model[entry_id] = now + delta;
+                            break;
+                        }
+                        case 2:
+                            wheel.Cancel(entry_id);
+                            model.erase(entry_id);
+                            break;
+                        default: {
+                            now += generator() % 200;
+                            expired_.clear();
+                            wheel.Advance(now, p_expiry_handler_);
+                            for (size_t expired_id : expired_) {
+                                auto model_itr = model.find(expired_id);
+                                ASSERT_NE(model.end(), model_itr);
+                                EXPECT_LE(model_itr->second, now);
+                                model.erase(model_itr);
+                            }
+                            for (auto &entry : model) {
+                                EXPECT_GT(entry.second, now);
+                            }
+                            break;
+                        }
+                    }
+                    ASSERT_EQ(model.size(), wheel.Size());
+                }
+            }
+        }
+    }
+}
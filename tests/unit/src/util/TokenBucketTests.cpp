@@ -0,0 +1,103 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TokenBucketTests.cpp
+ * @brief
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "util/threading/TokenBucket.hpp"
+
+namespace awsiotsdk {
+    namespace tests {
+        namespace unit {
+            class TokenBucketTester : public ::testing::Test {
+            protected:
+                typedef util::Threading::TokenBucket::Clock Clock;
+            };
+
+            // Full bucket allows burst_size tokens back to back, then reports the time to the next token
+            TEST_F(TokenBucketTester, BurstThenWait) {
+                util::Threading::TokenBucket bucket(10, 3);
+                Clock::time_point now = Clock::now();
+                std::chrono::microseconds wait_time(0);
+
+                for (int itr = 0; itr < 3; itr++) {
+                    EXPECT_TRUE(bucket.TryConsume(now, wait_time));
+                    EXPECT_EQ(0, wait_time.count());
+                }
+                EXPECT_FALSE(bucket.TryConsume(now, wait_time));
+                EXPECT_LE(99000, wait_time.count());
+                EXPECT_GE(101000, wait_time.count());
+
+                // One token is earned every 100ms at 10 per second
+                EXPECT_FALSE(bucket.TryConsume(now + std::chrono::milliseconds(50), wait_time));
+                EXPECT_TRUE(bucket.TryConsume(now + std::chrono::milliseconds(101), wait_time));
+                EXPECT_FALSE(bucket.TryConsume(now + std::chrono::milliseconds(101), wait_time));
+            }
+
+            // Tokens accumulated while idle never exceed the burst size
+            TEST_F(TokenBucketTester, IdleRefillCappedAtBurst) {
+                util::Threading::TokenBucket bucket(100, 5);
+                Clock::time_point now = Clock::now();
+                std::chrono::microseconds wait_time(0);
+
+                while (bucket.TryConsume(now, wait_time)) {
+                }
+                now += std::chrono::seconds(10);
+                int consumed = 0;
+                while (bucket.TryConsume(now, wait_time)) {
+                    consumed++;
+                }
+                EXPECT_EQ(5, consumed);
+            }
+
+            // Non positive rate disables limiting
+            TEST_F(TokenBucketTester, Unlimited) {
+                util::Threading::TokenBucket bucket(0, 1);
+                Clock::time_point now = Clock::now();
+                std::chrono::microseconds wait_time(0);
+                for (int itr = 0; itr < 1000; itr++) {
+                    EXPECT_TRUE(bucket.TryConsume(now, wait_time));
+                }
+            }
+
+            // Rate and burst size can be updated at runtime, available tokens are capped to the new burst size
+            TEST_F(TokenBucketTester, SetRate) {
+                util::Threading::TokenBucket bucket(1, 10);
+                EXPECT_EQ(1, bucket.GetRate());
+                EXPECT_EQ(10u, bucket.GetBurstSize());
+
+                bucket.SetRate(100, 2);
+                EXPECT_EQ(100, bucket.GetRate());
+                EXPECT_EQ(2u, bucket.GetBurstSize());
+
+                std::chrono::microseconds wait_time(0);
+                Clock::time_point now = Clock::now();
+                EXPECT_TRUE(bucket.TryConsume(now, wait_time));
+                EXPECT_TRUE(bucket.TryConsume(now, wait_time));
+                EXPECT_FALSE(bucket.TryConsume(now, wait_time));
+                EXPECT_GE(10001, wait_time.count());
+
+                // Burst size of 0 is treated as 1
+                bucket.SetRate(100, 0);
+                EXPECT_EQ(1u, bucket.GetBurstSize());
+            }
+        }
+    }
+}
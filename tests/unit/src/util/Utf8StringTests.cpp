@@ -0,0 +1,90 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file Utf8StringTests.cpp
+ * @brief
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "util/Utf8String.hpp"
+
+// Longer than the widest ASCII block checked at once, so sequences are tested in every block position
+#define UTF8_TEST_ASCII_LENGTH 100
+
+namespace awsiotsdk {
+    namespace tests {
+        namespace unit {
+            class Utf8StringTester : public ::testing::Test {
+            protected:
+                /**
+                 * @brief Check a byte sequence embedded at every offset of an ASCII string
+                 *
+                 * @param sequence - bytes to embed
+                 * @param is_valid - expected result for every offset
+                 */
+                static void ExpectAtEveryOffset(const util::String &sequence, bool is_valid) {
+                    util::String ascii(UTF8_TEST_ASCII_LENGTH, 'a');
+                    for (size_t offset = 0; offset <= UTF8_TEST_ASCII_LENGTH; offset++) {
+                        util::String input = ascii.substr(0, offset) + sequence + ascii.substr(offset);
+                        EXPECT_EQ(is_valid, Utf8String::IsValidInput(input)) << "offset " << offset;
+                        EXPECT_EQ(is_valid, Utf8String::IsValidInput(input.data(), input.length()))
+                                        << "offset " << offset;
+                    }
+
+                    // Sequence at the very end, nothing follows it
+                    util::String input = ascii + sequence;
+                    EXPECT_EQ(is_valid, Utf8String::IsValidInput(input));
+                }
+            };
+
+            // Valid sequences of every length are accepted wherever they are
+            TEST_F(Utf8StringTester, ValidSequences) {
+                EXPECT_TRUE(Utf8String::IsValidInput(""));
+                EXPECT_TRUE(Utf8String::IsValidInput(util::String(UTF8_TEST_ASCII_LENGTH, 'a')));
+                ExpectAtEveryOffset("\xC3\xA9", true);                   // U+00E9
+                ExpectAtEveryOffset("\xE2\x82\xAC", true);               // U+20AC
+                ExpectAtEveryOffset("\xF0\x9F\x98\x80", true);           // U+1F600
+                ExpectAtEveryOffset("\xF4\x8F\xBF\xBF", true);           // U+10FFFF
+                ExpectAtEveryOffset("\xE6\xB8\xA9\xE5\xBA\xA6/\xC3\xA9", true);
+                ExpectAtEveryOffset(util::String("\x00", 1), true);
+            }
+
+            // Invalid sequences are rejected wherever they are, including after ASCII blocks
+            TEST_F(Utf8StringTester, InvalidSequences) {
+                ExpectAtEveryOffset("\xFF", false);                      // Invalid lead byte
+                ExpectAtEveryOffset("\x80", false);                      // Trail byte without lead
+                ExpectAtEveryOffset("\xC3", false);                      // Missing trail byte
+                ExpectAtEveryOffset("\xE2\x82", false);                  // Missing trail byte
+                ExpectAtEveryOffset("\xC0\x80", false);                  // Overlong
+                ExpectAtEveryOffset("\xE0\x80\xAF", false);              // Overlong
+                ExpectAtEveryOffset("\xED\xA0\x80", false);              // Surrogate
+                ExpectAtEveryOffset("\xF4\x90\x80\x80", false);          // Above U+10FFFF
+            }
+
+            // Create keeps the string and rejects invalid input
+            TEST_F(Utf8StringTester, Create) {
+                std::unique_ptr<Utf8String> p_str = Utf8String::Create("sdk/\xC3\xA9t\xC3\xA9");
+                ASSERT_NE(nullptr, p_str);
+                EXPECT_EQ("sdk/\xC3\xA9t\xC3\xA9", p_str->ToStdString());
+                EXPECT_EQ(9u, p_str->Length());
+                EXPECT_EQ(nullptr, Utf8String::Create("sdk/\xC3"));
+                EXPECT_EQ(nullptr, Utf8String::Create("sdk/\xC3\xA9", 5));
+            }
+        }
+    }
+}